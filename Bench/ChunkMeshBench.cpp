@@ -0,0 +1,74 @@
+﻿// 청크 메셔 벤치마크: 꽉 찬 / 체커보드 / 무작위 청크의 정점·삼각형 감소 비율과 메싱 시간 (그리디, 면 컬링만)을 출력한다
+// 사용법: ChunkMeshBench [반복 (기본 20, 최소 시간)]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "ChunkMesher.h"
+
+// vol을 greedy/면 컬링만으로 iterations번 메싱해 최소 시간 (ms)과 통계를 돌려준다
+static double TimeBuild(ChunkMesher& mesher, const PaddedChunk& vol, bool greedy, int iterations, MeshStats& stats)
+{
+    ChunkMeshData mesh;
+    double best = 1e30;
+    for (int it = 0; it < iterations; ++it)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        mesher.Build(vol, 1.0f, mesh, greedy);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    stats = mesh.stats;
+    return best;
+}
+
+static void Print(const char* label, const SparseGrid& grid, int iterations)
+{
+    auto vol = std::make_unique<PaddedChunk>();
+    vol->Build(grid, *grid.FindChunk({ 0, 0, 0 }));
+
+    ChunkMesher mesher;
+    MeshStats greedy, culled;
+    double greedyMs = TimeBuild(mesher, *vol, true, iterations, greedy);
+    double culledMs = TimeBuild(mesher, *vol, false, iterations, culled);
+    printf("[Bench] Greedy mesh %s chunk: %u cells, %u verts / %u tris (x%.2f / x%.2f fewer), %.3f ms (face culling only: %u tris, %.3f ms)\n",
+        label, greedy.cells, greedy.vertices, greedy.triangles, greedy.VertexReduction(), greedy.TriangleReduction(), greedyMs,
+        culled.triangles, culledMs);
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = (argc > 1) ? atoi(argv[1]) : 20;
+    if (iterations <= 0)
+    {
+        fprintf(stderr, "usage: ChunkMeshBench [iterations]\n");
+        return 2;
+    }
+
+    // 보고서와 같은 꽉 찬 / 체커보드 청크 + 절반 채운 무작위 청크
+    SparseGrid solid, checker, random;
+    std::mt19937 rng(5);
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                solid.Set({ x, y, z }, 1);
+                if (((x + y + z) & 1) == 0) checker.Set({ x, y, z }, 1);
+                if (rng() & 1) random.Set({ x, y, z }, uint8_t(1 + (rng() & 1)));
+            }
+
+    Print("solid", solid, iterations);
+    Print("checkerboard", checker, iterations);
+    Print("random", random, iterations);
+
+    // 앱의 -bench가 출력하는 보고서와 같은 값인지
+    MeshReductionReport mr = BuildMeshReductionReport();
+    printf("[Bench] Mesh reduction report: solid x%.0f / x%.0f, checkerboard x%.2f / x%.2f fewer verts / tris\n",
+        mr.solid.VertexReduction(), mr.solid.TriangleReduction(),
+        mr.checkerboard.VertexReduction(), mr.checkerboard.TriangleReduction());
+    return 0;
+}
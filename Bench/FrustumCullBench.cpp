@@ -0,0 +1,24 @@
+﻿// 절두체 컬링 벤치마크: 무작위 AABB를 8개씩 SoA 배치로 컬링하고 AABB당 ns를 출력한다
+// 사용법: FrustumCullBench [AABB 수 (기본 1000000)] [반복 (기본 10)]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "FrustumCull.h"
+
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? size_t(strtoull(argv[1], nullptr, 10)) : 1000000;
+    const int iterations = (argc > 2) ? atoi(argv[2]) : 10;
+    if (count == 0 || iterations <= 0)
+    {
+        fprintf(stderr, "usage: FrustumCullBench [aabbs] [iterations]\n");
+        return 2;
+    }
+
+    // 캐시에 들어가는 크기부터 요청한 크기까지
+    for (size_t n = 1000; n < count; n *= 10)
+        printf("[Bench] Frustum cull %zu AABB: %.3f ns/AABB\n", n, BenchmarkFrustumCull(n, iterations));
+    printf("[Bench] Frustum cull %zu AABB: %.3f ns/AABB\n", count, BenchmarkFrustumCull(count, iterations));
+    return 0;
+}
@@ -0,0 +1,33 @@
+﻿// 오클루전 컬링 벤치마크: 벽 형태 가리개를 래스터하고 무작위 박스를 판정한 시간을 출력한다
+// 사용법: OcclusionBench [가리개 수 (기본 1024)] [판정할 박스 수 (기본 1000000)]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "OcclusionCuller.h"
+
+static void Print(const char* label, const OcclusionStats& os)
+{
+    printf("[Bench] Occlusion (%s): %u occluders (%u polys) raster %.1f us, %u tested / %u occluded in %.1f us (%.2f ns/box)\n",
+        label, os.occluders, os.polygons, os.rasterMicroseconds, os.tested, os.occluded, os.testMicroseconds,
+        os.tested ? os.testMicroseconds * 1000.0 / os.tested : 0.0);
+}
+
+int main(int argc, char** argv)
+{
+    const int occluders = (argc > 1) ? atoi(argv[1]) : 1024;
+    const int tests = (argc > 2) ? atoi(argv[2]) : 1000000;
+    if (occluders <= 0 || tests <= 0)
+    {
+        fprintf(stderr, "usage: OcclusionBench [occluders] [tests]\n");
+        return 2;
+    }
+
+    Print("1 thread", BenchmarkOcclusionCull(occluders, tests, nullptr));
+
+    ThreadPool pool;
+    char label[32];
+    snprintf(label, sizeof(label), "%zu threads", pool.ThreadCount());
+    Print(label, BenchmarkOcclusionCull(occluders, tests, &pool));
+    return 0;
+}
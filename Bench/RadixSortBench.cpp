@@ -0,0 +1,23 @@
+﻿// 기수 정렬 벤치마크: 무작위 64비트 키를 (키, 인덱스) 쌍으로 RadixSort64와 std::stable_sort로 정렬해 비교한다
+// 사용법: RadixSortBench [키 수 (기본 1000000)] [반복 (기본 5, 최소 시간)]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "RenderQueue.h"
+
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? size_t(strtoull(argv[1], nullptr, 10)) : 1000000;
+    const int iterations = (argc > 2) ? atoi(argv[2]) : 5;
+    if (count == 0 || iterations <= 0)
+    {
+        fprintf(stderr, "usage: RadixSortBench [keys] [iterations]\n");
+        return 2;
+    }
+
+    RadixSortBenchmark rs = BenchmarkRadixSort(count, iterations);
+    printf("[Bench] Radix sort %zu 64-bit keys: %.2f ms (std::stable_sort %.2f ms, x%.1f)%s\n",
+        rs.count, rs.radixMs, rs.stdSortMs, rs.stdSortMs / rs.radixMs, rs.matches ? "" : " MISMATCH");
+    return rs.matches ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+﻿// BoxHeadless: D3DBoxApp 장면을 창/GPU 없이 돌리는 Linux/Windows 콘솔 도구 (SceneScript.h)
+// 사용법: BoxHeadless [-frames N] [-softrender [out.png]]
+//   텍스처(Cooked/*.dds, skybox.dds)는 현재 디렉터리 기준이므로 D3DBoxApp/에서 실행한다.
+//   기본: Null 백엔드로 스크립트된 프레임을 돌리고 계수기를 stdout에 출력한다.
+//     초기화 실패, 검증 오류, 입력 재생 불일치가 있으면 1로 끝난다.
+//   -softrender: 같은 스크립트를 CPU 소프트웨어 래스터라이저로 돌려 래스터 벤치마크를 출력하고
+//     마지막 프레임을 PNG로 저장한다 (기본 softrender.png). 초기화/쓰기 실패나 디바이스 오류가 있으면 1.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "SceneScript.h"
+
+static int Usage()
+{
+    fprintf(stderr, "usage: BoxHeadless [-frames N] [-softrender [out.png]]\n");
+    return 2;
+}
+
+static void StdoutLog(const char* line) { fputs(line, stdout); }
+
+int main(int argc, char** argv)
+{
+    int frames = 120;
+    bool soft = false;
+    std::wstring outPath = L"softrender.png";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-frames") && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-softrender"))
+        {
+            soft = true;
+            // 다음 인자가 있으면 출력 경로 (경로는 ASCII 가정, ImageIO와 같음)
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                outPath.clear();
+                for (const char* p = argv[++i]; *p; ++p) outPath += wchar_t(static_cast<unsigned char>(*p));
+            }
+        }
+        else return Usage();
+    }
+    if (frames <= 0) return Usage();
+
+    if (soft) return RunSoftRender(outPath.c_str(), StdoutLog, frames) ? 0 : 1;
+    return RunHeadless(StdoutLog, frames) ? 0 : 1;
+}
@@ -2,12 +2,17 @@
 // Grid line rendering (POSITION + COLOR)
 #pragma pack_matrix(column_major)   // C++ Transpose() ø İ ȣȯ
 
-cbuffer CBVS : register(b0)
+//  󵵺   (BasicTex.hlsl   ġ)
+cbuffer CBPass : register(b1)      // н (ī޶ ٲ )
 {
-    float4x4 gWorld;
     float4x4 gViewProj;
 };
 
+cbuffer CBObject : register(b2)    // Ʈ ( ε )
+{
+    float4x4 gWorld;
+};
+
 struct VSInput
 {
     float3 pos : POSITION;
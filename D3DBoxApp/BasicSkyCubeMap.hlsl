@@ -5,12 +5,17 @@
 // - 2025-11, for D3D11 + SimpleMath matrices
 // =======================================================
 
-cbuffer CBVS : register(b0)
+//  󵵺   (BasicTex.hlsl   ġ)
+cbuffer CBPass : register(b1)      // ī н: ġ   * 
 {
-    matrix gWorld;
     matrix gViewProj;
 }
 
+cbuffer CBObject : register(b2)
+{
+    matrix gWorld;
+}
+
 struct VS_IN
 {
     float3 pos : POSITION;
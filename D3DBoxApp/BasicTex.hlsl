@@ -1,11 +1,9 @@
 
-cbuffer CBVS : register(b0)
-{
-    matrix gWorld;
-    matrix gViewProj;
-}
-
-cbuffer CBPS : register(b1)
+// 갱신 빈도별 상수 버퍼
+// b0 CBFrame : 프레임 공통 (라이트/카메라 위치), 카메라가 바뀔 때만 올린다
+// b1 CBPass  : 패스별 뷰프로젝션
+// b2 CBObject: 오브젝트별 월드 (프레임 업로드 링에서 구간 바인딩)
+cbuffer CBFrame : register(b0)
 {
     float3 gLightPos;
     float gLightRange;
@@ -15,6 +13,16 @@ cbuffer CBPS : register(b1)
     float gSpecPower;
 }
 
+cbuffer CBPass : register(b1)
+{
+    matrix gViewProj;
+}
+
+cbuffer CBObject : register(b2)
+{
+    matrix gWorld;
+}
+
 Texture2D gTex : register(t0);
 SamplerState gSamp : register(s0);
 
@@ -23,6 +31,11 @@ struct VS_IN
     float3 pos : POSITION;
     float2 uv : TEXCOORD;
     float3 nrm : NORMAL;
+
+    // 인스턴스별 월드 행렬 (전치된 상위 3행)
+    float4 w0 : INSTWORLD0;
+    float4 w1 : INSTWORLD1;
+    float4 w2 : INSTWORLD2;
 };
 
 struct PSInput
@@ -34,12 +47,32 @@ struct PSInput
 };
 
 PSInput VSMain(VS_IN i)
+{
+    PSInput o;
+    float4 p = float4(i.pos, 1);
+    float4 posW = float4(dot(i.w0, p), dot(i.w1, p), dot(i.w2, p), 1);
+    o.pos = mul(posW, gViewProj);
+    o.posW = posW.xyz;
+    o.nrmW = float3(dot(i.w0.xyz, i.nrm), dot(i.w1.xyz, i.nrm), dot(i.w2.xyz, i.nrm));
+    o.uv = i.uv;
+    return o;
+}
+
+// 청크 메쉬용: 정점이 이미 월드 좌표 (gWorld = 단위행렬)
+struct VS_MESH_IN
+{
+    float3 pos : POSITION;
+    float2 uv : TEXCOORD;
+    float3 nrm : NORMAL;
+};
+
+PSInput VSMesh(VS_MESH_IN i)
 {
     PSInput o;
     float4 posW = mul(float4(i.pos, 1), gWorld);
     o.pos = mul(posW, gViewProj);
     o.posW = posW.xyz;
-    o.nrmW = mul((float3x3) gWorld, i.nrm);
+    o.nrmW = mul(i.nrm, (float3x3) gWorld);
     o.uv = i.uv;
     return o;
 }
@@ -0,0 +1,884 @@
+﻿#pragma once
+
+// BC 블록 압축 (CPU 전용, Windows/D3D 의존성 없음)
+// - BC1: 끝점을 고르고 (Fast: 채널별 범위, Normal/High: 주성분 축의 양 끝), 인덱스를 고른 뒤 최소제곱으로 다듬는다.
+//        알파 < 128 픽셀이 있으면 3색 + 투명 모드. High는 불투명 블록에도 3색 모드를 시도한다.
+// - BC3: 알파 블록 (최소/최대, 8단계) + BC1 4색 블록.
+// - BC7: 모드 6 (subset 1개, RGBA 7비트 + p비트, 4비트 인덱스). Fast는 p비트 한 조합, Normal/High는 네 조합.
+//        High는 불투명 블록에 모드 1 (subset 2개, RGB 6비트 + 공유 p비트, 3비트 인덱스)도 시도한다.
+// - 가장 무거운 인덱스 선택 (픽셀마다 가장 가까운 팔레트 항목)은 AVX2/SSE로 16픽셀을 한 번에 처리한다.
+//   오차는 정수 제곱합이라 float로도 정확하고, 스칼라 경로와 결과가 비트 단위로 같다.
+// - CompressImage는 ThreadPool이 있으면 블록 행을 나눠 병렬로 압축한다.
+// 블록 입력은 4x4 RGBA8 (px[i] = 행 우선 픽셀 i), 복원 결과는 ImageIO.h의 디코더와 같다.
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLOCK_COMPRESS_AVX2 1
+#define BLOCK_COMPRESS_SSE 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BLOCK_COMPRESS_SSE 1
+#endif
+
+#include "ImageIO.h"
+#include "RenderDevice.h"
+#include "ThreadPool.h"
+
+enum class BlockFormat : uint8_t { BC1, BC3, BC7 };
+enum class BlockQuality : uint8_t { Fast, Normal, High };
+
+struct BlockCompressOptions
+{
+    BlockFormat  format = BlockFormat::BC7;
+    BlockQuality quality = BlockQuality::Normal;
+    bool         simd = true;   // false = 스칼라 인덱스 선택 (결과는 같다, 비교용)
+};
+
+inline size_t BlockBytes(BlockFormat format) { return format == BlockFormat::BC1 ? 8 : 16; }
+
+inline const wchar_t* BlockFormatName(BlockFormat format)
+{
+    switch (format)
+    {
+    case BlockFormat::BC1: return L"BC1";
+    case BlockFormat::BC3: return L"BC3";
+    case BlockFormat::BC7: return L"BC7";
+    }
+    return L"?";
+}
+
+inline const wchar_t* BlockQualityName(BlockQuality quality)
+{
+    switch (quality)
+    {
+    case BlockQuality::Fast:   return L"fast";
+    case BlockQuality::Normal: return L"normal";
+    case BlockQuality::High:   return L"high";
+    }
+    return L"?";
+}
+
+inline TextureFormat ToTextureFormat(BlockFormat format)
+{
+    switch (format)
+    {
+    case BlockFormat::BC1: return TextureFormat::BC1;
+    case BlockFormat::BC3: return TextureFormat::BC3;
+    case BlockFormat::BC7: return TextureFormat::BC7;
+    }
+    return TextureFormat::RGBA8;
+}
+
+// 블록 픽셀: 원본 RGBA8과 채널별 float (SIMD 적재용)
+struct BlockPixels
+{
+    alignas(32) float c[4][16];
+    uint8_t rgba[16][4];
+    bool    opaque = true;
+
+    void Load(const uint8_t px[16][4])
+    {
+        memcpy(rgba, px, sizeof(rgba));
+        opaque = true;
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int k = 0; k < 4; ++k) c[k][i] = px[i][k];
+            opaque = opaque && px[i][3] == 255;
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 인덱스 선택: 픽셀마다 가장 가까운 팔레트 항목 (앞쪽 채널 CH개의 제곱 오차, 같으면 앞 항목)
+// ------------------------------------------------------------
+template <int CH>
+inline void NearestPaletteScalar(const BlockPixels& px, const float (*pal)[4], int count, uint8_t idx[16], uint32_t err[16])
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        float best = FLT_MAX;
+        for (int j = 0; j < count; ++j)
+        {
+            float d = 0.0f;
+            for (int k = 0; k < CH; ++k) { float t = px.c[k][i] - pal[j][k]; d += t * t; }
+            if (d < best) { best = d; idx[i] = uint8_t(j); }
+        }
+        err[i] = uint32_t(best);
+    }
+}
+
+#if defined(BLOCK_COMPRESS_AVX2)
+template <int CH>
+inline void NearestPaletteSimd(const BlockPixels& px, const float (*pal)[4], int count, uint8_t idx[16], uint32_t err[16])
+{
+    alignas(32) int32_t bi[16], be[16];
+    for (int h = 0; h < 16; h += 8)
+    {
+        __m256 p[CH];
+        for (int k = 0; k < CH; ++k) p[k] = _mm256_load_ps(&px.c[k][h]);
+        __m256 best = _mm256_set1_ps(FLT_MAX), bestIdx = _mm256_setzero_ps();
+        for (int j = 0; j < count; ++j)
+        {
+            __m256 d = _mm256_setzero_ps();
+            for (int k = 0; k < CH; ++k)
+            {
+                __m256 t = _mm256_sub_ps(p[k], _mm256_set1_ps(pal[j][k]));
+                d = _mm256_add_ps(d, _mm256_mul_ps(t, t));
+            }
+            __m256 closer = _mm256_cmp_ps(d, best, _CMP_LT_OQ);
+            best = _mm256_blendv_ps(best, d, closer);
+            bestIdx = _mm256_blendv_ps(bestIdx, _mm256_set1_ps(float(j)), closer);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(bi + h), _mm256_cvtps_epi32(bestIdx));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(be + h), _mm256_cvtps_epi32(best));
+    }
+    for (int i = 0; i < 16; ++i) { idx[i] = uint8_t(bi[i]); err[i] = uint32_t(be[i]); }
+}
+#elif defined(BLOCK_COMPRESS_SSE)
+template <int CH>
+inline void NearestPaletteSimd(const BlockPixels& px, const float (*pal)[4], int count, uint8_t idx[16], uint32_t err[16])
+{
+    alignas(16) int32_t bi[16], be[16];
+    for (int h = 0; h < 16; h += 4)
+    {
+        __m128 p[CH];
+        for (int k = 0; k < CH; ++k) p[k] = _mm_load_ps(&px.c[k][h]);
+        __m128 best = _mm_set1_ps(FLT_MAX), bestIdx = _mm_setzero_ps();
+        for (int j = 0; j < count; ++j)
+        {
+            __m128 d = _mm_setzero_ps();
+            for (int k = 0; k < CH; ++k)
+            {
+                __m128 t = _mm_sub_ps(p[k], _mm_set1_ps(pal[j][k]));
+                d = _mm_add_ps(d, _mm_mul_ps(t, t));
+            }
+            __m128 closer = _mm_cmplt_ps(d, best);
+            best = _mm_or_ps(_mm_and_ps(closer, d), _mm_andnot_ps(closer, best));
+            bestIdx = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(float(j))), _mm_andnot_ps(closer, bestIdx));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(bi + h), _mm_cvtps_epi32(bestIdx));
+        _mm_store_si128(reinterpret_cast<__m128i*>(be + h), _mm_cvtps_epi32(best));
+    }
+    for (int i = 0; i < 16; ++i) { idx[i] = uint8_t(bi[i]); err[i] = uint32_t(be[i]); }
+}
+#endif
+
+template <int CH>
+inline void NearestPalette(const BlockPixels& px, const float (*pal)[4], int count, bool simd, uint8_t idx[16], uint32_t err[16])
+{
+#if defined(BLOCK_COMPRESS_SSE)
+    if (simd)
+    {
+        NearestPaletteSimd<CH>(px, pal, count, idx, err);
+        return;
+    }
+#endif
+    (void)simd;
+    NearestPaletteScalar<CH>(px, pal, count, idx, err);
+}
+
+// ------------------------------------------------------------
+// 공통: 주성분 축 (공분산 행렬에 거듭제곱법)
+// ------------------------------------------------------------
+template <int N>
+inline void PrincipalAxis(const float (*pts)[4], int count, float mean[N], float axis[N])
+{
+    for (int c = 0; c < N; ++c) mean[c] = 0.0f;
+    for (int i = 0; i < count; ++i)
+        for (int c = 0; c < N; ++c) mean[c] += pts[i][c];
+    for (int c = 0; c < N; ++c) mean[c] /= float(std::max(count, 1));
+
+    float cov[N][N] = {};
+    for (int i = 0; i < count; ++i)
+        for (int a = 0; a < N; ++a)
+            for (int b = 0; b < N; ++b)
+                cov[a][b] += (pts[i][a] - mean[a]) * (pts[i][b] - mean[b]);
+
+    // 시작 벡터: 분산이 가장 큰 채널 방향
+    int best = 0;
+    for (int c = 1; c < N; ++c) if (cov[c][c] > cov[best][best]) best = c;
+    for (int c = 0; c < N; ++c) axis[c] = (c == best) ? 1.0f : 0.0f;
+
+    for (int iter = 0; iter < 8; ++iter)
+    {
+        float next[N] = {};
+        for (int a = 0; a < N; ++a)
+            for (int b = 0; b < N; ++b) next[a] += cov[a][b] * axis[b];
+        float len = 0.0f;
+        for (int c = 0; c < N; ++c) len += next[c] * next[c];
+        if (len < 1e-12f) break;   // 단색 블록
+        len = 1.0f / sqrtf(len);
+        for (int c = 0; c < N; ++c) axis[c] = next[c] * len;
+    }
+}
+
+// 점들을 축에 투영한 양 끝 (inset: 범위의 몇 분의 1씩 안쪽으로)
+template <int N>
+inline void AxisEndpoints(const float (*pts)[4], int count, const float mean[N], const float axis[N], float inset,
+    float lo[N], float hi[N])
+{
+    float tmin = FLT_MAX, tmax = -FLT_MAX;
+    for (int i = 0; i < count; ++i)
+    {
+        float t = 0.0f;
+        for (int k = 0; k < N; ++k) t += (pts[i][k] - mean[k]) * axis[k];
+        tmin = std::min(tmin, t);
+        tmax = std::max(tmax, t);
+    }
+    float d = (tmax - tmin) * inset;
+    tmin += d; tmax -= d;
+    for (int k = 0; k < N; ++k)
+    {
+        lo[k] = std::clamp(mean[k] + axis[k] * tmin, 0.0f, 255.0f);
+        hi[k] = std::clamp(mean[k] + axis[k] * tmax, 0.0f, 255.0f);
+    }
+}
+
+// 인덱스 위치 t (0 = e0, 1 = e1, 음수 = 제외)로 끝점 두 개를 최소제곱으로 다시 구한다
+template <int N>
+inline bool LeastSquaresEndpoints(const uint8_t (*px)[4], const float t[16], float e0[N], float e1[N])
+{
+    float a = 0, b = 0, c = 0, x0[N] = {}, x1[N] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        if (t[i] < 0.0f) continue;
+        float s = 1.0f - t[i];
+        a += s * s; b += s * t[i]; c += t[i] * t[i];
+        for (int k = 0; k < N; ++k) { x0[k] += s * px[i][k]; x1[k] += t[i] * px[i][k]; }
+    }
+    float det = a * c - b * b;
+    if (fabsf(det) < 1e-6f) return false;
+    for (int k = 0; k < N; ++k)
+    {
+        e0[k] = std::clamp((c * x0[k] - b * x1[k]) / det, 0.0f, 255.0f);
+        e1[k] = std::clamp((a * x1[k] - b * x0[k]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// BC1 색 블록
+// ------------------------------------------------------------
+inline uint16_t Pack565(const float c[3])
+{
+    auto q = [](float v, int maxv) { return uint32_t(std::clamp(int(v * maxv / 255.0f + 0.5f), 0, maxv)); };
+    return uint16_t((q(c[0], 31) << 11) | (q(c[1], 63) << 5) | q(c[2], 31));
+}
+
+// 디코더(DecodeBC1Block)와 같은 반올림으로 팔레트를 만든다
+inline void Bc1Palette(uint16_t c0, uint16_t c1, bool fourColor, int pal[4][3])
+{
+    uint8_t a[4], b[4];
+    Unpack565(c0, a);
+    Unpack565(c1, b);
+    for (int k = 0; k < 3; ++k)
+    {
+        pal[0][k] = a[k];
+        pal[1][k] = b[k];
+        pal[2][k] = fourColor ? (2 * a[k] + b[k] + 1) / 3 : (a[k] + b[k]) / 2;
+        pal[3][k] = fourColor ? (a[k] + 2 * b[k] + 1) / 3 : 0;
+    }
+}
+
+struct Bc1Fit
+{
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t  idx[16] = {};
+    uint32_t err = UINT32_MAX;
+};
+
+// 인덱스를 고르고 오차 합을 돌려준다. 3색 모드에서 transparent[i]인 픽셀은 인덱스 3
+inline uint32_t Bc1AssignIndices(const BlockPixels& px, const bool transparent[16], uint16_t c0, uint16_t c1,
+    bool fourColor, bool simd, uint8_t idx[16])
+{
+    int pal[4][3];
+    Bc1Palette(c0, c1, fourColor, pal);
+    float palf[4][4] = {};
+    for (int j = 0; j < 4; ++j)
+        for (int k = 0; k < 3; ++k) palf[j][k] = float(pal[j][k]);
+
+    uint32_t err[16];
+    NearestPalette<3>(px, palf, fourColor ? 4 : 3, simd, idx, err);
+    uint32_t total = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (transparent[i]) idx[i] = 3;
+        else total += err[i];
+    }
+    return total;
+}
+
+inline Bc1Fit Bc1FitColors(const BlockPixels& px, const bool transparent[16], bool fourColor, BlockQuality quality, bool simd)
+{
+    float pts[16][4];
+    int count = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (transparent[i]) continue;
+        for (int k = 0; k < 3; ++k) pts[count][k] = px.rgba[i][k];
+        ++count;
+    }
+
+    Bc1Fit fit;
+    if (count == 0)
+    {
+        for (uint8_t& i : fit.idx) i = 3;   // 전부 투명: c0 == c1이면 3색 모드
+        fit.err = 0;
+        return fit;
+    }
+
+    float e0[3], e1[3];
+    if (quality == BlockQuality::Fast)
+    {
+        // 채널별 범위. 가장 넓은 채널과 반대로 움직이는 채널은 끝점을 뒤집는다
+        float lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 }, mean[3] = {};
+        for (int i = 0; i < count; ++i)
+            for (int k = 0; k < 3; ++k) { lo[k] = std::min(lo[k], pts[i][k]); hi[k] = std::max(hi[k], pts[i][k]); mean[k] += pts[i][k]; }
+        int major = 0;
+        for (int k = 1; k < 3; ++k) if (hi[k] - lo[k] > hi[major] - lo[major]) major = k;
+        for (int k = 0; k < 3; ++k)
+        {
+            mean[k] /= float(count);
+            float cov = 0.0f;
+            for (int i = 0; i < count; ++i) cov += (pts[i][k] - mean[k]) * (pts[i][major] - mean[major]);
+            float inset = (hi[k] - lo[k]) / 16.0f;
+            e0[k] = (cov < 0.0f) ? lo[k] + inset : hi[k] - inset;
+            e1[k] = (cov < 0.0f) ? hi[k] - inset : lo[k] + inset;
+        }
+    }
+    else
+    {
+        // 양 끝을 범위의 1/16씩 안쪽으로 (끝점 근처 픽셀보다 중간값이 많을 때 유리)
+        float mean[3], axis[3];
+        PrincipalAxis<3>(pts, count, mean, axis);
+        AxisEndpoints<3>(pts, count, mean, axis, 1.0f / 16.0f, e1, e0);
+    }
+
+    fit.c0 = Pack565(e0);
+    fit.c1 = Pack565(e1);
+    fit.err = Bc1AssignIndices(px, transparent, fit.c0, fit.c1, fourColor, simd, fit.idx);
+
+    static constexpr float T4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+    static constexpr float T3[4] = { 0.0f, 1.0f, 0.5f, -1.0f };
+    const int iterations = quality == BlockQuality::Fast ? 0 : quality == BlockQuality::Normal ? 2 : 4;
+    for (int iter = 0; iter < iterations && fit.err > 0; ++iter)
+    {
+        float t[16];
+        for (int i = 0; i < 16; ++i) t[i] = fourColor ? T4[fit.idx[i]] : T3[fit.idx[i]];
+        if (!LeastSquaresEndpoints<3>(px.rgba, t, e0, e1)) break;
+        Bc1Fit next;
+        next.c0 = Pack565(e0);
+        next.c1 = Pack565(e1);
+        next.err = Bc1AssignIndices(px, transparent, next.c0, next.c1, fourColor, simd, next.idx);
+        if (next.err >= fit.err) break;
+        fit = next;
+    }
+    return fit;
+}
+
+// forceFourColor: BC3의 색 블록 (항상 4색으로 디코드되므로 끝점 순서 제약이 없다)
+inline void EncodeBC1Color(const BlockPixels& px, uint8_t out[8], bool allowTransparent, bool forceFourColor,
+    BlockQuality quality, bool simd)
+{
+    bool transparent[16] = {};
+    bool anyTransparent = false;
+    for (int i = 0; i < 16; ++i)
+    {
+        transparent[i] = allowTransparent && px.rgba[i][3] < 128;
+        anyTransparent = anyTransparent || transparent[i];
+    }
+
+    bool fourColor = forceFourColor || !anyTransparent;
+    Bc1Fit fit = Bc1FitColors(px, transparent, fourColor, quality, simd);
+    if (quality == BlockQuality::High && fourColor && !forceFourColor && fit.err > 0)
+    {
+        // 불투명 블록이라도 끝점 사이 중간값 하나가 더 잘 맞을 때가 있다
+        Bc1Fit three = Bc1FitColors(px, transparent, false, quality, simd);
+        if (three.err < fit.err) { fit = three; fourColor = false; }
+    }
+
+    // 모드는 끝점 순서로 정해진다: 4색은 c0 > c1, 3색은 c0 <= c1
+    if (!forceFourColor)
+    {
+        if (fourColor && fit.c0 < fit.c1)
+        {
+            std::swap(fit.c0, fit.c1);
+            for (uint8_t& i : fit.idx) i ^= 1;   // 0<->1, 2<->3
+        }
+        else if (fourColor && fit.c0 == fit.c1)
+        {
+            for (uint8_t& i : fit.idx) i = 0;    // 4색을 쓸 수 없다 (단색이므로 인덱스 0이면 충분)
+        }
+        else if (!fourColor && fit.c0 > fit.c1)
+        {
+            std::swap(fit.c0, fit.c1);
+            for (uint8_t& i : fit.idx) if (i < 2) i ^= 1;
+        }
+    }
+
+    out[0] = uint8_t(fit.c0); out[1] = uint8_t(fit.c0 >> 8);
+    out[2] = uint8_t(fit.c1); out[3] = uint8_t(fit.c1 >> 8);
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= uint32_t(fit.idx[i]) << (i * 2);
+    memcpy(out + 4, &bits, 4);
+}
+
+inline void EncodeBC1Block(const BlockPixels& px, uint8_t out[8], BlockQuality quality = BlockQuality::Normal, bool simd = true)
+{
+    EncodeBC1Color(px, out, true, false, quality, simd);
+}
+
+// ------------------------------------------------------------
+// BC3 (알파 블록 + 4색 BC1 블록)
+// ------------------------------------------------------------
+inline void EncodeBC3Alpha(const BlockPixels& px, uint8_t out[8])
+{
+    uint8_t lo = 255, hi = 0;
+    for (int i = 0; i < 16; ++i) { lo = std::min(lo, px.rgba[i][3]); hi = std::max(hi, px.rgba[i][3]); }
+
+    out[0] = hi;
+    out[1] = lo;
+    uint64_t bits = 0;
+    if (hi > lo)   // 8단계 모드 (a0 > a1)
+    {
+        uint8_t a[8] = { hi, lo };
+        for (int i = 1; i < 7; ++i) a[i + 1] = uint8_t(((7 - i) * hi + i * lo + 3) / 7);
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestErr = 256;
+            for (int k = 0; k < 8; ++k)
+            {
+                int e = abs(int(px.rgba[i][3]) - a[k]);
+                if (e < bestErr) { bestErr = e; best = k; }
+            }
+            bits |= uint64_t(best) << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; ++i) out[2 + i] = uint8_t(bits >> (8 * i));
+}
+
+inline void EncodeBC3Block(const BlockPixels& px, uint8_t out[16], BlockQuality quality = BlockQuality::Normal, bool simd = true)
+{
+    EncodeBC3Alpha(px, out);
+    EncodeBC1Color(px, out + 8, false, true, quality, simd);
+}
+
+// ------------------------------------------------------------
+// BC7
+// ------------------------------------------------------------
+struct Bc7BitWriter
+{
+    uint8_t* out;
+    uint32_t pos = 0;
+
+    explicit Bc7BitWriter(uint8_t* dst) : out(dst) { memset(out, 0, 16); }
+
+    void Put(uint32_t v, uint32_t n)
+    {
+        for (uint32_t i = 0; i < n; ++i, ++pos) out[pos >> 3] |= uint8_t(((v >> i) & 1) << (pos & 7));
+    }
+};
+
+struct Bc7Mode6Candidate
+{
+    uint8_t  q[2][4] = {};   // 7비트 끝점
+    uint8_t  p[2] = {};      // p비트
+    uint8_t  idx[16] = {};
+    uint32_t err = UINT32_MAX;
+};
+
+// 끝점(0~255 실수)을 pbitMask에 켜진 p비트 조합 (비트 pb = p0 | p1 << 1)으로 양자화해 보고 가장 좋은 것을 best에 남긴다
+inline void Bc7Mode6TryEndpoints(const BlockPixels& px, const float e0[4], const float e1[4], uint32_t pbitMask, bool simd,
+    Bc7Mode6Candidate& best)
+{
+    for (int pb = 0; pb < 4; ++pb)
+    {
+        if (!(pbitMask & (1u << pb))) continue;
+        Bc7Mode6Candidate c;
+        c.p[0] = uint8_t(pb & 1);
+        c.p[1] = uint8_t(pb >> 1);
+        int ep[2][4];
+        for (int k = 0; k < 4; ++k)
+        {
+            c.q[0][k] = uint8_t(std::clamp(int((e0[k] - c.p[0]) * 0.5f + 0.5f), 0, 127));
+            c.q[1][k] = uint8_t(std::clamp(int((e1[k] - c.p[1]) * 0.5f + 0.5f), 0, 127));
+            ep[0][k] = (c.q[0][k] << 1) | c.p[0];
+            ep[1][k] = (c.q[1][k] << 1) | c.p[1];
+        }
+
+        float pal[16][4];
+        for (int j = 0; j < 16; ++j)
+            for (int k = 0; k < 4; ++k) pal[j][k] = Bc7Interpolate(ep[0][k], ep[1][k], BC7_WEIGHTS4[j]);
+
+        uint32_t err[16];
+        NearestPalette<4>(px, pal, 16, simd, c.idx, err);
+        c.err = 0;
+        for (uint32_t e : err) c.err += e;
+        if (c.err < best.err) best = c;
+    }
+}
+
+// 끝점 하나를 양자화했을 때 오차가 작은 p비트
+inline uint32_t Bc7BestPbit(const float e[4])
+{
+    float err[2] = {};
+    for (int p = 0; p < 2; ++p)
+        for (int k = 0; k < 4; ++k)
+        {
+            int q = std::clamp(int((e[k] - p) * 0.5f + 0.5f), 0, 127);
+            float d = e[k] - float((q << 1) | p);
+            err[p] += d * d;
+        }
+    return err[1] < err[0] ? 1 : 0;
+}
+
+inline Bc7Mode6Candidate Bc7FitMode6(const BlockPixels& px, BlockQuality quality, bool simd)
+{
+    float pts[16][4];
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 4; ++k) pts[i][k] = px.rgba[i][k];
+
+    float mean[4], axis[4], e0[4], e1[4];
+    PrincipalAxis<4>(pts, 16, mean, axis);
+    AxisEndpoints<4>(pts, 16, mean, axis, 0.0f, e0, e1);
+
+    Bc7Mode6Candidate best;
+    if (quality == BlockQuality::Fast)
+    {
+        Bc7Mode6TryEndpoints(px, e0, e1, 1u << (Bc7BestPbit(e0) | (Bc7BestPbit(e1) << 1)), simd, best);
+        return best;
+    }
+
+    Bc7Mode6TryEndpoints(px, e0, e1, 0xF, simd, best);
+
+    // 고른 인덱스로 끝점을 최소제곱으로 다듬어 다시 시도
+    const int iterations = quality == BlockQuality::Normal ? 2 : 4;
+    for (int iter = 0; iter < iterations && best.err > 0; ++iter)
+    {
+        float t[16];
+        for (int i = 0; i < 16; ++i) t[i] = BC7_WEIGHTS4[best.idx[i]] / 64.0f;
+        if (!LeastSquaresEndpoints<4>(px.rgba, t, e0, e1)) break;
+        uint32_t before = best.err;
+        Bc7Mode6TryEndpoints(px, e0, e1, 0xF, simd, best);
+        if (best.err >= before) break;
+    }
+    return best;
+}
+
+inline void Bc7PackMode6(Bc7Mode6Candidate best, uint8_t out[16])
+{
+    // 앵커(픽셀 0) 인덱스의 최상위 비트는 0이어야 한다: 끝점을 바꾸고 인덱스를 뒤집는다
+    if (best.idx[0] >= 8)
+    {
+        for (int k = 0; k < 4; ++k) std::swap(best.q[0][k], best.q[1][k]);
+        std::swap(best.p[0], best.p[1]);
+        for (uint8_t& i : best.idx) i = uint8_t(15 - i);
+    }
+
+    Bc7BitWriter w(out);
+    w.Put(1u << 6, 7);   // 모드 6
+    for (int k = 0; k < 4; ++k) { w.Put(best.q[0][k], 7); w.Put(best.q[1][k], 7); }
+    w.Put(best.p[0], 1);
+    w.Put(best.p[1], 1);
+    w.Put(best.idx[0], 3);
+    for (int i = 1; i < 16; ++i) w.Put(best.idx[i], 4);
+}
+
+// 모드 1: subset 2개 (분할 64가지), RGB 6비트 + subset별 공유 p비트 → 7비트, 3비트 인덱스, 알파 255
+struct Bc7Mode1Candidate
+{
+    uint8_t  partition = 0;
+    uint8_t  q[2][2][3] = {};   // [subset][끝점][채널] 6비트
+    uint8_t  p[2] = {};
+    uint8_t  idx[16] = {};
+    uint32_t err = UINT32_MAX;
+};
+
+inline uint8_t Bc7Expand7(uint32_t v) { return uint8_t((v << 1) | (v >> 6)); }
+
+// 분할 하나의 subset s를 맞춘다 (다른 subset 픽셀은 건드리지 않음). 오차를 돌려준다
+inline uint32_t Bc7FitMode1Subset(const BlockPixels& px, uint32_t partition, int s, bool simd, Bc7Mode1Candidate& c)
+{
+    float pts[16][4];
+    int count = 0;
+    bool member[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        member[i] = ((BC7_PARTITION2[partition] >> i) & 1) == uint32_t(s);
+        if (!member[i]) continue;
+        for (int k = 0; k < 3; ++k) pts[count][k] = px.rgba[i][k];
+        ++count;
+    }
+
+    float mean[3], axis[3], e0[3], e1[3];
+    PrincipalAxis<3>(pts, count, mean, axis);
+    AxisEndpoints<3>(pts, count, mean, axis, 0.0f, e0, e1);
+
+    uint32_t bestErr = UINT32_MAX;
+    for (int iter = 0; iter < 2; ++iter)
+    {
+        bool improved = false;
+        for (uint32_t p = 0; p < 2; ++p)
+        {
+            uint8_t q[2][3];
+            float pal[8][4] = {};
+            int ep[2][3];
+            for (int k = 0; k < 3; ++k)
+            {
+                q[0][k] = uint8_t(std::clamp(int((e0[k] * 127.0f / 255.0f - p) * 0.5f + 0.5f), 0, 63));
+                q[1][k] = uint8_t(std::clamp(int((e1[k] * 127.0f / 255.0f - p) * 0.5f + 0.5f), 0, 63));
+                ep[0][k] = Bc7Expand7((q[0][k] << 1) | p);
+                ep[1][k] = Bc7Expand7((q[1][k] << 1) | p);
+            }
+            for (int j = 0; j < 8; ++j)
+                for (int k = 0; k < 3; ++k) pal[j][k] = Bc7Interpolate(ep[0][k], ep[1][k], BC7_WEIGHTS3[j]);
+
+            uint8_t idx[16];
+            uint32_t err[16], total = 0;
+            NearestPalette<3>(px, pal, 8, simd, idx, err);
+            for (int i = 0; i < 16; ++i) if (member[i]) total += err[i];
+            if (total < bestErr)
+            {
+                bestErr = total;
+                improved = true;
+                memcpy(c.q[s], q, sizeof(q));
+                c.p[s] = uint8_t(p);
+                for (int i = 0; i < 16; ++i) if (member[i]) c.idx[i] = idx[i];
+            }
+        }
+        if (!improved || bestErr == 0) break;
+
+        float t[16];
+        for (int i = 0; i < 16; ++i) t[i] = member[i] ? BC7_WEIGHTS3[c.idx[i]] / 64.0f : -1.0f;
+        if (!LeastSquaresEndpoints<3>(px.rgba, t, e0, e1)) break;
+    }
+    return bestErr;
+}
+
+// 분할마다 subset별 주성분 축에서 벗어난 분산 (= 선 하나로 못 맞추는 정도)을 어림해 상위 tries개만 실제로 맞춘다.
+// 픽셀별 1차/2차 모멘트 (r g b rr rg rb gg gb bb)를 한 번 만들어 두고, subset 0의 합은 전체에서 subset 1을 빼서 얻는다.
+inline float Bc7SubsetResidual(const float m[10])
+{
+    const float inv = 1.0f / m[9];
+    const float mr = m[0] * inv, mg = m[1] * inv, mb = m[2] * inv;
+    const float cov[3][3] = {
+        { m[3] - m[0] * mr, m[4] - m[0] * mg, m[5] - m[0] * mb },
+        { m[4] - m[0] * mg, m[6] - m[1] * mg, m[7] - m[1] * mb },
+        { m[5] - m[0] * mb, m[7] - m[1] * mb, m[8] - m[2] * mb } };
+
+    // 가장 큰 고윳값: 거듭제곱법 (정규화는 마지막에 한 번, 중간에는 크기만 맞춘다)
+    float v[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iter = 0; iter < 4; ++iter)
+    {
+        float next[3];
+        for (int a = 0; a < 3; ++a) next[a] = cov[a][0] * v[0] + cov[a][1] * v[1] + cov[a][2] * v[2];
+        float scale = std::max({ fabsf(next[0]), fabsf(next[1]), fabsf(next[2]) });
+        if (scale < 1e-6f) return 0.0f;
+        scale = 1.0f / scale;
+        for (int a = 0; a < 3; ++a) v[a] = next[a] * scale;
+    }
+    float cv[3];
+    for (int a = 0; a < 3; ++a) cv[a] = cov[a][0] * v[0] + cov[a][1] * v[1] + cov[a][2] * v[2];
+    const float lambda = (cv[0] * v[0] + cv[1] * v[1] + cv[2] * v[2]) / (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    return std::max(0.0f, cov[0][0] + cov[1][1] + cov[2][2] - lambda);
+}
+
+inline Bc7Mode1Candidate Bc7FitMode1(const BlockPixels& px, int tries, bool simd)
+{
+    float moments[16][10], total[10] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        const float r = px.c[0][i], g = px.c[1][i], b = px.c[2][i];
+        const float m[10] = { r, g, b, r * r, r * g, r * b, g * g, g * b, b * b, 1.0f };
+        for (int k = 0; k < 10; ++k) { moments[i][k] = m[k]; total[k] += m[k]; }
+    }
+
+    struct Estimate { float residual; uint32_t partition; };
+    Estimate est[64];
+    for (uint32_t p = 0; p < 64; ++p)
+    {
+        float s0[10], s1[10] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            const float w = float((BC7_PARTITION2[p] >> i) & 1);
+            for (int k = 0; k < 10; ++k) s1[k] += w * moments[i][k];
+        }
+        for (int k = 0; k < 10; ++k) s0[k] = total[k] - s1[k];
+        est[p] = { Bc7SubsetResidual(s0) + Bc7SubsetResidual(s1), p };
+    }
+    tries = std::clamp(tries, 1, 64);
+    std::partial_sort(est, est + tries, est + 64, [](const Estimate& a, const Estimate& b) { return a.residual < b.residual; });
+
+    Bc7Mode1Candidate best;
+    for (int t = 0; t < tries; ++t)
+    {
+        Bc7Mode1Candidate c;
+        c.partition = uint8_t(est[t].partition);
+        c.err = Bc7FitMode1Subset(px, c.partition, 0, simd, c);
+        if (c.err >= best.err) continue;
+        c.err += Bc7FitMode1Subset(px, c.partition, 1, simd, c);
+        if (c.err < best.err) best = c;
+    }
+    return best;
+}
+
+inline void Bc7PackMode1(Bc7Mode1Candidate best, uint8_t out[16])
+{
+    // subset별 앵커 인덱스의 최상위 비트는 0이어야 한다 (p비트는 공유라 끝점만 바꾼다)
+    const int anchors[2] = { 0, BC7_ANCHOR2[best.partition] };
+    for (int s = 0; s < 2; ++s)
+    {
+        if (best.idx[anchors[s]] < 4) continue;
+        for (int k = 0; k < 3; ++k) std::swap(best.q[s][0][k], best.q[s][1][k]);
+        for (int i = 0; i < 16; ++i)
+            if (((BC7_PARTITION2[best.partition] >> i) & 1) == uint32_t(s)) best.idx[i] = uint8_t(7 - best.idx[i]);
+    }
+
+    Bc7BitWriter w(out);
+    w.Put(1u << 1, 2);   // 모드 1
+    w.Put(best.partition, 6);
+    for (int k = 0; k < 3; ++k)
+        for (int s = 0; s < 2; ++s) { w.Put(best.q[s][0][k], 6); w.Put(best.q[s][1][k], 6); }
+    w.Put(best.p[0], 1);
+    w.Put(best.p[1], 1);
+    for (int i = 0; i < 16; ++i) w.Put(best.idx[i], (i == anchors[0] || i == anchors[1]) ? 2 : 3);
+}
+
+inline void EncodeBC7Block(const BlockPixels& px, uint8_t out[16], BlockQuality quality = BlockQuality::Normal, bool simd = true)
+{
+    Bc7Mode6Candidate m6 = Bc7FitMode6(px, quality, simd);
+    if (quality == BlockQuality::High && px.opaque && m6.err > 0)
+    {
+        Bc7Mode1Candidate m1 = Bc7FitMode1(px, 4, simd);
+        if (m1.err < m6.err)
+        {
+            Bc7PackMode1(m1, out);
+            return;
+        }
+    }
+    Bc7PackMode6(m6, out);
+}
+
+// ------------------------------------------------------------
+// 이미지 전체
+// ------------------------------------------------------------
+inline void EncodeBlock(const BlockCompressOptions& options, const BlockPixels& px, uint8_t* out)
+{
+    switch (options.format)
+    {
+    case BlockFormat::BC1: EncodeBC1Block(px, out, options.quality, options.simd); break;
+    case BlockFormat::BC3: EncodeBC3Block(px, out, options.quality, options.simd); break;
+    case BlockFormat::BC7: EncodeBC7Block(px, out, options.quality, options.simd); break;
+    }
+}
+
+// 블록을 행 우선으로 out 뒤에 붙인다. 4의 배수가 아닌 가장자리는 경계 픽셀을 복제해 채운다.
+// pool이 있으면 블록 행 단위로 나눠 병렬 처리 (결과는 같다)
+inline void CompressImage(const Image& img, const BlockCompressOptions& options, std::vector<uint8_t>& out, ThreadPool* pool = nullptr)
+{
+    const uint32_t bw = (img.width + 3) / 4, bh = (img.height + 3) / 4;
+    const size_t blockBytes = BlockBytes(options.format);
+    const size_t base = out.size();
+    out.resize(base + size_t(bw) * bh * blockBytes);
+    uint8_t* dst = out.data() + base;
+
+    auto rows = [&](size_t begin, size_t end)
+    {
+        BlockPixels px;
+        uint8_t raw[16][4];
+        for (size_t by = begin; by < end; ++by)
+            for (uint32_t bx = 0; bx < bw; ++bx)
+            {
+                for (int i = 0; i < 16; ++i)
+                {
+                    uint32_t x = std::min(bx * 4 + (i & 3), img.width - 1);
+                    uint32_t y = std::min(uint32_t(by) * 4 + (i >> 2), img.height - 1);
+                    memcpy(raw[i], img.Pixel(x, y), 4);
+                }
+                px.Load(raw);
+                EncodeBlock(options, px, dst + (by * bw + bx) * blockBytes);
+            }
+    };
+
+    if (pool) pool->ParallelFor(bh, 4, rows);
+    else rows(0, bh);
+}
+
+// 런타임에 만든 밉 체인 (mips[0]이 가장 큼)을 압축해 텍스처로 올린다
+inline TextureHandle CreateCompressedTexture(IRenderDevice& device, const std::vector<Image>& mips,
+    const BlockCompressOptions& options, ThreadPool* pool = nullptr)
+{
+    if (mips.empty()) return {};
+    std::vector<std::vector<uint8_t>> blocks(mips.size());
+    std::vector<const void*> data(mips.size());
+    for (size_t m = 0; m < mips.size(); ++m)
+    {
+        CompressImage(mips[m], options, blocks[m], pool);
+        data[m] = blocks[m].data();
+    }
+
+    TextureDesc desc;
+    desc.width = mips[0].width;
+    desc.height = mips[0].height;
+    desc.mipLevels = uint32_t(mips.size());
+    desc.format = ToTextureFormat(options.format);
+    return device.CreateTexture(desc, data.data());
+}
+
+// ------------------------------------------------------------
+// 벤치마크
+// ------------------------------------------------------------
+struct BlockCompressBenchmark
+{
+    double megapixels = 0.0;
+    double scalarMs = 0.0;    // 스칼라 인덱스 선택, 단일 스레드
+    double simdMs = 0.0;      // SIMD, 단일 스레드
+    double threadedMs = 0.0;  // SIMD, 스레드 풀
+    double psnr = 0.0;        // 복원 대 원본 (RGBA)
+    bool   matches = false;   // 세 경로 결과가 비트 단위로 같은지
+};
+
+// img를 options.quality로 세 경로에서 압축해 가장 빠른 시간을 잰다
+inline BlockCompressBenchmark BenchmarkBlockCompress(const Image& img, BlockCompressOptions options, ThreadPool* pool, int iterations = 2)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    BlockCompressBenchmark r;
+    r.megapixels = double(img.width) * img.height / 1e6;
+    r.scalarMs = r.simdMs = r.threadedMs = 1e30;
+
+    std::vector<uint8_t> scalar, simd, threaded;
+    for (int it = 0; it < iterations; ++it)
+    {
+        scalar.clear(); simd.clear(); threaded.clear();
+        auto t0 = Clock::now();
+        options.simd = false;
+        CompressImage(img, options, scalar);
+        auto t1 = Clock::now();
+        options.simd = true;
+        CompressImage(img, options, simd);
+        auto t2 = Clock::now();
+        CompressImage(img, options, threaded, pool);
+        auto t3 = Clock::now();
+        r.scalarMs = std::min(r.scalarMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+        r.simdMs = std::min(r.simdMs, std::chrono::duration<double, std::milli>(t2 - t1).count());
+        r.threadedMs = std::min(r.threadedMs, std::chrono::duration<double, std::milli>(t3 - t2).count());
+    }
+    r.matches = (scalar == simd) && (simd == threaded);
+
+    Image decoded;
+    decoded.width = img.width;
+    decoded.height = img.height;
+    decoded.rgba.resize(img.rgba.size());
+    DecodeBlocks(options.format == BlockFormat::BC1 ? DdsFormat::BC1 : options.format == BlockFormat::BC3 ? DdsFormat::BC3 : DdsFormat::BC7,
+        simd.data(), decoded);
+    r.psnr = ComputePsnr(img, decoded);
+    return r;
+}
@@ -0,0 +1,134 @@
+﻿#pragma once
+
+// 장면용 최소 수학 (CPU 전용, Windows/D3D 의존성 없음)
+// - SimpleMath와 같은 규약: 행 벡터 (v * M), 행 우선 저장, 오른손 좌표계 (LookAt/Perspective는 ...RH와 같은 식)
+// - 상수 버퍼로 올릴 때는 SimpleMath처럼 Transpose()해서 올린다.
+
+#include <cmath>
+
+constexpr float BOX_PI = 3.14159265358979f;
+
+constexpr float ToRadians(float degrees) { return degrees * (BOX_PI / 180.0f); }
+
+struct Vec2
+{
+    float x = 0.0f, y = 0.0f;
+};
+
+struct Vec3
+{
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+
+    Vec3() = default;
+    constexpr Vec3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+
+    Vec3 operator+(const Vec3& o) const { return { x + o.x, y + o.y, z + o.z }; }
+    Vec3 operator-(const Vec3& o) const { return { x - o.x, y - o.y, z - o.z }; }
+    Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+    bool operator==(const Vec3& o) const { return x == o.x && y == o.y && z == o.z; }
+    bool operator!=(const Vec3& o) const { return !(*this == o); }
+
+    float Dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec3 Cross(const Vec3& o) const { return { y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x }; }
+    float LengthSquared() const { return Dot(*this); }
+    float Length() const { return sqrtf(LengthSquared()); }
+    void Normalize() { float l = Length(); if (l > 0.0f) { x /= l; y /= l; z /= l; } }
+
+    static float DistanceSquared(const Vec3& a, const Vec3& b) { return (a - b).LengthSquared(); }
+    static float Distance(const Vec3& a, const Vec3& b) { return (a - b).Length(); }
+};
+
+struct Mat4
+{
+    float m[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };   // 기본값 = 단위행렬
+
+    float* Data() { return &m[0][0]; }
+    const float* Data() const { return &m[0][0]; }
+
+    Mat4 operator*(const Mat4& o) const
+    {
+        Mat4 r;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+            {
+                float s = 0.0f;
+                for (int k = 0; k < 4; ++k) s += m[i][k] * o.m[k][j];
+                r.m[i][j] = s;
+            }
+        return r;
+    }
+
+    Mat4 Transpose() const
+    {
+        Mat4 r;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) r.m[i][j] = m[j][i];
+        return r;
+    }
+
+    // 여인수 전개로 구한 역행렬 (특이 행렬이면 단위행렬)
+    Mat4 Invert() const
+    {
+        const float* a = Data();
+        float inv[16];
+        inv[0]  =  a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+        inv[4]  = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+        inv[8]  =  a[4] * a[9]  * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+        inv[12] = -a[4] * a[9]  * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+        inv[1]  = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+        inv[5]  =  a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+        inv[9]  = -a[0] * a[9]  * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+        inv[13] =  a[0] * a[9]  * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+        inv[2]  =  a[1] * a[6]  * a[15] - a[1] * a[7]  * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7]  - a[13] * a[3] * a[6];
+        inv[6]  = -a[0] * a[6]  * a[15] + a[0] * a[7]  * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7]  + a[12] * a[3] * a[6];
+        inv[10] =  a[0] * a[5]  * a[15] - a[0] * a[7]  * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7]  - a[12] * a[3] * a[5];
+        inv[14] = -a[0] * a[5]  * a[14] + a[0] * a[6]  * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6]  + a[12] * a[2] * a[5];
+        inv[3]  = -a[1] * a[6]  * a[11] + a[1] * a[7]  * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9]  * a[2] * a[7]  + a[9]  * a[3] * a[6];
+        inv[7]  =  a[0] * a[6]  * a[11] - a[0] * a[7]  * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8]  * a[2] * a[7]  - a[8]  * a[3] * a[6];
+        inv[11] = -a[0] * a[5]  * a[11] + a[0] * a[7]  * a[9]  + a[4] * a[1] * a[11] - a[4] * a[3] * a[9]  - a[8]  * a[1] * a[7]  + a[8]  * a[3] * a[5];
+        inv[15] =  a[0] * a[5]  * a[10] - a[0] * a[6]  * a[9]  - a[4] * a[1] * a[10] + a[4] * a[2] * a[9]  + a[8]  * a[1] * a[6]  - a[8]  * a[2] * a[5];
+
+        Mat4 r;
+        float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+        if (det == 0.0f) return r;
+        float invDet = 1.0f / det;
+        for (int i = 0; i < 16; ++i) r.Data()[i] = inv[i] * invDet;
+        return r;
+    }
+
+    // SimpleMath Matrix::CreateLookAt (XMMatrixLookAtRH)
+    static Mat4 LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+    {
+        Vec3 z = eye - target; z.Normalize();
+        Vec3 x = up.Cross(z);  x.Normalize();
+        Vec3 y = z.Cross(x);
+        Mat4 r;
+        r.m[0][0] = x.x; r.m[0][1] = y.x; r.m[0][2] = z.x; r.m[0][3] = 0.0f;
+        r.m[1][0] = x.y; r.m[1][1] = y.y; r.m[1][2] = z.y; r.m[1][3] = 0.0f;
+        r.m[2][0] = x.z; r.m[2][1] = y.z; r.m[2][2] = z.z; r.m[2][3] = 0.0f;
+        r.m[3][0] = -x.Dot(eye); r.m[3][1] = -y.Dot(eye); r.m[3][2] = -z.Dot(eye); r.m[3][3] = 1.0f;
+        return r;
+    }
+
+    // SimpleMath Matrix::CreatePerspectiveFieldOfView (XMMatrixPerspectiveFovRH, 깊이 [0, 1])
+    static Mat4 PerspectiveFov(float fovY, float aspect, float zn, float zf)
+    {
+        float h = 1.0f / tanf(fovY * 0.5f), w = h / aspect, range = zf / (zn - zf);
+        Mat4 r;
+        r.m[0][0] = w;
+        r.m[1][1] = h;
+        r.m[2][2] = range; r.m[2][3] = -1.0f;
+        r.m[3][2] = range * zn; r.m[3][3] = 0.0f;
+        return r;
+    }
+
+    // 점 변환 후 w로 나눈다 (SimpleMath Vector3::Transform)
+    Vec3 TransformPoint(const Vec3& v) const
+    {
+        float x = v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + m[3][0];
+        float y = v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + m[3][1];
+        float z = v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + m[3][2];
+        float w = v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + m[3][3];
+        return { x / w, y / w, z / w };
+    }
+};
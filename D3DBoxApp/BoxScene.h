@@ -0,0 +1,1345 @@
+﻿#pragma once
+
+// 박스 배치 장면 (CPU 전용, Windows/D3D 의존성 없음)
+// - 카메라, 배치/레이캐스트, 인스턴싱/청크 메쉬, 컬링, 드로우 제출까지 IRenderDevice 위에서 처리한다.
+// - 창, 메시지 루프, D3D11 디바이스 생성은 D3DBoxApp.cpp가, 헤드리스 실행은 SceneScript.h가 맡는다.
+// - 로그는 Log()로 한 줄씩 m_LogSink에 넘긴다 (Windows 앱은 OutputDebugStringA).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BoxMath.h"
+#include "RenderDevice.h"
+#include "StateFilter.h"
+#include "RenderQueue.h"
+#include "ConstantBufferRing.h"
+#include "FrameGraph.h"
+#include "FrameInput.h"
+#include "FramePacer.h"
+#include "InstancePack.h"
+#include "PlacedBoxStore.h"
+#include "FrustumCull.h"
+#include "OcclusionCuller.h"
+#include "ThreadPool.h"
+#include "ChunkLod.h"
+#include "ChunkMesher.h"
+#include "ChunkRemesher.h"
+#include "InfiniteGrid.h"
+#include "TextureStreamer.h"
+
+#if defined(__GNUC__)
+#define BOX_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define BOX_PRINTF_FORMAT(fmt, args)
+#endif
+
+struct VertexPC
+{
+    Vec3 pos;
+    Vec3 col;
+};
+
+struct VertexPT
+{
+    Vec3 pos;
+    Vec2 uv;
+};
+
+struct VertexPTN
+{
+    Vec3 pos;
+    Vec2 uv;
+    Vec3 normal;
+};
+
+
+static_assert(sizeof(GridVertex) == sizeof(VertexPC), "InfiniteGrid 정점은 VertexPC와 같은 배치여야 함");
+static_assert(sizeof(MeshVertex) == sizeof(VertexPTN), "ChunkMesher 정점은 VertexPTN과 같은 배치여야 함");
+
+
+struct VertexP  // Skybox용
+{
+    Vec3 pos;
+};
+
+// 상수 버퍼는 갱신 빈도별로 나눈다 (HLSL의 b0/b1/b2와 같은 배치)
+// 프레임 공통 (b0, PS): 카메라가 바뀔 때만 올린다
+struct CBFrame
+{
+    Vec3 lightPos; float lightRange;
+    Vec3 lightColor; float pad;
+    Vec3 eyePos; float specPower;
+};
+
+// 패스별 (b1, VS): 장면 / 스카이
+struct CBPass
+{
+    Mat4 gViewProj;
+};
+
+// 오브젝트별 (b2, VS): 프레임 업로드 링에서 구간 바인딩
+struct CBObject
+{
+    Mat4 gWorld;
+};
+
+// 궤도 카메라: 입력(yaw/pitch/거리, 시야각/종횡비/near/far)이 바뀌면 dirty 비트만 세우고,
+// 파생 값(눈 위치, 뷰/투영, 뷰프로젝션과 역행렬, 스카이용 뷰프로젝션, 절두체)은 처음 읽을 때 한 번만 다시 계산한다.
+// Version()은 다시 계산할 때마다 증가하므로, 소비자는 마지막으로 본 버전과 비교해 자기 작업을 건너뛴다.
+struct OrbitCamera
+{
+    enum DirtyBits : uint8_t
+    {
+        DIRTY_VIEW = 1 << 0,   // yaw/pitch/거리
+        DIRTY_PROJ = 1 << 1,   // 시야각/종횡비/near/far
+    };
+
+    static constexpr float RADIUS_MIN = 2.0f;
+    static constexpr float RADIUS_MAX = 200.0f;
+
+    // 입력
+    float    m_Yaw = 0.0f;
+    float    m_Pitch = 0.0f;
+    float    m_Radius = RADIUS_MIN;
+    float    m_FovY = ToRadians(60.0f);
+    float    m_Aspect = 1.0f;
+    float    m_Near = 0.1f;
+    float    m_Far = 1000.0f;
+
+    // 파생 (Resolve가 채운다)
+    uint8_t  m_Dirty = DIRTY_VIEW | DIRTY_PROJ;
+    uint64_t m_Version = 0;
+    Vec3  m_Eye;
+    Mat4   m_View;
+    Mat4   m_Proj;
+    Mat4   m_ViewProj;
+    Mat4   m_InvViewProj;
+    Mat4   m_SkyViewProj;   // 카메라 위치를 뺀 뷰 * 투영
+    Frustum  m_Frustum;
+
+    void SetOrbit(float yaw, float pitch, float radius)
+    {
+        pitch = std::clamp(pitch, ToRadians(-89.0f), ToRadians(89.0f));
+        radius = std::clamp(radius, RADIUS_MIN, RADIUS_MAX);
+        if (yaw == m_Yaw && pitch == m_Pitch && radius == m_Radius) return;
+        m_Yaw = yaw;
+        m_Pitch = pitch;
+        m_Radius = radius;
+        m_Dirty |= DIRTY_VIEW;
+    }
+
+    void Orbit(float dYaw, float dPitch) { SetOrbit(m_Yaw + dYaw, m_Pitch + dPitch, m_Radius); }
+    void Zoom(float scale) { SetOrbit(m_Yaw, m_Pitch, m_Radius * scale); }
+
+    void SetProjection(float fovY, float aspect, float zn, float zf)
+    {
+        if (fovY == m_FovY && aspect == m_Aspect && zn == m_Near && zf == m_Far) return;
+        m_FovY = fovY;
+        m_Aspect = aspect;
+        m_Near = zn;
+        m_Far = zf;
+        m_Dirty |= DIRTY_PROJ;
+    }
+
+    void SetAspect(float aspect) { SetProjection(m_FovY, aspect, m_Near, m_Far); }
+
+    void Resolve()
+    {
+        if (!m_Dirty) return;
+        if (m_Dirty & DIRTY_VIEW)
+        {
+            float x = m_Radius * cosf(m_Pitch) * cosf(m_Yaw);
+            float z = m_Radius * cosf(m_Pitch) * sinf(m_Yaw);
+            float y = m_Radius * sinf(m_Pitch);
+            m_Eye = Vec3(x, y, z);
+            m_View = Mat4::LookAt(m_Eye, Vec3(0, 0, 0), Vec3(0, 1, 0));
+        }
+        if (m_Dirty & DIRTY_PROJ)
+            m_Proj = Mat4::PerspectiveFov(m_FovY, m_Aspect, m_Near, m_Far);
+
+        m_ViewProj = m_View * m_Proj;
+        m_InvViewProj = m_ViewProj.Invert();
+
+        // 스카이: 카메라 회전만 (위치 제외)
+        Mat4 viewNoTrans = m_View;
+        viewNoTrans.m[3][0] = 0.0f;
+        viewNoTrans.m[3][1] = 0.0f;
+        viewNoTrans.m[3][2] = 0.0f;
+        m_SkyViewProj = viewNoTrans * m_Proj;
+
+        m_Frustum.FromViewProj(m_ViewProj.Data());
+        m_Dirty = 0;
+        ++m_Version;
+    }
+
+    uint64_t Version() { Resolve(); return m_Version; }
+    float Radius() const { return m_Radius; }
+    const Vec3& Eye() { Resolve(); return m_Eye; }
+    const Mat4& View() { Resolve(); return m_View; }
+    const Mat4& Proj() { Resolve(); return m_Proj; }
+    const Mat4& ViewProj() { Resolve(); return m_ViewProj; }
+    const Mat4& InvViewProj() { Resolve(); return m_InvViewProj; }
+    const Mat4& SkyViewProj() { Resolve(); return m_SkyViewProj; }
+    const Frustum& GetFrustum() { Resolve(); return m_Frustum; }
+};
+
+
+// 장면 로그 한 줄 (끝에 \n 포함)
+using SceneLogFn = std::function<void(const char*)>;
+
+struct BoxScene
+{
+    // 렌더 백엔드 (D3D11, 헤드리스 Null, CPU Soft), 리소스는 모두 핸들로 다룬다
+    std::unique_ptr<IRenderDevice>   m_Device;
+    std::unique_ptr<StateFilterContext> m_StateFilter;   // 중복 Set* 제거, m_Context는 이것을 가리킨다
+    IRenderContext*                  m_Context = nullptr;
+    RenderQueue                      m_Queue;   // 프레임마다 제출 → 정렬 → 실행
+    bool                             m_ParallelRecord = true;   // 워커 스레드에서 지연 컨텍스트로 기록 (P 키)
+    FrameGraph                       m_FrameGraph;   // 프레임마다 패스 선언 → 컴파일 → 실행
+
+    static constexpr float CAMERA_NEAR = 0.1f;
+    static constexpr float CAMERA_FAR = 1000.0f;
+
+    // Shaders / Pipeline
+    ShaderHandle                     m_VSColor;
+    ShaderHandle                     m_PSColor;
+    ShaderHandle                     m_VSTex;
+    ShaderHandle                     m_PSTex;
+    InputLayoutHandle                m_InputLayoutColor;
+    InputLayoutHandle                m_InputLayoutTex;
+    ShaderHandle                     m_VSTexMesh;        // 청크 메쉬용 (인스턴싱 없음)
+    InputLayoutHandle                m_InputLayoutMesh;
+
+    ConstantBufferRing               m_VSRing; // Vertex Shader용 오브젝트별 상수 (프레임마다 선형 할당, 구간 바인딩)
+    static constexpr uint32_t        VS_RING_BYTES = 4u << 20;   // 256바이트 블록 16K개 (프레임 3개 이상이 동시에 들어간다)
+    BufferHandle                     m_CBFrame;       // b0: 라이트/카메라 위치
+    BufferHandle                     m_CBPassScene;   // b1: 장면 패스 뷰프로젝션
+    BufferHandle                     m_CBPassSky;     // b1: 스카이 패스 (카메라 위치를 뺀 뷰) 뷰프로젝션
+    uint64_t                         m_CameraConstantsVersion = 0;    // 프레임/패스 상수를 만든 카메라 버전
+    uint64_t                         m_CameraConstantUploads = 0;     // 카메라 상수를 실제로 올린 프레임 수
+
+    // Skybox
+    ShaderHandle                     m_VSSky;
+    ShaderHandle                     m_PSSky;
+    InputLayoutHandle                m_InputLayoutSky;
+    BufferHandle                     m_SkyVB;
+    BufferHandle                     m_SkyIB;
+    TextureHandle                    m_SkySRV;
+    SamplerHandle                    m_SkySampler;
+    DepthStateHandle                 m_SkyDSS;
+    RasterStateHandle                m_SkyRS;
+
+    
+    uint32_t                         m_SkyIndexCount = 0;
+
+    // Texture (Box 전용)
+    TextureHandle                    m_TexSRV;
+    SamplerHandle                    m_Sampler;
+    TextureHandle                    m_TexSRVGrass;
+    SamplerHandle                    m_SamplerGrass;
+
+    // 텍스처 스트리밍: 파일은 워커에서 읽고 파싱, 업로드는 BeginFrame에서. 그 전까지는 1x1 자리표시를 바인딩
+    static constexpr uint8_t         PLACEHOLDER_RGBA[4] = { 128, 128, 128, 255 };
+    TextureHandle                    m_PlaceholderTex;
+    TextureHandle                    m_PlaceholderCube;
+    TextureStreamer::Clock::time_point m_InitTime;   // 첫 프레임까지 걸린 시간 보고용
+
+    // Geometry
+    BufferHandle                     m_GridVB;           // 동적, 용량 = m_GridSettings.MaxVertices()
+    uint32_t                         m_GridVertexCount = 0;
+    InfiniteGridSettings             m_GridSettings;
+    InfiniteGridInfo                 m_GridInfo;
+    std::vector<GridVertex>          m_GridVertices;
+    Vec3                          m_GridEye = Vec3(NAN, NAN, NAN);   // 마지막으로 그리드를 만든 카메라 위치
+
+    BufferHandle                     m_BoxVB;
+    BufferHandle                     m_BoxIB;
+    BufferHandle                     m_GrassVB;
+    BufferHandle                     m_GrassIB;
+    uint32_t                         m_BoxIndexCount = 0;
+
+    // 배치된 박스 (인스턴싱)
+    PlacedBoxStore                   m_PlacedBoxes;
+    std::vector<InstanceData>        m_InstanceScratch;
+    BufferHandle                     m_InstanceVB;
+    uint32_t                         m_InstanceCapacity = 0;
+    uint32_t                         m_InstanceCount = 0;
+    uint64_t                         m_InstanceVersion = ~0ull; // 마지막으로 업로드한 m_PlacedBoxes 버전
+
+    // 절두체 컬링
+    ChunkCuller                      m_Culler;
+    std::vector<ChunkInstanceRange>  m_ChunkRanges;
+    std::vector<uint32_t>            m_VisibleInstances;
+    std::vector<InstanceData>        m_InstanceGather;   // 보이는 인스턴스만 모은 업로드용 배열
+    uint64_t                         m_CullCameraVersion = 0;   // 마지막으로 컬링한 카메라 버전
+    uint64_t                         m_CullFilterKey = 0;       // 마지막으로 컬링한 InstanceFilterKey()
+
+    // 오클루전 컬링 (카메라에 가까운 박스를 가리개로 사용)
+    ThreadPool                       m_Pool;
+    OcclusionCuller                  m_Occlusion;
+    std::vector<uint32_t>            m_Occluders;
+    bool                             m_UseOcclusion = true;
+    size_t                           m_OccluderBudget = 256;
+
+    // 박스 material (1 = BoxTexture, 2 = Grass)
+    std::vector<uint8_t>             m_InstanceMaterials;  // m_InstanceScratch와 같은 순서
+    std::vector<MeshSubset>          m_InstanceSubsets;    // material별 인스턴스 구간 (indexStart = 첫 인스턴스)
+    uint8_t                          m_CurrentMaterial = 1;
+
+    // 청크 메쉬 (그리디 메셔)
+    struct ChunkGpuMesh
+    {
+        ChunkCoord              coord;
+        BufferHandle            vb;
+        BufferHandle            ib;
+        std::vector<MeshSubset> subsets;
+        float                   boundsMin[3] = {};
+        float                   boundsMax[3] = {};
+        MeshStats               stats;
+    };
+    enum class BoxRenderMode { Instanced, ChunkMesh };
+
+    BoxRenderMode                    m_RenderMode = BoxRenderMode::Instanced;
+    std::unordered_map<uint64_t, ChunkGpuMesh> m_ChunkMeshes;
+    uint64_t                         m_ChunkMeshSetVersion = 0;   // m_ChunkMeshes에 청크가 생기거나 빠질 때마다 증가
+    bool                             m_ChunkMeshesBuilt = false;
+    std::vector<ChunkCoord>          m_DirtyChunks;
+
+    // 거리 기반 청크 LOD (요청한 레벨, 청크 키 → level)
+    std::unordered_map<uint64_t, uint8_t> m_ChunkLod;
+    ChunkLodSettings                 m_LodSettings;
+    uint64_t                         m_LodCameraVersion = ~0ull;   // 마지막으로 레벨을 훑은 카메라 버전
+
+    // 온디맨드 렌더링: 무효화가 없고 카메라/배치 버전이 마지막으로 그린 때와 같으면 그리지 않는다 ('R'로 전환)
+    bool                             m_OnDemand = true;
+    bool                             m_Invalidated = true;   // 크기 변경, 노출(WM_PAINT), 메쉬/텍스처 교체, 렌더 모드 변경
+    uint64_t                         m_DrawnCameraVersion = 0;
+    uint64_t                         m_DrawnSceneVersion = 0;
+    uint64_t                         m_FramesRendered = 0;
+    uint64_t                         m_FramesSkipped = 0;
+    std::function<void()>            m_OnWake;               // 리메싱/텍스처 완료 → 잠든 메인 루프 깨우기 (워커 스레드에서 불린다)
+
+    // 백그라운드 리메싱 (결과는 BeginFrame에서 교체)
+    ThreadPool                       m_MeshPool;
+    ChunkRemesher                    m_Remesher{ m_MeshPool, 1.0f };
+
+    // 백그라운드 텍스처 로드 (파일 읽기 위주라 워커 2개)
+    ThreadPool                       m_LoadPool{ 2 };
+    TextureStreamer                  m_TextureStreamer{ m_LoadPool };
+
+    // Camera (입력이 바뀌면 파생 행렬/절두체를 한 번만 다시 계산)
+    OrbitCamera                      m_Camera;
+
+    // 입력: 창 메시지 (또는 재생 스크립트)가 m_Input에 쌓고 ApplyInput이 프레임마다 한 번 적용
+    static constexpr float ORBIT_RADIANS_PER_PIXEL = 0.005f;
+    FrameInput                       m_Input;
+    FrameInputState                  m_FrameInput;   // 이번 프레임에 꺼낸 입력 (용량 재사용)
+
+    // 프레임 페이싱 ('V'로 모드 전환)
+    FramePacer                       m_Pacer;
+
+    // 뷰포트 / Grid
+    uint32_t                         m_Width = 1280;
+    uint32_t                         m_Height = 720;
+    float                            m_CellSize = 1.0f;
+
+    SceneLogFn                       m_LogSink;   // 비어 있으면 stdout
+
+    explicit BoxScene(IFrameClock& clock) : m_Pacer(clock) {}
+
+    void Log(const char* format, ...) BOX_PRINTF_FORMAT(2, 3)
+    {
+        char line[512];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        if (m_LogSink) m_LogSink(line);
+        else           fputs(line, stdout);
+    }
+
+    void Wake() { if (m_OnWake) m_OnWake(); }
+
+    // 주어진 백엔드로 씬 리소스를 만든다 (창은 호출한 쪽이 만든다, 헤드리스는 NullRenderDevice)
+    bool InitScene(std::unique_ptr<IRenderDevice> device)
+    {
+        m_InitTime = TextureStreamer::Clock::now();
+        m_Device = std::move(device);
+        m_StateFilter = std::make_unique<StateFilterContext>(m_Device->Context());
+        m_Context = m_StateFilter.get();
+        m_TextureStreamer.m_OnResult = [this] { Wake(); };
+
+        // --------------------------------------------------------
+        // 4. 셰이더 및 리소스 초기화
+        // --------------------------------------------------------
+        if (!CreateShaders()) return false;
+        if (!CreateSkyShader()) return false;
+
+        CreateConstantBuffer();
+        CreateGridVB();
+        CreateBoxMesh();
+        CreateGrassBoxMesh();
+        CreateSkyMesh();
+        CreatePlaceholderTextures();
+        LoadBoxTexture();
+        LoadGrassBoxTexture();
+        LoadSkyTexture();
+        CreateSkyRenderStates();
+
+        // --------------------------------------------------------
+        // 5. 카메라 기본 설정
+        // --------------------------------------------------------
+        m_Camera.SetProjection(ToRadians(60.0f),
+            float(m_Width) / float(m_Height),
+            CAMERA_NEAR, CAMERA_FAR);
+
+        m_Remesher.m_CellSize = m_CellSize;
+        m_Remesher.m_OnResult = [this] { Wake(); };
+        m_LodSettings.baseDistance = 64.0f * m_CellSize;
+
+        Log("[D3D] Init complete.\n");
+        return true;
+    }
+
+    bool CreateShaders()
+    {
+        // ---- Grid: Color shader ----
+        m_VSColor = m_Device->CreateShader({ ShaderStage::Vertex, L"BasicColor.hlsl", "VSMain" });
+        m_PSColor = m_Device->CreateShader({ ShaderStage::Pixel, L"BasicColor.hlsl", "PSMain" });
+        if (!m_VSColor || !m_PSColor) return false;
+
+        VertexElement ilColor[] =
+        {
+            { "POSITION", 0, VertexFormat::Float3, 0, offsetof(VertexPC, pos), false },
+            { "COLOR",    0, VertexFormat::Float3, 0, offsetof(VertexPC, col), false },
+        };
+        m_InputLayoutColor = m_Device->CreateInputLayout(ilColor, std::size(ilColor), m_VSColor);
+
+        // ---- Box: Texture shader ----
+        m_VSTex = m_Device->CreateShader({ ShaderStage::Vertex, L"BasicTex.hlsl", "VSMain" });
+        m_PSTex = m_Device->CreateShader({ ShaderStage::Pixel, L"BasicTex.hlsl", "PSMain" });
+        if (!m_VSTex || !m_PSTex) return false;
+
+        VertexElement ilTexN[] =
+        {
+            { "POSITION", 0, VertexFormat::Float3, 0, offsetof(VertexPTN,pos),    false },
+            { "TEXCOORD", 0, VertexFormat::Float2, 0, offsetof(VertexPTN,uv),     false },
+            { "NORMAL",   0, VertexFormat::Float3, 0, offsetof(VertexPTN,normal), false },
+
+            // 인스턴스별 월드 행렬 (slot 1)
+            { "INSTWORLD", 0, VertexFormat::Float4, 1, offsetof(InstanceData,row0), true },
+            { "INSTWORLD", 1, VertexFormat::Float4, 1, offsetof(InstanceData,row1), true },
+            { "INSTWORLD", 2, VertexFormat::Float4, 1, offsetof(InstanceData,row2), true },
+        };
+        m_InputLayoutTex = m_Device->CreateInputLayout(ilTexN, std::size(ilTexN), m_VSTex);
+
+        // ---- Chunk mesh: 같은 PS, 인스턴싱 없는 VS ----
+        m_VSTexMesh = m_Device->CreateShader({ ShaderStage::Vertex, L"BasicTex.hlsl", "VSMesh" });
+        if (!m_VSTexMesh) return false;
+        m_InputLayoutMesh = m_Device->CreateInputLayout(ilTexN, 3, m_VSTexMesh);
+
+        return true;
+    }
+
+    bool CreateSkyShader()
+    {
+        m_VSSky = m_Device->CreateShader({ ShaderStage::Vertex, L"BasicSkyCubeMap.hlsl", "VSMain" });
+        m_PSSky = m_Device->CreateShader({ ShaderStage::Pixel, L"BasicSkyCubeMap.hlsl", "PSMain" });
+        if (!m_VSSky || !m_PSSky) return false;
+
+        // Input Layout (POSITION only)
+        VertexElement ilSky[] =
+        {
+            { "POSITION", 0, VertexFormat::Float3, 0, 0, false },
+        };
+
+        m_InputLayoutSky = m_Device->CreateInputLayout(ilSky, std::size(ilSky), m_VSSky);
+
+        if (!m_InputLayoutSky) Log("[Skybox] InputLayout creation FAILED\n");
+        else Log("[Skybox] InputLayout creation OK\n");
+
+        return true;
+    }
+
+
+    void CreateSkyMesh()
+    {
+        float s = 50.0f;
+        VertexP v[8] =
+        {
+            {{-s, -s, -s}}, {{+s, -s, -s}}, {{+s, +s, -s}}, {{-s, +s, -s}},
+            {{-s, -s, +s}}, {{+s, -s, +s}}, {{+s, +s, +s}}, {{-s, +s, +s}},
+        };
+
+        m_SkyVB = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable, sizeof(v) }, v);
+
+        uint16_t idx[] =
+        {
+            0,3,2, 0,2,1,
+            1,2,6, 1,6,5,
+            5,6,7, 5,7,4,
+            4,7,3, 4,3,0,
+            3,7,6, 3,6,2,
+            4,0,1, 4,1,5
+        };
+        m_SkyIndexCount = std::size(idx);
+
+        m_SkyIB = m_Device->CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, sizeof(idx) }, idx);
+    }
+
+    void LoadSkyTexture()
+    {
+        // DDS CubeMap 로드 (준비될 때까지 자리표시 큐브)
+        StreamTexture(L"skybox.dds", m_SkySRV, m_PlaceholderCube);
+
+        // Cube 샘플러: CLAMP 대신 WRAP을 써도 무방
+        m_SkySampler = m_Device->CreateSampler({ TextureAddress::Clamp });
+    }
+
+
+    void CreateSkyRenderStates()
+    {
+        DepthStateDesc dsd;
+        dsd.depthWrite = false;
+        dsd.func = CompareFunc::LessEqual;
+        m_SkyDSS = m_Device->CreateDepthState(dsd);
+
+
+        RasterStateDesc rd;
+        rd.cull = CullMode::Front;
+        rd.frontCounterClockwise = true;
+        rd.depthClip = false;
+        m_SkyRS = m_Device->CreateRasterState(rd);
+    }
+
+
+    void CreateConstantBuffer()
+    {
+        // Vertex Shader용 상수 링
+        if (!m_VSRing.Init(*m_Device, VS_RING_BYTES))
+            Log("[D3D] Constant ring creation FAILED\n");
+
+        // 프레임/패스 상수 버퍼 (카메라가 바뀔 때만 갱신)
+        m_CBFrame = m_Device->CreateBuffer({ BufferBind::Constant, BufferUsage::Dynamic, sizeof(CBFrame) }, nullptr);
+        m_CBPassScene = m_Device->CreateBuffer({ BufferBind::Constant, BufferUsage::Dynamic, sizeof(CBPass) }, nullptr);
+        m_CBPassSky = m_Device->CreateBuffer({ BufferBind::Constant, BufferUsage::Dynamic, sizeof(CBPass) }, nullptr);
+
+    }
+
+    // 카메라 주변 그리드 선을 담을 고정 크기 동적 버퍼 (내용은 UpdateGrid에서 채움)
+    void CreateGridVB()
+    {
+        m_GridSettings.cellSize = m_CellSize;
+
+        m_GridVB = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Dynamic,
+            uint32_t(m_GridSettings.MaxVertices() * sizeof(VertexPC)) }, nullptr);
+    }
+
+    // 카메라가 움직였을 때만 보이는 선을 다시 만들어 올린다.
+    void UpdateGrid()
+    {
+        const Vec3& camPos = m_Camera.Eye();
+        if (!m_GridVB || m_GridEye == camPos) return;
+        m_GridEye = camPos;
+
+        float eye[3] = { camPos.x, camPos.y, camPos.z };
+        m_GridInfo = BuildInfiniteGrid(eye, m_Camera.Radius(), m_GridSettings, m_GridVertices);
+
+        if (!m_Context->UpdateBuffer(m_GridVB, m_GridVertices.data(), uint32_t(m_GridVertices.size() * sizeof(GridVertex))))
+        {
+            m_GridVertexCount = 0;
+            return;
+        }
+        m_GridVertexCount = uint32_t(m_GridVertices.size());
+    }
+
+    void CreateBoxMesh()
+    {
+        // 정점 정보
+        Vec3 p[8] =
+        {
+            {-0.5f, 0.0f, -0.5f}, {+0.5f, 0.0f, -0.5f},
+            {+0.5f, 1.0f, -0.5f}, {-0.5f, 1.0f, -0.5f},
+            {-0.5f, 0.0f, +0.5f}, {+0.5f, 0.0f, +0.5f},
+            {+0.5f, 1.0f, +0.5f}, {-0.5f, 1.0f, +0.5f},
+        };
+
+        // UV만 추가
+       /* VertexPT v24[24] =
+        {
+            {p[0], {0,1}}, {p[1], {1,1}}, {p[2], {1,0}}, {p[3], {0,0}},
+            {p[1], {0,1}}, {p[5], {1,1}}, {p[6], {1,0}}, {p[2], {0,0}},
+            {p[5], {0,1}}, {p[4], {1,1}}, {p[7], {1,0}}, {p[6], {0,0}},
+            {p[4], {0,1}}, {p[0], {1,1}}, {p[3], {1,0}}, {p[7], {0,0}},
+            {p[3], {0,1}}, {p[2], {1,1}}, {p[6], {1,0}}, {p[7], {0,0}},
+            {p[4], {0,0}}, {p[5], {1,0}}, {p[1], {1,1}}, {p[0], {0,1}},
+        };*/
+
+        // UV + 노멀 추가
+        VertexPTN v24[24] =
+        {
+            // Front (-Z)
+            {p[0], {0,1}, {0,0,-1}}, {p[1], {1,1}, {0,0,-1}},
+            {p[2], {1,0}, {0,0,-1}}, {p[3], {0,0}, {0,0,-1}},
+
+            // Right (+X)
+            {p[1], {0,1}, {1,0,0}}, {p[5], {1,1}, {1,0,0}},
+            {p[6], {1,0}, {1,0,0}}, {p[2], {0,0}, {1,0,0}},
+
+            // Back (+Z)
+            {p[5], {0,1}, {0,0,1}}, {p[4], {1,1}, {0,0,1}},
+            {p[7], {1,0}, {0,0,1}}, {p[6], {0,0}, {0,0,1}},
+
+            // Left (-X)
+            {p[4], {0,1}, {-1,0,0}}, {p[0], {1,1}, {-1,0,0}},
+            {p[3], {1,0}, {-1,0,0}}, {p[7], {0,0}, {-1,0,0}},
+
+            // Top (+Y)
+            {p[3], {0,1}, {0,1,0}}, {p[2], {1,1}, {0,1,0}},
+            {p[6], {1,0}, {0,1,0}}, {p[7], {0,0}, {0,1,0}},
+
+            // Bottom (-Y)
+            {p[4], {0,0}, {0,-1,0}}, {p[5], {1,0}, {0,-1,0}},
+            {p[1], {1,1}, {0,-1,0}}, {p[0], {0,1}, {0,-1,0}},
+        };
+
+      
+        uint16_t idx[] =
+        {
+            0,1,2, 0,2,3,
+            4,5,6, 4,6,7,
+            8,9,10, 8,10,11,
+            12,13,14, 12,14,15,
+            16,17,18, 16,18,19,
+            20,21,22, 20,22,23
+        };
+
+        m_BoxIndexCount = std::size(idx);
+
+       
+
+        m_BoxVB = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable, sizeof(v24) }, v24);
+        m_BoxIB = m_Device->CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, sizeof(idx) }, idx);
+    }
+
+    void CreateGrassBoxMesh()
+    {
+        // 정점 정보
+        Vec3 p[8] =
+        {
+            {-0.5f, 0.0f, -0.5f}, {+0.5f, 0.0f, -0.5f},
+            {+0.5f, 1.0f, -0.5f}, {-0.5f, 1.0f, -0.5f},
+            {-0.5f, 0.0f, +0.5f}, {+0.5f, 0.0f, +0.5f},
+            {+0.5f, 1.0f, +0.5f}, {-0.5f, 1.0f, +0.5f},
+        };
+
+        // UV만 추가
+       /* VertexPT v24[24] =
+        {
+            {p[0], {0,1}}, {p[1], {1,1}}, {p[2], {1,0}}, {p[3], {0,0}},
+            {p[1], {0,1}}, {p[5], {1,1}}, {p[6], {1,0}}, {p[2], {0,0}},
+            {p[5], {0,1}}, {p[4], {1,1}}, {p[7], {1,0}}, {p[6], {0,0}},
+            {p[4], {0,1}}, {p[0], {1,1}}, {p[3], {1,0}}, {p[7], {0,0}},
+            {p[3], {0,1}}, {p[2], {1,1}}, {p[6], {1,0}}, {p[7], {0,0}},
+            {p[4], {0,0}}, {p[5], {1,0}}, {p[1], {1,1}}, {p[0], {0,1}},
+        };*/
+
+        // UV + 노멀 추가
+        VertexPTN v24[24] =
+        {
+            // Front (-Z)
+            {p[0], {0,1}, {0,0,-1}}, {p[1], {1,1}, {0,0,-1}},
+            {p[2], {1,0}, {0,0,-1}}, {p[3], {0,0}, {0,0,-1}},
+
+            // Right (+X)
+            {p[1], {0,1}, {1,0,0}}, {p[5], {1,1}, {1,0,0}},
+            {p[6], {1,0}, {1,0,0}}, {p[2], {0,0}, {1,0,0}},
+
+            // Back (+Z)
+            {p[5], {0,1}, {0,0,1}}, {p[4], {1,1}, {0,0,1}},
+            {p[7], {1,0}, {0,0,1}}, {p[6], {0,0}, {0,0,1}},
+
+            // Left (-X)
+            {p[4], {0,1}, {-1,0,0}}, {p[0], {1,1}, {-1,0,0}},
+            {p[3], {1,0}, {-1,0,0}}, {p[7], {0,0}, {-1,0,0}},
+
+            // Top (+Y)
+            {p[3], {0,1}, {0,1,0}}, {p[2], {1,1}, {0,1,0}},
+            {p[6], {1,0}, {0,1,0}}, {p[7], {0,0}, {0,1,0}},
+
+            // Bottom (-Y)
+            {p[4], {0,0}, {0,-1,0}}, {p[5], {1,0}, {0,-1,0}},
+            {p[1], {1,1}, {0,-1,0}}, {p[0], {0,1}, {0,-1,0}},
+        };
+
+
+        uint16_t idx[] =
+        {
+            0,1,2, 0,2,3,
+            4,5,6, 4,6,7,
+            8,9,10, 8,10,11,
+            12,13,14, 12,14,15,
+            16,17,18, 16,18,19,
+            20,21,22, 20,22,23
+        };
+
+        m_BoxIndexCount = std::size(idx);
+
+
+
+        m_GrassVB = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable, sizeof(v24) }, v24);
+        m_GrassIB = m_Device->CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, sizeof(idx) }, idx);
+    }
+    
+    // 텍스처는 TextureCooker로 미리 압축/밉 생성한 DDS만 읽는다 (원본 BoxTexture.png, Field_micro04.dds)
+    //   TextureCooker -bc7 BoxTexture.png Cooked/BoxTexture.dds -bc1 Field_micro04.dds Cooked/Field_micro04.dds
+    void LoadBoxTexture()
+    {
+        StreamTexture(L"Cooked/BoxTexture.dds", m_TexSRV, m_PlaceholderTex);
+        m_Sampler = m_Device->CreateSampler({ TextureAddress::Wrap, 0.0f });
+    }
+
+    void LoadGrassBoxTexture()
+    {
+        StreamTexture(L"Cooked/Field_micro04.dds", m_TexSRVGrass, m_PlaceholderTex);
+        m_SamplerGrass = m_Device->CreateSampler({ TextureAddress::Wrap, 0.0f });
+    }
+
+    void CreatePlaceholderTextures()
+    {
+        m_PlaceholderTex = CreatePlaceholderTexture(*m_Device, false, PLACEHOLDER_RGBA);
+        m_PlaceholderCube = CreatePlaceholderTexture(*m_Device, true, PLACEHOLDER_RGBA);
+    }
+
+    // slot에 자리표시를 걸어 두고 백그라운드 로드를 요청한다. 실패하면 slot은 빈 핸들이 된다
+    void StreamTexture(const wchar_t* path, TextureHandle& slot, TextureHandle placeholder)
+    {
+        slot = placeholder;
+        Invalidate();
+        m_TextureStreamer.Request(path, [this, &slot](TextureHandle texture, const TextureLoadStats& s)
+            {
+                slot = texture;
+                Invalidate();
+
+                if (!s.ok)
+                    Log("[Texture] %ls: load failed after %.2f ms\n", s.path.c_str(), s.readyMs);
+                else
+                    Log("[Texture] %ls: %ls %ux%u%ls, %u mips, %.1f KB file -> %.1f KB upload, queue %.2f + read %.2f + parse %.2f ms (worker), upload %.2f ms, ready %.2f ms after request (%u frames)\n",
+                        s.path.c_str(), TextureFormatName(s.desc.format), s.desc.width, s.desc.height, s.desc.cube ? L" cube" : L"", s.desc.mipLevels,
+                        s.fileBytes / 1024.0, s.uploadBytes / 1024.0, s.queueMs, s.readMs, s.parseMs, s.uploadMs, s.readyMs, s.frames);
+            });
+    }
+
+    void Invalidate() { m_Invalidated = true; }
+
+    // 입력/배치는 버전으로, 나머지는 Invalidate()로 알린다. 켜져 있지 않으면 항상 그린다
+    bool NeedsRedraw()
+    {
+        return !m_OnDemand || m_Invalidated
+            || m_DrawnCameraVersion != m_Camera.Version() || m_DrawnSceneVersion != m_PlacedBoxes.m_Version;
+    }
+
+    void UpdateAndDraw()
+    {
+        m_Invalidated = false;
+        m_DrawnCameraVersion = m_Camera.Version();
+        m_DrawnSceneVersion = m_PlacedBoxes.m_Version;
+        if (++m_FramesRendered == 1)
+        {
+            Log("[Texture] first frame %.2f ms after init, %zu textures still loading\n",
+                std::chrono::duration<double, std::milli>(TextureStreamer::Clock::now() - m_InitTime).count(),
+                m_TextureStreamer.Pending());
+        }
+
+        RenderViewport vp{ 0,0,(float)m_Width,(float)m_Height,0,1 };
+
+        // ---- Skybox ----
+        // 지금은 모든 오브젝트가 월드 = 단위행렬이라 블록 하나를 같이 쓴다
+        m_Queue.Reset();
+        uint32_t identityCB = AddObjectConstants(Mat4{});
+        SubmitSkybox(identityCB);
+
+        // ---- Grid ----
+        UpdateGrid();
+        if (IsGridVisible())
+        {
+            DrawItem it;
+            it.vs = m_VSColor;
+            it.ps = m_PSColor;
+            it.layout = m_InputLayoutColor;
+            it.topology = PrimitiveTopology::LineList;
+            it.vb[0] = m_GridVB;
+            it.strides[0] = sizeof(VertexPC);
+            it.vbCount = 1;
+            it.constants = identityCB;
+            it.count = m_GridVertexCount;
+            m_Queue.Submit(RenderPass::Opaque, it, 1.0f);
+        }
+
+        // ---- Box ----
+        // 청크 메쉬 모드에서도 첫 메쉬가 아직 올라오지 않은 청크는 인스턴싱으로 그린다 (UploadInstances가 거른다)
+        if (m_RenderMode == BoxRenderMode::ChunkMesh)
+            SubmitChunkMeshes(identityCB);
+        UploadInstances();
+        SubmitInstances();
+
+        m_Queue.Sort();
+        UpdateCameraConstants();
+        m_VSRing.BeginFrame();
+        if (!m_Queue.UploadConstants(*m_Context, m_VSRing))
+            Log("[Render] Constant ring overflow, some draws skipped\n");
+
+        BuildFrameGraph(vp);
+        m_FrameGraph.Compile();
+        m_FrameGraph.Execute(*m_Context);
+        m_VSRing.EndFrame();
+
+        m_Device->Present(m_Pacer.SyncInterval());
+    }
+
+    // 프레임/패스 상수는 카메라가 바뀐 프레임에만 올린다 (안 바뀌면 지난 내용이 그대로 남아 있다)
+    void UpdateCameraConstants()
+    {
+        if (m_CameraConstantsVersion == m_Camera.Version()) return;
+        m_CameraConstantsVersion = m_Camera.Version();
+        ++m_CameraConstantUploads;
+
+        CBFrame frame{};
+        //frame.lightPos = Vec3(4, 6, -3);   // 라이트 위치
+        frame.lightPos = m_Camera.Eye() + Vec3(2.0f, 2.0f, 2.0f);   // 카메라를 따라다니는 라이트
+        frame.lightRange = 20.0f;
+        frame.lightColor = Vec3(1, 1, 0.8f);
+        frame.eyePos = m_Camera.Eye();
+        frame.specPower = 32.0f;
+        m_Context->UpdateBuffer(m_CBFrame, &frame, sizeof(frame));
+
+        CBPass scene{ m_Camera.ViewProj().Transpose() };
+        m_Context->UpdateBuffer(m_CBPassScene, &scene, sizeof(scene));
+
+        CBPass sky{ m_Camera.SkyViewProj().Transpose() };
+        m_Context->UpdateBuffer(m_CBPassSky, &sky, sizeof(sky));
+    }
+
+    // 백버퍼/깊이는 스왑체인 것이라 Import. 지금은 두 패스 모두 거기에 바로 그리므로 임시 리소스가 없다.
+    void BuildFrameGraph(const RenderViewport& vp)
+    {
+        const FGTextureDesc colorDesc{ uint32_t(m_Width), uint32_t(m_Height), FGFormat::RGBA8 };
+        const FGTextureDesc depthDesc{ uint32_t(m_Width), uint32_t(m_Height), FGFormat::D24S8 };
+
+        m_FrameGraph.Reset();
+        FrameGraphResource backBuffer = m_FrameGraph.Import("BackBuffer", colorDesc);
+        FrameGraphResource depth = m_FrameGraph.Import("Depth", depthDesc);
+
+        m_FrameGraph.AddPass("Sky",
+            [&](FrameGraph::Builder& b)
+            {
+                backBuffer = b.Write(backBuffer);
+                depth = b.Write(depth);
+            },
+            [this, vp](IRenderContext& ctx)
+            {
+                float clear[4] = { 0.08f, 0.09f, 0.11f, 1.0f };
+                ctx.ClearTargets(clear, 1.0f);
+                ctx.SetViewport(vp);
+                ctx.SetVSConstantBuffer(1, m_CBPassSky);
+                RenderQueue::Range sky = m_Queue.PassRange(RenderPass::Sky);
+                m_Queue.ExecuteRange(ctx, sky.begin, sky.end, 2);
+            });
+
+        m_FrameGraph.AddPass("Opaque",
+            [&](FrameGraph::Builder& b)
+            {
+                b.Read(depth);
+                backBuffer = b.Write(backBuffer);
+                depth = b.Write(depth);
+            },
+            [this, vp](IRenderContext& ctx)
+            {
+                ctx.SetVSConstantBuffer(1, m_CBPassScene);
+                ctx.SetPSConstantBuffer(0, m_CBFrame);
+                RenderQueue::Range opaque = m_Queue.PassRange(RenderPass::Opaque);
+                if (m_ParallelRecord)
+                {
+                    // 목록마다 상태를 새로 잡아야 하므로 뷰포트와 프레임/패스 상수를 먼저 기록한다
+                    m_Queue.ExecuteParallel(*m_Device, ctx, m_Pool, opaque,
+                        [&](IRenderContext& c)
+                        {
+                            c.SetViewport(vp);
+                            c.SetVSConstantBuffer(1, m_CBPassScene);
+                            c.SetPSConstantBuffer(0, m_CBFrame);
+                        },
+                        2);
+                }
+                else
+                {
+                    m_Queue.m_ListCount = 0;
+                    m_Queue.ExecuteRange(ctx, opaque.begin, opaque.end, 2);
+                }
+            });
+    }
+
+    bool IsGridVisible()
+    {
+        if (m_GridVertexCount == 0) return false;
+        AabbBatch b{};
+        b.Set(0, m_GridInfo.boundsMin, m_GridInfo.boundsMax);
+        uint8_t vis = 0;
+        CullAabbBatches(m_Camera.GetFrustum(), &b, 1, &vis, nullptr);
+        return (vis & 1) != 0;
+    }
+
+    // 인스턴싱으로 그릴 청크 집합을 나타내는 값: 인스턴스 모드면 0 (전부), 청크 메쉬 모드면 메쉬 집합 버전 + 1
+    uint64_t InstanceFilterKey() const
+    {
+        return (m_RenderMode == BoxRenderMode::ChunkMesh) ? m_ChunkMeshSetVersion + 1 : 0;
+    }
+
+    // 배치 데이터, 카메라, 인스턴싱할 청크 집합이 바뀐 경우에만 컬링 후 보이는 인스턴스를 업로드한다.
+    // 청크 메쉬 모드에서는 메쉬가 있는 청크를 빼서 아직 메쉬가 없는 청크만 남긴다.
+    void UploadInstances()
+    {
+        bool sceneChanged = (m_InstanceVersion != m_PlacedBoxes.m_Version);
+        if (sceneChanged)
+        {
+            m_InstanceVersion = m_PlacedBoxes.m_Version;
+            m_PlacedBoxes.PackInstances(m_CellSize, m_InstanceScratch, &m_ChunkRanges, &m_InstanceMaterials);
+            m_Culler.Build(m_InstanceScratch, m_ChunkRanges);
+        }
+
+        const uint64_t filterKey = InstanceFilterKey();
+        if (!sceneChanged && m_CullCameraVersion == m_Camera.Version() && m_CullFilterKey == filterKey) return;
+        m_CullCameraVersion = m_Camera.Version();
+        m_CullFilterKey = filterKey;
+
+        m_Culler.Cull(m_Camera.GetFrustum(), m_VisibleInstances);
+        if (filterKey != 0) DropMeshedChunks(m_VisibleInstances);
+        if (m_UseOcclusion && m_VisibleInstances.size() > m_OccluderBudget)
+            ApplyOcclusion(m_Camera.ViewProj());
+
+        // material별로 연속되도록 계수 정렬하며 모은다
+        uint32_t counts[256] = {};
+        for (uint32_t i : m_VisibleInstances) ++counts[m_InstanceMaterials[i]];
+
+        uint32_t offsets[256];
+        m_InstanceSubsets.clear();
+        for (uint32_t m = 0, start = 0; m < 256; ++m)
+        {
+            offsets[m] = start;
+            if (counts[m]) m_InstanceSubsets.push_back({ uint8_t(m), start, counts[m] });
+            start += counts[m];
+        }
+
+        m_InstanceGather.resize(m_VisibleInstances.size());
+        for (uint32_t i : m_VisibleInstances)
+            m_InstanceGather[offsets[m_InstanceMaterials[i]]++] = m_InstanceScratch[i];
+
+        m_InstanceCount = uint32_t(m_InstanceGather.size());
+        if (m_InstanceCount == 0) return;
+
+        // 용량 부족 시 2배씩 키워서 재생성
+        if (!m_InstanceVB || m_InstanceCount > m_InstanceCapacity)
+        {
+            uint32_t cap = std::max<uint32_t>(m_InstanceCapacity, 1024);
+            while (cap < m_InstanceCount) cap *= 2;
+
+            m_Device->DestroyBuffer(m_InstanceVB);
+            m_InstanceVB = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Dynamic, uint32_t(cap * sizeof(InstanceData)) }, nullptr);
+            if (!m_InstanceVB)
+            {
+                Log("[Instancing] Instance buffer creation FAILED\n");
+                m_InstanceCapacity = 0;
+                m_InstanceCount = 0;
+                m_InstanceSubsets.clear();
+                return;
+            }
+            m_InstanceCapacity = cap;
+        }
+
+        if (!m_Context->UpdateBuffer(m_InstanceVB, m_InstanceGather.data(), uint32_t(m_InstanceCount * sizeof(InstanceData))))
+            m_InstanceSubsets.clear();
+    }
+
+    // 메쉬가 올라간 청크의 인스턴스를 indices에서 뺀다 (m_ChunkRanges는 인스턴스 순서대로 연속)
+    void DropMeshedChunks(std::vector<uint32_t>& indices)
+    {
+        if (m_ChunkMeshes.empty()) return;
+        size_t n = 0;
+        for (uint32_t i : indices)
+        {
+            auto r = std::upper_bound(m_ChunkRanges.begin(), m_ChunkRanges.end(), i,
+                [](uint32_t v, const ChunkInstanceRange& cr) { return v < cr.first; });
+            if (r == m_ChunkRanges.begin() || !m_ChunkMeshes.count(ChunkKey((r - 1)->coord)))
+                indices[n++] = i;
+        }
+        indices.resize(n);
+    }
+
+    TextureHandle MaterialSRV(uint8_t material)
+    {
+        return (material == 2) ? m_TexSRVGrass : m_TexSRV;
+    }
+
+    // 프레임 시작: 워커에서 끝난 청크 메쉬를 GPU 버퍼로 교체하고, 새 리메싱을 제출한다.
+    void BeginFrame()
+    {
+        m_TextureStreamer.UploadCompleted(*m_Device);   // 완료된 텍스처는 onReady에서 Invalidate
+
+        size_t applied = m_Remesher.SwapCompleted([this](const ChunkMeshData& data) { UploadChunkMesh(data); });
+        if (applied > 0) Invalidate();
+        if (applied > 0 && m_Remesher.Idle())
+        {
+            const RemeshStats& rs = m_Remesher.m_Stats;
+            Log("[Remesh] requested=%llu done=%llu dropped=%llu latency last/avg/max=%.2f/%.2f/%.2f ms, mesh avg=%.2f ms\n",
+                (unsigned long long)rs.submitted, (unsigned long long)rs.completed, (unsigned long long)rs.dropped,
+                rs.lastLatencyMs, rs.avgLatencyMs, rs.maxLatencyMs, rs.avgMeshMs);
+        }
+
+        if (m_RenderMode == BoxRenderMode::ChunkMesh)
+            ScheduleChunkRemesh();
+    }
+
+    // 이번 프레임에 모인 dirty 청크만 한 번씩 리메싱 요청한다.
+    // 처음 청크 메쉬 모드로 들어오면 전체를 한 번 메싱한다.
+    void ScheduleChunkRemesh()
+    {
+        const SparseGrid& grid = m_PlacedBoxes.m_Grid;
+        if (!m_ChunkMeshesBuilt)
+        {
+            m_ChunkMeshesBuilt = true;
+            m_PlacedBoxes.m_Dirty.Clear();
+            m_LodCameraVersion = m_Camera.Version();
+            for (auto& chunk : grid.m_Chunks)
+                m_Remesher.Request(grid, chunk->coord, ChunkLodFor(chunk->coord));
+            return;
+        }
+
+        if (!m_PlacedBoxes.m_Dirty.Empty())
+        {
+            m_PlacedBoxes.m_Dirty.Take(m_DirtyChunks);
+            for (const ChunkCoord& cc : m_DirtyChunks)
+                m_Remesher.Request(grid, cc, ChunkLodFor(cc));
+        }
+
+        // 카메라 거리로 레벨이 바뀐 청크만 다시 메싱 (카메라가 움직인 프레임에만 훑는다.
+        // 새로 생기거나 바뀐 청크는 위의 dirty 요청에서 레벨을 기록한다)
+        if (m_LodCameraVersion == m_Camera.Version()) return;
+        m_LodCameraVersion = m_Camera.Version();
+        for (auto& chunk : grid.m_Chunks)
+        {
+            uint64_t key = ChunkKey(chunk->coord);
+            auto it = m_ChunkLod.find(key);
+            int old = (it != m_ChunkLod.end()) ? it->second : -1;
+            int level = ChunkLodFor(chunk->coord);
+            if (level != old)
+                m_Remesher.Request(grid, chunk->coord, level);
+        }
+    }
+
+    // 청크의 LOD 레벨을 다시 고르고 기록한다.
+    // 처음 보는 청크는 레벨 0을 현재 레벨로 삼아 고르므로 0에서 올라갈 때도 히스테리시스가 붙는다
+    // (경계를 조금만 넘은 새 청크는 한 단계 자세한 레벨로 시작한다).
+    int ChunkLodFor(const ChunkCoord& cc)
+    {
+        const Vec3& camPos = m_Camera.Eye();
+        float eye[3] = { camPos.x, camPos.y, camPos.z };
+        float d = ChunkDistance(cc, m_CellSize, eye);
+        uint8_t& level = m_ChunkLod.try_emplace(ChunkKey(cc), uint8_t(0)).first->second;
+        level = uint8_t(SelectChunkLod(level, d, m_LodSettings));
+        return level;
+    }
+
+    MeshStats TotalMeshStats() const
+    {
+        MeshStats total;
+        for (auto& [key, gm] : m_ChunkMeshes)
+        {
+            total.cells += gm.stats.cells;
+            total.quads += gm.stats.quads;
+            total.vertices += gm.stats.vertices;
+            total.triangles += gm.stats.triangles;
+        }
+        return total;
+    }
+
+    // 빈 메쉬면 청크를 지우고, 아니면 새 버퍼를 만든 뒤 교체한다 (실패하면 이전 메쉬 유지).
+    void UploadChunkMesh(const ChunkMeshData& data)
+    {
+        uint64_t key = ChunkKey(data.coord);
+        if (data.indices.empty())
+        {
+            auto it = m_ChunkMeshes.find(key);
+            if (it != m_ChunkMeshes.end())
+            {
+                ReleaseChunkMesh(it->second);
+                m_ChunkMeshes.erase(it);
+                ++m_ChunkMeshSetVersion;
+            }
+            m_ChunkLod.erase(key);
+            return;
+        }
+
+        ChunkGpuMesh gm;
+        gm.coord = data.coord;
+        gm.vb = m_Device->CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable,
+            uint32_t(data.vertices.size() * sizeof(MeshVertex)) }, data.vertices.data());
+        gm.ib = m_Device->CreateBuffer({ BufferBind::Index, BufferUsage::Immutable,
+            uint32_t(data.indices.size() * sizeof(uint32_t)) }, data.indices.data());
+        if (!gm.vb || !gm.ib)
+        {
+            ReleaseChunkMesh(gm);
+            return;
+        }
+
+        gm.subsets = data.subsets;
+        std::copy(data.boundsMin, data.boundsMin + 3, gm.boundsMin);
+        std::copy(data.boundsMax, data.boundsMax + 3, gm.boundsMax);
+        gm.stats = data.stats;
+
+        auto [slot, added] = m_ChunkMeshes.try_emplace(key);
+        ReleaseChunkMesh(slot->second);
+        slot->second = std::move(gm);
+        if (added) ++m_ChunkMeshSetVersion;
+    }
+
+    void ReleaseChunkMesh(ChunkGpuMesh& gm)
+    {
+        m_Device->DestroyBuffer(gm.vb);
+        m_Device->DestroyBuffer(gm.ib);
+        gm.vb = {};
+        gm.ib = {};
+    }
+
+    // material별로 한 번씩 인스턴스 드로우 (월드는 인스턴스 데이터라 오브젝트 상수 없음)
+    void SubmitInstances()
+    {
+        DrawItem it;
+        it.vs = m_VSTex;
+        it.ps = m_PSTex;
+        it.layout = m_InputLayoutTex;
+        it.vb[0] = m_BoxVB;
+        it.vb[1] = m_InstanceVB;
+        it.strides[0] = sizeof(VertexPTN);
+        it.strides[1] = sizeof(InstanceData);
+        it.vbCount = 2;
+        it.ib = m_BoxIB;
+        it.indexFormat = IndexFormat::UInt16;
+        it.sampler = m_Sampler;
+        it.count = m_BoxIndexCount;
+        for (const MeshSubset& sub : m_InstanceSubsets)
+        {
+            it.texture = MaterialSRV(sub.material);
+            it.instanceCount = sub.indexCount;
+            it.startInstance = sub.indexStart;
+            m_Queue.Submit(RenderPass::Opaque, it, 0.0f);
+        }
+    }
+
+    // 보이는 청크의 material별 구간을 카메라 거리와 함께 제출한다 (정렬 후 앞에서 뒤로)
+    void SubmitChunkMeshes(uint32_t objectCB)
+    {
+        DrawItem it;
+        it.vs = m_VSTexMesh;
+        it.ps = m_PSTex;
+        it.layout = m_InputLayoutMesh;
+        it.strides[0] = sizeof(MeshVertex);
+        it.vbCount = 1;
+        it.indexFormat = IndexFormat::UInt32;
+        it.sampler = m_Sampler;
+        it.constants = objectCB;
+
+        for (auto& [key, gm] : m_ChunkMeshes)
+        {
+            AabbBatch b{};
+            b.Set(0, gm.boundsMin, gm.boundsMax);
+            uint8_t vis = 0;
+            CullAabbBatches(m_Camera.GetFrustum(), &b, 1, &vis, nullptr);
+            if (!(vis & 1)) continue;
+
+            Vec3 center(0.5f * (gm.boundsMin[0] + gm.boundsMax[0]),
+                           0.5f * (gm.boundsMin[1] + gm.boundsMax[1]),
+                           0.5f * (gm.boundsMin[2] + gm.boundsMax[2]));
+            float depth01 = Vec3::Distance(center, m_Camera.Eye()) / CAMERA_FAR;
+
+            it.vb[0] = gm.vb;
+            it.ib = gm.ib;
+            for (const MeshSubset& sub : gm.subsets)
+            {
+                it.texture = MaterialSRV(sub.material);
+                it.start = sub.indexStart;
+                it.count = sub.indexCount;
+                m_Queue.Submit(RenderPass::Opaque, it, depth01);
+            }
+        }
+    }
+
+    // 보이는 박스 중 가까운 것부터 m_OccluderBudget개를 깊이 버퍼에 그리고, 가려진 박스를 목록에서 뺀다.
+    void ApplyOcclusion(const Mat4& viewProj)
+    {
+        const Vec3& eye = m_Camera.Eye();
+        auto dist2 = [&](uint32_t i)
+        {
+            const InstanceData& d = m_InstanceScratch[i];
+            return Vec3::DistanceSquared(eye, Vec3(d.row0[3], d.row1[3], d.row2[3]));
+        };
+
+        m_Occluders.assign(m_VisibleInstances.begin(), m_VisibleInstances.end());
+        size_t k = std::min(m_OccluderBudget, m_Occluders.size());
+        std::nth_element(m_Occluders.begin(), m_Occluders.begin() + k, m_Occluders.end(),
+            [&](uint32_t a, uint32_t b) { return dist2(a) < dist2(b); });
+
+        m_Occlusion.BeginFrame(viewProj.Data());
+        for (size_t i = 0; i < k; ++i)
+        {
+            float mn[3], mx[3];
+            InstanceBounds(m_InstanceScratch[m_Occluders[i]], mn, mx);
+            m_Occlusion.AddOccluderBox(mn, mx);
+        }
+        m_Occlusion.Rasterize(&m_Pool);
+        m_Occlusion.FilterVisible(m_VisibleInstances,
+            [this](uint32_t i, float mn[3], float mx[3]) { InstanceBounds(m_InstanceScratch[i], mn, mx); },
+            &m_Pool);
+    }
+
+    void SubmitSkybox(uint32_t objectCB)
+    {
+        if (!m_SkySRV) Log("[Skybox] SRV NULL\n");
+        if (!m_PSSky) Log("[Skybox] PixelShader null\n");
+        if (!m_VSSky) Log("[Skybox] VertexShader null\n");
+        if (!m_InputLayoutSky) Log("[Skybox] InputLayout null\n");
+
+        // 카메라 변환 (위치 제외)은 스카이 패스 상수 (m_CBPassSky), 월드는 단위행렬
+        DrawItem it;
+        it.vs = m_VSSky;
+        it.ps = m_PSSky;
+        it.layout = m_InputLayoutSky;
+        it.vb[0] = m_SkyVB;
+        it.strides[0] = sizeof(VertexP);
+        it.vbCount = 1;
+        it.ib = m_SkyIB;
+        it.indexFormat = IndexFormat::UInt16;
+        it.texture = m_SkySRV;
+        it.sampler = m_SkySampler;
+        it.depthState = m_SkyDSS;      // 깊이 쓰기 끔, LessEqual
+        it.rasterState = m_SkyRS;      // 안쪽 면, 깊이 클립 끔
+        it.constants = objectCB;
+        it.count = m_SkyIndexCount;
+        m_Queue.Submit(RenderPass::Sky, it, 1.0f);
+    }
+
+    // 오브젝트별 VS 상수 (월드)를 큐에 넣는다
+    uint32_t AddObjectConstants(const Mat4& world)
+    {
+        CBObject cb;
+        PackTransposed4x4(world.Data(), 1, cb.gWorld.Data(), false);
+        return m_Queue.AddConstants(&cb, sizeof(cb));
+    }
+
+    void ScreenRay(int mx, int my, Vec3& outOrigin, Vec3& outDir)
+    {
+        float x = (2.0f * mx / float(m_Width)) - 1.0f;
+        float y = 1.0f - (2.0f * my / float(m_Height));
+
+        const Mat4& invVP = m_Camera.InvViewProj();
+        Vec3 nearW = invVP.TransformPoint(Vec3(x, y, 0.0f));
+        Vec3 farW = invVP.TransformPoint(Vec3(x, y, 1.0f));
+
+        outOrigin = nearW;
+        outDir = (farW - nearW); outDir.Normalize();
+    }
+
+    bool RayHitGround(const Vec3& ro, const Vec3& rd, Vec3& outHit)
+    {
+        if (fabsf(rd.y) < 1e-6f) return false;
+        float t = -ro.y / rd.y;
+        if (t < 0) return false;
+        outHit = ro + rd * t;
+        return true;
+    }
+
+    Vec3 SnapToCellCenter(const Vec3& p)
+    {
+        float s = m_CellSize;
+        float cx = floorf(p.x / s) * s + s * 0.5f;
+        float cz = floorf(p.z / s) * s + s * 0.5f;
+        return { cx, 0.0f, cz };
+    }
+
+    // 지난 프레임 이후 쌓인 입력을 한 번에 적용한다.
+    // 카메라는 드래그/휠 합으로 한 번만 바뀌고, 클릭은 그 카메라로 들어온 순서대로 처리한다.
+    void ApplyInput()
+    {
+        m_Input.TakeFrame(m_FrameInput);
+        if (m_FrameInput.Empty()) return;
+
+        const FrameInputState& in = m_FrameInput;
+        if (in.dragDx || in.dragDy)
+            m_Camera.Orbit(float(in.dragDx) * ORBIT_RADIANS_PER_PIXEL, -float(in.dragDy) * ORBIT_RADIANS_PER_PIXEL);
+        for (int i = 0; i < in.wheelSteps; ++i) m_Camera.Zoom(0.9f);
+        for (int i = 0; i > in.wheelSteps; --i) m_Camera.Zoom(1.1f);
+        for (const InputClick& c : in.clicks) OnClick(c.x, c.y, c.erase);
+    }
+
+    // vsync → uncapped → fixed-rate (60 Hz) → low-latency 순환. 바꾸기 전 모드의 통계를 출력한다
+    void CyclePacingMode()
+    {
+        const FramePacerStats& s = m_Pacer.m_Stats;
+        Log("[Pacing] %ls: %llu frames, avg %.2f ms (min %.2f, max %.2f), %llu missed\n",
+            PacingModeName(m_Pacer.m_Mode), (unsigned long long)s.frames, s.AvgIntervalMs(),
+            s.intervals ? s.minIntervalUs / 1000.0 : 0.0, s.maxIntervalUs / 1000.0, (unsigned long long)s.missed);
+
+        m_Pacer.SetMode(PacingMode((uint8_t(m_Pacer.m_Mode) + 1) % 4));
+        Log("[Pacing] -> %ls\n", PacingModeName(m_Pacer.m_Mode));
+    }
+
+    // 클릭한 셀에 박스 배치 (erase == true 이면 제거)
+    // - 배치된 박스에 맞으면 그 면에 붙여서 쌓고, 아니면 바닥 셀에 놓는다.
+    void OnClick(int mx, int my, bool erase = false)
+    {
+        Vec3 ro, rd; ScreenRay(mx, my, ro, rd);
+
+        Vec3 hit;
+        bool groundHit = RayHitGround(ro, rd, hit);
+        float maxDist = groundHit ? (hit - ro).Length() + m_CellSize : 1000.0f;
+
+        GridRayHit gh;
+        if (RaycastCells(m_PlacedBoxes.m_Grid, &ro.x, &rd.x, m_CellSize, maxDist, gh))
+        {
+            if (erase) m_PlacedBoxes.Remove(gh.hit);
+            else if (gh.prev.y >= 0) m_PlacedBoxes.Place(gh.prev, m_CurrentMaterial);
+            return;
+        }
+
+        if (groundHit)
+        {
+            Vec3 c = SnapToCellCenter(hit);
+            CellCoord cell{ int(floorf(c.x / m_CellSize)), 0, int(floorf(c.z / m_CellSize)) };
+            if (erase) m_PlacedBoxes.Remove(cell);
+            else       m_PlacedBoxes.Place(cell, m_CurrentMaterial);
+        }
+    }
+
+    void Resize(uint32_t w, uint32_t h)
+    {
+        if (!m_Device) return;
+        m_Width = w; m_Height = h;
+        m_Device->Resize(w, h);
+        m_Camera.SetAspect(float(w) / float(h));
+        Invalidate();
+    }
+
+    void ToggleOnDemand()
+    {
+        Log("[Render] on-demand %s: %llu frames rendered, %llu skipped\n",
+            m_OnDemand ? "off" : "on", (unsigned long long)m_FramesRendered, (unsigned long long)m_FramesSkipped);
+        m_OnDemand = !m_OnDemand;
+    }
+};
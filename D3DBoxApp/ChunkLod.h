@@ -0,0 +1,94 @@
+﻿#pragma once
+
+// 거리 기반 청크 LOD (CPU 전용, Windows/D3D 의존성 없음)
+// - level L: 2^L x 2^L x 2^L 셀 블록을 큰 박스 하나로 다운샘플한다.
+//   블록 안에 셀이 하나라도 있으면 채우고, material은 가장 많은 값 (같으면 작은 값) → 결정적.
+// - 결과를 같은 34^3 PaddedChunk에 블록 단위로 채워 넣으므로 ChunkMesher를 그대로 쓴다
+//   (그리디 병합이 블록 면을 한 사각형으로 합친다).
+// - 패딩 층은 원본(level 0) 셀을 그대로 둔다: 이웃 청크가 어느 level이든 원본 셀의 상위 집합을 그리므로
+//   경계 면이 잘못 컬링돼 구멍이 생기지 않는다.
+// - 레벨 선택은 카메라에서 청크 AABB까지의 거리 + 히스테리시스로 한다.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "ChunkMesher.h"
+
+constexpr int CHUNK_LOD_MAX = 2;   // 0 = 원본, 1 = 2^3 블록, 2 = 4^3 블록
+
+// 청크 내부를 2^level 블록으로 다운샘플 (level 0이면 그대로)
+inline void DownsampleChunk(PaddedChunk& vol, int level)
+{
+    level = std::clamp(level, 0, CHUNK_LOD_MAX);
+    if (level == 0) return;
+
+    const int B = 1 << level;
+    uint8_t values[64];   // 4^3 블록까지
+
+    for (int by = 0; by < CHUNK_SIZE; by += B)
+        for (int bz = 0; bz < CHUNK_SIZE; bz += B)
+            for (int bx = 0; bx < CHUNK_SIZE; bx += B)
+            {
+                int n = 0;
+                for (int y = by; y < by + B; ++y)
+                    for (int z = bz; z < bz + B; ++z)
+                        for (int x = bx; x < bx + B; ++x)
+                        {
+                            uint8_t v = vol.At(x, y, z);
+                            if (v) values[n++] = v;
+                        }
+
+                // 가장 긴 같은 값 구간 = 최빈 material (정렬돼 있으니 같으면 작은 값이 먼저)
+                uint8_t material = 0;
+                if (n > 0)
+                {
+                    std::sort(values, values + n);
+                    int best = 0;
+                    for (int i = 0; i < n;)
+                    {
+                        int j = i;
+                        while (j < n && values[j] == values[i]) ++j;
+                        if (j - i > best) { best = j - i; material = values[i]; }
+                        i = j;
+                    }
+                }
+
+                for (int y = by; y < by + B; ++y)
+                    for (int z = bz; z < bz + B; ++z)
+                        memset(&vol.cells[PaddedChunk::Index(bx, y, z)], material, B);
+            }
+}
+
+// 점에서 청크 AABB까지의 거리 (청크 안이면 0)
+inline float ChunkDistance(const ChunkCoord& cc, float cellSize, const float p[3])
+{
+    const float size = CHUNK_SIZE * cellSize;
+    const float mn[3] = { cc.x * size, cc.y * size, cc.z * size };
+    float d2 = 0.0f;
+    for (int a = 0; a < 3; ++a)
+    {
+        float d = std::max(std::max(mn[a] - p[a], 0.0f), p[a] - (mn[a] + size));
+        d2 += d * d;
+    }
+    return sqrtf(d2);
+}
+
+// level L과 L+1의 경계 거리 = baseDistance * 2^L.
+// 경계를 hysteresis 비율만큼 넘어가야 레벨을 바꾼다 (경계 근처에서 왔다 갔다 하지 않도록).
+struct ChunkLodSettings
+{
+    float baseDistance = 64.0f;
+    float hysteresis = 0.15f;
+};
+
+inline int SelectChunkLod(int current, float distance, const ChunkLodSettings& s)
+{
+    int level = std::clamp(current, 0, CHUNK_LOD_MAX);
+    while (level < CHUNK_LOD_MAX && distance > s.baseDistance * float(1 << level) * (1.0f + s.hysteresis))
+        ++level;
+    while (level > 0 && distance < s.baseDistance * float(1 << (level - 1)) * (1.0f - s.hysteresis))
+        --level;
+    return level;
+}
@@ -0,0 +1,286 @@
+﻿#pragma once
+
+// 청크 그리디 메셔 (CPU 전용, Windows/D3D 의존성 없음)
+// - 이웃 셀이 점유된 면은 버리고, 같은 평면/같은 material의 면을 큰 사각형으로 합친다.
+// - 출력 정점은 VertexPTN과 같은 배치 (pos, uv, normal), 월드 좌표, 박스 메쉬와 같은 와인딩
+// - uv는 셀 단위로 증가하므로 WRAP 샘플러로 셀마다 텍스처가 반복된다.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "SparseGrid.h"
+
+struct MeshVertex
+{
+    float pos[3];
+    float uv[2];
+    float normal[3];
+};
+
+// material별 인덱스 구간
+struct MeshSubset
+{
+    uint8_t  material = 0;
+    uint32_t indexStart = 0;
+    uint32_t indexCount = 0;
+};
+
+struct MeshStats
+{
+    uint32_t cells = 0;
+    uint32_t quads = 0;
+    uint32_t vertices = 0;
+    uint32_t triangles = 0;
+
+    // 셀마다 박스 하나(24 정점, 12 삼각형)를 그릴 때 대비 감소 비율
+    double VertexReduction() const { return vertices ? double(cells) * 24.0 / vertices : 0.0; }
+    double TriangleReduction() const { return triangles ? double(cells) * 12.0 / triangles : 0.0; }
+};
+
+struct ChunkMeshData
+{
+    ChunkCoord              coord;
+    uint8_t                 lod = 0;   // ChunkLod.h의 다운샘플 레벨
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t>   indices;
+    std::vector<MeshSubset> subsets;
+    float                   boundsMin[3] = {};
+    float                   boundsMax[3] = {};
+    MeshStats               stats;
+};
+
+// 청크 + 6방향 이웃 경계 한 겹을 담은 34^3 볼륨 (스레드로 넘길 수 있는 스냅샷)
+struct PaddedChunk
+{
+    static constexpr int P = CHUNK_SIZE + 2;
+
+    ChunkCoord coord;
+    uint8_t    cells[P * P * P];
+
+    static int Index(int x, int y, int z) { return ((y + 1) * P + (z + 1)) * P + (x + 1); }
+    uint8_t At(int x, int y, int z) const { return cells[Index(x, y, z)]; }
+
+    void Build(const SparseGrid& grid, const Chunk& chunk)
+    {
+        coord = chunk.coord;
+        memset(cells, 0, sizeof(cells));
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                memcpy(&cells[Index(0, y, z)], &chunk.cells[Chunk::LocalIndex(0, y, z)], CHUNK_SIZE);
+
+        // 면으로 맞닿은 이웃 청크의 경계 셀만 복사
+        const int N = CHUNK_SIZE - 1;
+        for (int axis = 0; axis < 3; ++axis)
+            for (int side = -1; side <= 1; side += 2)
+            {
+                ChunkCoord nc = coord;
+                (axis == 0 ? nc.x : axis == 1 ? nc.y : nc.z) += side;
+                const Chunk* n = grid.FindChunk(nc);
+                if (!n) continue;
+
+                int src = (side < 0) ? N : 0;          // 이웃 청크에서 읽을 층
+                int dst = (side < 0) ? -1 : CHUNK_SIZE; // 패딩 층
+                for (int i = 0; i < CHUNK_SIZE; ++i)
+                    for (int j = 0; j < CHUNK_SIZE; ++j)
+                    {
+                        int s[3], d[3];
+                        if (axis == 0) { s[0] = src; s[1] = i; s[2] = j; }
+                        else if (axis == 1) { s[0] = i; s[1] = src; s[2] = j; }
+                        else { s[0] = i; s[1] = j; s[2] = src; }
+                        d[0] = s[0]; d[1] = s[1]; d[2] = s[2];
+                        d[axis] = dst;
+                        cells[Index(d[0], d[1], d[2])] = n->cells[Chunk::LocalIndex(s[0], s[1], s[2])];
+                    }
+            }
+    }
+};
+
+struct ChunkMesher
+{
+    // 면 방향 6개: 박스 메쉬(CreateBoxMesh)와 같은 정점 순서/uv를 쓴다.
+    // corner[k] = 각 축의 (0 = min, 1 = max), uv는 0/1에 사각형 크기(셀 수)를 곱한다.
+    struct FaceDesc
+    {
+        int   axis, sign;
+        int   uAxis, vAxis;
+        int   corner[4][3];
+        float uv[4][2];
+        float normal[3];
+    };
+
+    static const FaceDesc& Face(int f)
+    {
+        static const FaceDesc faces[6] =
+        {
+            { 2, -1, 0, 1, { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0} }, { {0,1}, {1,1}, {1,0}, {0,0} }, { 0, 0,-1 } }, // -Z
+            { 0, +1, 2, 1, { {1,0,0}, {1,0,1}, {1,1,1}, {1,1,0} }, { {0,1}, {1,1}, {1,0}, {0,0} }, { 1, 0, 0 } }, // +X
+            { 2, +1, 0, 1, { {1,0,1}, {0,0,1}, {0,1,1}, {1,1,1} }, { {0,1}, {1,1}, {1,0}, {0,0} }, { 0, 0, 1 } }, // +Z
+            { 0, -1, 2, 1, { {0,0,1}, {0,0,0}, {0,1,0}, {0,1,1} }, { {0,1}, {1,1}, {1,0}, {0,0} }, {-1, 0, 0 } }, // -X
+            { 1, +1, 0, 2, { {0,1,0}, {1,1,0}, {1,1,1}, {0,1,1} }, { {0,1}, {1,1}, {1,0}, {0,0} }, { 0, 1, 0 } }, // +Y
+            { 1, -1, 0, 2, { {0,0,1}, {1,0,1}, {1,0,0}, {0,0,0} }, { {0,0}, {1,0}, {1,1}, {0,1} }, { 0,-1, 0 } }, // -Y
+        };
+        return faces[f];
+    }
+
+    struct Quad
+    {
+        uint8_t material;
+        uint8_t face;
+        int     mn[3], mx[3];   // 로컬 셀 좌표 경계 (axis 방향은 mn == mx == 평면 위치)
+    };
+
+    std::vector<Quad> m_Quads;   // 재사용 버퍼
+
+    // greedy == false 이면 면 제거만 하고 합치지 않는다 (비교용).
+    void Build(const PaddedChunk& vol, float cellSize, ChunkMeshData& out, bool greedy = true)
+    {
+        out.coord = vol.coord;
+        out.vertices.clear();
+        out.indices.clear();
+        out.subsets.clear();
+        out.stats = MeshStats{};
+        m_Quads.clear();
+
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    if (vol.At(x, y, z)) ++out.stats.cells;
+        if (out.stats.cells == 0) return;
+
+        uint8_t mask[CHUNK_SIZE * CHUNK_SIZE];
+        for (int f = 0; f < 6; ++f)
+        {
+            const FaceDesc& fd = Face(f);
+            for (int k = 0; k < CHUNK_SIZE; ++k)
+            {
+                // 1) 이 층에서 보이는 면의 material 마스크
+                for (int j = 0; j < CHUNK_SIZE; ++j)
+                    for (int i = 0; i < CHUNK_SIZE; ++i)
+                    {
+                        int c[3];
+                        c[fd.axis] = k; c[fd.uAxis] = i; c[fd.vAxis] = j;
+                        uint8_t m = vol.At(c[0], c[1], c[2]);
+                        if (m)
+                        {
+                            c[fd.axis] += fd.sign;
+                            if (vol.At(c[0], c[1], c[2])) m = 0;
+                        }
+                        mask[j * CHUNK_SIZE + i] = m;
+                    }
+
+                // 2) 같은 material끼리 사각형으로 합치기
+                for (int j = 0; j < CHUNK_SIZE; ++j)
+                    for (int i = 0; i < CHUNK_SIZE;)
+                    {
+                        uint8_t m = mask[j * CHUNK_SIZE + i];
+                        if (!m) { ++i; continue; }
+
+                        int w = 1, h = 1;
+                        if (greedy)
+                        {
+                            while (i + w < CHUNK_SIZE && mask[j * CHUNK_SIZE + i + w] == m) ++w;
+                            for (; j + h < CHUNK_SIZE; ++h)
+                            {
+                                bool rowOk = true;
+                                for (int t = 0; t < w; ++t)
+                                    if (mask[(j + h) * CHUNK_SIZE + i + t] != m) { rowOk = false; break; }
+                                if (!rowOk) break;
+                            }
+                        }
+                        for (int dy = 0; dy < h; ++dy)
+                            memset(&mask[(j + dy) * CHUNK_SIZE + i], 0, w);
+
+                        Quad q;
+                        q.material = m;
+                        q.face = uint8_t(f);
+                        q.mn[fd.axis] = q.mx[fd.axis] = k + (fd.sign > 0 ? 1 : 0);
+                        q.mn[fd.uAxis] = i; q.mx[fd.uAxis] = i + w;
+                        q.mn[fd.vAxis] = j; q.mx[fd.vAxis] = j + h;
+                        m_Quads.push_back(q);
+                        i += w;
+                    }
+            }
+        }
+
+        // 3) material 순으로 정렬해 서브셋마다 연속된 인덱스 구간을 만든다
+        std::stable_sort(m_Quads.begin(), m_Quads.end(), [](const Quad& a, const Quad& b) { return a.material < b.material; });
+
+        const int origin[3] = { vol.coord.x << CHUNK_BITS, vol.coord.y << CHUNK_BITS, vol.coord.z << CHUNK_BITS };
+        int lo[3] = { CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE }, hi[3] = { 0, 0, 0 };
+        out.vertices.reserve(m_Quads.size() * 4);
+        out.indices.reserve(m_Quads.size() * 6);
+
+        for (const Quad& q : m_Quads)
+        {
+            if (out.subsets.empty() || out.subsets.back().material != q.material)
+                out.subsets.push_back({ q.material, uint32_t(out.indices.size()), 0 });
+
+            const FaceDesc& fd = Face(q.face);
+            float su = float(q.mx[fd.uAxis] - q.mn[fd.uAxis]);
+            float sv = float(q.mx[fd.vAxis] - q.mn[fd.vAxis]);
+            uint32_t base = uint32_t(out.vertices.size());
+            for (int v = 0; v < 4; ++v)
+            {
+                MeshVertex mv;
+                for (int a = 0; a < 3; ++a)
+                {
+                    int local = fd.corner[v][a] ? q.mx[a] : q.mn[a];
+                    mv.pos[a] = (origin[a] + local) * cellSize;
+                    mv.normal[a] = fd.normal[a];
+                }
+                mv.uv[0] = fd.uv[v][0] * su;
+                mv.uv[1] = fd.uv[v][1] * sv;
+                out.vertices.push_back(mv);
+            }
+            const uint32_t idx[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+            out.indices.insert(out.indices.end(), idx, idx + 6);
+            out.subsets.back().indexCount += 6;
+
+            for (int a = 0; a < 3; ++a) { lo[a] = std::min(lo[a], q.mn[a]); hi[a] = std::max(hi[a], q.mx[a]); }
+        }
+
+        for (int a = 0; a < 3; ++a)
+        {
+            out.boundsMin[a] = (origin[a] + lo[a]) * cellSize;
+            out.boundsMax[a] = (origin[a] + hi[a]) * cellSize;
+        }
+        out.stats.quads = uint32_t(m_Quads.size());
+        out.stats.vertices = uint32_t(out.vertices.size());
+        out.stats.triangles = uint32_t(out.indices.size() / 3);
+    }
+};
+
+// 꽉 찬 청크 / 체커보드 청크의 정점·삼각형 감소 비율 (박스당 24 정점 / 12 삼각형 대비)
+struct MeshReductionReport
+{
+    MeshStats solid;
+    MeshStats checkerboard;
+};
+
+inline MeshReductionReport BuildMeshReductionReport()
+{
+    MeshReductionReport r;
+    ChunkMesher mesher;
+    ChunkMeshData mesh;
+
+    SparseGrid solid, checker;
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                solid.Set({ x, y, z }, 1);
+                if (((x + y + z) & 1) == 0) checker.Set({ x, y, z }, 1);
+            }
+
+    auto vol = std::make_unique<PaddedChunk>();
+    vol->Build(solid, *solid.FindChunk({ 0, 0, 0 }));
+    mesher.Build(*vol, 1.0f, mesh);
+    r.solid = mesh.stats;
+
+    vol->Build(checker, *checker.FindChunk({ 0, 0, 0 }));
+    mesher.Build(*vol, 1.0f, mesh);
+    r.checkerboard = mesh.stats;
+    return r;
+}
@@ -0,0 +1,162 @@
+﻿#pragma once
+
+// 백그라운드 청크 리메싱 (CPU 전용, Windows/D3D 의존성 없음)
+// - UI 스레드: 청크를 PaddedChunk로 스냅샷해서 워커 풀에 메싱 작업을 넣는다.
+// - 워커: ChunkMeshData를 만들어 완료 큐에 넣는다.
+// - 렌더 루프: 프레임 시작에 완료 큐를 비워 GPU 버퍼를 교체한다 (그 전까지는 이전 메쉬를 계속 그림).
+// - 같은 청크에 더 새 요청이 있으면 오래된 결과는 버린다.
+// - 결과가 완료 큐에 들어갈 때마다 m_OnResult를 부른다 (잠든 메시지 루프를 깨우는 용도).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "ChunkLod.h"
+#include "ChunkMesher.h"
+#include "ThreadPool.h"
+
+struct RemeshStats
+{
+    uint32_t queueDepth = 0;       // 제출됐지만 아직 완료 큐에 들어오지 않은 작업 수
+    uint64_t submitted = 0;
+    uint64_t completed = 0;        // 교체까지 끝난 작업
+    uint64_t dropped = 0;          // 더 새 요청 때문에 버린 결과
+    double   lastLatencyMs = 0.0;  // 제출 → 프레임 교체
+    double   avgLatencyMs = 0.0;
+    double   maxLatencyMs = 0.0;
+    double   avgMeshMs = 0.0;      // 워커에서 메싱에 걸린 시간
+};
+
+struct ChunkRemesher
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Result
+    {
+        uint64_t                        key = 0;
+        uint64_t                        generation = 0;
+        Clock::time_point               submitTime;
+        double                          meshMs = 0.0;
+        std::unique_ptr<ChunkMeshData>  mesh;   // 청크가 비었으면 indices가 비어 있음
+    };
+
+    ThreadPool&                            m_Pool;
+    float                                  m_CellSize = 1.0f;
+    std::unordered_map<uint64_t, uint64_t> m_Generation;   // 청크 키 → 마지막 요청 번호 (UI 스레드 전용)
+    uint64_t                               m_NextGeneration = 1;
+
+    std::mutex                             m_DoneMutex;
+    std::vector<Result>                    m_Done;
+    std::atomic<uint32_t>                  m_InFlight{ 0 };
+    RemeshStats                            m_Stats;
+    std::function<void()>                  m_OnResult;   // 워커 스레드에서도 불린다. 작업을 제출하기 전에 설정
+
+    ChunkRemesher(ThreadPool& pool, float cellSize) : m_Pool(pool), m_CellSize(cellSize) {}
+
+    ~ChunkRemesher()
+    {
+        // 워커가 this를 참조하므로 남은 작업이 끝날 때까지 기다린다
+        while (m_InFlight.load() != 0) std::this_thread::yield();
+    }
+
+    // 청크 스냅샷을 떠서 메싱 작업을 제출한다. 그리드에 청크가 없으면 빈 메쉬(삭제) 결과를 바로 넣는다.
+    // lod > 0 이면 워커에서 다운샘플한 뒤 메싱한다.
+    void Request(const SparseGrid& grid, const ChunkCoord& cc, int lod = 0)
+    {
+        uint64_t key = ChunkKey(cc);
+        uint64_t gen = m_NextGeneration++;
+        m_Generation[key] = gen;
+        ++m_Stats.submitted;
+
+        const Chunk* chunk = grid.FindChunk(cc);
+        if (!chunk)
+        {
+            Result r;
+            r.key = key;
+            r.generation = gen;
+            r.submitTime = Clock::now();
+            r.mesh = std::make_unique<ChunkMeshData>();
+            r.mesh->coord = cc;
+            {
+                std::lock_guard<std::mutex> lock(m_DoneMutex);
+                m_Done.push_back(std::move(r));
+            }
+            if (m_OnResult) m_OnResult();
+            return;
+        }
+
+        auto vol = std::make_shared<PaddedChunk>();
+        vol->Build(grid, *chunk);
+
+        ++m_InFlight;
+        Clock::time_point submit = Clock::now();
+        float cellSize = m_CellSize;
+        m_Pool.Submit([this, vol, key, gen, submit, cellSize, lod]
+        {
+            Result r;
+            r.key = key;
+            r.generation = gen;
+            r.submitTime = submit;
+            r.mesh = std::make_unique<ChunkMeshData>();
+
+            auto t0 = Clock::now();
+            DownsampleChunk(*vol, lod);
+            thread_local ChunkMesher mesher;
+            mesher.Build(*vol, cellSize, *r.mesh);
+            r.mesh->lod = uint8_t(lod);
+            r.meshMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            {
+                std::lock_guard<std::mutex> lock(m_DoneMutex);
+                m_Done.push_back(std::move(r));
+            }
+            if (m_OnResult) m_OnResult();   // m_InFlight를 내리기 전에 (소멸자가 this를 기다리는 동안)
+            --m_InFlight;
+        });
+    }
+
+    // 프레임 시작에 호출: 최신 결과만 apply(ChunkMeshData&)로 넘긴다.
+    template <typename ApplyFn>
+    size_t SwapCompleted(ApplyFn apply)
+    {
+        std::vector<Result> done;
+        {
+            std::lock_guard<std::mutex> lock(m_DoneMutex);
+            done.swap(m_Done);
+        }
+
+        size_t applied = 0;
+        auto now = Clock::now();
+        for (Result& r : done)
+        {
+            auto it = m_Generation.find(r.key);
+            if (it == m_Generation.end() || it->second != r.generation)
+            {
+                ++m_Stats.dropped;
+                continue;
+            }
+            m_Generation.erase(it);
+
+            apply(*r.mesh);
+            ++applied;
+
+            double latency = std::chrono::duration<double, std::milli>(now - r.submitTime).count();
+            ++m_Stats.completed;
+            double n = double(m_Stats.completed);
+            m_Stats.lastLatencyMs = latency;
+            m_Stats.avgLatencyMs += (latency - m_Stats.avgLatencyMs) / n;
+            m_Stats.maxLatencyMs = std::max(m_Stats.maxLatencyMs, latency);
+            m_Stats.avgMeshMs += (r.meshMs - m_Stats.avgMeshMs) / n;
+        }
+        m_Stats.queueDepth = m_InFlight.load();
+        return applied;
+    }
+
+    bool Idle() const { return m_InFlight.load() == 0 && m_Generation.empty(); }
+};
@@ -0,0 +1,194 @@
+﻿#pragma once
+
+// CPU 명령 스트림 (Windows/D3D 의존성 없음)
+// - CommandStreamContext: IDeferredContext 구현. 호출을 고정 크기 명령 + 가변 인자 바이트열로 기록만 한다.
+// - CommandStream: Finish() 결과. Replay()로 아무 IRenderContext에나 같은 순서로 다시 호출한다.
+// - 네이티브 커맨드 리스트가 없는 백엔드(Null/Soft)의 지연 컨텍스트로 쓰여서, GPU 없이도 병렬 기록을 검증할 수 있다.
+// - 핸들 검증/계수는 재생하는 컨텍스트가 한다. UpdateBuffer는 데이터를 복사해 두고 항상 true를 돌려준다.
+// - MapBuffer는 즉시 컨텍스트 전용이라 nullptr (업로드는 기록 전에 즉시 컨텍스트에서 하고, 여기서는 구간 바인딩만 기록).
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "RenderDevice.h"
+
+enum class StreamOp : uint8_t
+{
+    Clear, Viewport, InputLayout, Topology, VertexBuffers, IndexBuffer,
+    VertexShader, PixelShader, VSConstantBuffer, VSConstantBufferRange, PSConstantBuffer, PSTexture, PSSampler,
+    DepthState, RasterState, UpdateBuffer, Draw, DrawIndexed, DrawIndexedInstanced,
+};
+
+struct StreamCommand
+{
+    StreamOp op;
+    uint32_t a = 0, b = 0, c = 0, d = 0, e = 0;   // 명령별 인자 (핸들 id/개수, 또는 m_Payload 오프셋)
+};
+
+struct CommandStream final : IRenderCommandList
+{
+    std::vector<StreamCommand> m_Commands;
+    std::vector<uint8_t>       m_Payload;   // 가변 길이 인자 (지우기 색, 뷰포트, 정점 버퍼 배열, 업로드 데이터)
+
+    uint32_t PushPayload(const void* data, size_t bytes)
+    {
+        uint32_t offset = uint32_t(m_Payload.size());
+        m_Payload.resize(offset + bytes);
+        if (bytes) memcpy(m_Payload.data() + offset, data, bytes);
+        return offset;
+    }
+
+    template <typename T>
+    T ReadPayload(uint32_t offset) const
+    {
+        T v;
+        memcpy(&v, m_Payload.data() + offset, sizeof(T));
+        return v;
+    }
+
+    void Replay(IRenderContext& ctx) const;
+};
+
+struct CommandStreamContext final : IDeferredContext
+{
+    static constexpr uint32_t MAX_VB_SLOTS = 16;
+
+    std::unique_ptr<CommandStream> m_Stream = std::make_unique<CommandStream>();
+    RenderCounters                 m_Counters;   // 기록만 하므로 항상 0
+
+    void Push(StreamOp op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, uint32_t d = 0, uint32_t e = 0)
+    {
+        m_Stream->m_Commands.push_back({ op, a, b, c, d, e });
+    }
+
+    void ClearTargets(const float color[4], float depth) override
+    {
+        uint32_t o = m_Stream->PushPayload(color, sizeof(float) * 4);
+        m_Stream->PushPayload(&depth, sizeof(depth));
+        Push(StreamOp::Clear, o);
+    }
+
+    void SetViewport(const RenderViewport& vp) override
+    {
+        Push(StreamOp::Viewport, m_Stream->PushPayload(&vp, sizeof(vp)));
+    }
+
+    void SetInputLayout(InputLayoutHandle layout) override { Push(StreamOp::InputLayout, layout.id); }
+    void SetPrimitiveTopology(PrimitiveTopology topology) override { Push(StreamOp::Topology, uint32_t(topology)); }
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                          const uint32_t* strides, const uint32_t* offsets) override
+    {
+        count = (count < MAX_VB_SLOTS) ? count : MAX_VB_SLOTS;
+        uint32_t o = uint32_t(m_Stream->m_Payload.size());
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t v[3] = { buffers[i].id, strides[i], offsets ? offsets[i] : 0 };
+            m_Stream->PushPayload(v, sizeof(v));
+        }
+        Push(StreamOp::VertexBuffers, startSlot, count, o);
+    }
+
+    void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) override
+    {
+        Push(StreamOp::IndexBuffer, buffer.id, uint32_t(format), offset);
+    }
+
+    void SetVertexShader(ShaderHandle shader) override { Push(StreamOp::VertexShader, shader.id); }
+    void SetPixelShader(ShaderHandle shader) override { Push(StreamOp::PixelShader, shader.id); }
+    void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) override { Push(StreamOp::VSConstantBuffer, slot, buffer.id); }
+    void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes) override
+    {
+        Push(StreamOp::VSConstantBufferRange, slot, buffer.id, offset, bytes);
+    }
+    void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) override { Push(StreamOp::PSConstantBuffer, slot, buffer.id); }
+    void SetPSTexture(uint32_t slot, TextureHandle texture) override { Push(StreamOp::PSTexture, slot, texture.id); }
+    void SetPSSampler(uint32_t slot, SamplerHandle sampler) override { Push(StreamOp::PSSampler, slot, sampler.id); }
+    void SetDepthState(DepthStateHandle state) override { Push(StreamOp::DepthState, state.id); }
+    void SetRasterState(RasterStateHandle state) override { Push(StreamOp::RasterState, state.id); }
+
+    bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) override
+    {
+        Push(StreamOp::UpdateBuffer, buffer.id, m_Stream->PushPayload(data, bytes), bytes);
+        return true;
+    }
+
+    void* MapBuffer(BufferHandle, MapMode) override { return nullptr; }
+    void UnmapBuffer(BufferHandle, uint32_t) override {}
+
+    void Draw(uint32_t vertexCount, uint32_t startVertex) override { Push(StreamOp::Draw, vertexCount, startVertex); }
+
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override
+    {
+        Push(StreamOp::DrawIndexed, indexCount, startIndex, uint32_t(baseVertex));
+    }
+
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override
+    {
+        Push(StreamOp::DrawIndexedInstanced, indexCount, instanceCount, startIndex, uint32_t(baseVertex), startInstance);
+    }
+
+    // 지연 컨텍스트 안에서의 중첩 실행은 지원하지 않는다 (무시)
+    void ExecuteCommandList(IRenderCommandList&) override {}
+
+    std::unique_ptr<IRenderCommandList> Finish() override
+    {
+        std::unique_ptr<CommandStream> done = std::move(m_Stream);
+        m_Stream = std::make_unique<CommandStream>();
+        return done;
+    }
+
+    const RenderCounters& Counters() const override { return m_Counters; }
+    void ResetCounters() override {}
+};
+
+inline void CommandStream::Replay(IRenderContext& ctx) const
+{
+    for (const StreamCommand& c : m_Commands)
+    {
+        switch (c.op)
+        {
+        case StreamOp::Clear:
+        {
+            float color[4];
+            memcpy(color, m_Payload.data() + c.a, sizeof(color));
+            ctx.ClearTargets(color, ReadPayload<float>(c.a + sizeof(color)));
+            break;
+        }
+        case StreamOp::Viewport:         ctx.SetViewport(ReadPayload<RenderViewport>(c.a)); break;
+        case StreamOp::InputLayout:      ctx.SetInputLayout({ c.a }); break;
+        case StreamOp::Topology:         ctx.SetPrimitiveTopology(PrimitiveTopology(c.a)); break;
+        case StreamOp::VertexBuffers:
+        {
+            BufferHandle buffers[CommandStreamContext::MAX_VB_SLOTS];
+            uint32_t strides[CommandStreamContext::MAX_VB_SLOTS], offsets[CommandStreamContext::MAX_VB_SLOTS];
+            for (uint32_t i = 0; i < c.b; ++i)
+            {
+                uint32_t v[3];
+                memcpy(v, m_Payload.data() + c.c + i * sizeof(v), sizeof(v));
+                buffers[i] = { v[0] };
+                strides[i] = v[1];
+                offsets[i] = v[2];
+            }
+            ctx.SetVertexBuffers(c.a, c.b, buffers, strides, offsets);
+            break;
+        }
+        case StreamOp::IndexBuffer:      ctx.SetIndexBuffer({ c.a }, IndexFormat(c.b), c.c); break;
+        case StreamOp::VertexShader:     ctx.SetVertexShader({ c.a }); break;
+        case StreamOp::PixelShader:      ctx.SetPixelShader({ c.a }); break;
+        case StreamOp::VSConstantBuffer: ctx.SetVSConstantBuffer(c.a, { c.b }); break;
+        case StreamOp::VSConstantBufferRange: ctx.SetVSConstantBufferRange(c.a, { c.b }, c.c, c.d); break;
+        case StreamOp::PSConstantBuffer: ctx.SetPSConstantBuffer(c.a, { c.b }); break;
+        case StreamOp::PSTexture:        ctx.SetPSTexture(c.a, { c.b }); break;
+        case StreamOp::PSSampler:        ctx.SetPSSampler(c.a, { c.b }); break;
+        case StreamOp::DepthState:       ctx.SetDepthState({ c.a }); break;
+        case StreamOp::RasterState:      ctx.SetRasterState({ c.a }); break;
+        case StreamOp::UpdateBuffer:     ctx.UpdateBuffer({ c.a }, m_Payload.data() + c.b, c.c); break;
+        case StreamOp::Draw:             ctx.Draw(c.a, c.b); break;
+        case StreamOp::DrawIndexed:      ctx.DrawIndexed(c.a, c.b, int32_t(c.c)); break;
+        case StreamOp::DrawIndexedInstanced: ctx.DrawIndexedInstanced(c.a, c.b, c.c, int32_t(c.d), c.e); break;
+        }
+    }
+}
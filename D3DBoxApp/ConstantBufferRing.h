@@ -0,0 +1,164 @@
+﻿#pragma once
+
+// 프레임별 상수 업로드 링 (Windows/D3D 의존성 없음)
+// - 큰 Dynamic 상수 버퍼 하나를 원형으로 쓰면서, 오브젝트별 상수를 CONSTANT_BUFFER_ALIGNMENT 단위로 선형 할당한다.
+// - 프레임마다 Map(NO_OVERWRITE) 한 번에 모든 블록을 복사하고, 드로우는 SetVSConstantBufferRange로 구간만 바인딩한다.
+// - EndFrame이 펜스를 넣고 그 프레임이 쓴 양을 기록한다. 공간이 모자라면 가장 오래된 프레임의 펜스가 끝날 때까지
+//   기다렸다가 (stall) 그 구간을 돌려받으므로, GPU가 아직 읽는 데이터를 덮어쓰지 않는다.
+// - 처음 Map만 DISCARD (드라이버가 새 메모리를 잡도록), 이후는 모두 NO_OVERWRITE.
+// - 한 프레임이 링 전체보다 많이 쓰면 Allocate가 실패한다 (bytes = 0).
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+
+#include "RenderDevice.h"
+
+struct ConstantRingStats
+{
+    uint64_t bytes = 0;       // 복사한 상수 바이트
+    uint64_t allocated = 0;   // 정렬/끝 패딩 포함 링 사용량
+    uint64_t maps = 0;
+    uint64_t allocations = 0;
+    uint64_t stalls = 0;      // 펜스를 기다린 횟수
+    uint64_t failures = 0;    // 링보다 큰 요청
+};
+
+struct ConstantBufferRing
+{
+    struct Allocation { uint32_t offset = 0, bytes = 0; };   // bytes = 0 이면 실패
+
+    // 제출이 끝난 프레임 하나가 차지한 링 구간 (펜스가 끝나면 돌려받는다)
+    struct FrameMark
+    {
+        uint64_t fence;
+        uint32_t bytes;
+    };
+
+    IRenderDevice*        m_Device = nullptr;
+    BufferHandle          m_Buffer;
+    uint32_t              m_Size = 0;
+    uint32_t              m_Head = 0;         // 다음 할당 위치
+    uint32_t              m_Used = 0;         // 아직 돌려받지 못한 바이트 (이번 프레임 포함)
+    uint32_t              m_FrameUsed = 0;    // 이번 프레임이 쓴 바이트
+    std::deque<FrameMark> m_InFlight;
+    uint8_t*              m_Mapped = nullptr;
+    uint32_t              m_MappedBytes = 0;
+    bool                  m_Discarded = false;
+    ConstantRingStats     m_Frame;            // 이번 프레임
+    ConstantRingStats     m_Total;            // 누적
+
+    static uint32_t Align(uint32_t bytes)
+    {
+        return (bytes + CONSTANT_BUFFER_ALIGNMENT - 1) / CONSTANT_BUFFER_ALIGNMENT * CONSTANT_BUFFER_ALIGNMENT;
+    }
+
+    bool Init(IRenderDevice& device, uint32_t bytes)
+    {
+        m_Device = &device;
+        m_Size = Align(bytes);
+        m_Buffer = device.CreateBuffer({ BufferBind::Constant, BufferUsage::Dynamic, m_Size }, nullptr);
+        return bool(m_Buffer);
+    }
+
+    BufferHandle Buffer() const { return m_Buffer; }
+
+    // 끝난 프레임을 (기다리지 않고) 거두고 이번 프레임 통계를 시작한다
+    void BeginFrame()
+    {
+        while (!m_InFlight.empty() && m_Device->IsFenceComplete(m_InFlight.front().fence)) Retire();
+        m_Frame = ConstantRingStats{};
+    }
+
+    // 이번 프레임 명령을 모두 제출한 뒤 호출
+    void EndFrame()
+    {
+        if (m_FrameUsed) m_InFlight.push_back({ m_Device->InsertFence(), m_FrameUsed });
+        m_FrameUsed = 0;
+        Accumulate(m_Total, m_Frame);
+    }
+
+    uint8_t* Map(IRenderContext& ctx)
+    {
+        if (m_Mapped) return m_Mapped;
+        m_Mapped = static_cast<uint8_t*>(ctx.MapBuffer(m_Buffer, m_Discarded ? MapMode::NoOverwrite : MapMode::Discard));
+        if (!m_Mapped) return nullptr;
+        m_Discarded = true;
+        m_MappedBytes = 0;
+        ++m_Frame.maps;
+        return m_Mapped;
+    }
+
+    void Unmap(IRenderContext& ctx)
+    {
+        if (!m_Mapped) return;
+        ctx.UnmapBuffer(m_Buffer, m_MappedBytes);
+        m_Mapped = nullptr;
+    }
+
+    // bytes를 정렬 단위로 올려 할당한다. 끝에 안 들어가면 남은 칸을 버리고 0부터.
+    Allocation Allocate(uint32_t bytes)
+    {
+        const uint32_t size = Align(bytes);
+        if (size == 0 || size > m_Size)
+        {
+            ++m_Frame.failures;
+            return {};
+        }
+
+        for (;;)
+        {
+            if (m_Used == 0) m_Head = 0;   // 비었으면 처음부터 (끝 패딩 낭비 없음)
+            const uint32_t pad = (m_Head + size > m_Size) ? m_Size - m_Head : 0;
+            if (pad + size <= m_Size - m_Used)
+            {
+                Allocation a{ pad ? 0 : m_Head, size };
+                m_Head = a.offset + size;
+                if (m_Head == m_Size) m_Head = 0;
+                m_Used += pad + size;
+                m_FrameUsed += pad + size;
+                m_Frame.allocated += pad + size;
+                ++m_Frame.allocations;
+                return a;
+            }
+            if (m_InFlight.empty())
+            {
+                ++m_Frame.failures;   // 이번 프레임만으로 링이 찼다
+                return {};
+            }
+            if (!m_Device->IsFenceComplete(m_InFlight.front().fence))
+            {
+                ++m_Frame.stalls;
+                m_Device->WaitForFence(m_InFlight.front().fence);
+            }
+            Retire();
+        }
+    }
+
+    // 할당 + 복사 (Map 안에서만)
+    Allocation Write(const void* data, uint32_t bytes)
+    {
+        Allocation a = Allocate(bytes);
+        if (!a.bytes || !m_Mapped) return {};
+        memcpy(m_Mapped + a.offset, data, bytes);
+        m_MappedBytes += bytes;
+        m_Frame.bytes += bytes;
+        return a;
+    }
+
+    void Retire()
+    {
+        m_Used -= m_InFlight.front().bytes;
+        m_InFlight.pop_front();
+    }
+
+    static void Accumulate(ConstantRingStats& total, const ConstantRingStats& frame)
+    {
+        total.bytes += frame.bytes;
+        total.allocated += frame.allocated;
+        total.maps += frame.maps;
+        total.allocations += frame.allocations;
+        total.stalls += frame.stalls;
+        total.failures += frame.failures;
+    }
+};
@@ -0,0 +1,743 @@
+﻿#pragma once
+
+// D3D11 렌더 백엔드 (Windows 전용)
+// - 스왑체인/디바이스 생성 (하드웨어 → WARP 순서), 백버퍼 RTV/DSV 관리
+// - RenderDevice.h의 핸들을 D3D11 객체 테이블로 연결한다.
+// - 지연 컨텍스트는 ID3D11DeviceContext 지연 컨텍스트 + FinishCommandList (같은 D3D11RenderContext 코드를 쓴다)
+// - 상수 버퍼 구간 바인딩은 ID3D11DeviceContext1::VSSetConstantBuffers1 (D3D11.1 런타임), 펜스는 D3D11_QUERY_EVENT
+// - 스왑체인은 flip 모델 + 프레임 지연 대기 객체 (최대 지연 1프레임)를 먼저 시도하고, 안 되면 bitblt 모델
+
+#include <Windows.h>
+
+#include <deque>
+#include <memory>
+#include <wrl.h>
+#include <d3d11.h>
+#include <d3d11_1.h>
+#include <dxgi.h>
+#include <dxgi1_3.h>
+#include <d3dcompiler.h>
+#include <DDSTextureLoader.h>
+
+#include "RenderDevice.h"
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "d3dcompiler.lib")
+
+struct D3D11RenderDevice;
+
+struct D3D11CommandList final : IRenderCommandList
+{
+    Microsoft::WRL::ComPtr<ID3D11CommandList>     m_List;
+    RenderCounters                                m_Counters;   // 기록하면서 센 값, 실행할 때 즉시 컨텍스트에 더한다
+};
+
+// 즉시 컨텍스트와 지연 컨텍스트 공용 (Finish는 지연 컨텍스트에서만 의미가 있다)
+struct D3D11RenderContext final : IDeferredContext
+{
+    D3D11RenderDevice&                            m_Device;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext>   m_Context;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1>  m_Context1;   // 없으면 구간 바인딩 불가 (D3D11.0 런타임)
+    RenderCounters                                m_Counters;
+    PrimitiveTopology                             m_Topology = PrimitiveTopology::TriangleList;
+    bool                                          m_Deferred = false;
+    bool                                          m_TargetsBound = false;   // 지연: 목록마다 첫 드로우 전에 바인딩
+
+    D3D11RenderContext(D3D11RenderDevice& device, ID3D11DeviceContext* context)
+        : m_Device(device), m_Context(context), m_Deferred(context->GetType() == D3D11_DEVICE_CONTEXT_DEFERRED)
+    {
+        m_Context.As(&m_Context1);
+    }
+
+    void BindTargets();
+
+    void ClearTargets(const float color[4], float depth) override;
+    void SetViewport(const RenderViewport& vp) override;
+    void SetInputLayout(InputLayoutHandle layout) override;
+    void SetPrimitiveTopology(PrimitiveTopology topology) override;
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                          const uint32_t* strides, const uint32_t* offsets) override;
+    void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) override;
+    void SetVertexShader(ShaderHandle shader) override;
+    void SetPixelShader(ShaderHandle shader) override;
+    void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) override;
+    void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes) override;
+    void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) override;
+    void SetPSTexture(uint32_t slot, TextureHandle texture) override;
+    void SetPSSampler(uint32_t slot, SamplerHandle sampler) override;
+    void SetDepthState(DepthStateHandle state) override;
+    void SetRasterState(RasterStateHandle state) override;
+    bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) override;
+    void* MapBuffer(BufferHandle buffer, MapMode mode) override;
+    void UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten) override;
+    void Draw(uint32_t vertexCount, uint32_t startVertex) override;
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override;
+    void ExecuteCommandList(IRenderCommandList& list) override;
+    std::unique_ptr<IRenderCommandList> Finish() override;
+
+    const RenderCounters& Counters() const override { return m_Counters; }
+    void ResetCounters() override { m_Counters = RenderCounters{}; }
+};
+
+struct D3D11RenderDevice final : IRenderDevice
+{
+    template <typename T> using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    struct Buffer
+    {
+        ComPtr<ID3D11Buffer> buffer;
+        BufferDesc           desc;
+    };
+
+    struct Shader
+    {
+        ComPtr<ID3D11VertexShader> vs;
+        ComPtr<ID3D11PixelShader>  ps;
+        ComPtr<ID3DBlob>           code;   // 입력 레이아웃 생성용 (VS만)
+    };
+
+    struct Fence
+    {
+        uint64_t            value;
+        ComPtr<ID3D11Query> query;
+    };
+
+    ComPtr<IDXGISwapChain>                       m_SwapChain;
+    ComPtr<ID3D11Device>                         m_Device;
+    ComPtr<ID3D11RenderTargetView>               m_RTV;
+    ComPtr<ID3D11Texture2D>                      m_DSVTex;
+    ComPtr<ID3D11DepthStencilView>               m_DSV;
+    std::unique_ptr<D3D11RenderContext>          m_Immediate;
+
+    HandleTable<Buffer>                          m_Buffers;
+    HandleTable<Shader>                          m_Shaders;
+    HandleTable<ComPtr<ID3D11InputLayout>>       m_Layouts;
+    HandleTable<ComPtr<ID3D11ShaderResourceView>> m_Textures;
+    HandleTable<ComPtr<ID3D11SamplerState>>      m_Samplers;
+    HandleTable<ComPtr<ID3D11DepthStencilState>> m_DepthStates;
+    HandleTable<ComPtr<ID3D11RasterizerState>>   m_RasterStates;
+
+    uint32_t                                     m_Width = 0;
+    uint32_t                                     m_Height = 0;
+
+    std::deque<Fence>                            m_PendingFences;   // 넣은 순서 = 끝나는 순서
+    std::vector<ComPtr<ID3D11Query>>             m_FreeQueries;
+    uint64_t                                     m_LastFence = 0;
+    uint64_t                                     m_CompletedFence = 0;
+    UINT                                         m_SwapChainFlags = 0;
+    HANDLE                                       m_FrameLatencyWaitable = nullptr;   // flip 모델일 때만
+
+    ~D3D11RenderDevice()
+    {
+        if (m_FrameLatencyWaitable) CloseHandle(m_FrameLatencyWaitable);
+    }
+
+    bool Init(HWND hWnd, uint32_t width, uint32_t height)
+    {
+        m_Width = width;
+        m_Height = height;
+
+        // --------------------------------------------------------
+        // 1. SwapChain 설정
+        // --------------------------------------------------------
+        DXGI_SWAP_CHAIN_DESC sd{};
+        sd.BufferDesc.Width = m_Width;
+        sd.BufferDesc.Height = m_Height;
+        sd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        sd.SampleDesc.Count = 1;
+        sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+        sd.BufferCount = 2;
+        sd.OutputWindow = hWnd;
+        sd.Windowed = TRUE;
+        sd.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;   // 프레임 지연 대기 객체는 flip 모델 전용 (Windows 8.1+)
+        sd.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+        DXGI_SWAP_CHAIN_DESC legacy = sd;
+        legacy.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+        legacy.Flags = 0;
+
+        // --------------------------------------------------------
+        // 2. Direct3D 11 Device 생성 (하드웨어 → WARP 순서로, 각각 flip → bitblt 스왑체인)
+        // --------------------------------------------------------
+        ComPtr<ID3D11DeviceContext> context;
+        D3D_FEATURE_LEVEL featureLevel{};
+        auto create = [&](D3D_DRIVER_TYPE driverType, DXGI_SWAP_CHAIN_DESC& desc)
+        {
+            return D3D11CreateDeviceAndSwapChain(
+                nullptr, driverType, nullptr, 0, nullptr, 0, D3D11_SDK_VERSION, &desc,
+                m_SwapChain.ReleaseAndGetAddressOf(), m_Device.ReleaseAndGetAddressOf(),
+                &featureLevel, context.ReleaseAndGetAddressOf());
+        };
+
+        HRESULT hr = create(D3D_DRIVER_TYPE_HARDWARE, sd);   // 1순위: GPU 기반
+        if (FAILED(hr)) hr = create(D3D_DRIVER_TYPE_HARDWARE, legacy);
+
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"[D3D] HARDWARE device creation failed, trying WARP...\n");
+
+            hr = create(D3D_DRIVER_TYPE_WARP, sd);           // 2순위: CPU 기반 WARP
+            if (FAILED(hr)) hr = create(D3D_DRIVER_TYPE_WARP, legacy);
+        }
+
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"[D3D] Failed to create any D3D11 device.\n");
+            return false;
+        }
+
+        // 실제로 만들어진 스왑체인이 대기 객체를 지원하면 최대 지연을 1프레임으로 줄이고 핸들을 받아 둔다
+        DXGI_SWAP_CHAIN_DESC actual{};
+        m_SwapChain->GetDesc(&actual);
+        m_SwapChainFlags = actual.Flags;
+        ComPtr<IDXGISwapChain2> swapChain2;
+        if ((m_SwapChainFlags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) && SUCCEEDED(m_SwapChain.As(&swapChain2)))
+        {
+            swapChain2->SetMaximumFrameLatency(1);
+            m_FrameLatencyWaitable = swapChain2->GetFrameLatencyWaitableObject();
+        }
+        if (!m_FrameLatencyWaitable)
+            OutputDebugString(L"[D3D] Frame latency waitable swap chain not available (low-latency pacing = vsync)\n");
+
+        m_Immediate = std::make_unique<D3D11RenderContext>(*this, context.Get());
+
+        // 상수 버퍼 링: 구간 바인딩 + 상수 버퍼 NO_OVERWRITE Map이 필요하다
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+        if (!m_Immediate->m_Context1
+            || FAILED(m_Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)))
+            || !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            OutputDebugString(L"[D3D] Constant buffer offsetting / NO_OVERWRITE not supported (D3D11.1 runtime required)\n");
+        }
+
+        // --------------------------------------------------------
+        // 3. RTV/DSV 생성
+        // --------------------------------------------------------
+        CreateRTVDSV();
+        return true;
+    }
+
+    void CreateRTVDSV()
+    {
+        if (m_Immediate) m_Immediate->m_Context->OMSetRenderTargets(0, nullptr, nullptr);
+        m_RTV.Reset(); m_DSV.Reset(); m_DSVTex.Reset();
+
+        ComPtr<ID3D11Texture2D> backBuffer;
+        m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)backBuffer.GetAddressOf());
+        m_Device->CreateRenderTargetView(backBuffer.Get(), nullptr, m_RTV.GetAddressOf());
+
+        D3D11_TEXTURE2D_DESC td{};
+        td.Width = m_Width;
+        td.Height = m_Height;
+        td.MipLevels = 1;
+        td.ArraySize = 1;
+        td.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+        td.SampleDesc.Count = 1;
+        td.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+        m_Device->CreateTexture2D(&td, nullptr, m_DSVTex.GetAddressOf());
+        m_Device->CreateDepthStencilView(m_DSVTex.Get(), nullptr, m_DSV.GetAddressOf());
+    }
+
+    IRenderContext& Context() override { return *m_Immediate; }
+
+    std::unique_ptr<IDeferredContext> CreateDeferredContext() override
+    {
+        ComPtr<ID3D11DeviceContext> deferred;
+        if (FAILED(m_Device->CreateDeferredContext(0, deferred.GetAddressOf())))
+        {
+            OutputDebugString(L"[D3D] CreateDeferredContext FAILED\n");
+            return nullptr;
+        }
+        return std::make_unique<D3D11RenderContext>(*this, deferred.Get());
+    }
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* initData) override
+    {
+        D3D11_BUFFER_DESC bd{};
+        bd.ByteWidth = desc.byteWidth;
+        bd.BindFlags = (desc.bind == BufferBind::Vertex) ? D3D11_BIND_VERTEX_BUFFER
+                     : (desc.bind == BufferBind::Index) ? D3D11_BIND_INDEX_BUFFER
+                     : D3D11_BIND_CONSTANT_BUFFER;
+        if (desc.usage == BufferUsage::Dynamic)
+        {
+            bd.Usage = D3D11_USAGE_DYNAMIC;
+            bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        }
+        else
+        {
+            bd.Usage = D3D11_USAGE_IMMUTABLE;
+        }
+
+        D3D11_SUBRESOURCE_DATA sd{ initData, 0, 0 };
+        Buffer b;
+        b.desc = desc;
+        if (FAILED(m_Device->CreateBuffer(&bd, initData ? &sd : nullptr, b.buffer.GetAddressOf())))
+        {
+            OutputDebugString(L"[D3D] CreateBuffer FAILED\n");
+            return {};
+        }
+        ++m_Immediate->m_Counters.buffersCreated;
+        if (initData) m_Immediate->m_Counters.bytesUploaded += desc.byteWidth;
+        return { m_Buffers.Add(std::move(b)) };
+    }
+
+    ShaderHandle CreateShader(const ShaderDesc& desc) override
+    {
+        UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#if _DEBUG
+        flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+        const char* target = (desc.stage == ShaderStage::Vertex) ? "vs_5_0" : "ps_5_0";
+
+        Shader s;
+        ComPtr<ID3DBlob> err;
+        if (FAILED(D3DCompileFromFile(desc.file, nullptr, nullptr, desc.entry, target, flags, 0,
+            s.code.GetAddressOf(), err.GetAddressOf())))
+        {
+            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
+            return {};
+        }
+
+        HRESULT hr = (desc.stage == ShaderStage::Vertex)
+            ? m_Device->CreateVertexShader(s.code->GetBufferPointer(), s.code->GetBufferSize(), nullptr, s.vs.GetAddressOf())
+            : m_Device->CreatePixelShader(s.code->GetBufferPointer(), s.code->GetBufferSize(), nullptr, s.ps.GetAddressOf());
+        if (FAILED(hr)) return {};
+
+        if (desc.stage == ShaderStage::Pixel) s.code.Reset();
+        return { m_Shaders.Add(std::move(s)) };
+    }
+
+    InputLayoutHandle CreateInputLayout(const VertexElement* elements, uint32_t count, ShaderHandle vs) override
+    {
+        Shader* s = m_Shaders.Get(vs.id);
+        if (!s || !s->code) return {};
+
+        D3D11_INPUT_ELEMENT_DESC il[16];
+        if (count > _countof(il)) return {};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const VertexElement& e = elements[i];
+            il[i].SemanticName = e.semantic;
+            il[i].SemanticIndex = e.semanticIndex;
+            il[i].Format = (e.format == VertexFormat::Float2) ? DXGI_FORMAT_R32G32_FLOAT
+                         : (e.format == VertexFormat::Float3) ? DXGI_FORMAT_R32G32B32_FLOAT
+                         : DXGI_FORMAT_R32G32B32A32_FLOAT;
+            il[i].InputSlot = e.slot;
+            il[i].AlignedByteOffset = e.offset;
+            il[i].InputSlotClass = e.perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+            il[i].InstanceDataStepRate = e.perInstance ? 1 : 0;
+        }
+
+        ComPtr<ID3D11InputLayout> layout;
+        if (FAILED(m_Device->CreateInputLayout(il, count, s->code->GetBufferPointer(), s->code->GetBufferSize(),
+            layout.GetAddressOf())))
+            return {};
+        return { m_Layouts.Add(std::move(layout)) };
+    }
+
+    // 쿠킹된 DDS만 DDSTextureLoader로 그대로 올린다 (큐브맵 포함, 디코드/밉 생성 없음)
+    TextureHandle LoadTexture(const wchar_t* path) override
+    {
+        ComPtr<ID3D11ShaderResourceView> srv;
+        if (FAILED(DirectX::CreateDDSTextureFromFile(m_Device.Get(), path, nullptr, srv.GetAddressOf())))
+        {
+            OutputDebugString(L"[D3D] LoadTexture failed (cooked .dds expected): ");
+            OutputDebugString(path);
+            OutputDebugString(L"\n");
+            return {};
+        }
+        return { m_Textures.Add(std::move(srv)) };
+    }
+
+    TextureHandle CreateTexture(const TextureDesc& desc, const void* const* mipData) override
+    {
+        D3D11_TEXTURE2D_DESC td{};
+        td.Width = desc.width;
+        td.Height = desc.height;
+        td.MipLevels = desc.mipLevels;
+        td.ArraySize = desc.cube ? 6 : 1;
+        td.Format = (desc.format == TextureFormat::BC1) ? DXGI_FORMAT_BC1_UNORM
+                  : (desc.format == TextureFormat::BC3) ? DXGI_FORMAT_BC3_UNORM
+                  : (desc.format == TextureFormat::BC7) ? DXGI_FORMAT_BC7_UNORM
+                  : DXGI_FORMAT_R8G8B8A8_UNORM;
+        td.SampleDesc.Count = 1;
+        td.Usage = D3D11_USAGE_IMMUTABLE;
+        td.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        td.MiscFlags = desc.cube ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+
+        // 서브리소스 순서 (면마다 밉 전체)는 mipData와 같다
+        std::vector<D3D11_SUBRESOURCE_DATA> init(size_t(td.ArraySize) * desc.mipLevels);
+        for (uint32_t f = 0; f < td.ArraySize; ++f)
+        {
+            uint32_t w = desc.width;
+            for (uint32_t m = 0; m < desc.mipLevels; ++m)
+            {
+                D3D11_SUBRESOURCE_DATA& sd = init[f * desc.mipLevels + m];
+                sd.pSysMem = mipData[f * desc.mipLevels + m];
+                sd.SysMemPitch = TextureRowPitch(desc.format, w);
+                w = std::max<uint32_t>(w / 2, 1);
+            }
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC vd{};
+        vd.Format = td.Format;
+        vd.ViewDimension = desc.cube ? D3D11_SRV_DIMENSION_TEXTURECUBE : D3D11_SRV_DIMENSION_TEXTURE2D;
+        vd.Texture2D.MipLevels = desc.mipLevels;   // TextureCube도 같은 위치 (MostDetailedMip, MipLevels)
+
+        ComPtr<ID3D11Texture2D> tex;
+        ComPtr<ID3D11ShaderResourceView> srv;
+        if (FAILED(m_Device->CreateTexture2D(&td, init.data(), tex.GetAddressOf())) ||
+            FAILED(m_Device->CreateShaderResourceView(tex.Get(), &vd, srv.GetAddressOf())))
+        {
+            OutputDebugString(L"[D3D] CreateTexture failed\n");
+            return {};
+        }
+        return { m_Textures.Add(std::move(srv)) };
+    }
+
+    SamplerHandle CreateSampler(const SamplerDesc& desc) override
+    {
+        D3D11_SAMPLER_DESC sd{};
+        sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+        sd.AddressU = sd.AddressV = sd.AddressW = (desc.address == TextureAddress::Clamp)
+            ? D3D11_TEXTURE_ADDRESS_CLAMP : D3D11_TEXTURE_ADDRESS_WRAP;
+        sd.ComparisonFunc = D3D11_COMPARISON_NEVER;
+        sd.MaxLOD = desc.maxLod;
+
+        ComPtr<ID3D11SamplerState> s;
+        if (FAILED(m_Device->CreateSamplerState(&sd, s.GetAddressOf()))) return {};
+        return { m_Samplers.Add(std::move(s)) };
+    }
+
+    DepthStateHandle CreateDepthState(const DepthStateDesc& desc) override
+    {
+        D3D11_DEPTH_STENCIL_DESC dsd{};
+        dsd.DepthEnable = desc.depthEnable;
+        dsd.DepthWriteMask = desc.depthWrite ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
+        dsd.DepthFunc = (desc.func == CompareFunc::LessEqual) ? D3D11_COMPARISON_LESS_EQUAL
+                      : (desc.func == CompareFunc::Always) ? D3D11_COMPARISON_ALWAYS
+                      : D3D11_COMPARISON_LESS;
+
+        ComPtr<ID3D11DepthStencilState> s;
+        if (FAILED(m_Device->CreateDepthStencilState(&dsd, s.GetAddressOf()))) return {};
+        return { m_DepthStates.Add(std::move(s)) };
+    }
+
+    RasterStateHandle CreateRasterState(const RasterStateDesc& desc) override
+    {
+        D3D11_RASTERIZER_DESC rd{};
+        rd.FillMode = D3D11_FILL_SOLID;
+        rd.CullMode = (desc.cull == CullMode::Front) ? D3D11_CULL_FRONT
+                    : (desc.cull == CullMode::None) ? D3D11_CULL_NONE
+                    : D3D11_CULL_BACK;
+        rd.FrontCounterClockwise = desc.frontCounterClockwise;
+        rd.DepthClipEnable = desc.depthClip;
+
+        ComPtr<ID3D11RasterizerState> s;
+        if (FAILED(m_Device->CreateRasterizerState(&rd, s.GetAddressOf()))) return {};
+        return { m_RasterStates.Add(std::move(s)) };
+    }
+
+    void DestroyBuffer(BufferHandle buffer) override { m_Buffers.Remove(buffer.id); }
+
+    void Resize(uint32_t width, uint32_t height) override
+    {
+        m_Width = width; m_Height = height;
+        m_Immediate->m_Context->OMSetRenderTargets(0, nullptr, nullptr);
+        m_RTV.Reset(); m_DSV.Reset(); m_DSVTex.Reset();
+        m_SwapChain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, m_SwapChainFlags);   // 생성 플래그는 유지해야 한다
+        CreateRTVDSV();
+    }
+
+    void Present(uint32_t syncInterval) override { m_SwapChain->Present(syncInterval, 0); }
+
+    bool WaitForFrameLatency(uint32_t timeoutMs) override
+    {
+        if (!m_FrameLatencyWaitable) return false;
+        WaitForSingleObjectEx(m_FrameLatencyWaitable, timeoutMs, TRUE);
+        return true;
+    }
+
+    uint64_t InsertFence() override
+    {
+        Fence f{ ++m_LastFence, nullptr };
+        if (!m_FreeQueries.empty())
+        {
+            f.query = std::move(m_FreeQueries.back());
+            m_FreeQueries.pop_back();
+        }
+        else
+        {
+            D3D11_QUERY_DESC qd{ D3D11_QUERY_EVENT, 0 };
+            if (FAILED(m_Device->CreateQuery(&qd, f.query.GetAddressOf())))
+            {
+                // 쿼리를 못 만들면 GPU 전체를 기다린 셈 치고 끝난 것으로 둔다
+                OutputDebugString(L"[D3D] CreateQuery(EVENT) FAILED\n");
+                m_Immediate->m_Context->Flush();
+                m_CompletedFence = m_LastFence;
+                return m_LastFence;
+            }
+        }
+        m_Immediate->m_Context->End(f.query.Get());
+        m_PendingFences.push_back(std::move(f));
+        return m_LastFence;
+    }
+
+    // 앞에서부터 끝난 펜스를 거둔다. wait이면 fence까지 끝날 때까지 돈다.
+    void PollFences(uint64_t fence, bool wait)
+    {
+        while (!m_PendingFences.empty() && m_CompletedFence < fence)
+        {
+            Fence& f = m_PendingFences.front();
+            HRESULT hr = m_Immediate->m_Context->GetData(f.query.Get(), nullptr, 0, wait ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH);
+            if (hr == S_FALSE)
+            {
+                if (!wait) break;
+                YieldProcessor();
+                continue;
+            }
+            if (FAILED(hr)) OutputDebugString(L"[D3D] Fence query FAILED (device removed?)\n");
+            m_CompletedFence = f.value;
+            m_FreeQueries.push_back(std::move(f.query));
+            m_PendingFences.pop_front();
+        }
+    }
+
+    bool IsFenceComplete(uint64_t fence) override
+    {
+        PollFences(fence, false);
+        return fence <= m_CompletedFence;
+    }
+
+    void WaitForFence(uint64_t fence) override { PollFences(fence, true); }
+
+    ID3D11Buffer* BufferPtr(BufferHandle h)
+    {
+        Buffer* b = m_Buffers.Get(h.id);
+        return b ? b->buffer.Get() : nullptr;
+    }
+};
+
+inline void D3D11RenderContext::ClearTargets(const float color[4], float depth)
+{
+    ID3D11RenderTargetView* rtv = m_Device.m_RTV.Get();
+    m_Context->OMSetRenderTargets(1, &rtv, m_Device.m_DSV.Get());
+    m_Context->ClearRenderTargetView(rtv, color);
+    m_Context->ClearDepthStencilView(m_Device.m_DSV.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, depth, 0);
+}
+
+inline void D3D11RenderContext::BindTargets()
+{
+    if (!m_Deferred || m_TargetsBound) return;
+    ID3D11RenderTargetView* rtv = m_Device.m_RTV.Get();
+    m_Context->OMSetRenderTargets(1, &rtv, m_Device.m_DSV.Get());
+    m_TargetsBound = true;
+}
+
+inline void D3D11RenderContext::SetViewport(const RenderViewport& v)
+{
+    D3D11_VIEWPORT vp{ v.x, v.y, v.width, v.height, v.minDepth, v.maxDepth };
+    m_Context->RSSetViewports(1, &vp);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetInputLayout(InputLayoutHandle layout)
+{
+    auto* l = m_Device.m_Layouts.Get(layout.id);
+    m_Context->IASetInputLayout(l ? l->Get() : nullptr);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetPrimitiveTopology(PrimitiveTopology topology)
+{
+    m_Topology = topology;
+    m_Context->IASetPrimitiveTopology(topology == PrimitiveTopology::LineList
+        ? D3D11_PRIMITIVE_TOPOLOGY_LINELIST : D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                                                 const uint32_t* strides, const uint32_t* offsets)
+{
+    ID3D11Buffer* vbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+    for (uint32_t i = 0; i < count; ++i) vbs[i] = m_Device.BufferPtr(buffers[i]);
+    m_Context->IASetVertexBuffers(startSlot, count, vbs, strides, offsets);
+    m_Counters.stateChanges += count;
+}
+
+inline void D3D11RenderContext::SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset)
+{
+    m_Context->IASetIndexBuffer(m_Device.BufferPtr(buffer),
+        format == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, offset);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetVertexShader(ShaderHandle shader)
+{
+    auto* s = m_Device.m_Shaders.Get(shader.id);
+    m_Context->VSSetShader(s ? s->vs.Get() : nullptr, nullptr, 0);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetPixelShader(ShaderHandle shader)
+{
+    auto* s = m_Device.m_Shaders.Get(shader.id);
+    m_Context->PSSetShader(s ? s->ps.Get() : nullptr, nullptr, 0);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetVSConstantBuffer(uint32_t slot, BufferHandle buffer)
+{
+    ID3D11Buffer* b = m_Device.BufferPtr(buffer);
+    m_Context->VSSetConstantBuffers(slot, 1, &b);
+    ++m_Counters.stateChanges;
+}
+
+// D3D11.1이 없으면 버퍼 시작을 바인딩한다 (Init에서 경고)
+inline void D3D11RenderContext::SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes)
+{
+    ID3D11Buffer* b = m_Device.BufferPtr(buffer);
+    if (m_Context1)
+    {
+        UINT first = offset / 16, count = bytes / 16;   // 상수(16바이트) 단위
+        m_Context1->VSSetConstantBuffers1(slot, 1, &b, &first, &count);
+    }
+    else
+    {
+        m_Context->VSSetConstantBuffers(slot, 1, &b);
+    }
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetPSConstantBuffer(uint32_t slot, BufferHandle buffer)
+{
+    ID3D11Buffer* b = m_Device.BufferPtr(buffer);
+    m_Context->PSSetConstantBuffers(slot, 1, &b);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetPSTexture(uint32_t slot, TextureHandle texture)
+{
+    auto* t = m_Device.m_Textures.Get(texture.id);
+    ID3D11ShaderResourceView* srv = t ? t->Get() : nullptr;
+    m_Context->PSSetShaderResources(slot, 1, &srv);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetPSSampler(uint32_t slot, SamplerHandle sampler)
+{
+    auto* s = m_Device.m_Samplers.Get(sampler.id);
+    ID3D11SamplerState* ss = s ? s->Get() : nullptr;
+    m_Context->PSSetSamplers(slot, 1, &ss);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetDepthState(DepthStateHandle state)
+{
+    auto* s = m_Device.m_DepthStates.Get(state.id);
+    m_Context->OMSetDepthStencilState(s ? s->Get() : nullptr, 0);
+    ++m_Counters.stateChanges;
+}
+
+inline void D3D11RenderContext::SetRasterState(RasterStateHandle state)
+{
+    auto* s = m_Device.m_RasterStates.Get(state.id);
+    m_Context->RSSetState(s ? s->Get() : nullptr);
+    ++m_Counters.stateChanges;
+}
+
+inline bool D3D11RenderContext::UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes)
+{
+    ID3D11Buffer* b = m_Device.BufferPtr(buffer);
+    if (!b) return false;
+
+    D3D11_MAPPED_SUBRESOURCE ms{};
+    if (FAILED(m_Context->Map(b, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms))) return false;
+    memcpy(ms.pData, data, bytes);
+    m_Context->Unmap(b, 0);
+    m_Counters.bytesUploaded += bytes;
+    ++m_Counters.maps;
+    return true;
+}
+
+// 지연 컨텍스트는 첫 Map이 DISCARD여야 하는 등 제약이 많아 즉시 컨텍스트에서만 연다
+inline void* D3D11RenderContext::MapBuffer(BufferHandle buffer, MapMode mode)
+{
+    ID3D11Buffer* b = m_Device.BufferPtr(buffer);
+    if (!b || m_Deferred) return nullptr;
+
+    D3D11_MAPPED_SUBRESOURCE ms{};
+    D3D11_MAP type = (mode == MapMode::NoOverwrite) ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
+    if (FAILED(m_Context->Map(b, 0, type, 0, &ms)))
+    {
+        OutputDebugString(L"[D3D] Map FAILED\n");
+        return nullptr;
+    }
+    ++m_Counters.maps;
+    return ms.pData;
+}
+
+inline void D3D11RenderContext::UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten)
+{
+    if (ID3D11Buffer* b = m_Device.BufferPtr(buffer)) m_Context->Unmap(b, 0);
+    m_Counters.bytesUploaded += bytesWritten;
+}
+
+inline void D3D11RenderContext::Draw(uint32_t vertexCount, uint32_t startVertex)
+{
+    BindTargets();
+    m_Context->Draw(vertexCount, startVertex);
+    ++m_Counters.draws;
+    m_Counters.instances += 1;
+    m_Counters.primitives += PrimitiveCount(m_Topology, vertexCount);
+}
+
+inline void D3D11RenderContext::DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
+{
+    BindTargets();
+    m_Context->DrawIndexed(indexCount, startIndex, baseVertex);
+    ++m_Counters.draws;
+    m_Counters.instances += 1;
+    m_Counters.primitives += PrimitiveCount(m_Topology, indexCount);
+}
+
+inline void D3D11RenderContext::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                                     uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+    BindTargets();
+    m_Context->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    ++m_Counters.draws;
+    m_Counters.instances += instanceCount;
+    m_Counters.primitives += PrimitiveCount(m_Topology, indexCount) * instanceCount;
+}
+
+// 지연 컨텍스트가 만든 목록만 받는다. RestoreContextState = FALSE라서 실행 후 즉시 컨텍스트는 기본 상태.
+inline void D3D11RenderContext::ExecuteCommandList(IRenderCommandList& list)
+{
+    D3D11CommandList& l = static_cast<D3D11CommandList&>(list);
+    if (m_Deferred || !l.m_List) return;
+    m_Context->ExecuteCommandList(l.m_List.Get(), FALSE);
+
+    m_Counters.draws += l.m_Counters.draws;
+    m_Counters.instances += l.m_Counters.instances;
+    m_Counters.primitives += l.m_Counters.primitives;
+    m_Counters.stateChanges += l.m_Counters.stateChanges;
+    m_Counters.bytesUploaded += l.m_Counters.bytesUploaded;
+    m_Counters.maps += l.m_Counters.maps;
+}
+
+inline std::unique_ptr<IRenderCommandList> D3D11RenderContext::Finish()
+{
+    if (!m_Deferred) return nullptr;
+
+    auto list = std::make_unique<D3D11CommandList>();
+    if (FAILED(m_Context->FinishCommandList(FALSE, list->m_List.GetAddressOf())))
+        OutputDebugString(L"[D3D] FinishCommandList FAILED\n");
+    list->m_Counters = m_Counters;
+    m_Counters = RenderCounters{};
+    m_TargetsBound = false;
+    return list;
+}
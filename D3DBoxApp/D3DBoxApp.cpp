@@ -1,144 +1,68 @@
-﻿
-#define WIN32_LEAN_AND_MEAN
+﻿#define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
 #include <Windowsx.h>
 
-#include <algorithm>
-#include <vector>
-#include <wrl.h>
-#include <d3d11.h>
-#include <dxgi.h>
-#include <d3dcompiler.h>
+#include <memory>
+#include <string>
 #include <SimpleMath.h>
-#include <WICTextureLoader.h>
-#include <DDSTextureLoader.h>
+
+#include "D3D11RenderDevice.h"
+#include "BoxScene.h"
+#include "SceneScript.h"
+#include "BlockCompress.h"
 
 
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "dxgi.lib")
-#pragma comment(lib, "d3dcompiler.lib")
 //#pragma comment(lib, "DirectXTK.lib")
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
+// 장면 로직은 BoxScene.h (이식 가능), 여기는 창/메시지 루프/D3D11 디바이스와 -bench 같은 Windows 진입점만 둔다.
 
-struct VertexPC
+// 고해상도 대기 타이머 (Windows 10 1803+)로 잠든다. 없으면 Sleep(ms) (타이머 해상도만큼 늦게 깰 수 있다)
+struct Win32FrameClock final : SteadyFrameClock
 {
-    Vector3 pos;
-    Vector3 col;
-};
+    HANDLE m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
 
-struct VertexPT
-{
-    Vector3 pos;
-    Vector2 uv;
-};
+    Win32FrameClock() = default;
+    Win32FrameClock(const Win32FrameClock&) = delete;
+    Win32FrameClock& operator=(const Win32FrameClock&) = delete;
+    ~Win32FrameClock() { if (m_Timer) CloseHandle(m_Timer); }
 
-struct VertexPTN
-{
-    Vector3 pos;
-    Vector2 uv;
-    Vector3 normal;
+    void SleepMicroseconds(int64_t us) override
+    {
+        if (us <= 0) return;
+        LARGE_INTEGER due;
+        due.QuadPart = -us * 10;   // 음수 = 상대 시간, 100 ns 단위
+        if (m_Timer && SetWaitableTimerEx(m_Timer, &due, 0, nullptr, nullptr, nullptr, 0))
+            WaitForSingleObject(m_Timer, INFINITE);
+        else
+            Sleep(DWORD(us / 1000));
+    }
 };
 
-
-struct VertexP  // Skybox용
+// 워커 스레드가 잠든 메시지 루프를 깨울 때 쓰는 자동 리셋 이벤트
+struct Win32WakeEvent
 {
-    Vector3 pos;
-};
+    HANDLE m_Handle = CreateEventW(nullptr, FALSE, FALSE, nullptr);
 
-struct CBVS
-{
-    Matrix gWorld;
-    Matrix gViewProj;
-};
+    Win32WakeEvent() = default;
+    Win32WakeEvent(const Win32WakeEvent&) = delete;
+    Win32WakeEvent& operator=(const Win32WakeEvent&) = delete;
+    ~Win32WakeEvent() { if (m_Handle) CloseHandle(m_Handle); }
 
-// Pixel Shader용 상수 버퍼
-struct CBPS
-{
-    Vector3 lightPos; float lightRange;
-    Vector3 lightColor; float pad;
-    Vector3 eyePos; float specPower;
+    void Signal() { if (m_Handle) SetEvent(m_Handle); }
 };
 
+// Win32 창 하나와 그 장면 (m_WakeEvent는 장면의 워커가 부르므로 m_Scene보다 먼저 선언해 나중에 파괴된다)
 struct App
 {
-    //Direct3D 11의 기본 렌더링 파이프라인 구성요소
-    ComPtr<IDXGISwapChain>           m_SwapChain;
-    ComPtr<ID3D11Device>             m_Device;
-    ComPtr<ID3D11DeviceContext>      m_Context;
-    ComPtr<ID3D11RenderTargetView>   m_RTV;
-    ComPtr<ID3D11Texture2D>          m_DSVTex;
-    ComPtr<ID3D11DepthStencilView>   m_DSV;
-
-    // Shaders / Pipeline
-    ComPtr<ID3D11VertexShader>       m_VSColor;
-    ComPtr<ID3D11PixelShader>        m_PSColor;
-    ComPtr<ID3D11VertexShader>       m_VSTex;
-    ComPtr<ID3D11PixelShader>        m_PSTex;
-    ComPtr<ID3D11InputLayout>        m_InputLayoutColor;
-    ComPtr<ID3D11InputLayout>        m_InputLayoutTex;
-
-    ComPtr<ID3D11Buffer>             m_CBVS; // Vertex Shader용 상수 버퍼
-    ComPtr<ID3D11Buffer>             m_CBPS; // Pixel Shader용 상수 버퍼
-
-    // Skybox
-    ComPtr<ID3D11VertexShader>       m_VSSky;
-    ComPtr<ID3D11PixelShader>        m_PSSky;
-    ComPtr<ID3D11InputLayout>        m_InputLayoutSky;
-    ComPtr<ID3D11Buffer>             m_SkyVB;
-    ComPtr<ID3D11Buffer>             m_SkyIB;
-    ComPtr<ID3D11ShaderResourceView> m_SkySRV;
-    ComPtr<ID3D11SamplerState>       m_SkySampler;
-    ComPtr<ID3D11DepthStencilState>  m_SkyDSS;
-    ComPtr<ID3D11RasterizerState>    m_SkyRS;
-
-    
-    UINT                             m_SkyIndexCount = 0;
-
-    // Texture (Box 전용)
-    ComPtr<ID3D11ShaderResourceView> m_TexSRV;
-    ComPtr<ID3D11SamplerState>       m_Sampler;
-    ComPtr<ID3D11ShaderResourceView> m_TexSRVGrass;
-    ComPtr<ID3D11SamplerState>       m_SamplerGrass;
-
-    // Geometry
-    ComPtr<ID3D11Buffer>             m_GridVB;
-    UINT                             m_GridVertexCount = 0;
-
-    ComPtr<ID3D11Buffer>             m_BoxVB;
-    ComPtr<ID3D11Buffer>             m_BoxIB;
-    ComPtr<ID3D11Buffer>             m_GrassVB;
-    ComPtr<ID3D11Buffer>             m_GrassIB;
-    UINT                             m_BoxIndexCount = 0;
-
-    // Transform
-    Matrix                           m_BoxWorld = Matrix::CreateTranslation(0, -1000, 0);
-
-    // Camera
-    Matrix                           m_View;
-    Matrix                           m_Proj;
-    /*float                            m_CamYaw = XMConvertToRadians(-135.0f);
-    float                            m_CamPitch = XMConvertToRadians(30.0f);*/
-    //
-    // float                            m_CamRadius = 18.0f;
-    float                            m_CamYaw = XMConvertToRadians(-0.0f);
-    float                            m_CamPitch = XMConvertToRadians(0.0f);
-
-    float                            m_CamRadius = 0.0f;
-
-    POINT                            m_LastMouse{ 0,0 };
-    bool                             m_RBtnDown = false;
-
-    // Window / Grid
+    Win32WakeEvent                   m_WakeEvent;   // 리메싱/텍스처 완료 → 메시지 루프 깨우기
+    Win32FrameClock                  m_Clock;
+    BoxScene                         m_Scene{ m_Clock };
     HWND                             m_hWnd = nullptr;
-    UINT                             m_Width = 1280;
-    UINT                             m_Height = 720;
-    float                            m_CellSize = 1.0f;
-    int                              m_HalfCells = 20;
+    uint64_t                         m_TitleCameraVersion = 0;   // 창 제목에 표시한 카메라 버전
 
     bool Init(HWND hWnd)
     {
@@ -146,850 +70,193 @@ struct App
 
         RECT rc;
         GetClientRect(hWnd, &rc);
-        m_Width = rc.right - rc.left;
-        m_Height = rc.bottom - rc.top;
+        m_Scene.m_Width = rc.right - rc.left;
+        m_Scene.m_Height = rc.bottom - rc.top;
+        m_Scene.m_LogSink = [](const char* line) { OutputDebugStringA(line); };
+        m_Scene.m_OnWake = [this] { m_WakeEvent.Signal(); };
 
         // --------------------------------------------------------
-        // 1. SwapChain 설정
+        // 1~3. 디바이스/스왑체인/RTV/DSV (D3D11 백엔드)
         // --------------------------------------------------------
-        DXGI_SWAP_CHAIN_DESC sd{};
-        sd.BufferDesc.Width = m_Width;
-        sd.BufferDesc.Height = m_Height;
-        sd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        sd.SampleDesc.Count = 1;
-        sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-        sd.BufferCount = 2;
-        sd.OutputWindow = hWnd;
-        sd.Windowed = TRUE;
-        sd.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-
-        // --------------------------------------------------------
-        // 2. Direct3D 11 Device 생성 (하드웨어 → WARP 순서로 시도)
-        // --------------------------------------------------------
-        D3D_FEATURE_LEVEL featureLevel{};
-        HRESULT hr = D3D11CreateDeviceAndSwapChain(
-            nullptr,
-            D3D_DRIVER_TYPE_HARDWARE,  // 1순위: GPU 기반
-            nullptr,
-            0,
-            nullptr, 0,
-            D3D11_SDK_VERSION,
-            &sd,
-            m_SwapChain.GetAddressOf(),
-            m_Device.GetAddressOf(),
-            &featureLevel,
-            m_Context.GetAddressOf()
-        );
-
-        if (FAILED(hr))
-        {
-            OutputDebugString(L"[D3D] HARDWARE device creation failed, trying WARP...\n");
-
-            hr = D3D11CreateDeviceAndSwapChain(
-                nullptr,
-                D3D_DRIVER_TYPE_WARP,    // 2순위: CPU 기반 WARP
-                nullptr,
-                0,
-                nullptr, 0,
-                D3D11_SDK_VERSION,
-                &sd,
-                m_SwapChain.GetAddressOf(),
-                m_Device.GetAddressOf(),
-                &featureLevel,
-                m_Context.GetAddressOf()
-            );
-        }
-
-        if (FAILED(hr))
-        {
-            OutputDebugString(L"[D3D] Failed to create any D3D11 device.\n");
-            return false;
-        }
-
-        // --------------------------------------------------------
-        // 3. RTV/DSV 생성
-        // --------------------------------------------------------
-        CreateRTVDSV();
-
-        // --------------------------------------------------------
-        // 4. 셰이더 및 리소스 초기화
-        // --------------------------------------------------------
-        if (!CreateShaders()) return false;
-        if (!CreateSkyShader()) return false;
-
-        CreateConstantBuffer();
-        CreateGridVB();
-        CreateBoxMesh();
-        CreateGrassBoxMesh();
-        CreateSkyMesh();
-        LoadBoxTexture();
-        LoadGrassBoxTexture();
-        LoadSkyTexture();
-        CreateSkyRenderStates();
-
-        // --------------------------------------------------------
-        // 5. 카메라 기본 설정
-        // --------------------------------------------------------
-        m_Proj = Matrix::CreatePerspectiveFieldOfView(
-            XMConvertToRadians(60.0f),
-            float(m_Width) / float(m_Height),
-            0.1f, 1000.0f);
-
-        UpdateView();
-
-        OutputDebugString(L"[D3D] Init complete.\n");
-        return true;
-    }
-
-
-    void CreateRTVDSV()
-    {
-        if (m_Context) m_Context->OMSetRenderTargets(0, nullptr, nullptr);
-        m_RTV.Reset(); m_DSV.Reset(); m_DSVTex.Reset();
-
-        ComPtr<ID3D11Texture2D> backBuffer;
-        m_SwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)backBuffer.GetAddressOf());
-        m_Device->CreateRenderTargetView(backBuffer.Get(), nullptr, m_RTV.GetAddressOf());
-
-        D3D11_TEXTURE2D_DESC td{};
-        td.Width = m_Width;
-        td.Height = m_Height;
-        td.MipLevels = 1;
-        td.ArraySize = 1;
-        td.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-        td.SampleDesc.Count = 1;
-        td.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-        m_Device->CreateTexture2D(&td, nullptr, m_DSVTex.GetAddressOf());
-        m_Device->CreateDepthStencilView(m_DSVTex.Get(), nullptr, m_DSV.GetAddressOf());
-    }
-
-    bool CreateShaders()
-    {
-        ComPtr<ID3DBlob> vsb, psb, err;
-        UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
-#if _DEBUG
-        flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-        // ---- Grid: Color shader ----
-        if (FAILED(D3DCompileFromFile(L"BasicColor.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", flags, 0,
-            vsb.GetAddressOf(), err.GetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreateVertexShader(vsb->GetBufferPointer(), vsb->GetBufferSize(), nullptr, m_VSColor.GetAddressOf());
-
-        if (FAILED(D3DCompileFromFile(L"BasicColor.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", flags, 0,
-            psb.GetAddressOf(), err.ReleaseAndGetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreatePixelShader(psb->GetBufferPointer(), psb->GetBufferSize(), nullptr, m_PSColor.GetAddressOf());
-
-        D3D11_INPUT_ELEMENT_DESC ilColor[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VertexPC, pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "COLOR",    0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VertexPC, col), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
-        m_Device->CreateInputLayout(ilColor, _countof(ilColor),
-            vsb->GetBufferPointer(), vsb->GetBufferSize(),
-            m_InputLayoutColor.GetAddressOf());
-
-        // ---- Box: Texture shader ----
-        if (FAILED(D3DCompileFromFile(L"BasicTex.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", flags, 0,
-            vsb.ReleaseAndGetAddressOf(), err.ReleaseAndGetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreateVertexShader(vsb->GetBufferPointer(), vsb->GetBufferSize(), nullptr, m_VSTex.GetAddressOf());
-
-        if (FAILED(D3DCompileFromFile(L"BasicTex.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", flags, 0,
-            psb.ReleaseAndGetAddressOf(), err.ReleaseAndGetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreatePixelShader(psb->GetBufferPointer(), psb->GetBufferSize(), nullptr, m_PSTex.GetAddressOf());
-
-    /*    D3D11_INPUT_ELEMENT_DESC ilTex[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VertexPT, pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, offsetof(VertexPT, uv),  D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };*/
-    
-        D3D11_INPUT_ELEMENT_DESC ilTexN[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VertexPTN,pos), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, offsetof(VertexPTN,uv),  D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VertexPTN,normal), D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
-
-        m_Device->CreateInputLayout(ilTexN, _countof(ilTexN),
-            vsb->GetBufferPointer(), vsb->GetBufferSize(),
-            m_InputLayoutTex.GetAddressOf());
-
-        return true;
-    }
-
-    bool CreateSkyShader()
-    {
-        ComPtr<ID3DBlob> vsb, psb, err;
-        UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
-#if _DEBUG
-        flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-        // Vertex Shader
-        if (FAILED(D3DCompileFromFile(L"BasicSkyCubeMap.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", flags, 0,
-            vsb.GetAddressOf(), err.GetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreateVertexShader(vsb->GetBufferPointer(), vsb->GetBufferSize(), nullptr, m_VSSky.GetAddressOf());
-
-        // Pixel Shader
-        if (FAILED(D3DCompileFromFile(L"BasicSkyCubeMap.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", flags, 0,
-            psb.GetAddressOf(), err.ReleaseAndGetAddressOf())))
-        {
-            if (err) OutputDebugStringA((char*)err->GetBufferPointer());
-            return false;
-        }
-        m_Device->CreatePixelShader(psb->GetBufferPointer(), psb->GetBufferSize(), nullptr, m_PSSky.GetAddressOf());
-
-        // Input Layout (POSITION only)
-        D3D11_INPUT_ELEMENT_DESC ilSky[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
+        auto device = std::make_unique<D3D11RenderDevice>();
+        if (!device->Init(hWnd, m_Scene.m_Width, m_Scene.m_Height)) return false;
 
-
-        HRESULT hrIL = m_Device->CreateInputLayout(ilSky, _countof(ilSky),
-            vsb->GetBufferPointer(), vsb->GetBufferSize(),
-            m_InputLayoutSky.GetAddressOf());
-
-        if (FAILED(hrIL)) OutputDebugString(L"[Skybox] InputLayout creation FAILED\n");
-        else OutputDebugString(L"[Skybox] InputLayout creation OK\n");
-
-        return true;
+        return m_Scene.InitScene(std::move(device));
     }
 
-
-    void CreateSkyMesh()
+    // 카메라가 바뀐 프레임에만 창 제목의 좌표를 갱신한다
+    void UpdateWindowTitle()
     {
-        float s = 50.0f;
-        VertexP v[8] =
-        {
-            {{-s, -s, -s}}, {{+s, -s, -s}}, {{+s, +s, -s}}, {{-s, +s, -s}},
-            {{-s, -s, +s}}, {{+s, -s, +s}}, {{+s, +s, +s}}, {{-s, +s, +s}},
-        };
-
-        D3D11_BUFFER_DESC vbd{};
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = sizeof(v);
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA vsd{ v, 0, 0 };
-        m_Device->CreateBuffer(&vbd, &vsd, m_SkyVB.GetAddressOf());
-
-        uint16_t idx[] =
-        {
-            0,3,2, 0,2,1,
-            1,2,6, 1,6,5,
-            5,6,7, 5,7,4,
-            4,7,3, 4,3,0,
-            3,7,6, 3,6,2,
-            4,0,1, 4,1,5
-        };
-        m_SkyIndexCount = _countof(idx);
-
-        D3D11_BUFFER_DESC ibd{};
-        ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        ibd.ByteWidth = sizeof(idx);
-        ibd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA isd{ idx, 0, 0 };
-        m_Device->CreateBuffer(&ibd, &isd, m_SkyIB.GetAddressOf());
-    }
-
-    void LoadSkyTexture()
-    {
-        // DDS CubeMap 로드
-        HRESULT hr = CreateDDSTextureFromFile(
-            m_Device.Get(),
-            L"skybox.dds",
-            nullptr,
-            m_SkySRV.GetAddressOf()
-        );
-
-        if (FAILED(hr))
-            OutputDebugString(L"Failed to load CubeMap skybox.dds\n");
-
-        // Cube 샘플러: CLAMP 대신 WRAP을 써도 무방
-        D3D11_SAMPLER_DESC sd{};
-        sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-        sd.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-        sd.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-        sd.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-        sd.ComparisonFunc = D3D11_COMPARISON_NEVER;
-        sd.MaxLOD = D3D11_FLOAT32_MAX;
-        m_Device->CreateSamplerState(&sd, m_SkySampler.GetAddressOf());
-    }
-
-
-    void CreateSkyRenderStates()
-    {
-        D3D11_DEPTH_STENCIL_DESC dsd{};
-        dsd.DepthEnable = TRUE;
-        dsd.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
-        dsd.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
-        m_Device->CreateDepthStencilState(&dsd, m_SkyDSS.GetAddressOf());
-
-
-        D3D11_RASTERIZER_DESC rd{};
-        rd.FillMode = D3D11_FILL_SOLID;
-        rd.CullMode = D3D11_CULL_FRONT;
-        rd.FrontCounterClockwise = TRUE;
-        m_Device->CreateRasterizerState(&rd, m_SkyRS.GetAddressOf());
-    }
-
-
-    void CreateConstantBuffer()
-    {
-        // Vertex Shader용 상수 버퍼
-        D3D11_BUFFER_DESC bd{};
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.ByteWidth = sizeof(CBVS);
-        bd.Usage = D3D11_USAGE_DYNAMIC;
-        bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        m_Device->CreateBuffer(&bd, nullptr, m_CBVS.GetAddressOf());
-
-        // Pixel Shader용 상수 버퍼
-        D3D11_BUFFER_DESC pbd{};
-        pbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        pbd.ByteWidth = sizeof(CBPS);
-        pbd.Usage = D3D11_USAGE_DYNAMIC;
-        pbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        m_Device->CreateBuffer(&pbd, nullptr, m_CBPS.GetAddressOf());
-
-    }
-
-    void CreateGridVB()
-    {
-        const int   N = m_HalfCells;
-        const float s = m_CellSize;
-        const float half = N * s;
-
-        std::vector<VertexPC> v;
-        v.reserve((N * 2 + 1) * 4);
-
-        Vector3 cMajor(1.0f, 1.0f, 1.0f); 
-        Vector3 cMinor(0.7f, 0.7f, 0.7f);
-
-        Vector3 cAxisX(0.8f, 0.2f, 0.2f);
-        Vector3 cAxisZ(0.2f, 0.4f, 0.8f);
-
-        for (int i = -N; i <= N; ++i)
-        {
-            float x = i * s;
-            Vector3 col = (i == 0) ? cAxisZ : ((i % 5 == 0) ? cMajor : cMinor);
-            v.push_back({ Vector3(-half, 0, x), col });
-            v.push_back({ Vector3(+half, 0, x), col });
-
-            float z = i * s;
-            col = (i == 0) ? cAxisX : ((i % 5 == 0) ? cMajor : cMinor);
-            v.push_back({ Vector3(z, 0, -half), col });
-            v.push_back({ Vector3(z, 0, +half), col });
-        }
-
-        m_GridVertexCount = (UINT)v.size();
-
-        D3D11_BUFFER_DESC bd{};
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        bd.ByteWidth = UINT(v.size() * sizeof(VertexPC));
-        bd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA sd{ v.data(), 0, 0 };
-        m_Device->CreateBuffer(&bd, &sd, m_GridVB.GetAddressOf());
-    }
-
-    void CreateBoxMesh()
-    {
-        // 정점 정보
-        Vector3 p[8] =
-        {
-            {-0.5f, 0.0f, -0.5f}, {+0.5f, 0.0f, -0.5f},
-            {+0.5f, 1.0f, -0.5f}, {-0.5f, 1.0f, -0.5f},
-            {-0.5f, 0.0f, +0.5f}, {+0.5f, 0.0f, +0.5f},
-            {+0.5f, 1.0f, +0.5f}, {-0.5f, 1.0f, +0.5f},
-        };
-
-        // UV만 추가
-       /* VertexPT v24[24] =
-        {
-            {p[0], {0,1}}, {p[1], {1,1}}, {p[2], {1,0}}, {p[3], {0,0}},
-            {p[1], {0,1}}, {p[5], {1,1}}, {p[6], {1,0}}, {p[2], {0,0}},
-            {p[5], {0,1}}, {p[4], {1,1}}, {p[7], {1,0}}, {p[6], {0,0}},
-            {p[4], {0,1}}, {p[0], {1,1}}, {p[3], {1,0}}, {p[7], {0,0}},
-            {p[3], {0,1}}, {p[2], {1,1}}, {p[6], {1,0}}, {p[7], {0,0}},
-            {p[4], {0,0}}, {p[5], {1,0}}, {p[1], {1,1}}, {p[0], {0,1}},
-        };*/
-
-        // UV + 노멀 추가
-        VertexPTN v24[24] =
-        {
-            // Front (-Z)
-            {p[0], {0,1}, {0,0,-1}}, {p[1], {1,1}, {0,0,-1}},
-            {p[2], {1,0}, {0,0,-1}}, {p[3], {0,0}, {0,0,-1}},
-
-            // Right (+X)
-            {p[1], {0,1}, {1,0,0}}, {p[5], {1,1}, {1,0,0}},
-            {p[6], {1,0}, {1,0,0}}, {p[2], {0,0}, {1,0,0}},
-
-            // Back (+Z)
-            {p[5], {0,1}, {0,0,1}}, {p[4], {1,1}, {0,0,1}},
-            {p[7], {1,0}, {0,0,1}}, {p[6], {0,0}, {0,0,1}},
-
-            // Left (-X)
-            {p[4], {0,1}, {-1,0,0}}, {p[0], {1,1}, {-1,0,0}},
-            {p[3], {1,0}, {-1,0,0}}, {p[7], {0,0}, {-1,0,0}},
-
-            // Top (+Y)
-            {p[3], {0,1}, {0,1,0}}, {p[2], {1,1}, {0,1,0}},
-            {p[6], {1,0}, {0,1,0}}, {p[7], {0,0}, {0,1,0}},
-
-            // Bottom (-Y)
-            {p[4], {0,0}, {0,-1,0}}, {p[5], {1,0}, {0,-1,0}},
-            {p[1], {1,1}, {0,-1,0}}, {p[0], {0,1}, {0,-1,0}},
-        };
-
-      
-        uint16_t idx[] =
-        {
-            0,1,2, 0,2,3,
-            4,5,6, 4,6,7,
-            8,9,10, 8,10,11,
-            12,13,14, 12,14,15,
-            16,17,18, 16,18,19,
-            20,21,22, 20,22,23
-        };
-
-        m_BoxIndexCount = _countof(idx);
-
-       
-
-        D3D11_BUFFER_DESC vbd{};
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = sizeof(v24);
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA vsd{ v24, 0, 0 };
-        m_Device->CreateBuffer(&vbd, &vsd, m_BoxVB.GetAddressOf());
-
-        D3D11_BUFFER_DESC ibd{};
-        ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        ibd.ByteWidth = sizeof(idx);
-        ibd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA isd{ idx, 0, 0 };
-        m_Device->CreateBuffer(&ibd, &isd, m_BoxIB.GetAddressOf());
-    }
-
-    void CreateGrassBoxMesh()
-    {
-        // 정점 정보
-        Vector3 p[8] =
-        {
-            {-0.5f, 0.0f, -0.5f}, {+0.5f, 0.0f, -0.5f},
-            {+0.5f, 1.0f, -0.5f}, {-0.5f, 1.0f, -0.5f},
-            {-0.5f, 0.0f, +0.5f}, {+0.5f, 0.0f, +0.5f},
-            {+0.5f, 1.0f, +0.5f}, {-0.5f, 1.0f, +0.5f},
-        };
-
-        // UV만 추가
-       /* VertexPT v24[24] =
-        {
-            {p[0], {0,1}}, {p[1], {1,1}}, {p[2], {1,0}}, {p[3], {0,0}},
-            {p[1], {0,1}}, {p[5], {1,1}}, {p[6], {1,0}}, {p[2], {0,0}},
-            {p[5], {0,1}}, {p[4], {1,1}}, {p[7], {1,0}}, {p[6], {0,0}},
-            {p[4], {0,1}}, {p[0], {1,1}}, {p[3], {1,0}}, {p[7], {0,0}},
-            {p[3], {0,1}}, {p[2], {1,1}}, {p[6], {1,0}}, {p[7], {0,0}},
-            {p[4], {0,0}}, {p[5], {1,0}}, {p[1], {1,1}}, {p[0], {0,1}},
-        };*/
-
-        // UV + 노멀 추가
-        VertexPTN v24[24] =
-        {
-            // Front (-Z)
-            {p[0], {0,1}, {0,0,-1}}, {p[1], {1,1}, {0,0,-1}},
-            {p[2], {1,0}, {0,0,-1}}, {p[3], {0,0}, {0,0,-1}},
-
-            // Right (+X)
-            {p[1], {0,1}, {1,0,0}}, {p[5], {1,1}, {1,0,0}},
-            {p[6], {1,0}, {1,0,0}}, {p[2], {0,0}, {1,0,0}},
-
-            // Back (+Z)
-            {p[5], {0,1}, {0,0,1}}, {p[4], {1,1}, {0,0,1}},
-            {p[7], {1,0}, {0,0,1}}, {p[6], {0,0}, {0,0,1}},
-
-            // Left (-X)
-            {p[4], {0,1}, {-1,0,0}}, {p[0], {1,1}, {-1,0,0}},
-            {p[3], {1,0}, {-1,0,0}}, {p[7], {0,0}, {-1,0,0}},
-
-            // Top (+Y)
-            {p[3], {0,1}, {0,1,0}}, {p[2], {1,1}, {0,1,0}},
-            {p[6], {1,0}, {0,1,0}}, {p[7], {0,0}, {0,1,0}},
-
-            // Bottom (-Y)
-            {p[4], {0,0}, {0,-1,0}}, {p[5], {1,0}, {0,-1,0}},
-            {p[1], {1,1}, {0,-1,0}}, {p[0], {0,1}, {0,-1,0}},
-        };
-
-
-        uint16_t idx[] =
-        {
-            0,1,2, 0,2,3,
-            4,5,6, 4,6,7,
-            8,9,10, 8,10,11,
-            12,13,14, 12,14,15,
-            16,17,18, 16,18,19,
-            20,21,22, 20,22,23
-        };
-
-        m_BoxIndexCount = _countof(idx);
-
-
-
-        D3D11_BUFFER_DESC vbd{};
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = sizeof(v24);
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA vsd{ v24, 0, 0 };
-        m_Device->CreateBuffer(&vbd, &vsd, m_GrassVB.GetAddressOf());
-
-        D3D11_BUFFER_DESC ibd{};
-        ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        ibd.ByteWidth = sizeof(idx);
-        ibd.Usage = D3D11_USAGE_IMMUTABLE;
-        D3D11_SUBRESOURCE_DATA isd{ idx, 0, 0 };
-        m_Device->CreateBuffer(&ibd, &isd, m_GrassIB.GetAddressOf());
-    }
-    
-    void LoadBoxTexture()
-    {
-        CreateWICTextureFromFile(
-            m_Device.Get(), m_Context.Get(),
-            L"BoxTexture.png", nullptr, m_TexSRV.GetAddressOf());
-
-        D3D11_SAMPLER_DESC sd{};
-        sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-        sd.AddressU = sd.AddressV = sd.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-        m_Device->CreateSamplerState(&sd, m_Sampler.GetAddressOf());
-    }
-
-    void LoadGrassBoxTexture()
-    {
-        CreateWICTextureFromFile(
-            m_Device.Get(), m_Context.Get(),
-            L"Field_micro04.dds", nullptr, m_TexSRVGrass.GetAddressOf());
-
-        D3D11_SAMPLER_DESC sd{};
-        sd.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-        sd.AddressU = sd.AddressV = sd.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-        m_Device->CreateSamplerState(&sd, m_SamplerGrass.GetAddressOf());
-    }
-
-    void UpdateAndDraw()
-    {
-        float clear[4] = { 0.08f, 0.09f, 0.11f, 1.0f };
-        m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), m_DSV.Get());
-        m_Context->ClearRenderTargetView(m_RTV.Get(), clear);
-        m_Context->ClearDepthStencilView(m_DSV.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-        D3D11_VIEWPORT vp{ 0,0,(FLOAT)m_Width,(FLOAT)m_Height,0,1 };
-        m_Context->RSSetViewports(1, &vp);
-
-        // ---- Skybox ----
-        RenderSkybox();
-
-       // m_Context->ClearDepthStencilView(m_DSV.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-        // ---- Grid ----
-        m_Context->IASetInputLayout(m_InputLayoutColor.Get());
-        m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-        
-        UINT stride = sizeof(VertexPC), offset = 0;
-        
-        m_Context->IASetVertexBuffers(0, 1, m_GridVB.GetAddressOf(), &stride, &offset);
-        m_Context->VSSetShader(m_VSColor.Get(), nullptr, 0);
-        m_Context->PSSetShader(m_PSColor.Get(), nullptr, 0);
-        MapAndSetCB(Matrix::Identity, m_View * m_Proj);
-        m_Context->Draw(m_GridVertexCount, 0);
-
-        // ---- Box ----
-        m_Context->IASetInputLayout(m_InputLayoutTex.Get());
-        m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        
-     /*   stride = sizeof(VertexPT); offset = 0;
-        m_Context->IASetVertexBuffers(0, 1, m_BoxVB.GetAddressOf(), &stride, &offset);*/
-
-        UINT stride2 = sizeof(VertexPTN), offset2 = 0;
-        m_Context->IASetVertexBuffers(0, 1, m_BoxVB.GetAddressOf(), &stride2, &offset2);
-
-        // 카메라 위치 계산
-        float x = m_CamRadius * cosf(m_CamPitch) * cosf(m_CamYaw);
-        float z = m_CamRadius * cosf(m_CamPitch) * sinf(m_CamYaw);
-        float y = m_CamRadius * sinf(m_CamPitch);
-
-        D3D11_MAPPED_SUBRESOURCE ms{};
-        m_Context->Map(m_CBPS.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &ms);
-        auto* cb = reinterpret_cast<CBPS*>(ms.pData);
-        //cb->lightPos = Vector3(4, 6, -3);   // 라이트 위치
-        cb->lightPos = Vector3(x + 2.0f, y + 2.0f, z + 2.0f);   // 라이트 위치
-
-        cb->lightRange = 20.0f;
-        cb->lightColor = Vector3(1, 1, 0.8f);
-        cb->eyePos = Vector3(x, y, z);      // 카메라 위치
-        cb->specPower = 32.0f;
-        m_Context->Unmap(m_CBPS.Get(), 0);
-        m_Context->PSSetConstantBuffers(1, 1, m_CBPS.GetAddressOf());
-
-        m_Context->IASetIndexBuffer(m_BoxIB.Get(), DXGI_FORMAT_R16_UINT, 0);
-        m_Context->VSSetShader(m_VSTex.Get(), nullptr, 0);
-        m_Context->PSSetShader(m_PSTex.Get(), nullptr, 0);
-        m_Context->PSSetShaderResources(0, 1, m_TexSRV.GetAddressOf());
-        m_Context->PSSetSamplers(0, 1, m_Sampler.GetAddressOf());
-        MapAndSetCB(m_BoxWorld, m_View * m_Proj);
-        m_Context->DrawIndexed(m_BoxIndexCount, 0, 0);
-
-        m_SwapChain->Present(1, 0);
-        //m_SwapChain->Present(0, 0); V-Sync Off
-    }
-
-    void RenderSkybox()
-    {
-        if (!m_SkySRV) OutputDebugString(L"[Skybox] SRV NULL\n");
-        if (!m_PSSky) OutputDebugString(L"[Skybox] PixelShader null\n");
-        if (!m_VSSky) OutputDebugString(L"[Skybox] VertexShader null\n");
-        if (!m_InputLayoutSky) OutputDebugString(L"[Skybox] InputLayout null\n");
-
-       
-        // ------------------------------------------
-        // 1. 깊이/래스터라이저 상태 설정
-        // ------------------------------------------
-        m_Context->OMSetDepthStencilState(m_SkyDSS.Get(), 0);
-        m_Context->RSSetState(m_SkyRS.Get());
-
-        // ------------------------------------------
-        // 2. 카메라 변환 (위치 제외)
-        // ------------------------------------------
-        Matrix viewNoTrans = m_View;
-        viewNoTrans._41 = 0.0f;
-        viewNoTrans._42 = 0.0f;
-        viewNoTrans._43 = 0.0f;
-
-        Matrix skyVP = viewNoTrans * m_Proj;
-
-        // ------------------------------------------
-        // 3. 상수 버퍼 업데이트 (월드는 단위행렬)
-        // ------------------------------------------
-        D3D11_MAPPED_SUBRESOURCE mapped{};
-        m_Context->Map(m_CBVS.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-        auto* cb = reinterpret_cast<CBVS*>(mapped.pData);
-        cb->gWorld = Matrix::Identity.Transpose();
-        cb->gViewProj = skyVP.Transpose();
-        m_Context->Unmap(m_CBVS.Get(), 0);
-        m_Context->VSSetConstantBuffers(0, 1, m_CBVS.GetAddressOf());
-
-        // ------------------------------------------
-        // 4. 입력 어셈블러 설정
-        // ------------------------------------------
-        UINT stride = sizeof(VertexP);
-        UINT offset = 0;
-        m_Context->IASetInputLayout(m_InputLayoutSky.Get());
-        m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        m_Context->IASetVertexBuffers(0, 1, m_SkyVB.GetAddressOf(), &stride, &offset);
-        m_Context->IASetIndexBuffer(m_SkyIB.Get(), DXGI_FORMAT_R16_UINT, 0);
-
-        // ------------------------------------------
-        // 5. 셰이더 및 리소스 바인딩
-        // ------------------------------------------
-        m_Context->VSSetShader(m_VSSky.Get(), nullptr, 0);
-        m_Context->PSSetShader(m_PSSky.Get(), nullptr, 0);
-
-        ID3D11ShaderResourceView* srv = m_SkySRV.Get();
-        ID3D11SamplerState* samp = m_SkySampler.Get();
-        m_Context->PSSetShaderResources(0, 1, &srv);
-        m_Context->PSSetSamplers(0, 1, &samp);
-
-        // ------------------------------------------
-        // 6. 실제 드로우 호출
-        // ------------------------------------------
-        m_Context->DrawIndexed(m_SkyIndexCount, 0, 0);
-
-        // ------------------------------------------
-        // 7. 상태 복원
-        // ------------------------------------------
-        m_Context->OMSetDepthStencilState(nullptr, 0);
-        m_Context->RSSetState(nullptr);
-    }
-
-
-    void MapAndSetCB(const Matrix& world, const Matrix& viewProj)
-    {
-        D3D11_MAPPED_SUBRESOURCE ms{};
-        m_Context->Map(m_CBVS.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &ms);
-        auto* cb = reinterpret_cast<CBVS*>(ms.pData);
-        cb->gWorld = world.Transpose();
-        cb->gViewProj = viewProj.Transpose();
-        m_Context->Unmap(m_CBVS.Get(), 0);
-        m_Context->VSSetConstantBuffers(0, 1, m_CBVS.GetAddressOf());
-    }
-
-    void ScreenRay(int mx, int my, Vector3& outOrigin, Vector3& outDir)
-    {
-        float x = (2.0f * mx / float(m_Width)) - 1.0f;
-        float y = 1.0f - (2.0f * my / float(m_Height));
-
-        Matrix invVP = (m_View * m_Proj).Invert();
-        Vector3 nearW = Vector3::Transform(Vector3(x, y, 0.0f), invVP);
-        Vector3 farW = Vector3::Transform(Vector3(x, y, 1.0f), invVP);
-
-        outOrigin = nearW;
-        outDir = (farW - nearW); outDir.Normalize();
-    }
-
-    bool RayHitGround(const Vector3& ro, const Vector3& rd, Vector3& outHit)
-    {
-        if (fabsf(rd.y) < 1e-6f) return false;
-        float t = -ro.y / rd.y;
-        if (t < 0) return false;
-        outHit = ro + rd * t;
-        return true;
-    }
-
-    Vector3 SnapToCellCenter(const Vector3& p)
-    {
-        float s = m_CellSize;
-        float cx = floorf(p.x / s) * s + s * 0.5f;
-        float cz = floorf(p.z / s) * s + s * 0.5f;
-
-        float half = m_HalfCells * s;
-        cx = std::clamp(cx, -half + s * 0.5f, half - s * 0.5f);
-        cz = std::clamp(cz, -half + s * 0.5f, half - s * 0.5f);
-        return { cx, 0.0f, cz };
-    }
-
-    void OnClick(int mx, int my)
-    {
-        Vector3 ro, rd; ScreenRay(mx, my, ro, rd);
-        Vector3 hit;
-        if (RayHitGround(ro, rd, hit))
-        {
-            Vector3 c = SnapToCellCenter(hit);
-            Matrix S = Matrix::CreateScale(m_CellSize, 1.0f, m_CellSize);
-            Matrix T = Matrix::CreateTranslation(c);
-            m_BoxWorld = S * T;
-        }
-    }
-
-    void UpdateView()
-    {
-        m_CamPitch = std::clamp(m_CamPitch, XMConvertToRadians(-89.0f), XMConvertToRadians(89.0f));
-        m_CamRadius = std::clamp(m_CamRadius, 2.0f, 200.0f);
-
-        float x = m_CamRadius * cosf(m_CamPitch) * cosf(m_CamYaw);
-        float z = m_CamRadius * cosf(m_CamPitch) * sinf(m_CamYaw);
-        float y = m_CamRadius * sinf(m_CamPitch);
-
-        m_View = Matrix::CreateLookAt(Vector3(x, y, z), Vector3(0, 0, 0), Vector3(0, 1, 0));
+        if (!m_hWnd || m_TitleCameraVersion == m_Scene.m_Camera.Version()) return;
+        m_TitleCameraVersion = m_Scene.m_Camera.Version();
 
+        const Vec3& eye = m_Scene.m_Camera.Eye();
         wchar_t t[128];
-        swprintf_s(t, L"DX11 Skybox + Grid + Box  |  XYZ: %.2f, %.2f, %.2f", x, y, z);
+        swprintf_s(t, L"DX11 Skybox + Grid + Box  |  XYZ: %.2f, %.2f, %.2f", eye.x, eye.y, eye.z);
         SetWindowText(m_hWnd, t);
     }
+};
 
-    void Resize(UINT w, UINT h)
+static App* g_App = nullptr;
+
+// -bench: CPU 측 벤치마크만 돌리고 종료 (결과는 디버그 출력)
+static void RunBenchmarks()
+{
+    wchar_t t[256];
+    swprintf_s(t, L"[Bench] Frustum cull 1M AABB: %.3f ns/AABB\n", BenchmarkFrustumCull(1000000));
+    OutputDebugString(t);
+
+    MeshReductionReport mr = BuildMeshReductionReport();
+    swprintf_s(t, L"[Bench] Greedy mesh solid chunk: %u verts / %u tris (x%.0f / x%.0f fewer)\n",
+        mr.solid.vertices, mr.solid.triangles, mr.solid.VertexReduction(), mr.solid.TriangleReduction());
+    OutputDebugString(t);
+    swprintf_s(t, L"[Bench] Greedy mesh checkerboard chunk: %u verts / %u tris (x%.2f / x%.2f fewer)\n",
+        mr.checkerboard.vertices, mr.checkerboard.triangles, mr.checkerboard.VertexReduction(), mr.checkerboard.TriangleReduction());
+    OutputDebugString(t);
+
+    ThreadPool pool;
+    OcclusionStats os = BenchmarkOcclusionCull(1024, 1000000, &pool);
+    swprintf_s(t, L"[Bench] Occlusion: %u occluders (%u polys) raster %.1f us, %u tested / %u occluded in %.1f us\n",
+        os.occluders, os.polygons, os.rasterMicroseconds, os.tested, os.occluded, os.testMicroseconds);
+    OutputDebugString(t);
+
+    RadixSortBenchmark rs = BenchmarkRadixSort(1000000);
+    swprintf_s(t, L"[Bench] Radix sort %zu 64-bit keys: %.2f ms (std::stable_sort %.2f ms, x%.1f)%ls\n",
+        rs.count, rs.radixMs, rs.stdSortMs, rs.stdSortMs / rs.radixMs, rs.matches ? L"" : L" MISMATCH");
+    OutputDebugString(t);
+
+    FrameGraphStats fg = BuildFrameGraphReport(1920, 1080);
+    swprintf_s(t, L"[Bench] Frame graph 1080p: %zu passes (%zu culled), %zu transients %.1f MB unaliased -> peak %.1f MB aliased (live bound %.1f MB), compile %.3f ms\n",
+        fg.passes, fg.culled, fg.transients, double(fg.transientBytes) / (1024.0 * 1024.0),
+        double(fg.peakBytes) / (1024.0 * 1024.0), double(fg.liveBytes) / (1024.0 * 1024.0), fg.compileMs);
+    OutputDebugString(t);
+
+    InstancePackBenchmark ip = BenchmarkInstancePack(1000000, [](const float* world, InstanceData& out)
+        {
+            Matrix m;
+            memcpy(&m._11, world, sizeof(float) * 16);
+            Matrix transposed = m.Transpose();
+            memcpy(&out, &transposed._11, sizeof(out));
+        });
+    swprintf_s(t, L"[Bench] Transpose-pack %zu instances: Matrix::Transpose %.2f ms, batched %.2f ms (x%.1f), streaming %.2f ms (x%.1f)%ls\n",
+        ip.count, ip.referenceMs, ip.packMs, ip.referenceMs / ip.packMs, ip.streamMs, ip.referenceMs / ip.streamMs,
+        ip.matches ? L"" : L" MISMATCH");
+    OutputDebugString(t);
+
+    FramePacerReport fp = BuildFramePacerReport();
+    auto pacing = [&](const wchar_t* name, const FramePacerStats& s)
+        {
+            swprintf_s(t, L"[Bench] Pacing %ls (%d simulated frames): avg %.2f ms, min %.2f, max %.2f, %llu missed, late %.3f ms/frame, sleep %.2f + spin %.2f ms/frame\n",
+                name, fp.frames, s.AvgIntervalMs(), s.minIntervalUs / 1000.0, s.maxIntervalUs / 1000.0,
+                (unsigned long long)s.missed, s.lateUs / 1000.0 / fp.frames, s.sleptUs / 1000.0 / fp.frames, s.spunUs / 1000.0 / fp.frames);
+            OutputDebugString(t);
+        };
+    pacing(L"fixed 60 Hz sleep+spin", fp.sleepSpin);
+    pacing(L"fixed 60 Hz sleep only", fp.sleepOnly);
+    pacing(L"uncapped", fp.uncapped);
+
+    NullRenderDevice null;
+    RecordingBenchmark rb = BenchmarkParallelRecording(null, pool, 20000);
+    swprintf_s(t, L"[Bench] Record %zu draws (null backend): serial %.2f ms, %zu command lists %.2f ms (record %.2f + execute %.2f), %llu validation errors%ls\n",
+        rb.items, rb.serialMs, rb.lists, rb.parallelMs, rb.recordMs, rb.executeMs,
+        null.m_Context.m_Counters.validationErrors, rb.matches ? L"" : L" MISMATCH");
+    OutputDebugString(t);
+
+    // 블록 압축: 원본 텍스처의 왼쪽 위 최대 512x512 (High는 느리므로 크기를 묶는다)
+    const wchar_t* sources[] = { L"BoxTexture.png", L"Field_micro04.dds" };
+    for (const wchar_t* path : sources)
     {
-        if (!m_Device) return;
-        m_Width = w; m_Height = h;
-        m_Context->OMSetRenderTargets(0, nullptr, nullptr);
-        m_RTV.Reset(); m_DSV.Reset(); m_DSVTex.Reset();
-        m_SwapChain->ResizeBuffers(0, w, h, DXGI_FORMAT_UNKNOWN, 0);
-        CreateRTVDSV();
-        m_Proj = Matrix::CreatePerspectiveFieldOfView(
-            XMConvertToRadians(60.0f),
-            float(w) / float(h), 0.1f, 1000.0f);
+        ImageSet set;
+        if (!LoadImageFile(path, set)) continue;
+        const Image& full = set.Surface(0, 0);
+        Image img;
+        img.width = std::min<uint32_t>(full.width, 512);
+        img.height = std::min<uint32_t>(full.height, 512);
+        img.rgba.resize(size_t(img.width) * img.height * 4);
+        for (uint32_t y = 0; y < img.height; ++y)
+            memcpy(img.Pixel(0, y), full.Pixel(0, y), size_t(img.width) * 4);
+
+        for (BlockFormat format : { BlockFormat::BC1, BlockFormat::BC7 })
+            for (BlockQuality quality : { BlockQuality::Fast, BlockQuality::Normal, BlockQuality::High })
+            {
+                BlockCompressOptions options;
+                options.format = format;
+                options.quality = quality;
+                BlockCompressBenchmark bc = BenchmarkBlockCompress(img, options, &pool, 1);
+                swprintf_s(t, L"[Bench] %ls %ux%u %ls %ls: scalar %.1f MP/s, SIMD %.1f MP/s, %zu threads %.1f MP/s, PSNR %.2f dB%ls\n",
+                    path, img.width, img.height, BlockFormatName(format), BlockQualityName(quality),
+                    bc.megapixels / (bc.scalarMs / 1000.0), bc.megapixels / (bc.simdMs / 1000.0),
+                    pool.m_Workers.size() + 1, bc.megapixels / (bc.threadedMs / 1000.0), bc.psnr, bc.matches ? L"" : L" MISMATCH");
+                OutputDebugString(t);
+            }
     }
-};
+}
 
-static App* g_App = nullptr;
+// -headless / -softrender 결과 (SceneScript.h)
+static void DebugLog(const char* line) { OutputDebugStringA(line); }
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
     switch (msg)
     {
+    case WM_PAINT:   // 가려졌다 드러난 영역은 다음 프레임에 다시 그린다
+        ValidateRect(hWnd, nullptr);
+        if (g_App) g_App->m_Scene.Invalidate();
+        return 0;
+
     case WM_SIZE:
         if (g_App && wParam != SIZE_MINIMIZED)
         {
-            g_App->Resize(LOWORD(lParam), HIWORD(lParam));
+            g_App->m_Scene.Resize(LOWORD(lParam), HIWORD(lParam));
         }
         break;
 
     case WM_LBUTTONDOWN:
-        if (g_App)
-        {
-            int mx = GET_X_LPARAM(lParam);
-            int my = GET_Y_LPARAM(lParam);
-            g_App->OnClick(mx, my);
-        }
+        if (g_App) g_App->m_Scene.m_Input.Click(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam), (wParam & MK_CONTROL) != 0);
         break;
 
     case WM_RBUTTONDOWN:
         if (g_App)
         {
-            g_App->m_RBtnDown = true;
             SetCapture(hWnd);
-            g_App->m_LastMouse.x = GET_X_LPARAM(lParam);
-            g_App->m_LastMouse.y = GET_Y_LPARAM(lParam);
+            g_App->m_Scene.m_Input.BeginDrag(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
         }
         break;
 
     case WM_RBUTTONUP:
         if (g_App)
         {
-            g_App->m_RBtnDown = false;
+            g_App->m_Scene.m_Input.EndDrag();
             ReleaseCapture();
         }
         break;
 
+    // 마우스 입력은 쌓기만 한다 (적용은 프레임 시작의 ApplyInput)
     case WM_MOUSEMOVE:
-        if (g_App && g_App->m_RBtnDown)
-        {
-            int mx = GET_X_LPARAM(lParam);
-            int my = GET_Y_LPARAM(lParam);
-            float dx = float(mx - g_App->m_LastMouse.x) * 0.005f;
-            float dy = float(my - g_App->m_LastMouse.y) * 0.005f;
-            g_App->m_CamYaw += dx;
-            g_App->m_CamPitch -= dy;
-            g_App->m_LastMouse.x = mx;
-            g_App->m_LastMouse.y = my;
-            g_App->UpdateView();
-        }
+        if (g_App) g_App->m_Scene.m_Input.MouseMove(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
         break;
 
     case WM_MOUSEWHEEL:
-        if (g_App)
-        {
-            int delta = GET_WHEEL_DELTA_WPARAM(wParam);
-            g_App->m_CamRadius *= (delta > 0) ? 0.9f : 1.1f;
-            g_App->UpdateView();
-        }
+        if (g_App) g_App->m_Scene.m_Input.Wheel(GET_WHEEL_DELTA_WPARAM(wParam));
         break;
 
     case WM_MBUTTONDOWN:  //Wheel 클릭
+        if (g_App) g_App->m_Scene.m_Input.Click(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam), (wParam & MK_CONTROL) != 0);
+        break;
+
+    case WM_KEYDOWN:
         if (g_App)
         {
-            g_App->m_LastMouse.x = GET_X_LPARAM(lParam);
-            g_App->m_LastMouse.y = GET_Y_LPARAM(lParam);
-            g_App->OnClick(g_App->m_LastMouse.x, g_App->m_LastMouse.y);
+            if (wParam == '1' || wParam == '2') g_App->m_Scene.m_CurrentMaterial = uint8_t(wParam - '0');
+            if (wParam == 'P') g_App->m_Scene.m_ParallelRecord = !g_App->m_Scene.m_ParallelRecord;
+            if (wParam == 'V') g_App->m_Scene.CyclePacingMode();
+            if (wParam == 'M')
+            {
+                g_App->m_Scene.m_RenderMode = (g_App->m_Scene.m_RenderMode == BoxScene::BoxRenderMode::Instanced)
+                    ? BoxScene::BoxRenderMode::ChunkMesh : BoxScene::BoxRenderMode::Instanced;
+                g_App->m_Scene.Invalidate();
+            }
+            if (wParam == 'R') g_App->m_Scene.ToggleOnDemand();
         }
         break;
 
@@ -1009,6 +276,29 @@ int WINAPI wWinMain(
     _In_ int nCmdShow
 )
 {
+    if (lpCmdLine && wcsstr(lpCmdLine, L"-bench"))
+    {
+        RunBenchmarks();
+        return 0;
+    }
+    if (lpCmdLine && wcsstr(lpCmdLine, L"-headless"))
+    {
+        return RunHeadless(DebugLog) ? 0 : 1;
+    }
+    if (const wchar_t* arg = lpCmdLine ? wcsstr(lpCmdLine, L"-softrender") : nullptr)
+    {
+        // 다음 인자가 있으면 출력 경로
+        std::wstring path = L"softrender.png";
+        const wchar_t* p = arg + wcslen(L"-softrender");
+        while (*p == L' ') ++p;
+        if (*p && *p != L'-')
+        {
+            path.clear();
+            while (*p && *p != L' ') path += *p++;
+        }
+        return RunSoftRender(path.c_str(), DebugLog) ? 0 : 1;
+    }
+
     WNDCLASSEX wc{ sizeof(WNDCLASSEX) };
     wc.hInstance = hInstance;
     wc.lpszClassName = L"DX11_SkyboxGridBox";
@@ -1029,19 +319,42 @@ int WINAPI wWinMain(
 
     App app; g_App = &app;
     if (!app.Init(hWnd)) return -1;
+    BoxScene& scene = app.m_Scene;
 
+    // 쌓인 메시지를 모두 처리한 뒤 (입력은 m_Input에 모였다가 ApplyInput에서 한 번에 적용) 바뀐 것이 있을 때만 그린다
     MSG msg{};
-    while (msg.message != WM_QUIT)
+    auto pumpMessages = [&msg]
+        {
+            while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+            {
+                if (msg.message == WM_QUIT) return false;
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+            return true;
+        };
+
+    for (;;)
     {
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
-        {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }
-        else
+        if (!pumpMessages()) return int(msg.wParam);
+        scene.ApplyInput();
+        scene.BeginFrame();
+
+        // 바뀐 것이 없으면 그리지 않고, 메시지나 리메싱 완료 신호가 올 때까지 잠든다 (CPU/GPU 0%)
+        if (!scene.NeedsRedraw())
         {
-            app.UpdateAndDraw();
+            ++scene.m_FramesSkipped;
+            scene.m_Pacer.Pause();
+            MsgWaitForMultipleObjectsEx(1, &app.m_WakeEvent.m_Handle, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            continue;
         }
+
+        // 그리는 프레임만 페이서가 시작을 정한다.
+        // 기다리는 동안 (LowLatency면 스왑체인 대기) 들어온 입력은 그리기 직전에 한 번 더 모아 입력-화면 지연을 줄인다
+        scene.m_Pacer.BeginFrame(scene.m_Device.get());
+        if (!pumpMessages()) return int(msg.wParam);
+        scene.ApplyInput();
+        scene.UpdateAndDraw();
+        app.UpdateWindowTitle();
     }
-    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,341 @@
+﻿#pragma once
+
+// 프레임 그래프 (Windows/D3D 의존성 없음)
+// - AddPass(): setup에서 패스가 만들고(Create) 읽고(Read) 쓰는(Write) 리소스를 선언하고, execute는 Execute() 때 호출된다.
+// - Compile(): 참조 계수로 최종 결과에 기여하지 않는 패스를 컬링하고, 남은 패스를 선언 순서대로 실행 순서로 삼는다.
+//   임시(transient) 리소스는 실행 순서상 [첫 사용, 마지막 사용] 수명을 구해, 수명이 겹치지 않는 것끼리 같은 힙 구간을 나눠 쓴다.
+// - Import()한 리소스 (백버퍼/깊이)는 그래프 밖에서 살아 있으므로 앨리어싱하지 않고, 여기에 쓰는 패스는 컬링하지 않는다.
+// - 배치는 힙 오프셋 계획까지만 한다. 실제 타깃 생성은 오프셋을 받아 백엔드가 한다 (디바이스에 오프스크린 타깃 API가 아직 없음).
+// - 그래프는 프레임마다 Reset() 후 다시 선언한다. 노드/패스 벡터는 재사용된다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "RenderDevice.h"
+
+enum class FGFormat : uint8_t { RGBA8, RGBA16F, R11G11B10F, R16F, D24S8, D32F };
+
+inline uint32_t FGBytesPerPixel(FGFormat format)
+{
+    switch (format)
+    {
+    case FGFormat::RGBA16F: return 8;
+    case FGFormat::R16F:    return 2;
+    default:                return 4;
+    }
+}
+
+struct FGTextureDesc
+{
+    uint32_t width = 0, height = 0;
+    FGFormat format = FGFormat::RGBA8;
+
+    uint64_t Bytes() const { return uint64_t(width) * height * FGBytesPerPixel(format); }
+};
+
+using FrameGraphResource = RenderHandle<struct FrameGraphResourceTag>;   // id = 리소스 인덱스 + 1
+
+struct FrameGraphStats
+{
+    size_t   passes = 0;           // 선언된 패스
+    size_t   culled = 0;
+    size_t   transients = 0;       // 살아남은 임시 리소스
+    uint64_t transientBytes = 0;   // 앨리어싱 없이 따로 잡았을 때 (정렬 포함)
+    uint64_t peakBytes = 0;        // 앨리어싱한 힙 크기 = 프레임의 임시 메모리 최고치
+    uint64_t liveBytes = 0;        // 한 시점에 동시에 살아 있는 최대 합 (배치의 하한)
+    double   compileMs = 0.0;
+};
+
+struct FrameGraph
+{
+    static constexpr uint64_t HEAP_ALIGNMENT = 64 * 1024;   // D3D 리소스 배치 정렬
+    static constexpr uint32_t NO_PASS = UINT32_MAX;
+
+    struct ResourceNode
+    {
+        std::string           name;
+        FGTextureDesc         desc;
+        bool                  imported = false;
+        std::vector<uint32_t> writers;                // 만들거나 쓰는 패스
+        uint32_t              refCount = 0;           // 읽는 (컬링되지 않은) 패스 수
+        uint32_t              firstUse = NO_PASS;     // 실행 순서 인덱스
+        uint32_t              lastUse = 0;
+        uint64_t              heapOffset = 0;
+
+        uint64_t AlignedBytes() const { return (desc.Bytes() + HEAP_ALIGNMENT - 1) / HEAP_ALIGNMENT * HEAP_ALIGNMENT; }
+        bool     Alive() const { return firstUse != NO_PASS; }
+    };
+
+    struct PassNode
+    {
+        std::string                          name;
+        std::vector<uint32_t>                reads, writes;   // writes는 Create 포함
+        bool                                 sideEffect = false;
+        uint32_t                             refCount = 0;    // 살아 있는 출력 수
+        bool                                 culled = false;
+        std::function<void(IRenderContext&)> execute;
+    };
+
+    // setup 람다에 넘겨져서 현재 패스의 입출력을 선언한다
+    struct Builder
+    {
+        FrameGraph& graph;
+        uint32_t    pass;
+
+        FrameGraphResource Create(const char* name, const FGTextureDesc& desc)
+        {
+            FrameGraphResource r = graph.AddResource(name, desc, false);
+            return Write(r);
+        }
+
+        FrameGraphResource Read(FrameGraphResource r)
+        {
+            if (r) graph.m_Passes[pass].reads.push_back(r.id - 1);
+            return r;
+        }
+
+        FrameGraphResource Write(FrameGraphResource r)
+        {
+            if (!r) return r;
+            ResourceNode& node = graph.m_Resources[r.id - 1];
+            node.writers.push_back(pass);
+            graph.m_Passes[pass].writes.push_back(r.id - 1);
+            if (node.imported) graph.m_Passes[pass].sideEffect = true;   // 그래프 밖에서 보는 결과
+            return r;
+        }
+
+        // 출력이 읽히지 않아도 실행해야 하는 패스 (리드백, 디버그 출력 등)
+        void SideEffect() { graph.m_Passes[pass].sideEffect = true; }
+    };
+
+    std::vector<ResourceNode> m_Resources;
+    std::vector<PassNode>     m_Passes;
+    std::vector<uint32_t>     m_Schedule;   // 실행할 패스 인덱스 (순서대로)
+    FrameGraphStats           m_Stats;
+
+    void Reset()
+    {
+        m_Resources.clear();
+        m_Passes.clear();
+        m_Schedule.clear();
+    }
+
+    FrameGraphResource AddResource(const char* name, const FGTextureDesc& desc, bool imported)
+    {
+        ResourceNode node;
+        node.name = name;
+        node.desc = desc;
+        node.imported = imported;
+        m_Resources.push_back(std::move(node));
+        return { uint32_t(m_Resources.size()) };
+    }
+
+    // 그래프 밖에서 관리하는 리소스 (백버퍼 등)
+    FrameGraphResource Import(const char* name, const FGTextureDesc& desc) { return AddResource(name, desc, true); }
+
+    template <typename Setup>
+    void AddPass(const char* name, Setup&& setup, std::function<void(IRenderContext&)> execute)
+    {
+        PassNode node;
+        node.name = name;
+        node.execute = std::move(execute);
+        m_Passes.push_back(std::move(node));
+        Builder builder{ *this, uint32_t(m_Passes.size() - 1) };
+        setup(builder);
+    }
+
+    void Compile()
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+
+        // 1) 참조 계수 컬링: 아무도 읽지 않는 리소스에서 시작해, 그것만 쓰던 패스와 그 패스만 읽던 리소스를 차례로 지운다
+        for (PassNode& p : m_Passes)
+        {
+            p.refCount = uint32_t(p.writes.size());
+            p.culled = false;
+        }
+        for (ResourceNode& r : m_Resources)
+        {
+            r.refCount = 0;
+            r.firstUse = NO_PASS;
+            r.lastUse = 0;
+            r.heapOffset = 0;
+        }
+        for (const PassNode& p : m_Passes)
+            for (uint32_t r : p.reads) ++m_Resources[r].refCount;
+
+        std::vector<uint32_t> unused;
+        for (uint32_t r = 0; r < m_Resources.size(); ++r)
+            if (m_Resources[r].refCount == 0) unused.push_back(r);
+
+        while (!unused.empty())
+        {
+            uint32_t r = unused.back();
+            unused.pop_back();
+            for (uint32_t w : m_Resources[r].writers)
+            {
+                PassNode& p = m_Passes[w];
+                if (p.culled || p.sideEffect || p.refCount == 0 || --p.refCount > 0) continue;
+                p.culled = true;
+                for (uint32_t read : p.reads)
+                    if (--m_Resources[read].refCount == 0) unused.push_back(read);
+            }
+        }
+
+        // 2) 실행 순서 (선언 순서가 곧 의존 순서) 와 리소스 수명
+        m_Schedule.clear();
+        for (uint32_t p = 0; p < m_Passes.size(); ++p)
+        {
+            if (m_Passes[p].culled) continue;
+            uint32_t order = uint32_t(m_Schedule.size());
+            m_Schedule.push_back(p);
+            auto touch = [&](uint32_t r)
+            {
+                ResourceNode& node = m_Resources[r];
+                node.firstUse = std::min(node.firstUse, order);
+                node.lastUse = std::max(node.lastUse, order);
+            };
+            for (uint32_t r : m_Passes[p].reads) touch(r);
+            for (uint32_t r : m_Passes[p].writes) touch(r);
+        }
+
+        // 3) 앨리어싱: 큰 것부터, 수명이 겹치는 이미 배치된 리소스와 안 겹치는 가장 낮은 오프셋 (first-fit)
+        std::vector<uint32_t> transients;
+        for (uint32_t r = 0; r < m_Resources.size(); ++r)
+            if (!m_Resources[r].imported && m_Resources[r].Alive()) transients.push_back(r);
+        std::stable_sort(transients.begin(), transients.end(), [&](uint32_t a, uint32_t b)
+        {
+            return m_Resources[a].AlignedBytes() > m_Resources[b].AlignedBytes();
+        });
+
+        m_Stats = FrameGraphStats{};
+        m_Stats.passes = m_Passes.size();
+        m_Stats.culled = m_Passes.size() - m_Schedule.size();
+        m_Stats.transients = transients.size();
+
+        std::vector<uint32_t> overlapping;
+        for (size_t i = 0; i < transients.size(); ++i)
+        {
+            ResourceNode& node = m_Resources[transients[i]];
+            const uint64_t size = node.AlignedBytes();
+            m_Stats.transientBytes += size;
+
+            overlapping.clear();
+            for (size_t j = 0; j < i; ++j)
+            {
+                const ResourceNode& other = m_Resources[transients[j]];
+                if (other.firstUse <= node.lastUse && node.firstUse <= other.lastUse) overlapping.push_back(transients[j]);
+            }
+
+            // 후보: 0과 겹치는 리소스들의 끝. 후보 구간이 아무것과도 안 겹치면 배치
+            uint64_t best = UINT64_MAX;
+            auto fits = [&](uint64_t offset)
+            {
+                for (uint32_t o : overlapping)
+                {
+                    const ResourceNode& other = m_Resources[o];
+                    if (offset < other.heapOffset + other.AlignedBytes() && other.heapOffset < offset + size) return false;
+                }
+                return true;
+            };
+            if (fits(0)) best = 0;
+            for (uint32_t o : overlapping)
+            {
+                uint64_t candidate = m_Resources[o].heapOffset + m_Resources[o].AlignedBytes();
+                if (candidate < best && fits(candidate)) best = candidate;
+            }
+            node.heapOffset = best;
+            m_Stats.peakBytes = std::max(m_Stats.peakBytes, best + size);
+        }
+
+        for (uint32_t s = 0; s < m_Schedule.size(); ++s)
+        {
+            uint64_t live = 0;
+            for (uint32_t r : transients)
+                if (m_Resources[r].firstUse <= s && s <= m_Resources[r].lastUse) live += m_Resources[r].AlignedBytes();
+            m_Stats.liveBytes = std::max(m_Stats.liveBytes, live);
+        }
+
+        m_Stats.compileMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+
+    void Execute(IRenderContext& ctx) const
+    {
+        for (uint32_t p : m_Schedule)
+            if (m_Passes[p].execute) m_Passes[p].execute(ctx);
+    }
+};
+
+// 리포트: 지연 셰이딩 + 블룸 체인 모양의 가상 그래프를 컴파일해 컬링/앨리어싱 결과를 본다 (execute는 비어 있음).
+// 쓰이지 않는 디버그 패스 하나가 컬링돼야 한다.
+inline FrameGraphStats BuildFrameGraphReport(uint32_t width, uint32_t height)
+{
+    FrameGraph g;
+    FrameGraphResource backBuffer = g.Import("BackBuffer", { width, height, FGFormat::RGBA8 });
+
+    FrameGraphResource shadow, albedo, normal, depth, ao, hdr, debug;
+    g.AddPass("Shadow", [&](FrameGraph::Builder& b) { shadow = b.Create("ShadowMap", { 2048, 2048, FGFormat::D32F }); }, nullptr);
+    g.AddPass("GBuffer", [&](FrameGraph::Builder& b)
+    {
+        albedo = b.Create("Albedo", { width, height, FGFormat::RGBA8 });
+        normal = b.Create("Normal", { width, height, FGFormat::RGBA16F });
+        depth = b.Create("Depth", { width, height, FGFormat::D24S8 });
+    }, nullptr);
+    g.AddPass("SSAO", [&](FrameGraph::Builder& b)
+    {
+        b.Read(normal);
+        b.Read(depth);
+        ao = b.Create("AO", { width / 2, height / 2, FGFormat::R16F });
+    }, nullptr);
+    g.AddPass("Lighting", [&](FrameGraph::Builder& b)
+    {
+        b.Read(albedo);
+        b.Read(normal);
+        b.Read(depth);
+        b.Read(shadow);
+        b.Read(ao);
+        hdr = b.Create("HDR", { width, height, FGFormat::RGBA16F });
+    }, nullptr);
+    g.AddPass("DebugNormals", [&](FrameGraph::Builder& b)
+    {
+        b.Read(normal);
+        debug = b.Create("DebugView", { width, height, FGFormat::RGBA8 });
+    }, nullptr);
+
+    // 블룸: 1/2 ~ 1/16로 내려갔다가 다시 1/2까지 올라온다
+    static const char* DOWN[] = { "BloomDown2", "BloomDown4", "BloomDown8", "BloomDown16" };
+    static const char* UP[] = { "BloomUp8", "BloomUp4", "BloomUp2" };
+    FrameGraphResource down[4], prev = hdr;
+    for (int i = 0; i < 4; ++i)
+    {
+        g.AddPass(DOWN[i], [&](FrameGraph::Builder& b)
+        {
+            b.Read(prev);
+            down[i] = b.Create(DOWN[i], { width >> (i + 1), height >> (i + 1), FGFormat::R11G11B10F });
+        }, nullptr);
+        prev = down[i];
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        g.AddPass(UP[i], [&](FrameGraph::Builder& b)
+        {
+            b.Read(prev);
+            b.Read(down[2 - i]);
+            prev = b.Create(UP[i], { width >> (3 - i), height >> (3 - i), FGFormat::R11G11B10F });
+        }, nullptr);
+    }
+
+    g.AddPass("Tonemap", [&](FrameGraph::Builder& b)
+    {
+        b.Read(hdr);
+        b.Read(prev);
+        b.Write(backBuffer);
+    }, nullptr);
+
+    g.Compile();
+    return g.m_Stats;
+}
@@ -0,0 +1,95 @@
+﻿#pragma once
+
+// 프레임 단위 입력 누적 (Windows/D3D 의존성 없음)
+// - WndProc는 이벤트를 FrameInput에 쌓기만 하고, 프레임 시작에 TakeFrame()으로 한 번에 꺼내 적용한다.
+// - 드래그 이동은 픽셀 델타 합, 휠은 방향별 노치 수 합, 클릭은 들어온 순서대로 모은다.
+// - 폴링 레이트가 높은 마우스라도 카메라/피킹은 프레임마다 한 번만 갱신된다.
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct InputClick
+{
+    int  x = 0;
+    int  y = 0;
+    bool erase = false;   // Ctrl + 클릭 = 제거
+};
+
+// 한 프레임 동안 쌓인 입력
+struct FrameInputState
+{
+    int                     dragDx = 0;       // 오른쪽 버튼 드래그 픽셀 합
+    int                     dragDy = 0;
+    int                     wheelSteps = 0;   // 양수 = 앞으로 (줌 인), 이벤트 하나 = 한 칸
+    std::vector<InputClick> clicks;
+    uint32_t                events = 0;       // 누적한 이벤트 수
+
+    bool Empty() const { return events == 0; }
+
+    // 용량은 남겨 둔다 (프레임마다 재할당하지 않도록)
+    void Clear()
+    {
+        dragDx = dragDy = wheelSteps = 0;
+        clicks.clear();
+        events = 0;
+    }
+};
+
+struct FrameInput
+{
+    FrameInputState m_Pending;
+    bool            m_Dragging = false;
+    int             m_LastX = 0;
+    int             m_LastY = 0;
+    uint64_t        m_TotalEvents = 0;
+    uint64_t        m_TotalFrames = 0;   // 입력이 있었던 프레임 수
+
+    void BeginDrag(int x, int y)
+    {
+        m_Dragging = true;
+        m_LastX = x;
+        m_LastY = y;
+        ++m_Pending.events;
+    }
+
+    void EndDrag()
+    {
+        m_Dragging = false;
+        ++m_Pending.events;
+    }
+
+    void MouseMove(int x, int y)
+    {
+        if (!m_Dragging) return;
+        m_Pending.dragDx += x - m_LastX;
+        m_Pending.dragDy += y - m_LastY;
+        m_LastX = x;
+        m_LastY = y;
+        ++m_Pending.events;
+    }
+
+    void Wheel(int delta)
+    {
+        m_Pending.wheelSteps += (delta > 0) ? 1 : -1;
+        ++m_Pending.events;
+    }
+
+    void Click(int x, int y, bool erase)
+    {
+        m_Pending.clicks.push_back({ x, y, erase });
+        ++m_Pending.events;
+    }
+
+    // 쌓인 입력을 out으로 넘기고 비운다 (out의 이전 내용은 버린다)
+    void TakeFrame(FrameInputState& out)
+    {
+        std::swap(out, m_Pending);
+        m_Pending.Clear();
+        if (!out.Empty())
+        {
+            m_TotalEvents += out.events;
+            ++m_TotalFrames;
+        }
+    }
+};
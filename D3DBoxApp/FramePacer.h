@@ -0,0 +1,227 @@
+﻿#pragma once
+
+// 프레임 페이싱 (Windows/D3D 의존성 없음)
+// - VSync:      Present(1). 기다림은 스왑체인에 맡긴다.
+// - Uncapped:   Present(0). 기다리지 않는다.
+// - FixedRate:  목표 간격의 마감 시각 m_SpinUs 전까지 잠들고 (sleep), 나머지는 스핀해서 맞춘다. Present(0).
+//               한 간격 넘게 늦으면 밀린 프레임을 몰아서 그리지 않고 기준을 지금으로 다시 잡는다.
+// - LowLatency: 프레임 시작 전(입력을 읽기 전)에 스왑체인의 프레임 지연 대기 객체를 기다린다. Present(1).
+//               백엔드가 지원하지 않으면 VSync와 같다.
+// - 시간은 IFrameClock으로만 읽고 기다리므로, SimulatedFrameClock으로 결정적으로 검증할 수 있다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "RenderDevice.h"
+
+enum class PacingMode : uint8_t { VSync, Uncapped, FixedRate, LowLatency };
+
+inline const wchar_t* PacingModeName(PacingMode mode)
+{
+    switch (mode)
+    {
+    case PacingMode::VSync:      return L"vsync";
+    case PacingMode::Uncapped:   return L"uncapped";
+    case PacingMode::FixedRate:  return L"fixed-rate";
+    case PacingMode::LowLatency: return L"low-latency";
+    }
+    return L"?";
+}
+
+struct IFrameClock
+{
+    virtual ~IFrameClock() = default;
+
+    virtual int64_t NowMicroseconds() = 0;
+    virtual void    SleepMicroseconds(int64_t us) = 0;   // 대략적인 대기 (더 자는 것은 허용)
+    virtual void    SpinPause() = 0;                     // 스핀 대기 한 번
+};
+
+// std::chrono 시계 + sleep_for (해상도는 OS 타이머에 따른다)
+struct SteadyFrameClock : IFrameClock
+{
+    int64_t NowMicroseconds() override
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void SleepMicroseconds(int64_t us) override
+    {
+        if (us > 0) std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+    void SpinPause() override { std::this_thread::yield(); }
+};
+
+// 검증용 시계: 시간은 Advance/Sleep/SpinPause로만 흐른다.
+// sleep은 OS 타이머 해상도를 흉내 내서 0 ~ m_SleepSlackUs만큼 (결정적 의사 난수로) 더 잔다.
+struct SimulatedFrameClock final : IFrameClock
+{
+    int64_t  m_Now = 0;
+    int64_t  m_SleepSlackUs = 1000;
+    int64_t  m_SpinStepUs = 1;
+    uint32_t m_Seed = 12345;
+
+    void Advance(int64_t us) { m_Now += us; }
+
+    int64_t NowMicroseconds() override { return m_Now; }
+
+    void SleepMicroseconds(int64_t us) override
+    {
+        if (us <= 0) return;
+        m_Seed = m_Seed * 1664525u + 1013904223u;
+        m_Now += us + int64_t((m_Seed >> 8) % uint32_t(m_SleepSlackUs + 1));
+    }
+
+    void SpinPause() override { m_Now += m_SpinStepUs; }
+};
+
+struct FramePacerStats
+{
+    uint64_t frames = 0;
+    uint64_t missed = 0;            // FixedRate: 마감을 한 간격 넘게 놓쳐 기준을 다시 잡은 횟수
+    int64_t  lateUs = 0;            // FixedRate: 마감보다 늦게 시작한 시간 합 (sleep 오차가 그대로 드러난다)
+    int64_t  sleptUs = 0;
+    int64_t  spunUs = 0;
+    uint64_t intervals = 0;         // 간격을 잰 프레임 수 (첫 프레임과 쉬고 난 첫 프레임 제외)
+    int64_t  totalIntervalUs = 0;   // 프레임 시작 간격 합
+    int64_t  minIntervalUs = INT64_MAX;
+    int64_t  maxIntervalUs = 0;
+
+    double AvgIntervalMs() const { return intervals ? double(totalIntervalUs) / double(intervals) / 1000.0 : 0.0; }
+};
+
+struct FramePacer
+{
+    IFrameClock*    m_Clock;
+    PacingMode      m_Mode = PacingMode::VSync;
+    int64_t         m_IntervalUs = 16667;      // FixedRate 목표 간격
+    int64_t         m_SpinUs = 2000;           // 마감 전 이만큼은 sleep 대신 스핀 (sleep 오차 흡수)
+    uint32_t        m_LatencyTimeoutMs = 100;  // LowLatency 대기 상한 (창이 가려졌을 때 등)
+    int64_t         m_Deadline = 0;            // 다음 프레임 시작 마감 (0 = 아직 없음)
+    int64_t         m_LastStart = 0;
+    bool            m_HasLastStart = false;
+    FramePacerStats m_Stats;
+
+    explicit FramePacer(IFrameClock& clock) : m_Clock(&clock) {}
+
+    // 모드/목표가 바뀌면 통계와 마감을 새로 시작한다
+    void SetMode(PacingMode mode)
+    {
+        m_Mode = mode;
+        Reset();
+    }
+
+    void SetTargetRate(double hz)
+    {
+        m_IntervalUs = std::max<int64_t>(1, int64_t(1e6 / hz + 0.5));
+        Reset();
+    }
+
+    void Reset()
+    {
+        Pause();
+        m_Stats = FramePacerStats{};
+    }
+
+    // 그릴 것이 없어 루프가 쉬러 갈 때 호출: 다음 프레임은 마감을 새로 잡고, 쉰 시간은 간격/놓친 프레임으로 세지 않는다
+    void Pause()
+    {
+        m_Deadline = 0;
+        m_HasLastStart = false;
+    }
+
+    uint32_t SyncInterval() const
+    {
+        return (m_Mode == PacingMode::VSync || m_Mode == PacingMode::LowLatency) ? 1 : 0;
+    }
+
+    // 프레임을 시작하기 전에 (메시지/입력을 처리하기 전에) 호출. device가 없으면 LowLatency는 기다리지 않는다.
+    void BeginFrame(IRenderDevice* device)
+    {
+        if (m_Mode == PacingMode::LowLatency && device)
+            device->WaitForFrameLatency(m_LatencyTimeoutMs);
+        else if (m_Mode == PacingMode::FixedRate)
+            WaitForDeadline();
+
+        int64_t now = m_Clock->NowMicroseconds();
+        if (m_HasLastStart)
+        {
+            int64_t interval = now - m_LastStart;
+            ++m_Stats.intervals;
+            m_Stats.totalIntervalUs += interval;
+            m_Stats.minIntervalUs = std::min(m_Stats.minIntervalUs, interval);
+            m_Stats.maxIntervalUs = std::max(m_Stats.maxIntervalUs, interval);
+        }
+        m_LastStart = now;
+        m_HasLastStart = true;
+        ++m_Stats.frames;
+    }
+
+    void WaitForDeadline()
+    {
+        int64_t now = m_Clock->NowMicroseconds();
+        if (m_Deadline == 0 || now - m_Deadline > m_IntervalUs)
+        {
+            if (m_Deadline != 0) ++m_Stats.missed;
+            m_Deadline = now + m_IntervalUs;
+            return;
+        }
+
+        if (m_Deadline - now > m_SpinUs)
+        {
+            m_Clock->SleepMicroseconds(m_Deadline - m_SpinUs - now);
+            int64_t woke = m_Clock->NowMicroseconds();
+            m_Stats.sleptUs += woke - now;
+            now = woke;
+        }
+
+        const int64_t spinStart = now;
+        while (now < m_Deadline)
+        {
+            m_Clock->SpinPause();
+            now = m_Clock->NowMicroseconds();
+        }
+        m_Stats.spunUs += now - spinStart;
+        m_Stats.lateUs += now - m_Deadline;
+        m_Deadline += m_IntervalUs;
+    }
+};
+
+struct FramePacerReport
+{
+    int             frames = 0;
+    FramePacerStats sleepSpin;   // FixedRate 60 Hz, 마감 2 ms 전부터 스핀
+    FramePacerStats sleepOnly;   // FixedRate 60 Hz, 스핀 없음
+    FramePacerStats uncapped;
+};
+
+// 시뮬레이션 시계로 같은 작업량 (4~12 ms, 100프레임마다 25 ms 튐)을 세 설정으로 돌린다.
+inline FramePacerReport BuildFramePacerReport(int frames = 600, int64_t sleepSlackUs = 1000)
+{
+    auto run = [&](PacingMode mode, int64_t spinUs)
+    {
+        SimulatedFrameClock clock;
+        clock.m_SleepSlackUs = sleepSlackUs;
+        FramePacer pacer(clock);
+        pacer.SetMode(mode);
+        pacer.SetTargetRate(60.0);
+        pacer.m_SpinUs = spinUs;
+        for (int f = 0; f < frames; ++f)
+        {
+            pacer.BeginFrame(nullptr);
+            clock.Advance((f % 100 == 99) ? 25000 : 4000 + (f * 7 % 9) * 1000);
+        }
+        return pacer.m_Stats;
+    };
+
+    FramePacerReport r;
+    r.frames = frames;
+    r.sleepSpin = run(PacingMode::FixedRate, 2000);
+    r.sleepOnly = run(PacingMode::FixedRate, 0);
+    r.uncapped = run(PacingMode::Uncapped, 0);
+    return r;
+}
@@ -0,0 +1,275 @@
+﻿#pragma once
+
+// 절두체 컬링 (CPU 전용, Windows/D3D 의존성 없음)
+// - m_View * m_Proj (행 벡터 규약, D3D 클립 z ∈ [0, 1])에서 6개 평면 추출
+// - AABB를 8개씩 SoA 배치로 묶어 AVX2(8 lane) / SSE(4 lane x 2) / 스칼라로 판정
+// - 청크 경계 → 청크 내 인스턴스 경계 순서로 2단계 컬링
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FRUSTUM_CULL_AVX2 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRUSTUM_CULL_SSE 1
+#endif
+
+#include "BoxMath.h"
+#include "PlacedBoxStore.h"
+
+struct Frustum
+{
+    float planes[6][4];   // (n.x, n.y, n.z, d), 안쪽이 n·p + d >= 0
+
+    // m: 행 우선 4x4 (SimpleMath Matrix와 같은 배치), clip = p * m
+    void FromViewProj(const float* m)
+    {
+        auto col = [m](int c, float out[4]) { for (int r = 0; r < 4; ++r) out[r] = m[r * 4 + c]; };
+        float c0[4], c1[4], c2[4], c3[4];
+        col(0, c0); col(1, c1); col(2, c2); col(3, c3);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            planes[0][i] = c3[i] + c0[i];  // left
+            planes[1][i] = c3[i] - c0[i];  // right
+            planes[2][i] = c3[i] + c1[i];  // bottom
+            planes[3][i] = c3[i] - c1[i];  // top
+            planes[4][i] = c2[i];          // near (z >= 0)
+            planes[5][i] = c3[i] - c2[i];  // far
+        }
+
+        for (auto& p : planes)
+        {
+            float len = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+            if (len > 0.0f) for (float& v : p) v /= len;
+        }
+    }
+};
+
+// 8개 AABB의 SoA 배치 (32바이트 정렬)
+struct alignas(32) AabbBatch
+{
+    float minX[8], minY[8], minZ[8];
+    float maxX[8], maxY[8], maxZ[8];
+
+    void Set(int lane, const float mn[3], const float mx[3])
+    {
+        minX[lane] = mn[0]; minY[lane] = mn[1]; minZ[lane] = mn[2];
+        maxX[lane] = mx[0]; maxY[lane] = mx[1]; maxZ[lane] = mx[2];
+    }
+};
+
+// 배치별 결과 비트마스크: visible = 절두체와 겹침, inside = 완전히 안쪽
+inline void CullAabbBatches(const Frustum& f, const AabbBatch* batches, size_t batchCount,
+    uint8_t* visibleMask, uint8_t* insideMask)
+{
+    for (size_t b = 0; b < batchCount; ++b)
+    {
+        const AabbBatch& bb = batches[b];
+
+#if defined(FRUSTUM_CULL_AVX2)
+        __m256 outside = _mm256_setzero_ps();
+        __m256 crossing = _mm256_setzero_ps();
+        const __m256 zero = _mm256_setzero_ps();
+        for (const auto& p : f.planes)
+        {
+            // 평면 법선 부호에 따라 p-vertex(가장 안쪽) / n-vertex(가장 바깥쪽) 선택
+            const float* px = p[0] > 0.0f ? bb.maxX : bb.minX;
+            const float* py = p[1] > 0.0f ? bb.maxY : bb.minY;
+            const float* pz = p[2] > 0.0f ? bb.maxZ : bb.minZ;
+            const float* nx = p[0] > 0.0f ? bb.minX : bb.maxX;
+            const float* ny = p[1] > 0.0f ? bb.minY : bb.maxY;
+            const float* nz = p[2] > 0.0f ? bb.minZ : bb.maxZ;
+
+            __m256 a = _mm256_set1_ps(p[0]), b2 = _mm256_set1_ps(p[1]), c = _mm256_set1_ps(p[2]), d = _mm256_set1_ps(p[3]);
+            __m256 dp = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, _mm256_load_ps(px)), _mm256_mul_ps(b2, _mm256_load_ps(py))), _mm256_add_ps(_mm256_mul_ps(c, _mm256_load_ps(pz)), d));
+            __m256 dn = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, _mm256_load_ps(nx)), _mm256_mul_ps(b2, _mm256_load_ps(ny))), _mm256_add_ps(_mm256_mul_ps(c, _mm256_load_ps(nz)), d));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dp, zero, _CMP_LT_OQ));
+            crossing = _mm256_or_ps(crossing, _mm256_cmp_ps(dn, zero, _CMP_LT_OQ));
+        }
+        int out = _mm256_movemask_ps(outside);
+        int cross = _mm256_movemask_ps(crossing);
+#elif defined(FRUSTUM_CULL_SSE)
+        int out = 0, cross = 0;
+        for (int half = 0; half < 8; half += 4)
+        {
+            __m128 outside = _mm_setzero_ps();
+            __m128 crossing = _mm_setzero_ps();
+            const __m128 zero = _mm_setzero_ps();
+            for (const auto& p : f.planes)
+            {
+                const float* px = (p[0] > 0.0f ? bb.maxX : bb.minX) + half;
+                const float* py = (p[1] > 0.0f ? bb.maxY : bb.minY) + half;
+                const float* pz = (p[2] > 0.0f ? bb.maxZ : bb.minZ) + half;
+                const float* nx = (p[0] > 0.0f ? bb.minX : bb.maxX) + half;
+                const float* ny = (p[1] > 0.0f ? bb.minY : bb.maxY) + half;
+                const float* nz = (p[2] > 0.0f ? bb.minZ : bb.maxZ) + half;
+
+                __m128 a = _mm_set1_ps(p[0]), b2 = _mm_set1_ps(p[1]), c = _mm_set1_ps(p[2]), d = _mm_set1_ps(p[3]);
+                __m128 dp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, _mm_load_ps(px)), _mm_mul_ps(b2, _mm_load_ps(py))), _mm_add_ps(_mm_mul_ps(c, _mm_load_ps(pz)), d));
+                __m128 dn = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, _mm_load_ps(nx)), _mm_mul_ps(b2, _mm_load_ps(ny))), _mm_add_ps(_mm_mul_ps(c, _mm_load_ps(nz)), d));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(dp, zero));
+                crossing = _mm_or_ps(crossing, _mm_cmplt_ps(dn, zero));
+            }
+            out |= _mm_movemask_ps(outside) << half;
+            cross |= _mm_movemask_ps(crossing) << half;
+        }
+#else
+        int out = 0, cross = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (const auto& p : f.planes)
+            {
+                float dp = p[0] * (p[0] > 0.0f ? bb.maxX[i] : bb.minX[i]) + p[1] * (p[1] > 0.0f ? bb.maxY[i] : bb.minY[i]) + p[2] * (p[2] > 0.0f ? bb.maxZ[i] : bb.minZ[i]) + p[3];
+                float dn = p[0] * (p[0] > 0.0f ? bb.minX[i] : bb.maxX[i]) + p[1] * (p[1] > 0.0f ? bb.minY[i] : bb.maxY[i]) + p[2] * (p[2] > 0.0f ? bb.minZ[i] : bb.maxZ[i]) + p[3];
+                if (dp < 0.0f) out |= 1 << i;
+                if (dn < 0.0f) cross |= 1 << i;
+            }
+        }
+#endif
+        visibleMask[b] = uint8_t(~out & 0xFF);
+        if (insideMask) insideMask[b] = uint8_t(~(out | cross) & 0xFF);
+    }
+}
+
+// 인스턴스 월드 행렬(상위 3행)로 단위 박스 메쉬 [-0.5,0.5]x[0,1]x[-0.5,0.5]의 AABB 계산
+inline void InstanceBounds(const InstanceData& inst, float mn[3], float mx[3])
+{
+    const float* rows[3] = { inst.row0, inst.row1, inst.row2 };
+    for (int a = 0; a < 3; ++a)
+    {
+        const float* r = rows[a];
+        float center = r[3] + r[1] * 0.5f;
+        float extent = (fabsf(r[0]) + fabsf(r[1]) + fabsf(r[2])) * 0.5f;
+        mn[a] = center - extent;
+        mx[a] = center + extent;
+    }
+}
+
+struct CullStats
+{
+    uint32_t chunksTested = 0;
+    uint32_t chunksVisible = 0;
+    uint32_t instancesTested = 0;
+    uint32_t instancesVisible = 0;
+    double   cullMicroseconds = 0.0;
+};
+
+// 청크 단위 2단계 컬러
+// - Build(): 배치가 바뀔 때만 청크/인스턴스 경계 SoA를 다시 만든다.
+// - Cull(): 보이는 인스턴스 인덱스 목록을 만든다.
+struct ChunkCuller
+{
+    std::vector<ChunkInstanceRange> m_Ranges;         // 청크별 인스턴스 범위
+    std::vector<AabbBatch>          m_ChunkBatches;   // 청크 경계 (8개씩)
+    std::vector<AabbBatch>          m_InstBatches;    // 인스턴스 경계 (청크마다 8개 경계에서 시작)
+    std::vector<uint32_t>           m_InstBatchStart; // 청크별 첫 인스턴스 배치
+    std::vector<uint8_t>            m_ChunkVisible, m_ChunkInside;
+    CullStats                       m_Stats;
+
+    void Build(const std::vector<InstanceData>& instances, const std::vector<ChunkInstanceRange>& ranges)
+    {
+        m_Ranges = ranges;
+        m_ChunkBatches.assign((ranges.size() + 7) / 8, AabbBatch{});
+        m_InstBatchStart.resize(ranges.size());
+        m_InstBatches.clear();
+
+        for (size_t c = 0; c < ranges.size(); ++c)
+        {
+            const ChunkInstanceRange& r = ranges[c];
+            m_ChunkBatches[c / 8].Set(int(c % 8), r.boundsMin, r.boundsMax);
+
+            m_InstBatchStart[c] = uint32_t(m_InstBatches.size());
+            m_InstBatches.resize(m_InstBatches.size() + (r.count + 7) / 8, AabbBatch{});
+            for (uint32_t i = 0; i < r.count; ++i)
+            {
+                float mn[3], mx[3];
+                InstanceBounds(instances[r.first + i], mn, mx);
+                m_InstBatches[m_InstBatchStart[c] + i / 8].Set(int(i % 8), mn, mx);
+            }
+        }
+    }
+
+    void Cull(const Frustum& f, std::vector<uint32_t>& outVisible)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        outVisible.clear();
+        m_Stats = CullStats{};
+
+        m_ChunkVisible.resize(m_ChunkBatches.size());
+        m_ChunkInside.resize(m_ChunkBatches.size());
+        CullAabbBatches(f, m_ChunkBatches.data(), m_ChunkBatches.size(), m_ChunkVisible.data(), m_ChunkInside.data());
+        m_Stats.chunksTested = uint32_t(m_Ranges.size());
+
+        uint8_t instVisible[64];
+        for (size_t c = 0; c < m_Ranges.size(); ++c)
+        {
+            uint8_t bit = uint8_t(1u << (c % 8));
+            if (!(m_ChunkVisible[c / 8] & bit)) continue;
+            ++m_Stats.chunksVisible;
+
+            const ChunkInstanceRange& r = m_Ranges[c];
+            if (m_ChunkInside[c / 8] & bit)
+            {
+                // 청크가 완전히 안쪽이면 인스턴스 검사 생략
+                for (uint32_t i = 0; i < r.count; ++i) outVisible.push_back(r.first + i);
+                continue;
+            }
+
+            m_Stats.instancesTested += r.count;
+            uint32_t batchCount = (r.count + 7) / 8;
+            for (uint32_t b0 = 0; b0 < batchCount; b0 += 64)
+            {
+                uint32_t n = std::min<uint32_t>(64, batchCount - b0);
+                CullAabbBatches(f, &m_InstBatches[m_InstBatchStart[c] + b0], n, instVisible, nullptr);
+                for (uint32_t b = 0; b < n; ++b)
+                {
+                    uint32_t base = (b0 + b) * 8;
+                    uint32_t lanes = std::min<uint32_t>(8, r.count - base);
+                    for (uint32_t l = 0; l < lanes; ++l)
+                        if (instVisible[b] & (1u << l)) outVisible.push_back(r.first + base + l);
+                }
+            }
+        }
+
+        m_Stats.instancesVisible = uint32_t(outVisible.size());
+        m_Stats.cullMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+};
+
+// 벤치마크: 무작위 AABB count개를 컬링하고 AABB당 ns를 돌려준다.
+inline double BenchmarkFrustumCull(size_t count, int iterations = 10)
+{
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f), ext(0.5f, 4.0f);
+
+    std::vector<AabbBatch> batches((count + 7) / 8);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float c[3] = { pos(rng), pos(rng) * 0.1f, pos(rng) }, e = ext(rng);
+        float mn[3] = { c[0] - e, c[1] - e, c[2] - e }, mx[3] = { c[0] + e, c[1] + e, c[2] + e };
+        batches[i / 8].Set(int(i % 8), mn, mx);
+    }
+
+    // 원점을 바라보는 60도 원근 투영 (장면 카메라와 같은 BoxMath 규약: 오른손, 행 우선, 깊이 [0, 1])
+    const Mat4 vp = Mat4::LookAt(Vec3(0.0f, 20.0f, -60.0f), Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f))
+                  * Mat4::PerspectiveFov(ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    Frustum f;
+    f.FromViewProj(vp.Data());
+
+    std::vector<uint8_t> vis(batches.size()), inside(batches.size());
+    CullAabbBatches(f, batches.data(), batches.size(), vis.data(), inside.data());   // 워밍업
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it)
+        CullAabbBatches(f, batches.data(), batches.size(), vis.data(), inside.data());
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - t0).count();
+    return ns / (double(count) * iterations);
+}
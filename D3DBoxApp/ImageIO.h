@@ -0,0 +1,876 @@
+﻿#pragma once
+
+// 이미지 입출력 (CPU 전용, Windows/D3D 의존성 없음)
+// - PNG 디코드: 8비트 Gray/GrayA/RGB/RGBA/팔레트, 16비트 Gray/RGB/RGBA (상위 바이트 사용), 비인터레이스
+// - DDS 읽기: BC1(DXT1)/BC2(DXT3)/BC3(DXT5)/BC7 (DX10), 32비트 비압축 (마스크 또는 DX10 R8G8B8A8/B8G8R8A8),
+//   밉맵과 큐브맵(6면) 포함
+// - PNG 쓰기: 무압축 deflate (stored 블록)
+// 결과는 모두 RGBA8 (r이 가장 낮은 바이트).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+struct Image
+{
+    uint32_t             width = 0;
+    uint32_t             height = 0;
+    std::vector<uint8_t> rgba;   // width * height * 4
+
+    uint8_t* Pixel(uint32_t x, uint32_t y) { return &rgba[(size_t(y) * width + x) * 4]; }
+    const uint8_t* Pixel(uint32_t x, uint32_t y) const { return &rgba[(size_t(y) * width + x) * 4]; }
+};
+
+// 밉/면을 포함한 텍스처 (surfaces[face * mipLevels + mip])
+struct ImageSet
+{
+    uint32_t           mipLevels = 0;
+    uint32_t           faces = 0;     // 1 또는 6 (큐브맵: +X -X +Y -Y +Z -Z)
+    std::vector<Image> surfaces;
+
+    const Image& Surface(uint32_t face, uint32_t mip) const { return surfaces[face * mipLevels + mip]; }
+};
+
+// ------------------------------------------------------------
+// 파일
+// ------------------------------------------------------------
+inline FILE* OpenImageFile(const wchar_t* path, bool write)
+{
+#ifdef _WIN32
+    FILE* f = nullptr;
+    _wfopen_s(&f, path, write ? L"wb" : L"rb");
+    return f;
+#else
+    std::string narrow;
+    for (const wchar_t* p = path; *p; ++p) narrow += char(*p);   // 경로는 ASCII 가정
+    return fopen(narrow.c_str(), write ? "wb" : "rb");
+#endif
+}
+
+inline bool ReadWholeFile(const wchar_t* path, std::vector<uint8_t>& out)
+{
+    FILE* f = OpenImageFile(path, false);
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    out.resize(size > 0 ? size_t(size) : 0);
+    size_t read = out.empty() ? 0 : fread(out.data(), 1, out.size(), f);
+    fclose(f);
+    return read == out.size();
+}
+
+inline bool WriteWholeFile(const wchar_t* path, const std::vector<uint8_t>& bytes)
+{
+    FILE* f = OpenImageFile(path, true);
+    if (!f) return false;
+    size_t written = bytes.empty() ? 0 : fwrite(bytes.data(), 1, bytes.size(), f);
+    fclose(f);
+    return written == bytes.size();
+}
+
+// ------------------------------------------------------------
+// inflate (zlib 스트림, RFC 1950/1951)
+// ------------------------------------------------------------
+struct Inflater
+{
+    struct Huffman
+    {
+        uint16_t counts[16];
+        uint16_t symbols[288];
+    };
+
+    const uint8_t*        m_Src = nullptr;
+    size_t                m_Len = 0;
+    size_t                m_Pos = 0;
+    uint32_t              m_BitBuf = 0;
+    int                   m_BitCount = 0;
+    bool                  m_Error = false;
+    std::vector<uint8_t>* m_Out = nullptr;
+
+    int Bit()
+    {
+        if (m_BitCount == 0)
+        {
+            if (m_Pos >= m_Len) { m_Error = true; return 0; }
+            m_BitBuf = m_Src[m_Pos++];
+            m_BitCount = 8;
+        }
+        int b = m_BitBuf & 1;
+        m_BitBuf >>= 1;
+        --m_BitCount;
+        return b;
+    }
+
+    uint32_t Bits(int n)
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < n; ++i) v |= uint32_t(Bit()) << i;
+        return v;
+    }
+
+    static void Build(Huffman& h, const uint8_t* lengths, int n)
+    {
+        memset(h.counts, 0, sizeof(h.counts));
+        for (int i = 0; i < n; ++i) ++h.counts[lengths[i]];
+        h.counts[0] = 0;
+
+        uint16_t offs[16];
+        offs[1] = 0;
+        for (int len = 1; len < 15; ++len) offs[len + 1] = offs[len] + h.counts[len];
+        for (int i = 0; i < n; ++i)
+            if (lengths[i]) h.symbols[offs[lengths[i]]++] = uint16_t(i);
+    }
+
+    // 정규 허프만 코드를 한 비트씩 읽어 해석
+    int Decode(const Huffman& h)
+    {
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len < 16; ++len)
+        {
+            code |= Bit();
+            int count = h.counts[len];
+            if (code - count < first) return h.symbols[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+            if (m_Error) return -1;
+        }
+        m_Error = true;
+        return -1;
+    }
+
+    bool Codes(const Huffman& lit, const Huffman& dist)
+    {
+        static const uint16_t lenBase[29] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+        static const uint8_t  lenExtra[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+        static const uint16_t distBase[30] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+        static const uint8_t  distExtra[30] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+        std::vector<uint8_t>& out = *m_Out;
+        for (;;)
+        {
+            int sym = Decode(lit);
+            if (sym < 0 || m_Error) return false;
+            if (sym < 256) { out.push_back(uint8_t(sym)); continue; }
+            if (sym == 256) return true;
+
+            sym -= 257;
+            if (sym >= 29) return false;
+            size_t len = lenBase[sym] + Bits(lenExtra[sym]);
+            int ds = Decode(dist);
+            if (ds < 0 || ds >= 30) return false;
+            size_t d = distBase[ds] + Bits(distExtra[ds]);
+            if (d > out.size()) return false;
+
+            size_t from = out.size() - d;
+            for (size_t i = 0; i < len; ++i) out.push_back(out[from + i]);
+        }
+    }
+
+    bool Stored()
+    {
+        m_BitBuf = 0; m_BitCount = 0;   // 바이트 경계로
+        if (m_Pos + 4 > m_Len) return false;
+        uint32_t len = m_Src[m_Pos] | (m_Src[m_Pos + 1] << 8);
+        uint32_t nlen = m_Src[m_Pos + 2] | (m_Src[m_Pos + 3] << 8);
+        m_Pos += 4;
+        if ((len ^ 0xFFFF) != nlen || m_Pos + len > m_Len) return false;
+        m_Out->insert(m_Out->end(), m_Src + m_Pos, m_Src + m_Pos + len);
+        m_Pos += len;
+        return true;
+    }
+
+    bool Fixed()
+    {
+        static Huffman lit, dist;
+        static bool built = false;
+        if (!built)
+        {
+            uint8_t l[288];
+            for (int i = 0; i < 144; ++i) l[i] = 8;
+            for (int i = 144; i < 256; ++i) l[i] = 9;
+            for (int i = 256; i < 280; ++i) l[i] = 7;
+            for (int i = 280; i < 288; ++i) l[i] = 8;
+            Build(lit, l, 288);
+            for (int i = 0; i < 30; ++i) l[i] = 5;
+            Build(dist, l, 30);
+            built = true;
+        }
+        return Codes(lit, dist);
+    }
+
+    bool Dynamic()
+    {
+        static const uint8_t order[19] = { 16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15 };
+        int nlen = int(Bits(5)) + 257, ndist = int(Bits(5)) + 1, ncode = int(Bits(4)) + 4;
+        if (nlen > 286 || ndist > 30) return false;
+
+        uint8_t lengths[320] = {};
+        for (int i = 0; i < ncode; ++i) lengths[order[i]] = uint8_t(Bits(3));
+        Huffman lencode;
+        Build(lencode, lengths, 19);
+
+        int index = 0;
+        while (index < nlen + ndist)
+        {
+            int sym = Decode(lencode);
+            if (sym < 0) return false;
+            if (sym < 16) { lengths[index++] = uint8_t(sym); continue; }
+
+            uint8_t len = 0;
+            int repeat;
+            if (sym == 16)
+            {
+                if (index == 0) return false;
+                len = lengths[index - 1];
+                repeat = 3 + int(Bits(2));
+            }
+            else if (sym == 17) repeat = 3 + int(Bits(3));
+            else repeat = 11 + int(Bits(7));
+            if (index + repeat > nlen + ndist) return false;
+            while (repeat--) lengths[index++] = len;
+        }
+
+        Huffman lit, dist;
+        Build(lit, lengths, nlen);
+        Build(dist, lengths + nlen, ndist);
+        return Codes(lit, dist);
+    }
+
+    bool Run(const uint8_t* src, size_t len, std::vector<uint8_t>& out)
+    {
+        if (len < 2 || (src[0] & 0x0F) != 8 || ((src[0] << 8) | src[1]) % 31 != 0) return false;
+        m_Src = src; m_Len = len; m_Pos = 2; m_Out = &out;
+
+        int last;
+        do
+        {
+            last = Bit();
+            int type = int(Bits(2));
+            bool ok = (type == 0) ? Stored() : (type == 1) ? Fixed() : (type == 2) ? Dynamic() : false;
+            if (!ok || m_Error) return false;
+        } while (!last);
+        return true;
+    }
+};
+
+// ------------------------------------------------------------
+// PNG
+// ------------------------------------------------------------
+inline uint32_t ReadBE32(const uint8_t* p) { return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3]; }
+
+inline bool DecodePng(const uint8_t* data, size_t size, Image& out)
+{
+    static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    if (size < 8 || memcmp(data, sig, 8) != 0) return false;
+
+    uint32_t w = 0, h = 0;
+    int depth = 0, colorType = 0, interlace = 0;
+    std::vector<uint8_t> idat, palette, trns;
+
+    size_t pos = 8;
+    while (pos + 12 <= size)
+    {
+        uint32_t len = ReadBE32(data + pos);
+        const uint8_t* type = data + pos + 4;
+        const uint8_t* body = data + pos + 8;
+        if (pos + 12 + size_t(len) > size) return false;
+
+        if (!memcmp(type, "IHDR", 4) && len >= 13)
+        {
+            w = ReadBE32(body); h = ReadBE32(body + 4);
+            depth = body[8]; colorType = body[9]; interlace = body[12];
+        }
+        else if (!memcmp(type, "PLTE", 4)) palette.assign(body, body + len);
+        else if (!memcmp(type, "tRNS", 4)) trns.assign(body, body + len);
+        else if (!memcmp(type, "IDAT", 4)) idat.insert(idat.end(), body, body + len);
+        else if (!memcmp(type, "IEND", 4)) break;
+        pos += 12 + size_t(len);
+    }
+
+    if (w == 0 || h == 0 || interlace != 0) return false;
+    int channels = (colorType == 0) ? 1 : (colorType == 2) ? 3 : (colorType == 3) ? 1 : (colorType == 4) ? 2 : (colorType == 6) ? 4 : 0;
+    if (channels == 0) return false;
+    if (colorType == 3 ? depth != 8 : (depth != 8 && depth != 16)) return false;
+
+    std::vector<uint8_t> raw;
+    raw.reserve(size_t(w) * h * channels * (depth / 8) + h);
+    Inflater inf;
+    if (!inf.Run(idat.data(), idat.size(), raw)) return false;
+
+    const size_t bpp = size_t(channels) * (depth / 8);
+    const size_t stride = bpp * w;
+    if (raw.size() < (stride + 1) * h) return false;
+
+    // 필터 복원
+    std::vector<uint8_t> prev(stride, 0), cur(stride);
+    out.width = w; out.height = h;
+    out.rgba.resize(size_t(w) * h * 4);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        const uint8_t* src = &raw[y * (stride + 1)];
+        int filter = src[0];
+        ++src;
+        for (size_t i = 0; i < stride; ++i)
+        {
+            int a = (i >= bpp) ? cur[i - bpp] : 0;
+            int b = prev[i];
+            int c = (i >= bpp) ? prev[i - bpp] : 0;
+            int x = src[i];
+            switch (filter)
+            {
+            case 1: x += a; break;
+            case 2: x += b; break;
+            case 3: x += (a + b) >> 1; break;
+            case 4:
+            {
+                int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+                x += (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+                break;
+            }
+            default: break;
+            }
+            cur[i] = uint8_t(x);
+        }
+
+        const int step = depth / 8;   // 16비트면 상위 바이트만
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            const uint8_t* s = &cur[x * bpp];
+            uint8_t* d = out.Pixel(x, y);
+            switch (colorType)
+            {
+            case 0: d[0] = d[1] = d[2] = s[0]; d[3] = 255; break;
+            case 2: d[0] = s[0]; d[1] = s[step]; d[2] = s[2 * step]; d[3] = 255; break;
+            case 3:
+            {
+                uint32_t i = s[0];
+                d[0] = (i * 3 + 2 < palette.size()) ? palette[i * 3] : 0;
+                d[1] = (i * 3 + 2 < palette.size()) ? palette[i * 3 + 1] : 0;
+                d[2] = (i * 3 + 2 < palette.size()) ? palette[i * 3 + 2] : 0;
+                d[3] = (i < trns.size()) ? trns[i] : 255;
+                break;
+            }
+            case 4: d[0] = d[1] = d[2] = s[0]; d[3] = s[step]; break;
+            default: d[0] = s[0]; d[1] = s[step]; d[2] = s[2 * step]; d[3] = s[3 * step]; break;
+            }
+        }
+        prev.swap(cur);
+    }
+    return true;
+}
+
+inline uint32_t Crc32(const uint8_t* p, size_t n, uint32_t crc = 0)
+{
+    static uint32_t table[256];
+    static bool init = false;
+    if (!init)
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        init = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// RGBA8 PNG 저장 (무압축)
+inline bool WritePng(const wchar_t* path, const Image& img)
+{
+    std::vector<uint8_t> raw;
+    const size_t stride = size_t(img.width) * 4;
+    raw.reserve((stride + 1) * img.height);
+    for (uint32_t y = 0; y < img.height; ++y)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), img.Pixel(0, y), img.Pixel(0, y) + stride);
+    }
+
+    std::vector<uint8_t> z = { 0x78, 0x01 };
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : raw) { a = (a + v) % 65521; b = (b + a) % 65521; }
+    for (size_t pos = 0; pos < raw.size() || pos == 0;)
+    {
+        size_t n = std::min<size_t>(raw.size() - pos, 65535);
+        bool last = (pos + n == raw.size());
+        z.push_back(last ? 1 : 0);
+        z.push_back(uint8_t(n)); z.push_back(uint8_t(n >> 8));
+        z.push_back(uint8_t(~n)); z.push_back(uint8_t(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+        if (last) break;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int i = 3; i >= 0; --i) z.push_back(uint8_t(adler >> (i * 8)));
+
+    FILE* f = OpenImageFile(path, true);
+    if (!f) return false;
+    auto chunk = [f](const char* type, const uint8_t* body, size_t len)
+    {
+        uint8_t hdr[8] = { uint8_t(len >> 24), uint8_t(len >> 16), uint8_t(len >> 8), uint8_t(len),
+                           uint8_t(type[0]), uint8_t(type[1]), uint8_t(type[2]), uint8_t(type[3]) };
+        fwrite(hdr, 1, 8, f);
+        if (len) fwrite(body, 1, len, f);
+        uint32_t crc = Crc32(body, len, Crc32(hdr + 4, 4));
+        uint8_t c[4] = { uint8_t(crc >> 24), uint8_t(crc >> 16), uint8_t(crc >> 8), uint8_t(crc) };
+        fwrite(c, 1, 4, f);
+    };
+
+    static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    fwrite(sig, 1, 8, f);
+    uint8_t ihdr[13] = { uint8_t(img.width >> 24), uint8_t(img.width >> 16), uint8_t(img.width >> 8), uint8_t(img.width),
+                         uint8_t(img.height >> 24), uint8_t(img.height >> 16), uint8_t(img.height >> 8), uint8_t(img.height),
+                         8, 6, 0, 0, 0 };
+    chunk("IHDR", ihdr, 13);
+    chunk("IDAT", z.data(), z.size());
+    chunk("IEND", nullptr, 0);
+    bool ok = ferror(f) == 0;
+    fclose(f);
+    return ok;
+}
+
+// ------------------------------------------------------------
+// DDS / BC 디코드
+// ------------------------------------------------------------
+inline void Unpack565(uint16_t c, uint8_t out[4])
+{
+    uint32_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = uint8_t((r << 3) | (r >> 2));
+    out[1] = uint8_t((g << 2) | (g >> 4));
+    out[2] = uint8_t((b << 3) | (b >> 2));
+    out[3] = 255;
+}
+
+// BC1 색 블록 8바이트 → 4x4 RGBA (forceFourColor: BC2/BC3의 색 블록)
+inline void DecodeBC1Block(const uint8_t* src, uint8_t out[16][4], bool forceFourColor = false)
+{
+    uint16_t c0 = uint16_t(src[0] | (src[1] << 8)), c1 = uint16_t(src[2] | (src[3] << 8));
+    uint8_t pal[4][4];
+    Unpack565(c0, pal[0]);
+    Unpack565(c1, pal[1]);
+    if (c0 > c1 || forceFourColor)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            pal[2][k] = uint8_t((2 * pal[0][k] + pal[1][k] + 1) / 3);
+            pal[3][k] = uint8_t((pal[0][k] + 2 * pal[1][k] + 1) / 3);
+        }
+        pal[2][3] = pal[3][3] = 255;
+    }
+    else
+    {
+        for (int k = 0; k < 3; ++k) pal[2][k] = uint8_t((pal[0][k] + pal[1][k]) / 2);
+        pal[2][3] = 255;
+        pal[3][0] = pal[3][1] = pal[3][2] = pal[3][3] = 0;
+    }
+
+    uint32_t bits = uint32_t(src[4]) | (uint32_t(src[5]) << 8) | (uint32_t(src[6]) << 16) | (uint32_t(src[7]) << 24);
+    for (int i = 0; i < 16; ++i) memcpy(out[i], pal[(bits >> (i * 2)) & 3], 4);
+}
+
+// BC3 알파 블록 8바이트 → out[i][3]
+inline void DecodeBC3Alpha(const uint8_t* src, uint8_t out[16][4])
+{
+    uint8_t a[8];
+    a[0] = src[0]; a[1] = src[1];
+    if (a[0] > a[1])
+        for (int i = 1; i < 7; ++i) a[i + 1] = uint8_t(((7 - i) * a[0] + i * a[1] + 3) / 7);
+    else
+    {
+        for (int i = 1; i < 5; ++i) a[i + 1] = uint8_t(((5 - i) * a[0] + i * a[1] + 2) / 5);
+        a[6] = 0; a[7] = 255;
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) bits |= uint64_t(src[2 + i]) << (8 * i);
+    for (int i = 0; i < 16; ++i) out[i][3] = a[(bits >> (3 * i)) & 7];
+}
+
+// BC7 분할 테이블 (2개 subset: 픽셀 i의 subset = 비트 i, 3개 subset: 픽셀별 subset)과 subset별 앵커 픽셀
+constexpr uint16_t BC7_PARTITION2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+constexpr uint8_t BC7_PARTITION3[64][16] = {
+    {0,0,1,1,0,0,1,1,0,2,2,1,2,2,2,2}, {0,0,0,1,0,0,1,1,2,2,1,1,2,2,2,1}, {0,0,0,0,2,0,0,1,2,2,1,1,2,2,1,1}, {0,2,2,2,0,0,2,2,0,0,1,1,0,1,1,1},
+    {0,0,0,0,0,0,0,0,1,1,2,2,1,1,2,2}, {0,0,1,1,0,0,1,1,0,0,2,2,0,0,2,2}, {0,0,2,2,0,0,2,2,1,1,1,1,1,1,1,1}, {0,0,1,1,0,0,1,1,2,2,1,1,2,2,1,1},
+    {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2}, {0,0,0,0,1,1,1,1,1,1,1,1,2,2,2,2}, {0,0,0,0,1,1,1,1,2,2,2,2,2,2,2,2}, {0,0,1,2,0,0,1,2,0,0,1,2,0,0,1,2},
+    {0,1,1,2,0,1,1,2,0,1,1,2,0,1,1,2}, {0,1,2,2,0,1,2,2,0,1,2,2,0,1,2,2}, {0,0,1,1,0,1,1,2,1,1,2,2,1,2,2,2}, {0,0,1,1,2,0,0,1,2,2,0,0,2,2,2,0},
+    {0,0,0,1,0,0,1,1,0,1,1,2,1,1,2,2}, {0,1,1,1,0,0,1,1,2,0,0,1,2,2,0,0}, {0,0,0,0,1,1,2,2,1,1,2,2,1,1,2,2}, {0,0,2,2,0,0,2,2,0,0,2,2,1,1,1,1},
+    {0,1,1,1,0,1,1,1,0,2,2,2,0,2,2,2}, {0,0,0,1,0,0,0,1,2,2,2,1,2,2,2,1}, {0,0,0,0,0,0,1,1,0,1,2,2,0,1,2,2}, {0,0,0,0,1,1,0,0,2,2,1,0,2,2,1,0},
+    {0,1,2,2,0,1,2,2,0,0,1,1,0,0,0,0}, {0,0,1,2,0,0,1,2,1,1,2,2,2,2,2,2}, {0,1,1,0,1,2,2,1,1,2,2,1,0,1,1,0}, {0,0,0,0,0,1,1,0,1,2,2,1,1,2,2,1},
+    {0,0,2,2,1,1,0,2,1,1,0,2,0,0,2,2}, {0,1,1,0,0,1,1,0,2,0,0,2,2,2,2,2}, {0,0,1,1,0,1,2,2,0,1,2,2,0,0,1,1}, {0,0,0,0,2,0,0,0,2,2,1,1,2,2,2,1},
+    {0,0,0,0,0,0,0,2,1,1,2,2,1,2,2,2}, {0,2,2,2,0,0,2,2,0,0,1,2,0,0,1,1}, {0,0,1,1,0,0,1,2,0,0,2,2,0,2,2,2}, {0,1,2,0,0,1,2,0,0,1,2,0,0,1,2,0},
+    {0,0,0,0,1,1,1,1,2,2,2,2,0,0,0,0}, {0,1,2,0,1,2,0,1,2,0,1,2,0,1,2,0}, {0,1,2,0,2,0,1,2,1,2,0,1,0,1,2,0}, {0,0,1,1,2,2,0,0,1,1,2,2,0,0,1,1},
+    {0,0,1,1,1,1,2,2,2,2,0,0,0,0,1,1}, {0,1,0,1,0,1,0,1,2,2,2,2,2,2,2,2}, {0,0,0,0,0,0,0,0,2,1,2,1,2,1,2,1}, {0,0,2,2,1,1,2,2,0,0,2,2,1,1,2,2},
+    {0,0,2,2,0,0,1,1,0,0,2,2,0,0,1,1}, {0,2,2,0,1,2,2,1,0,2,2,0,1,2,2,1}, {0,1,0,1,2,2,2,2,2,2,2,2,0,1,0,1}, {0,0,0,0,2,1,2,1,2,1,2,1,2,1,2,1},
+    {0,1,0,1,0,1,0,1,0,1,0,1,2,2,2,2}, {0,2,2,2,0,1,1,1,0,2,2,2,0,1,1,1}, {0,0,0,2,1,1,1,2,0,0,0,2,1,1,1,2}, {0,0,0,0,2,1,1,2,2,1,1,2,2,1,1,2},
+    {0,2,2,2,0,1,1,1,0,1,1,1,0,2,2,2}, {0,0,0,2,1,1,1,2,1,1,1,2,0,0,0,2}, {0,1,1,0,0,1,1,0,0,1,1,0,2,2,2,2}, {0,0,0,0,0,0,0,0,2,1,1,2,2,1,1,2},
+    {0,1,1,0,0,1,1,0,2,2,2,2,2,2,2,2}, {0,0,2,2,0,0,1,1,0,0,1,1,0,0,2,2}, {0,0,2,2,1,1,2,2,1,1,2,2,0,0,2,2}, {0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,2},
+    {0,0,0,2,0,0,0,1,0,0,0,2,0,0,0,1}, {0,2,2,2,1,2,2,2,0,2,2,2,1,2,2,2}, {0,1,0,1,2,2,2,2,2,2,2,2,2,2,2,2}, {0,1,1,1,2,0,1,1,2,2,0,1,2,2,2,0},
+};
+
+constexpr uint8_t BC7_ANCHOR2[64] = {
+    15,15,15,15,15,15,15,15, 15,15,15,15,15,15,15,15, 15, 2, 8, 2, 2, 8, 8,15,  2, 8, 2, 2, 8, 8, 2, 2,
+    15,15, 6, 8, 2, 8,15,15,  2, 8, 2, 2, 2,15,15, 6,  6, 2, 6, 8,15,15, 2, 2, 15,15,15,15,15, 2, 2,15,
+};
+constexpr uint8_t BC7_ANCHOR3A[64] = {
+     3, 3,15,15, 8, 3,15,15,  8, 8, 6, 6, 6, 5, 3, 3,  3, 3, 8,15, 3, 3, 6,10,  5, 8, 8, 6, 8, 5,15,15,
+     8,15, 3, 5, 6,10, 8,15, 15, 3,15, 5,15,15,15,15,  3,15, 5, 5, 5, 8, 5,10,  5,10, 8,13,15,12, 3, 3,
+};
+constexpr uint8_t BC7_ANCHOR3B[64] = {
+    15, 8, 8, 3,15,15, 3, 8, 15,15,15,15,15,15,15, 8, 15, 8,15, 3,15, 8,15, 8,  3,15, 6,10,15,15,10, 8,
+    15, 3,15,10,10, 8, 9,10,  6,15, 8,15, 3, 6, 6, 8, 15, 3,15,15,15,15,15,15, 15,15,15,15, 3,15,15, 8,
+};
+
+// 보간 가중치 (64 = 끝점 1)
+constexpr uint8_t BC7_WEIGHTS2[4] = { 0, 21, 43, 64 };
+constexpr uint8_t BC7_WEIGHTS3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+constexpr uint8_t BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+inline uint8_t Bc7Interpolate(uint32_t e0, uint32_t e1, uint32_t weight)
+{
+    return uint8_t(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+inline int Bc7Subset(uint32_t subsets, uint32_t partition, int pixel)
+{
+    if (subsets == 2) return (BC7_PARTITION2[partition] >> pixel) & 1;
+    if (subsets == 3) return BC7_PARTITION3[partition][pixel];
+    return 0;
+}
+
+inline bool Bc7IsAnchor(uint32_t subsets, uint32_t partition, int pixel)
+{
+    if (pixel == 0) return true;
+    if (subsets == 2) return pixel == BC7_ANCHOR2[partition];
+    if (subsets == 3) return pixel == BC7_ANCHOR3A[partition] || pixel == BC7_ANCHOR3B[partition];
+    return false;
+}
+
+// BC7 블록 16바이트 → 4x4 RGBA (예약된 모드 비트면 0)
+inline void DecodeBC7Block(const uint8_t* src, uint8_t out[16][4])
+{
+    struct ModeInfo { uint8_t subsets, partitionBits, rotationBits, indexSelBits, colorBits, alphaBits, endpointPBits, sharedPBits, indexBits, index2Bits; };
+    static constexpr ModeInfo MODES[8] = {
+        { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 }, { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 }, { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 }, { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+        { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 }, { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 }, { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 }, { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+    };
+
+    uint32_t pos = 0;
+    auto bits = [&](uint32_t n)
+    {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < n; ++i, ++pos) v |= uint32_t((src[pos >> 3] >> (pos & 7)) & 1) << i;
+        return v;
+    };
+
+    uint32_t mode = 0;
+    while (mode < 8 && bits(1) == 0) ++mode;
+    if (mode == 8)
+    {
+        memset(out, 0, 16 * 4);
+        return;
+    }
+
+    const ModeInfo& m = MODES[mode];
+    uint32_t partition = bits(m.partitionBits);
+    uint32_t rotation = bits(m.rotationBits);
+    uint32_t indexSel = bits(m.indexSelBits);
+
+    // 끝점: 채널별로 (subset0 e0, e1, subset1 e0, e1, ...) 순서
+    uint32_t ep[6][4] = {};
+    const uint32_t endpoints = m.subsets * 2u;
+    for (int c = 0; c < 3; ++c)
+        for (uint32_t e = 0; e < endpoints; ++e) ep[e][c] = bits(m.colorBits);
+    for (uint32_t e = 0; e < endpoints; ++e) ep[e][3] = m.alphaBits ? bits(m.alphaBits) : 255;
+
+    uint32_t colorBits = m.colorBits, alphaBits = m.alphaBits;
+    if (m.endpointPBits || m.sharedPBits)
+    {
+        uint32_t p[6];
+        for (uint32_t e = 0; e < endpoints; ++e) p[e] = m.endpointPBits ? bits(1) : 0;
+        if (m.sharedPBits)
+            for (uint32_t s = 0; s < m.subsets; ++s) p[s * 2] = p[s * 2 + 1] = bits(1);
+        for (uint32_t e = 0; e < endpoints; ++e)
+            for (int c = 0; c < 4; ++c)
+                if (c < 3 || alphaBits) ep[e][c] = (ep[e][c] << 1) | p[e];
+        ++colorBits;
+        if (alphaBits) ++alphaBits;
+    }
+
+    // 비트 확장 (상위 비트를 아래로 복제)
+    for (uint32_t e = 0; e < endpoints; ++e)
+    {
+        for (int c = 0; c < 3; ++c) ep[e][c] = (ep[e][c] << (8 - colorBits)) | (ep[e][c] >> (2 * colorBits - 8));
+        if (alphaBits) ep[e][3] = (ep[e][3] << (8 - alphaBits)) | (ep[e][3] >> (2 * alphaBits - 8));
+    }
+
+    // 인덱스: 앵커 픽셀은 최상위 비트가 0이라 한 비트 적다
+    uint32_t index[16], index2[16] = {};
+    for (int i = 0; i < 16; ++i)
+        index[i] = bits(m.indexBits - (Bc7IsAnchor(m.subsets, partition, i) ? 1 : 0));
+    if (m.index2Bits)
+        for (int i = 0; i < 16; ++i) index2[i] = bits(m.index2Bits - (i == 0 ? 1 : 0));
+
+    auto weights = [](uint32_t n) { return n == 2 ? BC7_WEIGHTS2 : n == 3 ? BC7_WEIGHTS3 : BC7_WEIGHTS4; };
+    const uint8_t* colorWeights = weights(m.indexBits);
+    const uint8_t* alphaWeights = colorWeights;
+    uint32_t colorIndex[16], alphaIndex[16];
+    memcpy(colorIndex, index, sizeof(index));
+    memcpy(alphaIndex, index, sizeof(index));
+    if (m.index2Bits)
+    {
+        if (indexSel)
+        {
+            memcpy(colorIndex, index2, sizeof(index2));
+            colorWeights = weights(m.index2Bits);
+        }
+        else
+        {
+            memcpy(alphaIndex, index2, sizeof(index2));
+            alphaWeights = weights(m.index2Bits);
+        }
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int s = Bc7Subset(m.subsets, partition, i);
+        const uint32_t* e0 = ep[s * 2];
+        const uint32_t* e1 = ep[s * 2 + 1];
+        for (int c = 0; c < 3; ++c) out[i][c] = Bc7Interpolate(e0[c], e1[c], colorWeights[colorIndex[i]]);
+        out[i][3] = Bc7Interpolate(e0[3], e1[3], alphaWeights[alphaIndex[i]]);
+        if (rotation) std::swap(out[i][3], out[i][rotation - 1]);
+    }
+}
+
+enum class DdsFormat { Unknown, BC1, BC2, BC3, BC7, RGBA8, BGRA8, Masked32 };
+
+// 블록 압축 데이터 (행 우선 블록)를 img (width/height/rgba 크기가 정해진 상태)에 풀어 쓴다
+inline void DecodeBlocks(DdsFormat fmt, const uint8_t* src, Image& img)
+{
+    const uint32_t w = img.width, h = img.height;
+    const uint32_t bw = (w + 3) / 4, bh = (h + 3) / 4;
+    const size_t blockBytes = (fmt == DdsFormat::BC1) ? 8 : 16;
+    uint8_t px[16][4];
+    for (uint32_t by = 0; by < bh; ++by)
+        for (uint32_t bx = 0; bx < bw; ++bx, src += blockBytes)
+        {
+            if (fmt == DdsFormat::BC1) DecodeBC1Block(src, px);
+            else if (fmt == DdsFormat::BC7) DecodeBC7Block(src, px);
+            else
+            {
+                DecodeBC1Block(src + 8, px, true);
+                if (fmt == DdsFormat::BC3) DecodeBC3Alpha(src, px);
+                else for (int i = 0; i < 16; ++i) { int a = (src[i / 2] >> ((i & 1) * 4)) & 15; px[i][3] = uint8_t(a * 17); }
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                uint32_t x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+                if (x < w && y < h) memcpy(img.Pixel(x, y), px[i], 4);
+            }
+        }
+}
+
+// DDS 헤더에서 읽은 배치 정보 (데이터는 offset부터 면마다 밉 전체)
+struct DdsHeader
+{
+    uint32_t  width = 0, height = 0, mips = 1, faces = 1;
+    DdsFormat format = DdsFormat::Unknown;
+    uint32_t  masks[4] = {};   // Masked32
+    size_t    offset = 128;
+
+    bool IsBlock() const { return format == DdsFormat::BC1 || format == DdsFormat::BC2 || format == DdsFormat::BC3 || format == DdsFormat::BC7; }
+
+    // 레벨 하나 (w x h)의 바이트 수
+    size_t SurfaceBytes(uint32_t w, uint32_t h) const
+    {
+        return IsBlock() ? size_t((w + 3) / 4) * ((h + 3) / 4) * (format == DdsFormat::BC1 ? 8 : 16) : size_t(w) * h * 4;
+    }
+};
+
+inline bool ParseDdsHeader(const uint8_t* data, size_t size, DdsHeader& out)
+{
+    if (size < 128 || memcmp(data, "DDS ", 4) != 0) return false;
+    auto u32 = [&](size_t off) { uint32_t v; memcpy(&v, data + off, 4); return v; };
+
+    DdsHeader h;
+    h.height = u32(12);
+    h.width = u32(16);
+    h.mips = std::max<uint32_t>(u32(28), 1);
+    uint32_t pfFlags = u32(80), fourCC = u32(84), bitCount = u32(88);
+    for (int k = 0; k < 4; ++k) h.masks[k] = u32(92 + 4 * k);
+    uint32_t caps2 = u32(112);
+
+    h.faces = (caps2 & 0x200) ? 6 : 1;
+    auto cc = [](const char* s) { return uint32_t(s[0]) | (uint32_t(s[1]) << 8) | (uint32_t(s[2]) << 16) | (uint32_t(s[3]) << 24); };
+
+    if (pfFlags & 0x4)   // DDPF_FOURCC
+    {
+        if (fourCC == cc("DXT1")) h.format = DdsFormat::BC1;
+        else if (fourCC == cc("DXT2") || fourCC == cc("DXT3")) h.format = DdsFormat::BC2;
+        else if (fourCC == cc("DXT4") || fourCC == cc("DXT5")) h.format = DdsFormat::BC3;
+        else if (fourCC == cc("DX10"))
+        {
+            if (size < 148) return false;
+            uint32_t dxgi = u32(128), misc = u32(136), arraySize = std::max<uint32_t>(u32(140), 1);
+            h.offset = 148;
+            if (dxgi == 71 || dxgi == 72) h.format = DdsFormat::BC1;
+            else if (dxgi == 74 || dxgi == 75) h.format = DdsFormat::BC2;
+            else if (dxgi == 77 || dxgi == 78) h.format = DdsFormat::BC3;
+            else if (dxgi == 98 || dxgi == 99) h.format = DdsFormat::BC7;
+            else if (dxgi == 28 || dxgi == 29) h.format = DdsFormat::RGBA8;
+            else if (dxgi == 87 || dxgi == 91) h.format = DdsFormat::BGRA8;
+            h.faces = (misc & 0x4) ? 6 * arraySize : arraySize;
+            if (h.faces != 1 && h.faces != 6) return false;
+        }
+    }
+    else if (bitCount == 32)
+    {
+        h.format = DdsFormat::Masked32;
+    }
+    if (h.format == DdsFormat::Unknown || h.width == 0 || h.height == 0) return false;
+    out = h;
+    return true;
+}
+
+inline bool DecodeDds(const uint8_t* data, size_t size, ImageSet& out)
+{
+    DdsHeader header;
+    if (!ParseDdsHeader(data, size, header)) return false;
+    const uint32_t width = header.width, height = header.height, mips = header.mips, faces = header.faces;
+    const DdsFormat fmt = header.format;
+    const uint32_t* masks = header.masks;
+    size_t offset = header.offset;
+
+    auto shiftOf = [](uint32_t m) { int s = 0; if (!m) return -1; while (!(m & 1)) { m >>= 1; ++s; } return s; };
+    int shifts[4] = { shiftOf(masks[0]), shiftOf(masks[1]), shiftOf(masks[2]), shiftOf(masks[3]) };
+
+    out.mipLevels = mips;
+    out.faces = faces;
+    out.surfaces.clear();
+    out.surfaces.reserve(size_t(faces) * mips);
+    for (uint32_t f = 0; f < faces; ++f)
+    {
+        uint32_t w = width, h = height;
+        for (uint32_t m = 0; m < mips; ++m)
+        {
+            Image img;
+            img.width = w; img.height = h;
+            img.rgba.resize(size_t(w) * h * 4);
+
+            size_t bytes = header.SurfaceBytes(w, h);
+            if (offset + bytes > size) return false;
+            const uint8_t* src = data + offset;
+
+            if (header.IsBlock())
+            {
+                DecodeBlocks(fmt, src, img);
+            }
+            else
+            {
+                for (size_t i = 0; i < size_t(w) * h; ++i, src += 4)
+                {
+                    uint8_t* d = &img.rgba[i * 4];
+                    if (fmt == DdsFormat::RGBA8) memcpy(d, src, 4);
+                    else if (fmt == DdsFormat::BGRA8) { d[0] = src[2]; d[1] = src[1]; d[2] = src[0]; d[3] = src[3]; }
+                    else
+                    {
+                        uint32_t v; memcpy(&v, src, 4);
+                        for (int k = 0; k < 4; ++k) d[k] = (shifts[k] < 0) ? 255 : uint8_t((v & masks[k]) >> shifts[k]);
+                    }
+                }
+            }
+
+            offset += bytes;
+            out.surfaces.push_back(std::move(img));
+            w = std::max<uint32_t>(w / 2, 1);
+            h = std::max<uint32_t>(h / 2, 1);
+        }
+    }
+    return true;
+}
+
+// 박스 필터로 밉 체인 생성 (기존 mip 0만 있을 때)
+inline void GenerateMips(ImageSet& set)
+{
+    if (set.mipLevels != 1) return;
+    std::vector<Image> out;
+    uint32_t levels = 1;
+    for (uint32_t f = 0; f < set.faces; ++f)
+    {
+        std::vector<Image> chain{ set.surfaces[f] };
+        while (chain.back().width > 1 || chain.back().height > 1)
+        {
+            const Image& s = chain.back();
+            Image d;
+            d.width = std::max<uint32_t>(s.width / 2, 1);
+            d.height = std::max<uint32_t>(s.height / 2, 1);
+            d.rgba.resize(size_t(d.width) * d.height * 4);
+            for (uint32_t y = 0; y < d.height; ++y)
+                for (uint32_t x = 0; x < d.width; ++x)
+                {
+                    uint32_t x0 = std::min(x * 2, s.width - 1), x1 = std::min(x * 2 + 1, s.width - 1);
+                    uint32_t y0 = std::min(y * 2, s.height - 1), y1 = std::min(y * 2 + 1, s.height - 1);
+                    for (int k = 0; k < 4; ++k)
+                        d.Pixel(x, y)[k] = uint8_t((s.Pixel(x0, y0)[k] + s.Pixel(x1, y0)[k] + s.Pixel(x0, y1)[k] + s.Pixel(x1, y1)[k] + 2) / 4);
+                }
+            chain.push_back(std::move(d));
+        }
+        levels = uint32_t(chain.size());
+        for (Image& i : chain) out.push_back(std::move(i));
+    }
+    set.mipLevels = levels;
+    set.surfaces = std::move(out);
+}
+
+// RGBA 채널 전체의 PSNR (dB, 크기가 다르면 0, 같으면 큰 값)
+inline double ComputePsnr(const Image& a, const Image& b)
+{
+    if (a.width != b.width || a.height != b.height || a.rgba.empty()) return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < a.rgba.size(); ++i)
+    {
+        double d = double(a.rgba[i]) - double(b.rgba[i]);
+        sum += d * d;
+    }
+    double mse = sum / double(a.rgba.size());
+    return mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : 99.0;
+}
+
+// 내용으로 형식 판단 (DDS 매직이 없으면 PNG)
+inline bool DecodeImage(const uint8_t* data, size_t size, ImageSet& out)
+{
+    if (size >= 4 && memcmp(data, "DDS ", 4) == 0)
+        return DecodeDds(data, size, out);
+
+    Image img;
+    if (!DecodePng(data, size, img)) return false;
+    out.mipLevels = 1;
+    out.faces = 1;
+    out.surfaces.clear();
+    out.surfaces.push_back(std::move(img));
+    return true;
+}
+
+inline bool LoadImageFile(const wchar_t* path, ImageSet& out)
+{
+    std::vector<uint8_t> bytes;
+    if (!ReadWholeFile(path, bytes)) return false;
+    return DecodeImage(bytes.data(), bytes.size(), out);
+}
@@ -0,0 +1,122 @@
+﻿#pragma once
+
+// 카메라 기준 절차적 바닥 그리드 (CPU 전용, Windows/D3D 의존성 없음)
+// - 월드 크기와 상관없이 카메라 주변의 보이는 선만 만든다 → 정점 수는 설정으로 정해진 상한 이하.
+// - 간격 LOD: 카메라 거리가 멀어지면 minor 간격을 majorEvery배씩 키운다.
+// - 거리 LOD: minor 선은 가까운 영역(minorHalfLines)만, major 선은 더 넓은 영역까지 그린다.
+// - 선은 월드 좌표의 간격 배수에 고정되므로 카메라가 움직여도 선이 미끄러지지 않는다.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// VertexPC와 같은 레이아웃 (pos, col)
+struct GridVertex
+{
+    float pos[3];
+    float col[3];
+};
+
+struct InfiniteGridSettings
+{
+    float cellSize = 1.0f;
+    int   majorEvery = 5;        // minor 간격 몇 개마다 major 선
+    int   minorHalfLines = 40;   // 중심에서 한쪽으로 그릴 minor 선 수
+    int   majorHalfLines = 40;   // 중심에서 한쪽으로 그릴 major 선 수
+    int   maxLevel = 6;          // 간격 LOD 상한 (minor 간격 = cellSize * majorEvery^level)
+
+    // 축마다 (minor 2N+1 + major 2M+1)개 선, 선당 정점 2개
+    size_t MaxVertices() const
+    {
+        return size_t(2) * 2 * size_t((2 * minorHalfLines + 1) + (2 * majorHalfLines + 1));
+    }
+};
+
+struct InfiniteGridInfo
+{
+    int   level = 0;
+    float minorSpacing = 0.0f;
+    float majorSpacing = 0.0f;
+    float boundsMin[3] = {};     // 생성된 선 전체의 AABB (y = 0)
+    float boundsMax[3] = {};
+    uint32_t minorLines = 0;
+    uint32_t majorLines = 0;
+};
+
+// 카메라 거리로 간격 레벨을 고른다: minor 영역이 카메라 거리 이상을 덮는 가장 작은 레벨
+inline int SelectGridLevel(float cameraDistance, const InfiniteGridSettings& s)
+{
+    int   level = 0;
+    float spacing = s.cellSize;
+    while (level < s.maxLevel && spacing * s.minorHalfLines < cameraDistance)
+    {
+        spacing *= float(s.majorEvery);
+        ++level;
+    }
+    return level;
+}
+
+// eye: 카메라 위치, cameraDistance: LOD 기준 거리 (궤도 카메라면 궤도 반지름)
+inline InfiniteGridInfo BuildInfiniteGrid(const float eye[3], float cameraDistance,
+                                          const InfiniteGridSettings& s, std::vector<GridVertex>& out)
+{
+    static const float cMajor[3] = { 1.0f, 1.0f, 1.0f };
+    static const float cMinor[3] = { 0.7f, 0.7f, 0.7f };
+    static const float cAxisX[3] = { 0.8f, 0.2f, 0.2f };
+    static const float cAxisZ[3] = { 0.2f, 0.4f, 0.8f };
+
+    InfiniteGridInfo info;
+    info.level = SelectGridLevel(std::max(cameraDistance, fabsf(eye[1])), s);
+    info.minorSpacing = s.cellSize * powf(float(s.majorEvery), float(info.level));
+    info.majorSpacing = info.minorSpacing * float(s.majorEvery);
+
+    out.clear();
+    out.reserve(s.MaxVertices());
+
+    // 카메라 바로 아래의 major 선에 중심을 맞춘다 (minor 선도 major 배수에 정렬됨)
+    const double major = info.majorSpacing, minor = info.minorSpacing;
+    const int64_t centerX = int64_t(floor(eye[0] / major + 0.5)) * s.majorEvery;   // minor 인덱스
+    const int64_t centerZ = int64_t(floor(eye[2] / major + 0.5)) * s.majorEvery;
+
+    const float majorExtent = float(s.majorHalfLines * major);
+    const float minorExtent = float(s.minorHalfLines * minor);
+    const float cx = float(centerX * minor), cz = float(centerZ * minor);
+
+    auto addLine = [&](float x0, float z0, float x1, float z1, const float* col)
+    {
+        out.push_back({ { x0, 0.0f, z0 }, { col[0], col[1], col[2] } });
+        out.push_back({ { x1, 0.0f, z1 }, { col[0], col[1], col[2] } });
+    };
+
+    // minor 선 (major 배수 위치는 major 패스에서 그림)
+    for (int i = -s.minorHalfLines; i <= s.minorHalfLines; ++i)
+    {
+        int64_t ix = centerX + i, iz = centerZ + i;
+        if (iz % s.majorEvery != 0)
+        {
+            addLine(cx - minorExtent, float(iz * minor), cx + minorExtent, float(iz * minor), cMinor);
+            ++info.minorLines;
+        }
+        if (ix % s.majorEvery != 0)
+        {
+            addLine(float(ix * minor), cz - minorExtent, float(ix * minor), cz + minorExtent, cMinor);
+            ++info.minorLines;
+        }
+    }
+
+    // major 선 + 월드 축 (X 방향 선 중 z = 0 → cAxisZ, Z 방향 선 중 x = 0 → cAxisX: 기존 그리드와 같은 색)
+    const int64_t majorX = centerX / s.majorEvery, majorZ = centerZ / s.majorEvery;
+    for (int j = -s.majorHalfLines; j <= s.majorHalfLines; ++j)
+    {
+        int64_t jz = majorZ + j, jx = majorX + j;
+        addLine(cx - majorExtent, float(jz * major), cx + majorExtent, float(jz * major), jz == 0 ? cAxisZ : cMajor);
+        addLine(float(jx * major), cz - majorExtent, float(jx * major), cz + majorExtent, jx == 0 ? cAxisX : cMajor);
+        info.majorLines += 2;
+    }
+
+    const float extent = std::max(majorExtent, minorExtent);
+    info.boundsMin[0] = cx - extent; info.boundsMin[1] = 0.0f; info.boundsMin[2] = cz - extent;
+    info.boundsMax[0] = cx + extent; info.boundsMax[1] = 0.0f; info.boundsMax[2] = cz + extent;
+    return info;
+}
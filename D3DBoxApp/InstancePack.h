@@ -0,0 +1,233 @@
+﻿#pragma once
+
+// 인스턴스 데이터 일괄 패킹 (CPU 전용, Windows/D3D 의존성 없음)
+// - 월드 행렬 배열(행 우선, SimpleMath Matrix 배치)을 전치해서 GPU용 3x4(InstanceData) / 4x4 행으로 한 번에 쓴다.
+// - AVX2: 행렬 2개를 256비트 한 벌로 묶어 lane 안에서 4x4 전치 / SSE: 행렬 1개씩 / 그 외 스칼라
+// - 셀 좌표 배열(위치 + 셀 크기 스케일)에서 InstanceData를 바로 만드는 커널도 둔다 (PlacedBoxStore::PackInstance와 같은 결과).
+// - streaming = true면 출력이 정렬된 경우 non-temporal 저장 (매핑된 업로드 버퍼처럼 다시 읽지 않는 곳용).
+//   곧바로 다시 읽을 배열(컬링 입력 등)에는 캐시를 거치는 일반 저장이 낫다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INSTANCE_PACK_AVX2 1
+#define INSTANCE_PACK_SSE 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define INSTANCE_PACK_SSE 1
+#endif
+
+#include "SparseGrid.h"
+
+// 인스턴스 버퍼 한 항목: 전치된 월드 행렬의 상위 3행 (48 bytes)
+// HLSL에서 posW = float3(dot(w0, p), dot(w1, p), dot(w2, p)) 로 사용
+struct InstanceData
+{
+    float row0[4];
+    float row1[4];
+    float row2[4];
+};
+
+#if defined(INSTANCE_PACK_SSE)
+inline void StoreInstanceRow(float* dst, __m128 v, bool stream)
+{
+    if (stream) _mm_stream_ps(dst, v);
+    else        _mm_storeu_ps(dst, v);
+}
+#endif
+
+#if defined(INSTANCE_PACK_AVX2)
+inline void StoreInstanceRows(float* dst, __m256 v, bool stream)
+{
+    if (stream) _mm256_stream_ps(dst, v);
+    else        _mm256_storeu_ps(dst, v);
+}
+
+// 행렬 a, b의 같은 행을 한 벌로 읽는다 (하위 128비트 = a, 상위 = b)
+inline __m256 LoadMatrixRowPair(const float* a, const float* b)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a)), _mm_loadu_ps(b), 1);
+}
+
+// lane별 4x4 전치: c[k] = (a의 열 k | b의 열 k)
+inline void TransposeMatrixPair(const float* a, const float* b, __m256 c[4])
+{
+    __m256 r0 = LoadMatrixRowPair(a, b), r1 = LoadMatrixRowPair(a + 4, b + 4);
+    __m256 r2 = LoadMatrixRowPair(a + 8, b + 8), r3 = LoadMatrixRowPair(a + 12, b + 12);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+    c[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    c[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    c[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+#endif
+
+// 행렬 하나를 전치해서 앞 rows개 행을 쓴다 (나머지 꼬리 / SSE 경로)
+inline void PackTransposedOne(const float* m, float* dst, int rows, bool stream)
+{
+#if defined(INSTANCE_PACK_SSE)
+    __m128 r0 = _mm_loadu_ps(m), r1 = _mm_loadu_ps(m + 4), r2 = _mm_loadu_ps(m + 8), r3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    StoreInstanceRow(dst, r0, stream);
+    StoreInstanceRow(dst + 4, r1, stream);
+    StoreInstanceRow(dst + 8, r2, stream);
+    if (rows == 4) StoreInstanceRow(dst + 12, r3, stream);
+#else
+    (void)stream;
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < 4; ++c) dst[r * 4 + c] = m[c * 4 + r];
+#endif
+}
+
+// worlds: count개의 행 우선 4x4 (행 벡터 규약, 이동은 4행) → out: 전치한 상위 3행
+inline void PackTransposed3x4(const float* worlds, size_t count, InstanceData* out, bool streaming = true)
+{
+    float* dst = out->row0;
+    size_t i = 0;
+#if defined(INSTANCE_PACK_AVX2)
+    // 2개씩 96 bytes = 256비트 3번: [a0 a1] [a2 b0] [b1 b2]
+    const bool stream = streaming && (uintptr_t(dst) & 31) == 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m256 c[4];
+        TransposeMatrixPair(worlds + i * 16, worlds + i * 16 + 16, c);
+        float* d = dst + i * 12;
+        StoreInstanceRows(d, _mm256_permute2f128_ps(c[0], c[1], 0x20), stream);
+        StoreInstanceRows(d + 8, _mm256_permute2f128_ps(c[2], c[0], 0x30), stream);
+        StoreInstanceRows(d + 16, _mm256_permute2f128_ps(c[1], c[2], 0x31), stream);
+    }
+#endif
+#if defined(INSTANCE_PACK_SSE)
+    const bool streamOne = streaming && (uintptr_t(dst) & 15) == 0;
+#else
+    const bool streamOne = false;
+#endif
+    for (; i < count; ++i) PackTransposedOne(worlds + i * 16, dst + i * 12, 3, streamOne);
+#if defined(INSTANCE_PACK_SSE)
+    if (streaming) _mm_sfence();
+#endif
+}
+
+// worlds → out: 전치한 4x4 (상수 버퍼의 float4x4 배치), 행렬당 16 floats
+inline void PackTransposed4x4(const float* worlds, size_t count, float* out, bool streaming = true)
+{
+    size_t i = 0;
+#if defined(INSTANCE_PACK_AVX2)
+    const bool stream = streaming && (uintptr_t(out) & 31) == 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m256 c[4];
+        TransposeMatrixPair(worlds + i * 16, worlds + i * 16 + 16, c);
+        float* d = out + i * 16;
+        StoreInstanceRows(d, _mm256_permute2f128_ps(c[0], c[1], 0x20), stream);
+        StoreInstanceRows(d + 8, _mm256_permute2f128_ps(c[2], c[3], 0x20), stream);
+        StoreInstanceRows(d + 16, _mm256_permute2f128_ps(c[0], c[1], 0x31), stream);
+        StoreInstanceRows(d + 24, _mm256_permute2f128_ps(c[2], c[3], 0x31), stream);
+    }
+#endif
+#if defined(INSTANCE_PACK_SSE)
+    const bool streamOne = streaming && (uintptr_t(out) & 15) == 0;
+#else
+    const bool streamOne = false;
+#endif
+    for (; i < count; ++i) PackTransposedOne(worlds + i * 16, out + i * 16, 4, streamOne);
+#if defined(INSTANCE_PACK_SSE)
+    if (streaming) _mm_sfence();
+#endif
+}
+
+// 셀 → 월드 (PlacedBoxStore::PackInstance와 같은 배치): 대각 = 셀 크기, 이동 = (x + 0.5, y, z + 0.5) * 셀 크기
+inline void PackCellInstances(const CellCoord* cells, size_t count, float cellSize, InstanceData* out, bool streaming = false)
+{
+#if defined(INSTANCE_PACK_SSE)
+    const __m128 s = _mm_set1_ps(cellSize);
+    const __m128 half = _mm_setr_ps(0.5f, 0.0f, 0.5f, 0.0f);
+    const __m128 lane3 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    const __m128 d0 = _mm_setr_ps(cellSize, 0.0f, 0.0f, 0.0f);
+    const __m128 d1 = _mm_setr_ps(0.0f, cellSize, 0.0f, 0.0f);
+    const __m128 d2 = _mm_setr_ps(0.0f, 0.0f, cellSize, 0.0f);
+    const bool stream = streaming && (uintptr_t(out) & 15) == 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const CellCoord& c = cells[i];
+        __m128 t = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(_mm_setr_epi32(c.x, c.y, c.z, 0)), half), s);
+        float* d = out[i].row0;
+        StoreInstanceRow(d, _mm_or_ps(d0, _mm_and_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)), lane3)), stream);
+        StoreInstanceRow(d + 4, _mm_or_ps(d1, _mm_and_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)), lane3)), stream);
+        StoreInstanceRow(d + 8, _mm_or_ps(d2, _mm_and_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)), lane3)), stream);
+    }
+    if (stream) _mm_sfence();
+#else
+    (void)streaming;
+    const float s = cellSize;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const CellCoord& c = cells[i];
+        InstanceData& o = out[i];
+        o.row0[0] = s;    o.row0[1] = 0.0f; o.row0[2] = 0.0f; o.row0[3] = (c.x + 0.5f) * s;
+        o.row1[0] = 0.0f; o.row1[1] = s;    o.row1[2] = 0.0f; o.row1[3] = c.y * s;
+        o.row2[0] = 0.0f; o.row2[1] = 0.0f; o.row2[2] = s;    o.row2[3] = (c.z + 0.5f) * s;
+    }
+#endif
+}
+
+struct InstancePackBenchmark
+{
+    size_t count = 0;
+    double referenceMs = 0.0;   // 행렬마다 전치 후 복사 (reference 콜백)
+    double packMs = 0.0;        // 일괄 커널, 일반 저장
+    double streamMs = 0.0;      // 일괄 커널, 스트리밍 저장
+    bool   matches = false;     // 세 경로 결과가 비트 단위로 같은지
+};
+
+// 행렬 하나 → InstanceData (비교 기준. 앱은 SimpleMath Matrix::Transpose 경로를 넘긴다)
+using InstancePackReference = void (*)(const float* world, InstanceData& out);
+
+// 벤치마크: 무작위 아핀 월드 행렬 count개를 기준 경로 / 일괄 커널(일반, 스트리밍)로 패킹해 최솟값을 비교한다.
+inline InstancePackBenchmark BenchmarkInstancePack(size_t count, InstancePackReference reference, int iterations = 5)
+{
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+    std::vector<float> worlds(count * 16);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float* m = worlds.data() + i * 16;
+        for (int k = 0; k < 16; ++k) m[k] = value(rng);
+        m[3] = m[7] = m[11] = 0.0f;
+        m[15] = 1.0f;
+    }
+
+    // 스트리밍 저장이 256비트 정렬을 쓰도록 한 칸 여유를 두고 시작점을 맞춘다 (48 bytes 간격이라 짝수 항목마다 32 정렬)
+    std::vector<InstanceData> refStorage(count), packStorage(count + 1), streamStorage(count + 1);
+    auto aligned = [](std::vector<InstanceData>& v) { return v.data() + ((uintptr_t(v.data()) & 31) ? 1 : 0); };
+    InstanceData* pack = aligned(packStorage);
+    InstanceData* stream = aligned(streamStorage);
+
+    InstancePackBenchmark r;
+    r.count = count;
+    r.referenceMs = r.packMs = r.streamMs = 1e30;
+    for (int it = 0; it < iterations; ++it)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < count; ++i) reference(worlds.data() + i * 16, refStorage[i]);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        PackTransposed3x4(worlds.data(), count, pack, false);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        PackTransposed3x4(worlds.data(), count, stream, true);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        r.referenceMs = std::min(r.referenceMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+        r.packMs = std::min(r.packMs, std::chrono::duration<double, std::milli>(t2 - t1).count());
+        r.streamMs = std::min(r.streamMs, std::chrono::duration<double, std::milli>(t3 - t2).count());
+    }
+
+    r.matches = memcmp(refStorage.data(), pack, count * sizeof(InstanceData)) == 0 &&
+                memcmp(refStorage.data(), stream, count * sizeof(InstanceData)) == 0;
+    return r;
+}
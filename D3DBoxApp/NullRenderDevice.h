@@ -0,0 +1,452 @@
+﻿#pragma once
+
+// GPU 없는 렌더 백엔드 (Windows/D3D 의존성 없음)
+// - 리소스는 설명(desc)만 보관하고, 명령은 실행하지 않는다.
+// - 호출을 검증한다: 잘못된/해제된 핸들, 용도가 다른 버퍼 바인딩, 셰이더 단계 불일치,
+//   레이아웃이 요구하는 슬롯 누락, 버퍼 범위를 넘는 드로우, Immutable 버퍼 갱신,
+//   정렬되지 않은 상수 버퍼 구간, 매핑한 채로 드로우.
+// - 펜스는 GPU_LATENCY_FRAMES 프레임 (Present 횟수) 뒤에 끝난 것으로 친다. WaitForFence는 즉시 끝낸다.
+// - 드로우/상태 변경/업로드 바이트를 센다 (RenderCounters).
+// - m_Record = true 이면 명령을 m_Log에 기록한다 (헤드리스 테스트/비교용).
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "CommandStream.h"
+#include "RenderDevice.h"
+
+enum class NullOp : uint8_t
+{
+    Clear, Viewport, InputLayout, Topology, VertexBuffer, IndexBuffer,
+    VertexShader, PixelShader, VSConstantBuffer, VSConstantBufferRange, PSConstantBuffer, PSTexture, PSSampler,
+    DepthState, RasterState, UpdateBuffer, Map, Unmap, Draw, DrawIndexed, DrawIndexedInstanced,
+};
+
+struct NullCommand
+{
+    NullOp   op;
+    uint32_t a = 0, b = 0, c = 0;   // 명령별 인자 (슬롯/핸들/개수 등)
+};
+
+struct NullRenderDevice;
+
+struct NullRenderContext final : IRenderContext
+{
+    static constexpr uint32_t MAX_VB_SLOTS = 4;
+    static constexpr uint32_t MAX_CB_SLOTS = 4;
+
+    NullRenderDevice&        m_Device;
+    RenderCounters           m_Counters;
+    std::vector<std::string> m_Errors;          // 처음 MAX_ERRORS개만 보관
+    static constexpr size_t  MAX_ERRORS = 64;
+    bool                     m_Record = false;
+    std::vector<NullCommand> m_Log;
+
+    // 현재 바인딩
+    InputLayoutHandle        m_Layout;
+    PrimitiveTopology        m_Topology = PrimitiveTopology::TriangleList;
+    BufferHandle             m_VB[MAX_VB_SLOTS];
+    uint32_t                 m_VBStride[MAX_VB_SLOTS] = {};
+    BufferHandle             m_IB;
+    IndexFormat              m_IBFormat = IndexFormat::UInt16;
+    ShaderHandle             m_VS, m_PS;
+    BufferHandle             m_VSCB[MAX_CB_SLOTS], m_PSCB[MAX_CB_SLOTS];
+    BufferHandle             m_Mapped;                  // 지금 열려 있는 버퍼 (하나만)
+    std::vector<uint8_t>     m_MapScratch;              // MapBuffer가 돌려주는 쓰기 공간 (내용은 버린다)
+
+    explicit NullRenderContext(NullRenderDevice& device) : m_Device(device) {}
+
+    void Error(const char* what)
+    {
+        ++m_Counters.validationErrors;
+        if (m_Errors.size() < MAX_ERRORS) m_Errors.emplace_back(what);
+    }
+
+    void Record(NullOp op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0)
+    {
+        if (m_Record) m_Log.push_back({ op, a, b, c });
+    }
+
+    void StateChange(NullOp op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0)
+    {
+        ++m_Counters.stateChanges;
+        Record(op, a, b, c);
+    }
+
+    // 아래는 NullRenderDevice 정의 뒤에 구현
+    bool CheckBuffer(BufferHandle h, BufferBind bind, const char* what);
+    bool CheckShader(ShaderHandle h, ShaderStage stage, const char* what);
+    bool CheckDrawState(uint32_t vertexEnd, uint32_t instanceEnd);
+    uint32_t BufferBytes(BufferHandle h);
+
+    void ClearTargets(const float*, float) override { Record(NullOp::Clear); }
+
+    void SetViewport(const RenderViewport& vp) override
+    {
+        if (vp.width <= 0 || vp.height <= 0) Error("SetViewport: empty viewport");
+        StateChange(NullOp::Viewport, uint32_t(vp.width), uint32_t(vp.height));
+    }
+
+    void SetInputLayout(InputLayoutHandle layout) override;
+
+    void SetPrimitiveTopology(PrimitiveTopology topology) override
+    {
+        m_Topology = topology;
+        StateChange(NullOp::Topology, uint32_t(topology));
+    }
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                          const uint32_t* strides, const uint32_t*) override
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t slot = startSlot + i;
+            if (slot >= MAX_VB_SLOTS) { Error("SetVertexBuffers: slot out of range"); break; }
+            if (buffers[i]) CheckBuffer(buffers[i], BufferBind::Vertex, "SetVertexBuffers");
+            m_VB[slot] = buffers[i];
+            m_VBStride[slot] = strides[i];
+            StateChange(NullOp::VertexBuffer, slot, buffers[i].id, strides[i]);
+        }
+    }
+
+    void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) override
+    {
+        if (buffer) CheckBuffer(buffer, BufferBind::Index, "SetIndexBuffer");
+        m_IB = buffer;
+        m_IBFormat = format;
+        StateChange(NullOp::IndexBuffer, buffer.id, uint32_t(format), offset);
+    }
+
+    void SetVertexShader(ShaderHandle shader) override
+    {
+        if (shader) CheckShader(shader, ShaderStage::Vertex, "SetVertexShader");
+        m_VS = shader;
+        StateChange(NullOp::VertexShader, shader.id);
+    }
+
+    void SetPixelShader(ShaderHandle shader) override
+    {
+        if (shader) CheckShader(shader, ShaderStage::Pixel, "SetPixelShader");
+        m_PS = shader;
+        StateChange(NullOp::PixelShader, shader.id);
+    }
+
+    void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        if (slot >= MAX_CB_SLOTS) { Error("SetVSConstantBuffer: slot out of range"); return; }
+        if (buffer) CheckBuffer(buffer, BufferBind::Constant, "SetVSConstantBuffer");
+        m_VSCB[slot] = buffer;
+        StateChange(NullOp::VSConstantBuffer, slot, buffer.id);
+    }
+
+    void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes) override
+    {
+        if (slot >= MAX_CB_SLOTS) { Error("SetVSConstantBufferRange: slot out of range"); return; }
+        if (buffer && CheckBuffer(buffer, BufferBind::Constant, "SetVSConstantBufferRange"))
+        {
+            if (offset % CONSTANT_BUFFER_ALIGNMENT || bytes % CONSTANT_BUFFER_ALIGNMENT || bytes == 0)
+                Error("SetVSConstantBufferRange: offset/size not 256-byte aligned");
+            else if (uint64_t(offset) + bytes > BufferBytes(buffer))
+                Error("SetVSConstantBufferRange: range exceeds buffer");
+        }
+        m_VSCB[slot] = buffer;
+        StateChange(NullOp::VSConstantBufferRange, slot, buffer.id, offset);
+    }
+
+    void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        if (slot >= MAX_CB_SLOTS) { Error("SetPSConstantBuffer: slot out of range"); return; }
+        if (buffer) CheckBuffer(buffer, BufferBind::Constant, "SetPSConstantBuffer");
+        m_PSCB[slot] = buffer;
+        StateChange(NullOp::PSConstantBuffer, slot, buffer.id);
+    }
+
+    void SetPSTexture(uint32_t slot, TextureHandle texture) override;
+    void SetPSSampler(uint32_t slot, SamplerHandle sampler) override;
+    void SetDepthState(DepthStateHandle state) override;
+    void SetRasterState(RasterStateHandle state) override;
+    bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) override;
+    void* MapBuffer(BufferHandle buffer, MapMode mode) override;
+    void UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten) override;
+
+    void Draw(uint32_t vertexCount, uint32_t startVertex) override
+    {
+        CheckDrawState(startVertex + vertexCount, 0);
+        ++m_Counters.draws;
+        m_Counters.instances += 1;
+        m_Counters.primitives += PrimitiveCount(m_Topology, vertexCount);
+        Record(NullOp::Draw, vertexCount, startVertex);
+    }
+
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override
+    {
+        CheckIndexed(indexCount, startIndex);
+        CheckDrawState(0, 0);
+        ++m_Counters.draws;
+        m_Counters.instances += 1;
+        m_Counters.primitives += PrimitiveCount(m_Topology, indexCount);
+        Record(NullOp::DrawIndexed, indexCount, startIndex, uint32_t(baseVertex));
+    }
+
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t, uint32_t startInstance) override
+    {
+        CheckIndexed(indexCount, startIndex);
+        CheckDrawState(0, startInstance + instanceCount);
+        ++m_Counters.draws;
+        m_Counters.instances += instanceCount;
+        m_Counters.primitives += PrimitiveCount(m_Topology, indexCount) * instanceCount;
+        Record(NullOp::DrawIndexedInstanced, indexCount, instanceCount, startInstance);
+    }
+
+    void CheckIndexed(uint32_t indexCount, uint32_t startIndex)
+    {
+        if (!m_IB) { Error("DrawIndexed: no index buffer"); return; }
+        uint32_t indexSize = (m_IBFormat == IndexFormat::UInt16) ? 2 : 4;
+        if (uint64_t(startIndex + indexCount) * indexSize > BufferBytes(m_IB))
+            Error("DrawIndexed: index range exceeds buffer");
+    }
+
+    // 지연 컨텍스트는 CommandStreamContext라서 목록은 항상 CommandStream
+    void ExecuteCommandList(IRenderCommandList& list) override { static_cast<CommandStream&>(list).Replay(*this); }
+
+    const RenderCounters& Counters() const override { return m_Counters; }
+    void ResetCounters() override { m_Counters = RenderCounters{}; }
+};
+
+struct NullRenderDevice final : IRenderDevice
+{
+    static constexpr uint64_t GPU_LATENCY_FRAMES = 2;
+
+    struct Layout
+    {
+        uint32_t vertexSlots = 0;     // 비트마스크: 정점 단위 슬롯
+        uint32_t instanceSlots = 0;   // 비트마스크: 인스턴스 단위 슬롯
+    };
+
+    HandleTable<BufferDesc>      m_Buffers;
+    HandleTable<ShaderStage>     m_Shaders;
+    HandleTable<Layout>          m_Layouts;
+    HandleTable<std::wstring>    m_Textures;
+    HandleTable<SamplerDesc>     m_Samplers;
+    HandleTable<DepthStateDesc>  m_DepthStates;
+    HandleTable<RasterStateDesc> m_RasterStates;
+    NullRenderContext            m_Context{ *this };
+    uint32_t                     m_Width = 0, m_Height = 0;
+    uint64_t                     m_Frames = 0;
+    uint64_t                     m_LastFence = 0, m_CompletedFence = 0;
+    std::deque<std::pair<uint64_t, uint64_t>> m_PendingFences;   // (펜스, 넣은 프레임)
+    uint64_t                     m_FenceWaits = 0;              // WaitForFence가 기다려야 했던 횟수
+
+    NullRenderDevice(uint32_t width = 1280, uint32_t height = 720) : m_Width(width), m_Height(height) {}
+
+    IRenderContext& Context() override { return m_Context; }
+    std::unique_ptr<IDeferredContext> CreateDeferredContext() override { return std::make_unique<CommandStreamContext>(); }
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* initData) override
+    {
+        if (desc.byteWidth == 0) { m_Context.Error("CreateBuffer: zero size"); return {}; }
+        if (desc.usage == BufferUsage::Immutable && !initData)
+        {
+            m_Context.Error("CreateBuffer: immutable buffer without data");
+            return {};
+        }
+        ++m_Context.m_Counters.buffersCreated;
+        if (initData) m_Context.m_Counters.bytesUploaded += desc.byteWidth;
+        return { m_Buffers.Add(desc) };
+    }
+
+    ShaderHandle CreateShader(const ShaderDesc& desc) override
+    {
+        if (!desc.file || !desc.entry) { m_Context.Error("CreateShader: missing file/entry"); return {}; }
+        return { m_Shaders.Add(desc.stage) };
+    }
+
+    InputLayoutHandle CreateInputLayout(const VertexElement* elements, uint32_t count, ShaderHandle vs) override
+    {
+        const ShaderStage* stage = m_Shaders.Get(vs.id);
+        if (!stage || *stage != ShaderStage::Vertex)
+        {
+            m_Context.Error("CreateInputLayout: invalid vertex shader");
+            return {};
+        }
+        Layout l;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (elements[i].slot >= NullRenderContext::MAX_VB_SLOTS)
+            {
+                m_Context.Error("CreateInputLayout: slot out of range");
+                return {};
+            }
+            (elements[i].perInstance ? l.instanceSlots : l.vertexSlots) |= 1u << elements[i].slot;
+        }
+        return { m_Layouts.Add(l) };
+    }
+
+    TextureHandle LoadTexture(const wchar_t* path) override
+    {
+        if (!path) { m_Context.Error("LoadTexture: null path"); return {}; }
+        return { m_Textures.Add(path) };
+    }
+
+    TextureHandle CreateTexture(const TextureDesc& desc, const void* const* mipData) override
+    {
+        if (desc.width == 0 || desc.height == 0 || desc.mipLevels == 0) { m_Context.Error("CreateTexture: empty texture"); return {}; }
+        if (!mipData) { m_Context.Error("CreateTexture: null data"); return {}; }
+        for (uint32_t m = 0; m < desc.mipLevels * (desc.cube ? 6u : 1u); ++m)
+            if (!mipData[m]) { m_Context.Error("CreateTexture: null mip data"); return {}; }
+        return { m_Textures.Add(L"<created>") };
+    }
+
+    SamplerHandle CreateSampler(const SamplerDesc& desc) override { return { m_Samplers.Add(desc) }; }
+    DepthStateHandle CreateDepthState(const DepthStateDesc& desc) override { return { m_DepthStates.Add(desc) }; }
+    RasterStateHandle CreateRasterState(const RasterStateDesc& desc) override { return { m_RasterStates.Add(desc) }; }
+
+    void DestroyBuffer(BufferHandle buffer) override
+    {
+        if (buffer && !m_Buffers.Remove(buffer.id)) m_Context.Error("DestroyBuffer: invalid handle");
+    }
+
+    void Resize(uint32_t width, uint32_t height) override { m_Width = width; m_Height = height; }
+    void Present(uint32_t) override
+    {
+        ++m_Frames;
+        while (!m_PendingFences.empty() && m_PendingFences.front().second + GPU_LATENCY_FRAMES <= m_Frames)
+        {
+            m_CompletedFence = m_PendingFences.front().first;
+            m_PendingFences.pop_front();
+        }
+    }
+
+    uint64_t InsertFence() override
+    {
+        m_PendingFences.push_back({ ++m_LastFence, m_Frames });
+        return m_LastFence;
+    }
+
+    bool IsFenceComplete(uint64_t fence) override { return fence <= m_CompletedFence; }
+    bool WaitForFrameLatency(uint32_t) override { return false; }
+
+    void WaitForFence(uint64_t fence) override
+    {
+        if (fence > m_LastFence) { m_Context.Error("WaitForFence: fence was never inserted"); return; }
+        if (fence <= m_CompletedFence) return;
+        ++m_FenceWaits;
+        m_CompletedFence = fence;
+        while (!m_PendingFences.empty() && m_PendingFences.front().first <= fence) m_PendingFences.pop_front();
+    }
+};
+
+inline uint32_t NullRenderContext::BufferBytes(BufferHandle h)
+{
+    const BufferDesc* d = m_Device.m_Buffers.Get(h.id);
+    return d ? d->byteWidth : 0;
+}
+
+inline bool NullRenderContext::CheckBuffer(BufferHandle h, BufferBind bind, const char* what)
+{
+    const BufferDesc* d = m_Device.m_Buffers.Get(h.id);
+    if (!d) { Error((std::string(what) + ": invalid buffer handle").c_str()); return false; }
+    if (d->bind != bind) { Error((std::string(what) + ": buffer bound with wrong usage").c_str()); return false; }
+    return true;
+}
+
+inline bool NullRenderContext::CheckShader(ShaderHandle h, ShaderStage stage, const char* what)
+{
+    const ShaderStage* s = m_Device.m_Shaders.Get(h.id);
+    if (!s) { Error((std::string(what) + ": invalid shader handle").c_str()); return false; }
+    if (*s != stage) { Error((std::string(what) + ": shader stage mismatch").c_str()); return false; }
+    return true;
+}
+
+// vertexEnd/instanceEnd: 0 이면 범위 검사 생략
+inline bool NullRenderContext::CheckDrawState(uint32_t vertexEnd, uint32_t instanceEnd)
+{
+    bool ok = true;
+    if (m_Mapped) { Error("Draw: a buffer is still mapped"); ok = false; }
+    if (!m_Device.m_Shaders.Get(m_VS.id)) { Error("Draw: no vertex shader"); ok = false; }
+    if (!m_Device.m_Shaders.Get(m_PS.id)) { Error("Draw: no pixel shader"); ok = false; }
+
+    const NullRenderDevice::Layout* l = m_Device.m_Layouts.Get(m_Layout.id);
+    if (!l) { Error("Draw: no input layout"); return false; }
+
+    for (uint32_t s = 0; s < MAX_VB_SLOTS; ++s)
+    {
+        bool perVertex = (l->vertexSlots >> s) & 1, perInstance = (l->instanceSlots >> s) & 1;
+        if (!perVertex && !perInstance) continue;
+        if (!m_Device.m_Buffers.Get(m_VB[s].id)) { Error("Draw: vertex buffer slot required by layout is empty"); ok = false; continue; }
+
+        uint64_t bytes = BufferBytes(m_VB[s]);
+        uint32_t end = perInstance ? instanceEnd : vertexEnd;
+        if (end && uint64_t(end) * m_VBStride[s] > bytes) { Error("Draw: range exceeds vertex buffer"); ok = false; }
+    }
+    return ok;
+}
+
+inline void NullRenderContext::SetInputLayout(InputLayoutHandle layout)
+{
+    if (layout && !m_Device.m_Layouts.Get(layout.id)) Error("SetInputLayout: invalid handle");
+    m_Layout = layout;
+    StateChange(NullOp::InputLayout, layout.id);
+}
+
+inline void NullRenderContext::SetPSTexture(uint32_t slot, TextureHandle texture)
+{
+    if (texture && !m_Device.m_Textures.Get(texture.id)) Error("SetPSTexture: invalid handle");
+    StateChange(NullOp::PSTexture, slot, texture.id);
+}
+
+inline void NullRenderContext::SetPSSampler(uint32_t slot, SamplerHandle sampler)
+{
+    if (sampler && !m_Device.m_Samplers.Get(sampler.id)) Error("SetPSSampler: invalid handle");
+    StateChange(NullOp::PSSampler, slot, sampler.id);
+}
+
+inline void NullRenderContext::SetDepthState(DepthStateHandle state)
+{
+    if (state && !m_Device.m_DepthStates.Get(state.id)) Error("SetDepthState: invalid handle");
+    StateChange(NullOp::DepthState, state.id);
+}
+
+inline void NullRenderContext::SetRasterState(RasterStateHandle state)
+{
+    if (state && !m_Device.m_RasterStates.Get(state.id)) Error("SetRasterState: invalid handle");
+    StateChange(NullOp::RasterState, state.id);
+}
+
+inline bool NullRenderContext::UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes)
+{
+    const BufferDesc* d = m_Device.m_Buffers.Get(buffer.id);
+    if (!d) { Error("UpdateBuffer: invalid buffer handle"); return false; }
+    if (d->usage != BufferUsage::Dynamic) { Error("UpdateBuffer: buffer is not dynamic"); return false; }
+    if (!data || bytes > d->byteWidth) { Error("UpdateBuffer: size exceeds buffer"); return false; }
+    if (buffer == m_Mapped) { Error("UpdateBuffer: buffer is mapped"); return false; }
+    m_Counters.bytesUploaded += bytes;
+    ++m_Counters.maps;
+    Record(NullOp::UpdateBuffer, buffer.id, bytes);
+    return true;
+}
+
+inline void* NullRenderContext::MapBuffer(BufferHandle buffer, MapMode mode)
+{
+    const BufferDesc* d = m_Device.m_Buffers.Get(buffer.id);
+    if (!d) { Error("MapBuffer: invalid buffer handle"); return nullptr; }
+    if (d->usage != BufferUsage::Dynamic) { Error("MapBuffer: buffer is not dynamic"); return nullptr; }
+    if (m_Mapped) { Error("MapBuffer: another buffer is already mapped"); return nullptr; }
+    m_Mapped = buffer;
+    m_MapScratch.resize(std::max<size_t>(m_MapScratch.size(), d->byteWidth));
+    ++m_Counters.maps;
+    Record(NullOp::Map, buffer.id, uint32_t(mode));
+    return m_MapScratch.data();
+}
+
+inline void NullRenderContext::UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten)
+{
+    if (!m_Mapped || buffer != m_Mapped) { Error("UnmapBuffer: buffer is not mapped"); return; }
+    if (bytesWritten > BufferBytes(buffer)) Error("UnmapBuffer: bytesWritten exceeds buffer");
+    m_Mapped = {};
+    m_Counters.bytesUploaded += bytesWritten;
+    Record(NullOp::Unmap, buffer.id, bytesWritten);
+}
@@ -0,0 +1,363 @@
+﻿#pragma once
+
+// CPU 소프트웨어 오클루전 컬링 (CPU 전용, Windows/D3D 의존성 없음)
+// - 가까운 박스를 가리개(occluder)로 저해상도 깊이 버퍼에 래스터라이즈
+//   (박스의 화면 실루엣 = 투영한 8 모서리의 볼록 껍질을 타일에 비닝 → 타일 단위로 스레드 병렬, 픽셀 4개씩 SSE 처리)
+// - 8x8 블록마다 최대 깊이(HiZ)를 만들고, 나머지 박스의 화면 사각형/최소 깊이로 가려짐 판정
+// - 판정은 보수적이다 (애매하면 보임): 가리개는 픽셀 전체가 덮일 때만 깊이를 쓰고 (inner-conservative,
+//   엣지 함수를 픽셀의 가장 불리한 모서리에서 본다), 깊이는 박스의 가장 먼 모서리 깊이를 쓴다.
+//   그래서 두 가리개 사이의 틈이 픽셀 하나보다 좁아도 그 픽셀은 비어 있다.
+//   대가로 인접한 가리개끼리의 경계 픽셀도 비므로 벽을 이룬 박스들은 이음매마다 조금씩 새어 보인다.
+// - 깊이는 D3D 규약 z/w ∈ [0, 1], 작을수록 가깝다.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define OCCLUSION_SSE 1
+#endif
+
+#include "BoxMath.h"
+#include "ThreadPool.h"
+
+struct OcclusionStats
+{
+    uint32_t occluders = 0;
+    uint32_t polygons = 0;
+    uint32_t tested = 0;
+    uint32_t occluded = 0;
+    double   rasterMicroseconds = 0.0;
+    double   testMicroseconds = 0.0;
+};
+
+struct OcclusionCuller
+{
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 144;
+    static constexpr int TILE_W = 32;
+    static constexpr int TILE_H = 16;
+    static constexpr int TILES_X = WIDTH / TILE_W;
+    static constexpr int TILES_Y = HEIGHT / TILE_H;
+    static constexpr int HIZ = 8;                       // HiZ 블록 크기 (픽셀)
+    static constexpr int HIZ_W = WIDTH / HIZ;
+    static constexpr int HIZ_H = HEIGHT / HIZ;
+
+    static constexpr int MAX_EDGES = 6;                 // 박스 실루엣은 최대 육각형
+
+    // 볼록 다각형 가리개. 엣지 함수 E(x, y) = A x + B y + C는 픽셀 중심에서 재며,
+    // C에 반 픽셀만큼을 빼 두어서 E >= 0이면 픽셀의 네 모서리가 모두 안쪽이다.
+    struct Poly
+    {
+        float A[MAX_EDGES], B[MAX_EDGES], C[MAX_EDGES];
+        int   edges = 0;
+        float z = 1.0f;                   // 덮인 픽셀에 쓸 깊이
+        int   minX, minY, maxX, maxY;     // 완전히 덮일 수 있는 픽셀 경계 (포함)
+    };
+
+    float                               m_ViewProj[16] = {};
+    std::vector<float>                  m_Depth;   // WIDTH * HEIGHT
+    std::vector<float>                  m_HiZ;     // HIZ_W * HIZ_H, 블록 내 최대 깊이
+    std::vector<Poly>                   m_Polys;
+    std::vector<std::vector<uint32_t>>  m_Bins;    // 타일별 다각형 인덱스
+    OcclusionStats                      m_Stats;
+
+    OcclusionCuller()
+        : m_Depth(WIDTH * HEIGHT, 1.0f), m_HiZ(HIZ_W * HIZ_H, 1.0f), m_Bins(TILES_X * TILES_Y)
+    {
+    }
+
+    // 한 프레임 시작: 가리개 목록 초기화 (m: 행 우선 view-proj, clip = p * m)
+    void BeginFrame(const float* viewProj)
+    {
+        std::copy(viewProj, viewProj + 16, m_ViewProj);
+        m_Polys.clear();
+        for (auto& bin : m_Bins) bin.clear();
+        m_Stats = OcclusionStats{};
+    }
+
+    void ToClip(const float p[3], float out[4]) const
+    {
+        const float* m = m_ViewProj;
+        for (int c = 0; c < 4; ++c)
+            out[c] = p[0] * m[c] + p[1] * m[4 + c] + p[2] * m[8 + c] + m[12 + c];
+    }
+
+    static void Corners(const float mn[3], const float mx[3], float out[8][3])
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            out[i][0] = (i & 1) ? mx[0] : mn[0];
+            out[i][1] = (i & 2) ? mx[1] : mn[1];
+            out[i][2] = (i & 4) ? mx[2] : mn[2];
+        }
+    }
+
+    // AABB 가리개 추가. 근평면에 걸치는 박스는 보수적으로 건너뛴다.
+    // 화면 실루엣을 한 다각형으로 그려서 박스 안쪽 면 경계에서는 픽셀이 빠지지 않는다.
+    void AddOccluderBox(const float mn[3], const float mx[3])
+    {
+        float c[8][3], sx[8], sy[8], zmax = 0.0f;
+        Corners(mn, mx, c);
+        for (int i = 0; i < 8; ++i)
+        {
+            float clip[4];
+            ToClip(c[i], clip);
+            if (clip[3] <= 1e-4f || clip[2] < 0.0f) return;
+            float iw = 1.0f / clip[3];
+            sx[i] = (clip[0] * iw * 0.5f + 0.5f) * WIDTH;
+            sy[i] = (0.5f - clip[1] * iw * 0.5f) * HEIGHT;
+            zmax = std::max(zmax, clip[2] * iw);
+        }
+
+        ++m_Stats.occluders;
+        // 실루엣 안의 광선은 박스의 가장 먼 모서리보다 먼저 박스에 닿는다
+        AddPolygon(sx, sy, zmax);
+    }
+
+    // 점 8개의 볼록 껍질 (monotone chain)을 inner-conservative 다각형으로 비닝한다.
+    void AddPolygon(const float* sx, const float* sy, float z)
+    {
+        int order[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+        std::sort(order, order + 8, [&](int a, int b) { return sx[a] < sx[b] || (sx[a] == sx[b] && sy[a] < sy[b]); });
+        auto cross = [&](int o, int a, int b)
+        {
+            return (sx[a] - sx[o]) * (sy[b] - sy[o]) - (sy[a] - sy[o]) * (sx[b] - sx[o]);
+        };
+        int hull[16], n = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            while (n >= 2 && cross(hull[n - 2], hull[n - 1], order[i]) <= 0.0f) --n;
+            hull[n++] = order[i];
+        }
+        for (int i = 6, lower = n + 1; i >= 0; --i)
+        {
+            while (n >= lower && cross(hull[n - 2], hull[n - 1], order[i]) <= 0.0f) --n;
+            hull[n++] = order[i];
+        }
+        --n;   // 마지막 점은 첫 점
+        if (n < 3 || n > MAX_EDGES) return;
+
+        Poly p;
+        p.edges = n;
+        p.z = z;
+        float area = 0.0f, x0 = 1e30f, y0 = 1e30f, x1 = -1e30f, y1 = -1e30f;
+        for (int e = 0; e < n; ++e)
+        {
+            int i = hull[e], j = hull[(e + 1) % n];
+            p.A[e] = sy[i] - sy[j];
+            p.B[e] = sx[j] - sx[i];
+            p.C[e] = sx[i] * sy[j] - sx[j] * sy[i];
+            area += p.C[e];
+            x0 = std::min(x0, sx[i]); x1 = std::max(x1, sx[i]);
+            y0 = std::min(y0, sy[i]); y1 = std::max(y1, sy[i]);
+        }
+        if (fabsf(area) < 1e-6f) return;
+        for (int e = 0; e < n; ++e)
+        {
+            if (area < 0.0f) { p.A[e] = -p.A[e]; p.B[e] = -p.B[e]; p.C[e] = -p.C[e]; }
+            // 중심 → 가장 불리한 모서리 (반올림 오차 여유를 조금 더)
+            p.C[e] -= (0.5f + 1.0f / 256.0f) * (fabsf(p.A[e]) + fabsf(p.B[e]));
+        }
+
+        // 완전히 덮일 수 있는 픽셀은 [ceil(x0), floor(x1) - 1]
+        p.minX = std::max(0, int(ceilf(x0)));
+        p.minY = std::max(0, int(ceilf(y0)));
+        p.maxX = std::min(WIDTH - 1, int(floorf(x1)) - 1);
+        p.maxY = std::min(HEIGHT - 1, int(floorf(y1)) - 1);
+        if (p.minX > p.maxX || p.minY > p.maxY) return;
+
+        uint32_t pi = uint32_t(m_Polys.size());
+        m_Polys.push_back(p);
+        ++m_Stats.polygons;
+
+        for (int ty = p.minY / TILE_H; ty <= p.maxY / TILE_H; ++ty)
+            for (int tx = p.minX / TILE_W; tx <= p.maxX / TILE_W; ++tx)
+                m_Bins[ty * TILES_X + tx].push_back(pi);
+    }
+
+    // 타일 하나: 깊이 초기화 → 비닝된 다각형 래스터 → HiZ 갱신
+    void RasterizeTile(int tile)
+    {
+        const int tx0 = (tile % TILES_X) * TILE_W, ty0 = (tile / TILES_X) * TILE_H;
+        for (int y = 0; y < TILE_H; ++y)
+            std::fill_n(&m_Depth[(ty0 + y) * WIDTH + tx0], TILE_W, 1.0f);
+
+        for (uint32_t pi : m_Bins[tile])
+        {
+            const Poly& p = m_Polys[pi];
+            int x0 = std::max(p.minX, tx0), x1 = std::min(p.maxX, tx0 + TILE_W - 1);
+            int y0 = std::max(p.minY, ty0), y1 = std::min(p.maxY, ty0 + TILE_H - 1);
+            if (x0 > x1 || y0 > y1) continue;
+
+            for (int y = y0; y <= y1; ++y)
+            {
+                float py = y + 0.5f;
+                float* row = &m_Depth[y * WIDTH];
+                float rowC[MAX_EDGES];
+                for (int e = 0; e < p.edges; ++e) rowC[e] = p.B[e] * py + p.C[e];
+                int x = x0;
+#if defined(OCCLUSION_SSE)
+                const __m128 step = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 z = _mm_set1_ps(p.z);
+                for (; x + 3 <= x1; x += 4)
+                {
+                    __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), step);
+                    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    for (int e = 0; e < p.edges; ++e)
+                    {
+                        __m128 ev = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.A[e]), px), _mm_set1_ps(rowC[e]));
+                        inside = _mm_and_ps(inside, _mm_cmpge_ps(ev, zero));
+                    }
+                    if (_mm_movemask_ps(inside) == 0) continue;
+
+                    __m128 old = _mm_loadu_ps(row + x);
+                    __m128 nz = _mm_min_ps(old, z);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nz), _mm_andnot_ps(inside, old)));
+                }
+#endif
+                for (; x <= x1; ++x)
+                {
+                    float px = x + 0.5f;
+                    bool inside = true;
+                    for (int e = 0; e < p.edges && inside; ++e) inside = p.A[e] * px + rowC[e] >= 0.0f;
+                    if (inside && p.z < row[x]) row[x] = p.z;
+                }
+            }
+        }
+
+        // 타일 안의 HiZ 블록 갱신
+        for (int by = ty0 / HIZ; by < (ty0 + TILE_H) / HIZ; ++by)
+            for (int bx = tx0 / HIZ; bx < (tx0 + TILE_W) / HIZ; ++bx)
+            {
+                float m = 0.0f;
+                for (int y = 0; y < HIZ; ++y)
+                {
+                    const float* row = &m_Depth[(by * HIZ + y) * WIDTH + bx * HIZ];
+                    for (int x = 0; x < HIZ; ++x) m = std::max(m, row[x]);
+                }
+                m_HiZ[by * HIZ_W + bx] = m;
+            }
+    }
+
+    void Rasterize(ThreadPool* pool)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        const int tiles = TILES_X * TILES_Y;
+        if (pool)
+            pool->ParallelFor(tiles, 4, [this](size_t b, size_t e) { for (size_t i = b; i < e; ++i) RasterizeTile(int(i)); });
+        else
+            for (int i = 0; i < tiles; ++i) RasterizeTile(i);
+        m_Stats.rasterMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+
+    // 화면 사각형이 걸친 픽셀의 가리개가 모두 박스의 최소 깊이보다 가까우면 가려진 것
+    // (깊이가 쓰인 픽셀은 전부 덮였으므로 박스가 픽셀 일부에만 걸쳐도 그 부분은 가려진다)
+    bool IsVisible(const float mn[3], const float mx[3]) const
+    {
+        float c[8][3];
+        Corners(mn, mx, c);
+
+        float x0 = 1e30f, y0 = 1e30f, x1 = -1e30f, y1 = -1e30f, zmin = 1e30f;
+        for (int i = 0; i < 8; ++i)
+        {
+            float clip[4];
+            ToClip(c[i], clip);
+            if (clip[3] <= 1e-4f) return true;   // 카메라 뒤/근평면에 걸침 → 보수적으로 보임
+            float iw = 1.0f / clip[3];
+            float sx = (clip[0] * iw * 0.5f + 0.5f) * WIDTH;
+            float sy = (0.5f - clip[1] * iw * 0.5f) * HEIGHT;
+            x0 = std::min(x0, sx); x1 = std::max(x1, sx);
+            y0 = std::min(y0, sy); y1 = std::max(y1, sy);
+            zmin = std::min(zmin, clip[2] * iw);
+        }
+        if (zmin < 0.0f) return true;
+
+        if (x1 < 0.0f || y1 < 0.0f || x0 >= WIDTH || y0 >= HEIGHT) return true;   // 화면 밖 (절두체 컬링이 처리)
+        int px0 = std::max(0, int(floorf(x0))), px1 = std::min(WIDTH - 1, int(floorf(x1)));
+        int py0 = std::max(0, int(floorf(y0))), py1 = std::min(HEIGHT - 1, int(floorf(y1)));
+
+        // 1) HiZ 블록으로 빠르게 판정
+        bool allBlocksCloser = true;
+        for (int by = py0 / HIZ; by <= py1 / HIZ && allBlocksCloser; ++by)
+            for (int bx = px0 / HIZ; bx <= px1 / HIZ; ++bx)
+                if (m_HiZ[by * HIZ_W + bx] >= zmin) { allBlocksCloser = false; break; }
+        if (allBlocksCloser) return false;
+
+        // 2) 블록 경계에 걸친 경우 픽셀 단위로 확인
+        for (int y = py0; y <= py1; ++y)
+        {
+            const float* row = &m_Depth[y * WIDTH];
+            for (int x = px0; x <= px1; ++x)
+                if (row[x] >= zmin) return true;
+        }
+        return false;
+    }
+
+    // indices 중 가려진 항목을 제거한다. bounds(i, mn, mx)로 i번째 AABB를 얻는다.
+    template <typename BoundsFn>
+    void FilterVisible(std::vector<uint32_t>& indices, BoundsFn bounds, ThreadPool* pool)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::vector<uint8_t> keep(indices.size(), 1);
+        auto work = [&](size_t b, size_t e)
+        {
+            for (size_t i = b; i < e; ++i)
+            {
+                float mn[3], mx[3];
+                bounds(indices[i], mn, mx);
+                keep[i] = IsVisible(mn, mx) ? 1 : 0;
+            }
+        };
+        if (pool) pool->ParallelFor(indices.size(), 1024, work);
+        else      work(0, indices.size());
+
+        size_t n = 0;
+        for (size_t i = 0; i < indices.size(); ++i)
+            if (keep[i]) indices[n++] = indices[i];
+
+        m_Stats.tested = uint32_t(indices.size());
+        m_Stats.occluded = uint32_t(indices.size() - n);
+        indices.resize(n);
+        m_Stats.testMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+};
+
+// 벤치마크: 카메라 앞 벽 형태의 가리개 뒤에 무작위 박스를 두고 래스터/판정 시간을 잰다.
+inline OcclusionStats BenchmarkOcclusionCull(int occluders, int tests, ThreadPool* pool)
+{
+    // 원점에서 +Z를 바라보는 원근 투영 (60도, 16:9, near 0.1, far 1000). 장면 카메라와 같은 BoxMath 규약 (오른손)
+    const Mat4 vp = Mat4::LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 1.0f, 0.0f))
+                  * Mat4::PerspectiveFov(ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    OcclusionCuller oc;
+    oc.BeginFrame(vp.Data());
+
+    std::mt19937 rng(7);
+    int side = std::max(1, int(sqrtf(float(occluders))));
+    for (int i = 0; i < occluders; ++i)
+    {
+        float x = (i % side - side * 0.5f) * 2.0f, y = (i / side - side * 0.5f) * 2.0f;
+        float mn[3] = { x, y, 20.0f }, mx[3] = { x + 2.0f, y + 2.0f, 22.0f };
+        oc.AddOccluderBox(mn, mx);
+    }
+    oc.Rasterize(pool);
+
+    std::uniform_real_distribution<float> pos(-30.0f, 30.0f), depth(5.0f, 200.0f);
+    std::vector<float> boxes(size_t(tests) * 3);
+    for (float& v : boxes) v = pos(rng);
+    for (int i = 0; i < tests; ++i) boxes[size_t(i) * 3 + 2] = depth(rng);
+
+    std::vector<uint32_t> idx(tests);
+    for (int i = 0; i < tests; ++i) idx[i] = uint32_t(i);
+    oc.FilterVisible(idx, [&](uint32_t i, float mn[3], float mx[3])
+    {
+        for (int a = 0; a < 3; ++a) { mn[a] = boxes[size_t(i) * 3 + a]; mx[a] = mn[a] + 1.0f; }
+    }, pool);
+    return oc.m_Stats;
+}
@@ -0,0 +1,166 @@
+﻿#pragma once
+
+// 배치된 박스 저장소 (CPU 전용, Windows/D3D 의존성 없음)
+// - 셀 좌표를 키로 박스를 SparseGrid에 저장하고, 인스턴싱용 데이터로 패킹한다.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "InstancePack.h"
+#include "SparseGrid.h"
+
+// 한 프레임 동안의 편집을 모아 청크마다 한 번만 리메싱하도록 하는 dirty 집합
+// (메셔는 이웃 경계 셀까지 보고 청크 전체를 다시 만들므로 어느 면이 바뀌었는지는 기록하지 않는다)
+struct ChunkDirtySet
+{
+    ChunkHashMap            m_Map;      // 청크 키 → m_Chunks 인덱스
+    std::vector<ChunkCoord> m_Chunks;
+    uint64_t                m_Marks = 0; // Mark 호출 수 (중복 포함)
+
+    void Mark(const ChunkCoord& cc)
+    {
+        ++m_Marks;
+        uint64_t key = ChunkKey(cc);
+        if (m_Map.Find(key) != ChunkHashMap::EMPTY) return;
+        m_Map.Insert(key, uint32_t(m_Chunks.size()));
+        m_Chunks.push_back(cc);
+    }
+
+    bool Empty() const { return m_Chunks.empty(); }
+    size_t Count() const { return m_Chunks.size(); }
+
+    // 모인 dirty 청크를 넘겨주고 비운다.
+    void Take(std::vector<ChunkCoord>& out)
+    {
+        out.swap(m_Chunks);
+        m_Chunks.clear();
+        m_Map.Clear();
+    }
+
+    void Clear()
+    {
+        m_Chunks.clear();
+        m_Map.Clear();
+    }
+};
+
+// 청크 하나에 속한 인스턴스 범위와 그 경계 (PackInstances 출력, 컬링 입력)
+struct ChunkInstanceRange
+{
+    ChunkCoord coord;
+    uint32_t   first = 0;
+    uint32_t   count = 0;
+    float      boundsMin[3] = {};
+    float      boundsMax[3] = {};
+};
+
+struct PlacedBoxStore
+{
+    SparseGrid    m_Grid;         // 셀 값 = material (0 = 빈 셀)
+    uint64_t      m_Version = 0;  // 변경될 때마다 증가 (업로드 여부 판단용)
+    ChunkDirtySet m_Dirty;        // 리메싱이 필요한 청크
+    std::vector<CellCoord> m_PackCells;   // PackInstances 임시: 패킹 순서의 셀 좌표
+
+    // 이미 박스가 있거나 셀이 CELL_COORD_LIMIT 밖이면 false
+    bool Place(const CellCoord& c, uint8_t material = 1)
+    {
+        if (material == 0 || !CellInRange(c) || m_Grid.Get(c) != 0) return false;
+        m_Grid.Set(c, material);
+        MarkDirty(c);
+        ++m_Version;
+        return true;
+    }
+
+    // 박스가 없으면 false
+    bool Remove(const CellCoord& c)
+    {
+        if (!m_Grid.Set(c, 0)) return false;
+        MarkDirty(c);
+        ++m_Version;
+        return true;
+    }
+
+    // 셀 c가 바뀌었을 때: 소속 청크는 항상 dirty,
+    // c가 청크 경계에 있고 맞은편 이웃 셀이 점유돼 있으면 그 이웃 청크의 경계 면도 바뀐다 (면이 생기거나 없어짐).
+    void MarkDirty(const CellCoord& c)
+    {
+        m_Dirty.Mark(ChunkOf(c));
+
+        const int local[3] = { c.x & CHUNK_MASK, c.y & CHUNK_MASK, c.z & CHUNK_MASK };
+        for (int a = 0; a < 3; ++a)
+        {
+            int side = (local[a] == 0) ? -1 : (local[a] == CHUNK_MASK) ? 1 : 0;
+            if (side == 0) continue;
+
+            CellCoord nc = c;
+            (a == 0 ? nc.x : a == 1 ? nc.y : nc.z) += side;
+            if (m_Grid.Get(nc)) m_Dirty.Mark(ChunkOf(nc));
+        }
+    }
+
+    bool Contains(const CellCoord& c) const { return m_Grid.Get(c) != 0; }
+    uint8_t MaterialAt(const CellCoord& c) const { return m_Grid.Get(c); }
+    size_t Count() const { return m_Grid.m_CellCount; }
+
+    void Clear()
+    {
+        for (auto& chunk : m_Grid.m_Chunks) m_Dirty.Mark(chunk->coord);
+        m_Grid.Clear();
+        ++m_Version;
+    }
+
+    // 셀 → 월드 (한 개, 일괄 패킹은 PackCellInstances): 박스 메쉬는 x,z ∈ [-0.5, 0.5], y ∈ [0, 1] 이므로
+    // (셀 중심 x, 셀 바닥 y, 셀 중심 z)로 이동하고 셀 크기로 스케일한다.
+    static void PackInstance(const CellCoord& c, float cellSize, InstanceData& out)
+    {
+        const float s = cellSize;
+        out.row0[0] = s;    out.row0[1] = 0.0f; out.row0[2] = 0.0f; out.row0[3] = (c.x + 0.5f) * s;
+        out.row1[0] = 0.0f; out.row1[1] = s;    out.row1[2] = 0.0f; out.row1[3] = c.y * s;
+        out.row2[0] = 0.0f; out.row2[1] = 0.0f; out.row2[2] = s;    out.row2[3] = (c.z + 0.5f) * s;
+    }
+
+    // 청크 순서대로 패킹 (같은 청크의 인스턴스는 연속)
+    // ranges가 주어지면 청크별 범위와 점유 셀 기준의 빡빡한 경계도 채운다.
+    // materials가 주어지면 인스턴스별 material을 같은 순서로 채운다.
+    void PackInstances(float cellSize, std::vector<InstanceData>& out,
+        std::vector<ChunkInstanceRange>* ranges = nullptr, std::vector<uint8_t>* materials = nullptr)
+    {
+        out.resize(m_Grid.m_CellCount);
+        m_PackCells.resize(m_Grid.m_CellCount);
+        if (ranges) ranges->clear();
+        if (materials) materials->resize(m_Grid.m_CellCount);
+
+        uint32_t n = 0;
+        for (auto& chunk : m_Grid.m_Chunks)
+        {
+            int lo[3] = { CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE }, hi[3] = { -1, -1, -1 };
+            uint32_t first = n;
+            for (uint16_t idx : chunk->Occupied())
+            {
+                if (materials) (*materials)[n] = chunk->cells[idx];
+                m_PackCells[n++] = chunk->CellAt(idx);
+                int l[3] = { Chunk::LocalX(idx), Chunk::LocalY(idx), Chunk::LocalZ(idx) };
+                for (int a = 0; a < 3; ++a) { lo[a] = std::min(lo[a], l[a]); hi[a] = std::max(hi[a], l[a]); }
+            }
+
+            if (ranges && n > first)
+            {
+                ChunkInstanceRange r;
+                r.coord = chunk->coord;
+                r.first = first;
+                r.count = n - first;
+                const int base[3] = { chunk->coord.x << CHUNK_BITS, chunk->coord.y << CHUNK_BITS, chunk->coord.z << CHUNK_BITS };
+                for (int a = 0; a < 3; ++a)
+                {
+                    r.boundsMin[a] = (base[a] + lo[a]) * cellSize;
+                    r.boundsMax[a] = (base[a] + hi[a] + 1) * cellSize;
+                }
+                ranges->push_back(r);
+            }
+        }
+
+        // 컬링 Build가 곧바로 다시 읽으므로 캐시를 거치는 일반 저장
+        PackCellInstances(m_PackCells.data(), n, cellSize, out.data(), false);
+    }
+};
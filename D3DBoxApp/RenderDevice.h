@@ -0,0 +1,309 @@
+﻿#pragma once
+
+// 렌더링 디바이스 추상화 (Windows/D3D 의존성 없음)
+// - IRenderDevice: 리소스 생성/해제, 백버퍼 (Resize/Present)
+// - IRenderContext: 상태 바인딩과 드로우 명령
+// - IDeferredContext: 워커 스레드에서 명령 목록 기록, 즉시 컨텍스트가 순서대로 실행
+// - 펜스: InsertFence 이전 명령을 GPU가 다 끝냈는지 확인/대기 (CPU가 쓰는 업로드 링 재사용용)
+// - 리소스는 불투명 핸들(32비트 id, 0 = 없음/기본 상태)로만 주고받는다.
+// - 백엔드: D3D11RenderDevice.h (Windows), NullRenderDevice.h (GPU 없이 검증/계수), SoftRenderDevice.h (CPU 래스터라이저)
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+template <typename Tag>
+struct RenderHandle
+{
+    uint32_t id = 0;
+
+    explicit operator bool() const { return id != 0; }
+    bool operator==(const RenderHandle& o) const { return id == o.id; }
+    bool operator!=(const RenderHandle& o) const { return id != o.id; }
+};
+
+using BufferHandle      = RenderHandle<struct BufferTag>;
+using ShaderHandle      = RenderHandle<struct ShaderTag>;        // VS/PS 공통
+using InputLayoutHandle = RenderHandle<struct InputLayoutTag>;
+using TextureHandle     = RenderHandle<struct TextureTag>;       // 셰이더 리소스 뷰
+using SamplerHandle     = RenderHandle<struct SamplerTag>;
+using DepthStateHandle  = RenderHandle<struct DepthStateTag>;
+using RasterStateHandle = RenderHandle<struct RasterStateTag>;
+
+enum class BufferBind : uint8_t { Vertex, Index, Constant };
+enum class BufferUsage : uint8_t { Immutable, Dynamic };   // Dynamic = CPU 쓰기 (WRITE_DISCARD / NO_OVERWRITE)
+
+// Discard: 새 메모리를 받는다 (이전 내용 버림). NoOverwrite: GPU가 아직 읽는 구간은 건드리지 않는다고 약속하고 그대로 연다.
+enum class MapMode : uint8_t { Discard, NoOverwrite };
+
+// 상수 버퍼 구간 바인딩 단위 (16 상수 = 256바이트)
+constexpr uint32_t CONSTANT_BUFFER_ALIGNMENT = 256;
+
+struct BufferDesc
+{
+    BufferBind  bind = BufferBind::Vertex;
+    BufferUsage usage = BufferUsage::Immutable;
+    uint32_t    byteWidth = 0;
+};
+
+enum class ShaderStage : uint8_t { Vertex, Pixel };
+
+struct ShaderDesc
+{
+    ShaderStage    stage = ShaderStage::Vertex;
+    const wchar_t* file = nullptr;    // HLSL 파일
+    const char*    entry = nullptr;   // 진입 함수
+};
+
+enum class VertexFormat : uint8_t { Float2, Float3, Float4 };
+
+struct VertexElement
+{
+    const char*  semantic;
+    uint32_t     semanticIndex;
+    VertexFormat format;
+    uint32_t     slot;
+    uint32_t     offset;
+    bool         perInstance;   // true 이면 인스턴스마다 한 번 (step rate 1)
+};
+
+// 런타임 생성 텍스처 형식 (BC*는 4x4 블록, 행 우선)
+enum class TextureFormat : uint8_t { RGBA8, BC1, BC3, BC7 };
+
+struct TextureDesc
+{
+    uint32_t      width = 0;
+    uint32_t      height = 0;
+    uint32_t      mipLevels = 1;
+    TextureFormat format = TextureFormat::RGBA8;
+    bool          cube = false;   // 6면 큐브맵 (mipData[face * mipLevels + mip], 면 순서는 DDS와 같음)
+};
+
+// 밉 레벨 한 행(블록 형식은 블록 한 줄)의 바이트 수
+inline uint32_t TextureRowPitch(TextureFormat format, uint32_t width)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8: return width * 4;
+    case TextureFormat::BC1:   return ((width + 3) / 4) * 8;
+    case TextureFormat::BC3:
+    case TextureFormat::BC7:   return ((width + 3) / 4) * 16;
+    }
+    return 0;
+}
+
+inline const wchar_t* TextureFormatName(TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8: return L"RGBA8";
+    case TextureFormat::BC1:   return L"BC1";
+    case TextureFormat::BC3:   return L"BC3";
+    case TextureFormat::BC7:   return L"BC7";
+    }
+    return L"?";
+}
+
+enum class TextureAddress : uint8_t { Wrap, Clamp };
+
+// 필터는 항상 MIN_MAG_MIP_LINEAR
+struct SamplerDesc
+{
+    TextureAddress address = TextureAddress::Wrap;
+    float          maxLod = 3.402823466e+38f;   // 0 이면 mip 0만 사용
+};
+
+enum class CompareFunc : uint8_t { Less, LessEqual, Always };
+
+struct DepthStateDesc
+{
+    bool        depthEnable = true;
+    bool        depthWrite = true;
+    CompareFunc func = CompareFunc::Less;
+};
+
+enum class CullMode : uint8_t { None, Front, Back };
+
+struct RasterStateDesc
+{
+    CullMode cull = CullMode::Back;
+    bool     frontCounterClockwise = false;
+    bool     depthClip = true;
+};
+
+enum class PrimitiveTopology : uint8_t { TriangleList, LineList };
+enum class IndexFormat : uint8_t { UInt16, UInt32 };
+
+struct RenderViewport
+{
+    float x = 0, y = 0, width = 0, height = 0, minDepth = 0, maxDepth = 1;
+};
+
+// 백엔드 공통 계수기 (ResetCounters 전까지 누적)
+struct RenderCounters
+{
+    uint64_t draws = 0;              // Draw / DrawIndexed / DrawIndexedInstanced 호출 수
+    uint64_t instances = 0;
+    uint64_t primitives = 0;         // 삼각형 또는 선 수 (인스턴스 포함)
+    uint64_t stateChanges = 0;       // Set* 호출 수
+    uint64_t bytesUploaded = 0;      // UpdateBuffer + MapBuffer로 쓴 바이트 + 버퍼 초기 데이터
+    uint64_t maps = 0;               // Map 호출 (UpdateBuffer 포함)
+    uint64_t buffersCreated = 0;
+    uint64_t validationErrors = 0;   // Null 백엔드만 검사
+};
+
+// 백엔드별 명령 목록 (D3D11 커맨드 리스트 또는 CPU 명령 스트림)
+struct IRenderCommandList
+{
+    virtual ~IRenderCommandList() = default;
+};
+
+struct IRenderContext
+{
+    virtual ~IRenderContext() = default;
+
+    // 백버퍼/깊이 버퍼를 바인딩하고 지운다.
+    virtual void ClearTargets(const float color[4], float depth) = 0;
+    virtual void SetViewport(const RenderViewport& vp) = 0;
+
+    virtual void SetInputLayout(InputLayoutHandle layout) = 0;
+    virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
+    virtual void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                                  const uint32_t* strides, const uint32_t* offsets) = 0;
+    virtual void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) = 0;
+
+    virtual void SetVertexShader(ShaderHandle shader) = 0;
+    virtual void SetPixelShader(ShaderHandle shader) = 0;
+    virtual void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) = 0;
+    // 상수 버퍼의 [offset, offset + bytes) 구간만 바인딩 (VSSetConstantBuffers1). 둘 다 CONSTANT_BUFFER_ALIGNMENT 배수.
+    virtual void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes) = 0;
+    virtual void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) = 0;
+    virtual void SetPSTexture(uint32_t slot, TextureHandle texture) = 0;
+    virtual void SetPSSampler(uint32_t slot, SamplerHandle sampler) = 0;
+
+    // 핸들 0 = 기본 상태
+    virtual void SetDepthState(DepthStateHandle state) = 0;
+    virtual void SetRasterState(RasterStateHandle state) = 0;
+
+    // Dynamic 버퍼 전체를 새 내용으로 교체 (WRITE_DISCARD)
+    virtual bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) = 0;
+
+    // Dynamic 버퍼를 CPU 쓰기용으로 연다 (즉시 컨텍스트 전용, 실패 시 nullptr). 버퍼 전체의 시작 주소를 돌려준다.
+    // Unmap의 bytesWritten은 계수기용 (실제로 쓴 바이트).
+    virtual void* MapBuffer(BufferHandle buffer, MapMode mode) = 0;
+    virtual void  UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten) = 0;
+
+    virtual void Draw(uint32_t vertexCount, uint32_t startVertex) = 0;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) = 0;
+    virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                                      uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) = 0;
+
+    // 지연 컨텍스트에서 만든 명령 목록을 실행한다 (즉시 컨텍스트 전용).
+    // 실행 후 바인딩 상태는 정해지지 않으므로 이후 드로우는 상태를 다시 설정해야 한다.
+    virtual void ExecuteCommandList(IRenderCommandList& list) = 0;
+
+    virtual const RenderCounters& Counters() const = 0;
+    virtual void ResetCounters() = 0;
+};
+
+// 워커 스레드에서 명령을 기록하는 컨텍스트 (스레드당 하나).
+// 기록은 기본 상태 + 백버퍼/깊이 타겟이 바인딩된 상태에서 시작하고, Finish()가 목록을 만든 뒤 다시 기본 상태로 돌아간다.
+// 계수기는 즉시 컨텍스트가 목록을 실행할 때 더해진다.
+struct IDeferredContext : IRenderContext
+{
+    virtual std::unique_ptr<IRenderCommandList> Finish() = 0;
+};
+
+struct IRenderDevice
+{
+    virtual ~IRenderDevice() = default;
+
+    virtual IRenderContext& Context() = 0;   // 즉시 컨텍스트
+    virtual std::unique_ptr<IDeferredContext> CreateDeferredContext() = 0;   // 실패 시 nullptr
+
+    // 생성 실패 시 0 핸들 (원인은 백엔드가 디버그 출력)
+    virtual BufferHandle      CreateBuffer(const BufferDesc& desc, const void* initData) = 0;
+    virtual ShaderHandle      CreateShader(const ShaderDesc& desc) = 0;
+    virtual InputLayoutHandle CreateInputLayout(const VertexElement* elements, uint32_t count, ShaderHandle vs) = 0;
+    virtual TextureHandle     LoadTexture(const wchar_t* path) = 0;   // 쿠킹된 .dds (큐브맵 포함, 밉은 파일에 있는 그대로)
+    virtual TextureHandle     CreateTexture(const TextureDesc& desc, const void* const* mipData) = 0;   // mipData[m] = 레벨 m (촘촘한 행)
+    virtual SamplerHandle     CreateSampler(const SamplerDesc& desc) = 0;
+    virtual DepthStateHandle  CreateDepthState(const DepthStateDesc& desc) = 0;
+    virtual RasterStateHandle CreateRasterState(const RasterStateDesc& desc) = 0;
+    virtual void              DestroyBuffer(BufferHandle buffer) = 0;
+
+    virtual void Resize(uint32_t width, uint32_t height) = 0;
+    virtual void Present(uint32_t syncInterval) = 0;
+
+    // 스왑체인이 새 프레임을 받을 수 있을 때까지 (최대 timeoutMs) 기다린다 (프레임 지연 대기 객체).
+    // 지원하지 않으면 기다리지 않고 false.
+    virtual bool WaitForFrameLatency(uint32_t timeoutMs) = 0;
+
+    // 즉시 컨텍스트에 지금까지 제출한 명령 뒤로 펜스를 넣는다 (값은 1부터 증가).
+    virtual uint64_t InsertFence() = 0;
+    virtual bool     IsFenceComplete(uint64_t fence) = 0;
+    virtual void     WaitForFence(uint64_t fence) = 0;
+};
+
+// 핸들 id → 백엔드 객체. id = (세대 << HANDLE_INDEX_BITS) | (인덱스 + 1)
+// - 해제된 칸은 재사용하지만 칸의 세대가 올라가므로, 해제한 핸들과 그 칸에 새로 만든 핸들은 id가 다르다.
+//   (StateFilterContext처럼 id로 바인딩을 기억하는 쪽이 새 객체를 이전 객체로 착각하지 않는다)
+// - 해제한 핸들로 Get하면 칸이 재사용된 뒤에도 nullptr. 세대는 HANDLE_GENERATION_BITS에서 한 바퀴 돈다.
+constexpr uint32_t HANDLE_INDEX_BITS = 20;   // 칸 1M개
+constexpr uint32_t HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1;
+constexpr uint32_t HANDLE_GENERATION_BITS = 32 - HANDLE_INDEX_BITS;
+
+template <typename T>
+struct HandleTable
+{
+    std::vector<T>        m_Items;
+    std::vector<bool>     m_Live;
+    std::vector<uint32_t> m_Generation;   // 칸별 세대 (Remove마다 증가)
+    std::vector<uint32_t> m_Free;
+
+    uint32_t MakeId(uint32_t index) const { return (m_Generation[index] << HANDLE_INDEX_BITS) | (index + 1); }
+
+    // 칸이 모두 차면 0
+    uint32_t Add(T item)
+    {
+        if (!m_Free.empty())
+        {
+            uint32_t i = m_Free.back();
+            m_Free.pop_back();
+            m_Items[i] = std::move(item);
+            m_Live[i] = true;
+            return MakeId(i);
+        }
+        if (m_Items.size() >= HANDLE_INDEX_MASK) return 0;
+        m_Items.push_back(std::move(item));
+        m_Live.push_back(true);
+        m_Generation.push_back(0);
+        return MakeId(uint32_t(m_Items.size() - 1));
+    }
+
+    T* Get(uint32_t id)
+    {
+        uint32_t slot = id & HANDLE_INDEX_MASK;
+        if (slot == 0 || slot > m_Items.size() || !m_Live[slot - 1] || MakeId(slot - 1) != id) return nullptr;
+        return &m_Items[slot - 1];
+    }
+
+    bool Remove(uint32_t id)
+    {
+        if (!Get(id)) return false;
+        uint32_t i = (id & HANDLE_INDEX_MASK) - 1;
+        m_Items[i] = T{};
+        m_Live[i] = false;
+        m_Generation[i] = (m_Generation[i] + 1) & ((1u << HANDLE_GENERATION_BITS) - 1);
+        m_Free.push_back(i);
+        return true;
+    }
+
+    size_t LiveCount() const { return m_Items.size() - m_Free.size(); }
+};
+
+// 토폴로지별 프리미티브 수
+inline uint64_t PrimitiveCount(PrimitiveTopology topology, uint32_t vertexCount)
+{
+    return (topology == PrimitiveTopology::LineList) ? vertexCount / 2 : vertexCount / 3;
+}
@@ -0,0 +1,478 @@
+﻿#pragma once
+
+// 64비트 정렬 키 렌더 큐 (Windows/D3D 의존성 없음)
+// - 드로우마다 키 (패스 | 셰이더 | 입력 레이아웃 | 텍스처 | 양자화 깊이)를 만들어 제출하고, 프레임마다 기수 정렬 후 순서대로 실행한다.
+// - 키의 상위 비트일수록 바꾸기 비싼 상태라서 정렬하면 상태 변경이 묶이고, 같은 상태 안에서는 앞에서 뒤로 그려진다.
+// - 실행은 Set*을 항목마다 그대로 부르므로 StateFilterContext 위에서 돌려야 중복 호출이 빠진다.
+// - 정렬은 안정적이라 키가 같으면 제출 순서를 지킨다.
+// - ExecuteParallel: 정렬된 목록을 연속 구간으로 나눠 워커마다 지연 컨텍스트에 기록하고, 즉시 컨텍스트가 구간 순서대로 실행한다.
+// - 드로우별 상수는 UploadConstants가 실행 전에 ConstantBufferRing으로 한 번에 올리고, 실행 중에는 구간 바인딩만 한다.
+// - PassRange: 패스가 키 최상위 비트라서 정렬 후 패스별 항목은 연속 구간이다 (프레임 그래프 패스마다 따로 실행).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ConstantBufferRing.h"
+#include "RenderDevice.h"
+#include "StateFilter.h"
+#include "ThreadPool.h"
+
+// LSD 기수 정렬 (11비트 자릿수 6회, 히스토그램 48KB). 모든 키에서 같은 자릿수는 건너뛴다.
+// keys/values를 정렬하고, tmpKeys/tmpValues는 n개짜리 작업 공간. 작은 배열은 삽입 정렬.
+inline void RadixSort64(uint64_t* keys, uint32_t* values, uint64_t* tmpKeys, uint32_t* tmpValues, size_t n)
+{
+    constexpr int      DIGIT_BITS = 11;
+    constexpr int      DIGITS = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+    constexpr uint32_t RADIX = 1u << DIGIT_BITS;
+    constexpr uint64_t MASK = RADIX - 1;
+
+    if (n <= 64)
+    {
+        for (size_t i = 1; i < n; ++i)
+        {
+            uint64_t k = keys[i];
+            uint32_t v = values[i];
+            size_t j = i;
+            for (; j > 0 && keys[j - 1] > k; --j)
+            {
+                keys[j] = keys[j - 1];
+                values[j] = values[j - 1];
+            }
+            keys[j] = k;
+            values[j] = v;
+        }
+        return;
+    }
+
+    static thread_local uint32_t hist[DIGITS][RADIX];
+    memset(hist, 0, sizeof(hist));
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint64_t k = keys[i];
+        for (int d = 0; d < DIGITS; ++d) ++hist[d][(k >> (d * DIGIT_BITS)) & MASK];
+    }
+
+    uint64_t* srcK = keys;    uint64_t* dstK = tmpKeys;
+    uint32_t* srcV = values;  uint32_t* dstV = tmpValues;
+    for (int d = 0; d < DIGITS; ++d)
+    {
+        const int shift = d * DIGIT_BITS;
+        if (hist[d][(srcK[0] >> shift) & MASK] == n) continue;   // 모두 같은 자릿수
+
+        uint32_t offset = 0;
+        for (uint32_t& h : hist[d])
+        {
+            uint32_t c = h;
+            h = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint32_t dst = hist[d][(srcK[i] >> shift) & MASK]++;
+            dstK[dst] = srcK[i];
+            dstV[dst] = srcV[i];
+        }
+        std::swap(srcK, dstK);
+        std::swap(srcV, dstV);
+    }
+
+    if (srcK != keys)
+    {
+        memcpy(keys, srcK, n * sizeof(uint64_t));
+        memcpy(values, srcV, n * sizeof(uint32_t));
+    }
+}
+
+enum class RenderPass : uint8_t { Sky, Opaque };
+
+// 드로우 하나를 그리는 데 필요한 상태 전부 (핸들 + 인자)
+struct DrawItem
+{
+    static constexpr uint32_t NO_CONSTANTS = ~0u;
+
+    ShaderHandle      vs, ps;
+    InputLayoutHandle layout;
+    PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+    BufferHandle      vb[2];
+    uint32_t          strides[2] = {};
+    uint32_t          vbCount = 0;
+    BufferHandle      ib;                                   // 없으면 Draw
+    IndexFormat       indexFormat = IndexFormat::UInt16;
+    TextureHandle     texture;                              // t0
+    SamplerHandle     sampler;                              // s0
+    DepthStateHandle  depthState;
+    RasterStateHandle rasterState;
+    uint32_t          constants = NO_CONSTANTS;             // RenderQueue::AddConstants 결과
+
+    uint32_t          count = 0;                            // 정점 또는 인덱스 수
+    uint32_t          start = 0;
+    int32_t           baseVertex = 0;
+    uint32_t          instanceCount = 0;                    // 0이면 인스턴싱 없음
+    uint32_t          startInstance = 0;
+};
+
+struct RenderQueue
+{
+    // 키 배치 (상위 → 하위)
+    static constexpr int PASS_SHIFT    = 60;   // 4비트
+    static constexpr int SHADER_SHIFT  = 48;   // 12비트: VS 6 | PS 6
+    static constexpr int LAYOUT_SHIFT  = 40;   // 8비트
+    static constexpr int TEXTURE_SHIFT = 24;   // 16비트
+    static constexpr int DEPTH_BITS    = 24;
+
+    static constexpr size_t MIN_ITEMS_PER_LIST = 16;   // 이보다 적게 나누면 목록 오버헤드가 더 크다
+
+    struct ConstantBlock { uint32_t offset, bytes; };
+    struct Range { size_t begin = 0, end = 0; };   // 정렬된 순서의 [begin, end)
+
+    // 워커 하나의 기록 상태 (지연 컨텍스트 + 그 위의 중복 제거 필터 + 마지막 목록)
+    struct Recorder
+    {
+        std::unique_ptr<IDeferredContext>   context;
+        std::unique_ptr<StateFilterContext> filter;
+        std::unique_ptr<IRenderCommandList> list;
+    };
+
+    std::vector<DrawItem>      m_Items;
+    std::vector<uint64_t>      m_Keys, m_TmpKeys;
+    std::vector<uint32_t>      m_Order, m_TmpOrder;
+    std::vector<uint8_t>       m_ConstantData;
+    std::vector<ConstantBlock> m_Constants;
+    std::vector<ConstantBufferRing::Allocation> m_ConstantRanges;   // UploadConstants 결과 (m_Constants와 같은 인덱스)
+    BufferHandle               m_ConstantBuffer;
+    std::vector<Recorder>      m_Recorders;
+    double                     m_SortMs = 0.0;
+    double                     m_RecordMs = 0.0;    // ExecuteParallel: 병렬 기록 (벽시계)
+    double                     m_ExecuteMs = 0.0;   // ExecuteParallel: 목록 실행
+    size_t                     m_ListCount = 0;     // 마지막 프레임에 만든 목록 수 (0 = 즉시 실행)
+
+    // depth01: 0(가까움) ~ 1(멂). 핸들 id는 잘려서 들어가므로 겹쳐도 묶임만 덜 될 뿐 결과는 같다.
+    static uint64_t MakeKey(RenderPass pass, const DrawItem& item, float depth01)
+    {
+        const uint32_t maxDepth = (1u << DEPTH_BITS) - 1;
+        float d = std::min(std::max(depth01, 0.0f), 1.0f);
+        uint64_t shader = (uint64_t(item.vs.id & 63) << 6) | (item.ps.id & 63);
+        return (uint64_t(pass) << PASS_SHIFT)
+             | (shader << SHADER_SHIFT)
+             | (uint64_t(item.layout.id & 0xFF) << LAYOUT_SHIFT)
+             | (uint64_t(item.texture.id & 0xFFFF) << TEXTURE_SHIFT)
+             | uint64_t(d * float(maxDepth));
+    }
+
+    void Reset()
+    {
+        m_Items.clear();
+        m_Keys.clear();
+        m_ConstantData.clear();
+        m_Constants.clear();
+    }
+
+    // 드로우별 상수 블록을 복사해 두고 인덱스를 돌려준다 (실행 시 바뀔 때만 업로드)
+    uint32_t AddConstants(const void* data, uint32_t bytes)
+    {
+        uint32_t offset = uint32_t(m_ConstantData.size());
+        m_ConstantData.resize(offset + bytes);
+        memcpy(m_ConstantData.data() + offset, data, bytes);
+        m_Constants.push_back({ offset, bytes });
+        return uint32_t(m_Constants.size() - 1);
+    }
+
+    void Submit(RenderPass pass, const DrawItem& item, float depth01)
+    {
+        m_Keys.push_back(MakeKey(pass, item, depth01));
+        m_Items.push_back(item);
+    }
+
+    void Sort()
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        const size_t n = m_Keys.size();
+        m_Order.resize(n);
+        for (size_t i = 0; i < n; ++i) m_Order[i] = uint32_t(i);
+        m_TmpKeys.resize(n);
+        m_TmpOrder.resize(n);
+        RadixSort64(m_Keys.data(), m_Order.data(), m_TmpKeys.data(), m_TmpOrder.data(), n);
+        m_SortMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+
+    // Sort() 이후에만 유효
+    Range All() const { return { 0, m_Order.size() }; }
+
+    // m_Keys는 제자리에서 정렬되므로 정렬된 위치로 이분 탐색한다 (m_Order 값은 제출 인덱스라 키 순서가 아니다).
+    Range PassRange(RenderPass pass) const
+    {
+        auto first = std::partition_point(m_Keys.begin(), m_Keys.end(), [&](uint64_t k) { return (k >> PASS_SHIFT) < uint64_t(pass); });
+        auto last = std::partition_point(first, m_Keys.end(), [&](uint64_t k) { return (k >> PASS_SHIFT) == uint64_t(pass); });
+        return { size_t(first - m_Keys.begin()), size_t(last - m_Keys.begin()) };
+    }
+
+    // 모든 상수 블록을 링에 복사한다 (즉시 컨텍스트, Map 한 번). 실행 전에 한 번. 링이 모자라면 false.
+    bool UploadConstants(IRenderContext& ctx, ConstantBufferRing& ring)
+    {
+        m_ConstantBuffer = ring.Buffer();
+        m_ConstantRanges.assign(m_Constants.size(), {});
+        if (m_Constants.empty()) return true;
+        if (!ring.Map(ctx)) return false;
+
+        bool ok = true;
+        for (size_t i = 0; i < m_Constants.size() && ok; ++i)
+        {
+            const ConstantBlock& cb = m_Constants[i];
+            m_ConstantRanges[i] = ring.Write(m_ConstantData.data() + cb.offset, cb.bytes);
+            ok = m_ConstantRanges[i].bytes != 0;
+        }
+        ring.Unmap(ctx);
+        return ok;
+    }
+
+    // 정렬된 순서대로 그린다. 상수 블록은 VS 슬롯 constantSlot에 링 구간으로 바인딩한다.
+    void Execute(IRenderContext& ctx, uint32_t constantSlot)
+    {
+        m_ListCount = 0;
+        ExecuteRange(ctx, 0, m_Order.size(), constantSlot);
+    }
+
+    // 정렬된 [begin, end) 구간을 그린다. 올리지 못한 블록을 쓰는 드로우는 건너뛴다.
+    void ExecuteRange(IRenderContext& ctx, size_t begin, size_t end, uint32_t constantSlot) const
+    {
+        uint32_t lastConstants = DrawItem::NO_CONSTANTS;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const DrawItem& it = m_Items[m_Order[i]];
+
+            if (it.constants != DrawItem::NO_CONSTANTS && it.constants != lastConstants)
+            {
+                const ConstantBufferRing::Allocation& a = m_ConstantRanges[it.constants];
+                if (!a.bytes) continue;
+                ctx.SetVSConstantBufferRange(constantSlot, m_ConstantBuffer, a.offset, a.bytes);
+                lastConstants = it.constants;
+            }
+
+            ctx.SetDepthState(it.depthState);
+            ctx.SetRasterState(it.rasterState);
+            ctx.SetInputLayout(it.layout);
+            ctx.SetPrimitiveTopology(it.topology);
+            const uint32_t offsets[2] = {};
+            if (it.vbCount) ctx.SetVertexBuffers(0, it.vbCount, it.vb, it.strides, offsets);
+            if (it.ib) ctx.SetIndexBuffer(it.ib, it.indexFormat, 0);
+            ctx.SetVertexShader(it.vs);
+            ctx.SetPixelShader(it.ps);
+            ctx.SetPSTexture(0, it.texture);
+            ctx.SetPSSampler(0, it.sampler);
+
+            if (!it.ib)
+                ctx.Draw(it.count, it.start);
+            else if (it.instanceCount == 0)
+                ctx.DrawIndexed(it.count, it.start, it.baseVertex);
+            else
+                ctx.DrawIndexedInstanced(it.count, it.instanceCount, it.start, it.baseVertex, it.startInstance);
+        }
+    }
+
+    // 정렬된 range 항목을 최대 (워커 + 1)개 구간으로 나눠 병렬 기록 후 순서대로 실행한다.
+    // 목록은 상태를 물려받지 않으므로 prologue가 구간마다 공통 상태 (뷰포트, 프레임 상수 등)를 기록한다.
+    // 지연 컨텍스트를 만들 수 없거나 항목이 적으면 즉시 컨텍스트에서 그대로 실행한다.
+    void ExecuteParallel(IRenderDevice& device, IRenderContext& immediate, ThreadPool& pool, Range range,
+                         const std::function<void(IRenderContext&)>& prologue,
+                         uint32_t constantSlot)
+    {
+        const size_t n = range.end - range.begin;
+        size_t lists = std::min(pool.ThreadCount() + 1, n / MIN_ITEMS_PER_LIST);
+        while (m_Recorders.size() < lists)
+        {
+            Recorder r;
+            r.context = device.CreateDeferredContext();
+            if (!r.context) break;
+            r.filter = std::make_unique<StateFilterContext>(*r.context);
+            m_Recorders.push_back(std::move(r));
+        }
+        lists = std::min(lists, m_Recorders.size());
+        if (lists < 2)
+        {
+            m_ListCount = 0;
+            ExecuteRange(immediate, range.begin, range.end, constantSlot);
+            return;
+        }
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        pool.ParallelFor(lists, 1, [&](size_t first, size_t last)
+        {
+            for (size_t l = first; l < last; ++l)
+            {
+                Recorder& r = m_Recorders[l];
+                r.filter->Invalidate();   // 지연 컨텍스트는 기본 상태에서 시작
+                prologue(*r.filter);
+                ExecuteRange(*r.filter, range.begin + n * l / lists, range.begin + n * (l + 1) / lists, constantSlot);
+                r.list = r.context->Finish();
+            }
+        });
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        for (size_t l = 0; l < lists; ++l)
+        {
+            if (m_Recorders[l].list) immediate.ExecuteCommandList(*m_Recorders[l].list);
+            m_Recorders[l].list.reset();
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        m_ListCount = lists;
+        m_RecordMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        m_ExecuteMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+
+    size_t Size() const { return m_Items.size(); }
+};
+
+struct RadixSortBenchmark
+{
+    size_t count = 0;
+    double radixMs = 0.0;
+    double stdSortMs = 0.0;
+    bool   matches = false;   // std::stable_sort 결과와 같은지
+};
+
+// 벤치마크: 무작위 64비트 키 count개를 (키, 인덱스) 쌍으로 기수 정렬과 std::stable_sort로 정렬해 비교한다.
+inline RadixSortBenchmark BenchmarkRadixSort(size_t count, int iterations = 5)
+{
+    std::mt19937_64 rng(12345);
+    std::vector<uint64_t> source(count);
+    for (uint64_t& k : source) k = rng();
+
+    std::vector<uint64_t> keys(count), tmpKeys(count);
+    std::vector<uint32_t> values(count), tmpValues(count);
+    std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+
+    RadixSortBenchmark r;
+    r.count = count;
+    r.radixMs = r.stdSortMs = 1e30;
+    for (int it = 0; it < iterations; ++it)
+    {
+        keys = source;
+        for (size_t i = 0; i < count; ++i) values[i] = uint32_t(i);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        RadixSort64(keys.data(), values.data(), tmpKeys.data(), tmpValues.data(), count);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        r.radixMs = std::min(r.radixMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+        for (size_t i = 0; i < count; ++i) pairs[i] = { source[i], uint32_t(i) };
+        t0 = std::chrono::high_resolution_clock::now();
+        std::stable_sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        t1 = std::chrono::high_resolution_clock::now();
+        r.stdSortMs = std::min(r.stdSortMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+
+    r.matches = true;
+    for (size_t i = 0; i < count && r.matches; ++i)
+        r.matches = (keys[i] == pairs[i].first && values[i] == pairs[i].second);
+    return r;
+}
+
+struct RecordingBenchmark
+{
+    size_t   items = 0;
+    size_t   lists = 0;
+    double   serialMs = 0.0;     // 즉시 컨텍스트에서 기록 = 실행
+    double   parallelMs = 0.0;   // 병렬 기록 + 목록 실행
+    double   recordMs = 0.0;
+    double   executeMs = 0.0;
+    uint64_t draws = 0;
+    bool     matches = false;    // 두 경로의 드로우/프리미티브 수가 같은지
+};
+
+// 벤치마크: 셰이더 4쌍 x 텍스처 8장에 드로우별 상수를 가진 count개 항목을 한 번은 즉시 컨텍스트에서,
+// 한 번은 ExecuteParallel로 실행해 시간과 계수기를 비교한다. 셰이더/텍스처 파일을 읽지 않는 백엔드(Null)용.
+inline RecordingBenchmark BenchmarkParallelRecording(IRenderDevice& device, ThreadPool& pool, size_t count, int iterations = 5)
+{
+    ShaderHandle vs[4], ps[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        vs[i] = device.CreateShader({ ShaderStage::Vertex, L"Bench.hlsl", "VSMain" });
+        ps[i] = device.CreateShader({ ShaderStage::Pixel, L"Bench.hlsl", "PSMain" });
+    }
+    const VertexElement element{ "POSITION", 0, VertexFormat::Float3, 0, 0, false };
+    InputLayoutHandle layout = device.CreateInputLayout(&element, 1, vs[0]);
+
+    std::vector<float> vertices(24 * 3, 0.0f);
+    std::vector<uint16_t> indices(36);
+    for (size_t i = 0; i < indices.size(); ++i) indices[i] = uint16_t(i % 24);
+    BufferHandle vb = device.CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable, uint32_t(vertices.size() * sizeof(float)) }, vertices.data());
+    BufferHandle ib = device.CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, uint32_t(indices.size() * sizeof(uint16_t)) }, indices.data());
+
+    TextureHandle textures[8];
+    for (TextureHandle& t : textures) t = device.LoadTexture(L"Bench.dds");
+
+    RenderQueue queue;
+    std::mt19937 rng(12345);
+    float constants[32] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        DrawItem it;
+        int program = int(rng() % 4);
+        it.vs = vs[program];
+        it.ps = ps[program];
+        it.layout = layout;
+        it.vb[0] = vb;
+        it.strides[0] = 12;
+        it.vbCount = 1;
+        it.ib = ib;
+        it.texture = textures[rng() % 8];
+        constants[12] = float(i);
+        it.constants = queue.AddConstants(constants, sizeof(constants));
+        it.count = 36;
+        queue.Submit(RenderPass::Opaque, it, float(rng() % 1000) / 1000.0f);
+    }
+    queue.Sort();
+
+    // 상수는 한 번만 올리고 두 경로가 같은 구간을 바인딩한다 (기록 비용만 비교)
+    IRenderContext& ctx = device.Context();
+    ConstantBufferRing ring;
+    ring.Init(device, uint32_t(count) * ConstantBufferRing::Align(sizeof(constants)));
+    ring.BeginFrame();
+    queue.UploadConstants(ctx, ring);
+    ring.EndFrame();
+    StateFilterContext filter(ctx);
+    const RenderViewport vp{ 0, 0, 1280, 720, 0, 1 };
+
+    RecordingBenchmark r;
+    r.items = count;
+    r.serialMs = r.parallelMs = 1e30;
+    RenderCounters serial{}, parallel{};
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        RenderCounters before = ctx.Counters();
+        filter.Invalidate();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        filter.SetViewport(vp);
+        queue.Execute(filter, 0);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        r.serialMs = std::min(r.serialMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+        serial.draws = ctx.Counters().draws - before.draws;
+        serial.primitives = ctx.Counters().primitives - before.primitives;
+
+        before = ctx.Counters();
+        filter.Invalidate();
+        t0 = std::chrono::high_resolution_clock::now();
+        queue.ExecuteParallel(device, filter, pool, queue.All(), [&](IRenderContext& c) { c.SetViewport(vp); }, 0);
+        t1 = std::chrono::high_resolution_clock::now();
+        if (std::chrono::duration<double, std::milli>(t1 - t0).count() < r.parallelMs)
+        {
+            r.parallelMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            r.recordMs = queue.m_RecordMs;
+            r.executeMs = queue.m_ExecuteMs;
+        }
+        parallel.draws = ctx.Counters().draws - before.draws;
+        parallel.primitives = ctx.Counters().primitives - before.primitives;
+    }
+
+    r.lists = queue.m_ListCount;
+    r.draws = parallel.draws;
+    r.matches = serial.draws == parallel.draws && serial.primitives == parallel.primitives && serial.draws == count;
+    return r;
+}
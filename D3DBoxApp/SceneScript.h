@@ -0,0 +1,212 @@
+﻿#pragma once
+
+// 장면 스크립트 실행 (CPU 전용, Windows/D3D 의존성 없음)
+// - 결정적 배치 + 카메라/클릭 스크립트로 BoxScene 프레임 루프를 창 없이 돌린다.
+// - Windows 앱의 -headless / -softrender와 Linux BoxHeadless가 같은 함수를 쓴다 (결과는 log로 한 줄씩).
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "BoxScene.h"
+#include "NullRenderDevice.h"
+#include "SoftRenderDevice.h"
+
+// 헤드리스 공용: 결정적 배치 + 스크립트된 카메라/클릭으로 frames만큼 돌린다
+inline bool RunScriptedFrames(BoxScene& app, std::unique_ptr<IRenderDevice> device, int frames)
+{
+    if (!app.InitScene(std::move(device))) return false;
+
+    // 64x64 바닥 + 계단 모양 기둥 (결정적 배치)
+    for (int x = -32; x < 32; ++x)
+        for (int z = -32; z < 32; ++z)
+        {
+            int h = ((x * 7 + z * 13) & 15) == 0 ? (x & 3) + 1 : 0;
+            for (int y = 0; y <= h; ++y)
+                app.m_PlacedBoxes.Place({ x, y, z }, uint8_t(1 + ((x ^ z) & 1)));
+        }
+
+    app.m_Camera.SetOrbit(0.0f, ToRadians(30.0f), 40.0f);
+    for (int f = 0; f < frames; ++f)
+    {
+        app.m_Camera.Orbit(0.02f, 0.0f);
+        if (f == frames / 2) app.m_RenderMode = BoxScene::BoxRenderMode::ChunkMesh;
+        if (f % 10 == 0) app.OnClick(int(app.m_Width / 2), int(app.m_Height / 2), (f % 20) != 0);
+
+        app.BeginFrame();
+        app.UpdateAndDraw();
+    }
+    return true;
+}
+
+struct InputReplayReport
+{
+    uint32_t events = 0;
+    int      frames = 0;
+    uint64_t coalescedUpdates = 0;   // 프레임당 한 번 적용했을 때 카메라 재계산 수
+    uint64_t perEventUpdates = 0;    // 이벤트마다 적용했을 때 (이전 WndProc 방식)
+    float    yawError = 0.0f, pitchError = 0.0f, radiusError = 0.0f;
+    size_t   boxes = 0;
+
+    bool Matches() const { return yawError < 1e-3f && pitchError < 1e-3f && radiusError < 1e-3f; }
+};
+
+// 합성 입력 스트림: 1000Hz 마우스 드래그(프레임당 16회) + 휠 + 가끔 클릭을 frames 프레임 동안 넣고,
+// 프레임마다 한 번 적용한 카메라와 이벤트마다 바로 적용한 카메라를 비교한다.
+inline InputReplayReport RunInputReplay(int frames)
+{
+    SteadyFrameClock clock;
+    BoxScene app(clock);
+    app.m_Camera.SetProjection(ToRadians(60.0f), float(app.m_Width) / float(app.m_Height), BoxScene::CAMERA_NEAR, BoxScene::CAMERA_FAR);
+    app.m_Camera.SetOrbit(0.0f, ToRadians(30.0f), 40.0f);
+    OrbitCamera reference = app.m_Camera;
+
+    InputReplayReport r;
+    r.frames = frames;
+    const uint64_t startVersion = app.m_Camera.Version();
+    uint64_t referenceVersion = reference.Version();
+    int x = 640, y = 360;
+    for (int f = 0; f < frames; ++f)
+    {
+        app.m_Input.BeginDrag(x, y);
+        for (int i = 0; i < 16; ++i)
+        {
+            int nx = x + ((f + i) % 5) - 1, ny = y + ((f * 3 + i) % 3) - 1;
+            app.m_Input.MouseMove(nx, ny);
+            reference.Orbit(float(nx - x) * BoxScene::ORBIT_RADIANS_PER_PIXEL, -float(ny - y) * BoxScene::ORBIT_RADIANS_PER_PIXEL);
+            if (reference.Version() != referenceVersion) { referenceVersion = reference.m_Version; ++r.perEventUpdates; }
+            x = nx; y = ny;
+        }
+        app.m_Input.EndDrag();
+
+        // 휠은 프레임 안에서 한 방향 (방향이 섞이면 0.9 * 1.1 != 1 이라 순서에 따라 달라진다)
+        for (int i = 0; i < (f % 4); ++i)
+        {
+            int delta = (f / 30) % 2 ? -120 : 120;
+            app.m_Input.Wheel(delta);
+            reference.Zoom(delta > 0 ? 0.9f : 1.1f);
+            if (reference.Version() != referenceVersion) { referenceVersion = reference.m_Version; ++r.perEventUpdates; }
+        }
+        if (f % 30 == 0) app.m_Input.Click(int(app.m_Width / 2), int(app.m_Height / 2), false);
+
+        app.ApplyInput();
+        app.m_Camera.Version();   // 프레임에서 처음 읽을 때 한 번 재계산
+    }
+
+    r.events = uint32_t(app.m_Input.m_TotalEvents);
+    r.coalescedUpdates = app.m_Camera.m_Version - startVersion;
+    r.yawError = fabsf(app.m_Camera.m_Yaw - reference.m_Yaw);
+    r.pitchError = fabsf(app.m_Camera.m_Pitch - reference.m_Pitch);
+    r.radiusError = fabsf(app.m_Camera.m_Radius - reference.m_Radius);
+    r.boxes = app.m_PlacedBoxes.Count();
+    return r;
+}
+
+// 스크립트가 끝난 뒤 정지 상태로 frames만큼 돌린다 (1/3 지점에 크기 변경, 2/3 지점에 배치 클릭 한 번).
+// 매 프레임 전에 리메싱 작업이 끝나길 기다려서 결과가 도착하는 프레임이 결정적이다.
+inline void RunOnDemandFrames(BoxScene& app, int frames)
+{
+    auto step = [&app]
+        {
+            while (app.m_Remesher.m_InFlight.load() != 0) std::this_thread::yield();
+            app.BeginFrame();
+            if (app.NeedsRedraw()) app.UpdateAndDraw();
+            else ++app.m_FramesSkipped;
+        };
+
+    while (!app.m_Remesher.Idle()) step();   // 스크립트에서 남은 리메싱 정리
+
+    const uint64_t rendered = app.m_FramesRendered, skipped = app.m_FramesSkipped;
+    for (int f = 0; f < frames; ++f)
+    {
+        if (f == frames / 3) app.Resize(app.m_Width, app.m_Height);
+        if (f == frames * 2 / 3) app.OnClick(int(app.m_Width / 2), int(app.m_Height / 2));
+        step();
+    }
+
+    app.Log("[Headless] on-demand: %d static frames (1 resize, 1 click) -> %llu rendered, %llu skipped\n",
+        frames, (unsigned long long)(app.m_FramesRendered - rendered), (unsigned long long)(app.m_FramesSkipped - skipped));
+}
+
+// 헤드리스: 창/GPU 없이 Null 백엔드로 프레임 루프를 돌리고 계수기를 출력한다.
+// 초기화에 실패하거나, 검증 오류가 있거나, 입력 재생 카메라가 어긋나면 false
+inline bool RunHeadless(const SceneLogFn& log, int frames = 120)
+{
+    SteadyFrameClock clock;
+    BoxScene app(clock);
+    app.m_LogSink = log;
+    if (!RunScriptedFrames(app, std::make_unique<NullRenderDevice>(app.m_Width, app.m_Height), frames))
+    {
+        app.Log("[Headless] Init FAILED\n");
+        return false;
+    }
+
+    const RenderCounters& c = app.m_Context->Counters();
+    app.Log("[Headless] %d frames: %.1f draws, %.1f state changes, %.0f prims, %.1f KB uploaded per frame, %llu validation errors\n",
+        frames, double(c.draws) / frames, double(c.stateChanges) / frames, double(c.primitives) / frames,
+        double(c.bytesUploaded) / 1024.0 / frames, (unsigned long long)c.validationErrors);
+
+    const StateFilterStats& f = app.m_StateFilter->m_Stats;
+    app.Log("[Headless] state filter: %.1f issued, %.1f elided per frame (%.0f%% elided)\n",
+        double(f.issued) / frames, double(f.elided) / frames, f.ElidedRatio() * 100.0);
+    app.Log("[Headless] render queue (last frame): %zu items, %zu command lists, record %.3f ms, execute %.3f ms\n",
+        app.m_Queue.Size(), app.m_Queue.m_ListCount, app.m_Queue.m_RecordMs, app.m_Queue.m_ExecuteMs);
+    const ConstantRingStats& ring = app.m_VSRing.m_Total;
+    app.Log("[Headless] constant ring: %.1f KB copied (%.1f KB allocated) in %.2f maps per frame, %.1f Map calls per frame total, %llu stalls, %llu failures\n",
+        double(ring.bytes) / 1024.0 / frames, double(ring.allocated) / 1024.0 / frames, double(ring.maps) / frames,
+        double(c.maps) / frames, (unsigned long long)ring.stalls, (unsigned long long)ring.failures);
+    app.Log("[Headless] camera resolved %llu times, frame/pass constants uploaded in %llu of %d frames\n",
+        (unsigned long long)app.m_Camera.m_Version, (unsigned long long)app.m_CameraConstantUploads, frames);
+    const FrameGraphStats& g = app.m_FrameGraph.m_Stats;
+    app.Log("[Headless] frame graph (last frame): %zu passes (%zu culled), %zu transients, peak transient %.1f KB, compile %.3f ms\n",
+        g.passes, g.culled, g.transients, double(g.peakBytes) / 1024.0, g.compileMs);
+
+    InputReplayReport ir = RunInputReplay(frames);
+    app.Log("[Headless] input replay: %u events in %d frames -> %llu camera updates (per-event %llu), yaw/pitch/radius error %.1e/%.1e/%.1e, %zu boxes%s\n",
+        ir.events, ir.frames, (unsigned long long)ir.coalescedUpdates, (unsigned long long)ir.perEventUpdates,
+        ir.yawError, ir.pitchError, ir.radiusError, ir.boxes, ir.Matches() ? "" : " MISMATCH");
+
+    RunOnDemandFrames(app, 60);
+
+    auto& null = static_cast<NullRenderContext&>(app.m_Device->Context());
+    for (const std::string& e : null.m_Errors)
+        app.Log("[Headless] %s\n", e.c_str());
+    return null.m_Counters.validationErrors == 0 && ir.Matches();
+}
+
+// 소프트 렌더: 같은 스크립트를 CPU 소프트웨어 래스터라이저로 돌리고 마지막 프레임을 PNG로 저장한다
+inline bool RunSoftRender(const wchar_t* outPath, const SceneLogFn& log, int frames = 120)
+{
+    SteadyFrameClock clock;
+    BoxScene app(clock);
+    app.m_LogSink = log;
+    auto device = std::make_unique<SoftRenderDevice>(app.m_Width, app.m_Height);
+    SoftRenderDevice* soft = device.get();
+    bool ok = RunScriptedFrames(app, std::move(device), frames);
+
+    for (const std::string& e : soft->m_Errors)
+        app.Log("[SoftRender] %s\n", e.c_str());
+    if (!ok)
+    {
+        app.Log("[SoftRender] Init FAILED\n");
+        return false;
+    }
+
+    const SoftRasterStats& s = soft->Stats();
+    app.Log("[SoftRender] %llu frames %ux%u, %zu threads: %.2f ms geometry + %.2f ms raster per frame, %.0f tris (%.0f binned) / %.0f pixels per frame\n",
+        (unsigned long long)s.frames, app.m_Width, app.m_Height, soft->m_Pool.ThreadCount() + 1,
+        s.geometryMs / s.frames, s.rasterMs / s.frames,
+        double(s.trianglesIn) / s.frames, double(s.trianglesBinned) / s.frames, double(s.pixelsShaded) / s.frames);
+    app.Log("[SoftRender] %.2f M triangles/s, %.1f M pixels/s\n", s.TrianglesPerSecond() * 1e-6, s.PixelsPerSecond() * 1e-6);
+    const StateFilterStats& f = app.m_StateFilter->m_Stats;
+    app.Log("[SoftRender] state filter: %.1f issued, %.1f elided per frame\n",
+        double(f.issued) / frames, double(f.elided) / frames);
+
+    if (!WritePng(outPath, soft->ReadBack()))
+    {
+        app.Log("[SoftRender] failed to write %ls\n", outPath);
+        return false;
+    }
+    app.Log("[SoftRender] wrote %ls\n", outPath);
+    return soft->m_Errors.empty();
+}
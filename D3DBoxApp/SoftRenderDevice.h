@@ -0,0 +1,1002 @@
+﻿#pragma once
+
+// CPU 소프트웨어 래스터라이저 렌더 백엔드 (Windows/D3D 의존성 없음)
+// - 드로우 호출 시: 정점 셰이더(SoftShaders.h) → 클리핑(근평면 + 가드 밴드) → 컬링 → 화면 타일(64x64)에 비닝
+// - Present/ReadBack 때: 타일 단위로 스레드 병렬 래스터, 타일 안에서는 제출 순서대로 2x2 쿼드를 F4(SIMD)로 셰이딩
+// - 컬러 RGBA8, 깊이 float32, 블렌딩 없음. 픽셀 중심 샘플링 + top-left 규칙.
+// - 선(LineList)은 주축 DDA로 1픽셀 두께 (D3D의 diamond-exit 규칙과 끝점 픽셀이 다를 수 있다)
+// - ReadBack()으로 백버퍼를 얻어 PNG로 저장할 수 있다 (GPU 없는 참조 이미지)
+// - 상수 버퍼는 드로우 호출 때 복사해 두므로 그 뒤에 버퍼를 고쳐 써도 된다. 펜스는 항상 끝난 상태.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CommandStream.h"
+#include "ImageIO.h"
+#include "RenderDevice.h"
+#include "SoftShaders.h"
+#include "ThreadPool.h"
+
+struct SoftRasterStats
+{
+    uint64_t frames = 0;
+    uint64_t trianglesIn = 0;        // 정점 셰이더를 거친 삼각형
+    uint64_t trianglesBinned = 0;    // 클리핑/컬링 후 타일에 들어간 삼각형
+    uint64_t linesBinned = 0;
+    uint64_t pixelsShaded = 0;       // 깊이 테스트를 통과해 기록된 픽셀
+    double   geometryMs = 0.0;       // 정점 처리 + 셋업 + 비닝
+    double   rasterMs = 0.0;         // 타일 래스터 + 셰이딩
+
+    double TrianglesPerSecond() const { return geometryMs + rasterMs > 0.0 ? trianglesIn / ((geometryMs + rasterMs) * 1e-3) : 0.0; }
+    double PixelsPerSecond() const { return rasterMs > 0.0 ? pixelsShaded / (rasterMs * 1e-3) : 0.0; }
+};
+
+struct SoftRenderDevice;
+
+struct SoftRenderContext final : IRenderContext
+{
+    static constexpr uint32_t MAX_VB_SLOTS = 4;
+    static constexpr uint32_t MAX_CB_SLOTS = SOFT_MAX_CB_SLOTS;
+    static constexpr uint32_t MAX_CB_FLOATS = 64;
+    static constexpr int      TILE = 64;
+    static constexpr uint32_t LINE_BIT = 0x80000000u;   // 빈 항목: 선이면 최상위 비트
+    static constexpr float    GUARD_BAND = 4.0f;        // NDC 기준 가드 밴드 (이 밖만 실제로 잘라낸다)
+
+    // 드로우마다 고정되는 픽셀 단계 상태 (래스터는 나중에 하므로 복사해 둔다)
+    struct DrawState
+    {
+        SoftPixelShaderFn  ps = nullptr;
+        const SoftTexture* tex = nullptr;
+        SamplerDesc        sampler;
+        DepthStateDesc     depth;
+        bool               depthClip = true;
+        uint32_t           varyings = 0;
+        float              cb[MAX_CB_SLOTS][MAX_CB_FLOATS] = {};
+        bool               hasCB[MAX_CB_SLOTS] = {};
+    };
+
+    // 평면식 f(x, y) = a x + b y + c
+    struct Plane { float a, b, c; };
+
+    struct Tri
+    {
+        Plane    edge[3];
+        uint8_t  topLeft = 0;         // 비트 e: e번 엣지가 top/left
+        Plane    z, invW;
+        Plane    var[SOFT_MAX_VARYINGS]; // varying / w
+        int      minX, minY, maxX, maxY;
+        uint32_t draw;
+    };
+
+    struct Line
+    {
+        float    x[2], y[2], z[2], invW[2];
+        float    var[2][SOFT_MAX_VARYINGS];   // varying / w
+        int      minX, minY, maxX, maxY;
+        uint32_t draw;
+    };
+
+    SoftRenderDevice&        m_Device;
+    RenderCounters           m_Counters;
+    SoftRasterStats          m_Stats;
+
+    // 현재 바인딩
+    RenderViewport           m_Viewport;
+    InputLayoutHandle        m_Layout;
+    PrimitiveTopology        m_Topology = PrimitiveTopology::TriangleList;
+    BufferHandle             m_VB[MAX_VB_SLOTS];
+    uint32_t                 m_VBStride[MAX_VB_SLOTS] = {};
+    uint32_t                 m_VBOffset[MAX_VB_SLOTS] = {};
+    BufferHandle             m_IB;
+    IndexFormat              m_IBFormat = IndexFormat::UInt16;
+    uint32_t                 m_IBOffset = 0;
+    ShaderHandle             m_VS, m_PS;
+    BufferHandle             m_VSCB[MAX_CB_SLOTS], m_PSCB[MAX_CB_SLOTS];
+    uint32_t                 m_VSCBOffset[MAX_CB_SLOTS] = {};
+    TextureHandle            m_Tex;
+    SamplerHandle            m_Sampler;
+    DepthStateHandle         m_DepthState;
+    RasterStateHandle        m_RasterState;
+
+    // 렌더 타깃 (pitch/rows는 2의 배수로 올림 → 쿼드가 항상 버퍼 안)
+    uint32_t                 m_Width = 0, m_Height = 0, m_Pitch = 0, m_Rows = 0;
+    std::vector<uint32_t>    m_Color;
+    std::vector<float>       m_Depth;
+
+    // 이번 프레임에 쌓인 프리미티브 (Flush에서 래스터)
+    int                                m_TilesX = 0, m_TilesY = 0;
+    std::vector<DrawState>             m_Draws;
+    std::vector<Tri>                   m_Tris;
+    std::vector<Line>                  m_Lines;
+    std::vector<std::vector<uint32_t>> m_Bins;
+    std::vector<uint64_t>              m_TilePixels;
+
+    // 정점 처리 임시 버퍼
+    std::vector<SoftVertexOut>         m_VertexCache;
+    std::vector<uint32_t>              m_Indices;
+
+    explicit SoftRenderContext(SoftRenderDevice& device) : m_Device(device) {}
+
+    void ResizeTargets(uint32_t width, uint32_t height)
+    {
+        Flush();
+        m_Width = width; m_Height = height;
+        m_Pitch = (width + 1) & ~1u;
+        m_Rows = (height + 1) & ~1u;
+        m_Color.assign(size_t(m_Pitch) * m_Rows, 0);
+        m_Depth.assign(size_t(m_Pitch) * m_Rows, 1.0f);
+        m_TilesX = int((width + TILE - 1) / TILE);
+        m_TilesY = int((height + TILE - 1) / TILE);
+        m_Bins.assign(size_t(m_TilesX) * m_TilesY, {});
+        m_TilePixels.assign(m_Bins.size(), 0);
+    }
+
+    // 아래는 SoftRenderDevice 정의 뒤에 구현
+    void Flush();
+    void DrawPrimitives(bool indexed, uint32_t count, uint32_t start, int32_t baseVertex,
+                        uint32_t instanceCount, uint32_t startInstance);
+    bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) override;
+    void* MapBuffer(BufferHandle buffer, MapMode mode) override;
+    void UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten) override;
+
+    void ClearTargets(const float color[4], float depth) override
+    {
+        Flush();
+        uint32_t c = 0;
+        for (int k = 0; k < 4; ++k)
+            c |= uint32_t(std::clamp(color[k], 0.0f, 1.0f) * 255.0f + 0.5f) << (k * 8);
+        std::fill(m_Color.begin(), m_Color.end(), c);
+        std::fill(m_Depth.begin(), m_Depth.end(), depth);
+    }
+
+    void SetViewport(const RenderViewport& vp) override { m_Viewport = vp; ++m_Counters.stateChanges; }
+    void SetInputLayout(InputLayoutHandle layout) override { m_Layout = layout; ++m_Counters.stateChanges; }
+    void SetPrimitiveTopology(PrimitiveTopology topology) override { m_Topology = topology; ++m_Counters.stateChanges; }
+
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                          const uint32_t* strides, const uint32_t* offsets) override
+    {
+        for (uint32_t i = 0; i < count && startSlot + i < MAX_VB_SLOTS; ++i)
+        {
+            m_VB[startSlot + i] = buffers[i];
+            m_VBStride[startSlot + i] = strides[i];
+            m_VBOffset[startSlot + i] = offsets ? offsets[i] : 0;
+            ++m_Counters.stateChanges;
+        }
+    }
+
+    void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) override
+    {
+        m_IB = buffer; m_IBFormat = format; m_IBOffset = offset;
+        ++m_Counters.stateChanges;
+    }
+
+    void SetVertexShader(ShaderHandle shader) override { m_VS = shader; ++m_Counters.stateChanges; }
+    void SetPixelShader(ShaderHandle shader) override { m_PS = shader; ++m_Counters.stateChanges; }
+
+    void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        SetVSConstantBufferRange(slot, buffer, 0, 0);
+    }
+
+    void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t) override
+    {
+        if (slot < MAX_CB_SLOTS)
+        {
+            m_VSCB[slot] = buffer;
+            m_VSCBOffset[slot] = offset;
+        }
+        ++m_Counters.stateChanges;
+    }
+
+    void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        if (slot < MAX_CB_SLOTS) m_PSCB[slot] = buffer;
+        ++m_Counters.stateChanges;
+    }
+
+    void SetPSTexture(uint32_t slot, TextureHandle texture) override { if (slot == 0) m_Tex = texture; ++m_Counters.stateChanges; }
+    void SetPSSampler(uint32_t slot, SamplerHandle sampler) override { if (slot == 0) m_Sampler = sampler; ++m_Counters.stateChanges; }
+    void SetDepthState(DepthStateHandle state) override { m_DepthState = state; ++m_Counters.stateChanges; }
+    void SetRasterState(RasterStateHandle state) override { m_RasterState = state; ++m_Counters.stateChanges; }
+
+    void Draw(uint32_t vertexCount, uint32_t startVertex) override
+    {
+        DrawPrimitives(false, vertexCount, startVertex, 0, 1, 0);
+    }
+
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override
+    {
+        DrawPrimitives(true, indexCount, startIndex, baseVertex, 1, 0);
+    }
+
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override
+    {
+        DrawPrimitives(true, indexCount, startIndex, baseVertex, instanceCount, startInstance);
+    }
+
+    const RenderCounters& Counters() const override { return m_Counters; }
+    void ResetCounters() override { m_Counters = RenderCounters{}; }
+
+    // 지연 컨텍스트는 CommandStreamContext라서 목록은 항상 CommandStream
+    void ExecuteCommandList(IRenderCommandList& list) override { static_cast<CommandStream&>(list).Replay(*this); }
+
+    // ------------------------------------------------------------
+    // 클리핑 / 셋업 / 비닝
+    // ------------------------------------------------------------
+
+    // 평면 i에 대한 부호 거리 (>= 0 이면 안쪽). 0: 근평면, 1~4: 가드 밴드 x/y
+    static float ClipDistance(const SoftVertexOut& v, int plane, bool depthClip)
+    {
+        const float* p = v.pos;
+        switch (plane)
+        {
+        case 0:  return depthClip ? p[2] : p[3] - 1e-5f;
+        case 1:  return GUARD_BAND * p[3] - p[0];
+        case 2:  return GUARD_BAND * p[3] + p[0];
+        case 3:  return GUARD_BAND * p[3] - p[1];
+        default: return GUARD_BAND * p[3] + p[1];
+        }
+    }
+
+    static SoftVertexOut Lerp(const SoftVertexOut& a, const SoftVertexOut& b, float t, uint32_t nvar)
+    {
+        SoftVertexOut r;
+        for (int k = 0; k < 4; ++k) r.pos[k] = a.pos[k] + (b.pos[k] - a.pos[k]) * t;
+        for (uint32_t k = 0; k < nvar; ++k) r.var[k] = a.var[k] + (b.var[k] - a.var[k]) * t;
+        return r;
+    }
+
+    // 모든 정점이 한 절두체 평면 밖이면 true
+    static bool TriviallyOutside(const SoftVertexOut* const* v, int n, bool depthClip)
+    {
+        auto all = [&](auto pred) { for (int i = 0; i < n; ++i) if (!pred(v[i]->pos)) return false; return true; };
+        if (all([](const float* p) { return p[0] > p[3]; }) || all([](const float* p) { return p[0] < -p[3]; })) return true;
+        if (all([](const float* p) { return p[1] > p[3]; }) || all([](const float* p) { return p[1] < -p[3]; })) return true;
+        if (all([](const float* p) { return p[3] <= 0.0f; })) return true;
+        if (depthClip && (all([](const float* p) { return p[2] < 0.0f; }) || all([](const float* p) { return p[2] > p[3]; }))) return true;
+        return false;
+    }
+
+    void ToScreen(const SoftVertexOut& v, float& x, float& y, float& z, float& invW) const
+    {
+        invW = 1.0f / v.pos[3];
+        const RenderViewport& vp = m_Viewport;
+        x = vp.x + (v.pos[0] * invW * 0.5f + 0.5f) * vp.width;
+        y = vp.y + (0.5f - v.pos[1] * invW * 0.5f) * vp.height;
+        z = vp.minDepth + v.pos[2] * invW * (vp.maxDepth - vp.minDepth);
+        // 1/256 픽셀로 스냅 (인접 삼각형의 공유 엣지가 같은 값을 갖도록)
+        x = floorf(x * 256.0f + 0.5f) * (1.0f / 256.0f);
+        y = floorf(y * 256.0f + 0.5f) * (1.0f / 256.0f);
+    }
+
+    // 뷰포트와 화면의 교집합 (픽셀, 포함)
+    void ScissorRect(int& x0, int& y0, int& x1, int& y1) const
+    {
+        x0 = std::max(0, int(ceilf(m_Viewport.x - 0.5f)));
+        y0 = std::max(0, int(ceilf(m_Viewport.y - 0.5f)));
+        x1 = std::min(int(m_Width) - 1, int(floorf(m_Viewport.x + m_Viewport.width - 0.5f)));
+        y1 = std::min(int(m_Height) - 1, int(floorf(m_Viewport.y + m_Viewport.height - 0.5f)));
+    }
+
+    void Bin(uint32_t item, int minX, int minY, int maxX, int maxY)
+    {
+        for (int ty = minY / TILE; ty <= maxY / TILE; ++ty)
+            for (int tx = minX / TILE; tx <= maxX / TILE; ++tx)
+                m_Bins[size_t(ty) * m_TilesX + tx].push_back(item);
+    }
+
+    void SetupTriangle(const SoftVertexOut& v0, const SoftVertexOut& v1, const SoftVertexOut& v2,
+                       uint32_t draw, const RasterStateDesc& rs)
+    {
+        const SoftVertexOut* v[3] = { &v0, &v1, &v2 };
+        float x[3], y[3], z[3], iw[3];
+        for (int i = 0; i < 3; ++i) ToScreen(*v[i], x[i], y[i], z[i], iw[i]);
+
+        // 화면은 y가 아래로: area > 0 이면 시계 방향
+        float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (area == 0.0f) return;
+        bool front = rs.frontCounterClockwise ? (area < 0.0f) : (area > 0.0f);
+        if ((rs.cull == CullMode::Back && !front) || (rs.cull == CullMode::Front && front)) return;
+        if (area < 0.0f)
+        {
+            std::swap(v[1], v[2]);
+            std::swap(x[1], x[2]); std::swap(y[1], y[2]); std::swap(z[1], z[2]); std::swap(iw[1], iw[2]);
+            area = -area;
+        }
+
+        Tri t;
+        int sx0, sy0, sx1, sy1;
+        ScissorRect(sx0, sy0, sx1, sy1);
+        t.minX = std::max(sx0, int(ceilf(std::min({ x[0], x[1], x[2] }) - 0.5f)));
+        t.minY = std::max(sy0, int(ceilf(std::min({ y[0], y[1], y[2] }) - 0.5f)));
+        t.maxX = std::min(sx1, int(floorf(std::max({ x[0], x[1], x[2] }) - 0.5f)));
+        t.maxY = std::min(sy1, int(floorf(std::max({ y[0], y[1], y[2] }) - 0.5f)));
+        if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+        // 엣지 e: 정점 e → e+1, 안쪽이 양수. top = 수평이고 오른쪽으로, left = 위로 향하는 엣지
+        for (int e = 0; e < 3; ++e)
+        {
+            int i = e, j = (e + 1) % 3;
+            t.edge[e] = { y[i] - y[j], x[j] - x[i], x[i] * y[j] - x[j] * y[i] };
+            float dx = x[j] - x[i], dy = y[j] - y[i];
+            if ((dy == 0.0f && dx > 0.0f) || dy < 0.0f) t.topLeft |= uint8_t(1 << e);
+        }
+
+        // 무게중심: 정점 0 ← 엣지 1, 정점 1 ← 엣지 2, 정점 2 ← 엣지 0
+        const float inv = 1.0f / area;
+        auto plane = [&](float f0, float f1, float f2) -> Plane
+        {
+            return { (t.edge[1].a * f0 + t.edge[2].a * f1 + t.edge[0].a * f2) * inv,
+                     (t.edge[1].b * f0 + t.edge[2].b * f1 + t.edge[0].b * f2) * inv,
+                     (t.edge[1].c * f0 + t.edge[2].c * f1 + t.edge[0].c * f2) * inv };
+        };
+        t.z = plane(z[0], z[1], z[2]);
+        t.invW = plane(iw[0], iw[1], iw[2]);
+        const uint32_t nvar = m_Draws[draw].varyings;
+        for (uint32_t k = 0; k < nvar; ++k)
+            t.var[k] = plane(v[0]->var[k] * iw[0], v[1]->var[k] * iw[1], v[2]->var[k] * iw[2]);
+        t.draw = draw;
+
+        uint32_t index = uint32_t(m_Tris.size());
+        m_Tris.push_back(t);
+        ++m_Stats.trianglesBinned;
+        Bin(index, t.minX, t.minY, t.maxX, t.maxY);
+    }
+
+    // 근평면/가드 밴드에 걸치면 Sutherland-Hodgman으로 잘라 부채꼴로 나눈다.
+    void ClipTriangle(const SoftVertexOut& a, const SoftVertexOut& b, const SoftVertexOut& c,
+                      uint32_t draw, const RasterStateDesc& rs)
+    {
+        const SoftVertexOut* tri[3] = { &a, &b, &c };
+        if (TriviallyOutside(tri, 3, rs.depthClip)) return;
+
+        int planes = 0;
+        for (int p = 0; p < 5; ++p)
+            for (int i = 0; i < 3; ++i)
+                if (ClipDistance(*tri[i], p, rs.depthClip) < 0.0f) planes |= 1 << p;
+        if (planes == 0)
+        {
+            SetupTriangle(a, b, c, draw, rs);
+            return;
+        }
+
+        const uint32_t nvar = m_Draws[draw].varyings;
+        SoftVertexOut bufA[9], bufB[9];
+        SoftVertexOut* in = bufA;
+        SoftVertexOut* out = bufB;
+        int n = 3;
+        in[0] = a; in[1] = b; in[2] = c;
+        for (int p = 0; p < 5 && n >= 3; ++p)
+        {
+            if (!(planes & (1 << p))) continue;
+            int m = 0;
+            for (int i = 0; i < n; ++i)
+            {
+                const SoftVertexOut& s = in[i];
+                const SoftVertexOut& e = in[(i + 1) % n];
+                float ds = ClipDistance(s, p, rs.depthClip), de = ClipDistance(e, p, rs.depthClip);
+                if (ds >= 0.0f) out[m++] = s;
+                if ((ds >= 0.0f) != (de >= 0.0f) && m < 9)
+                    out[m++] = Lerp(s, e, ds / (ds - de), nvar);
+            }
+            std::swap(in, out);
+            n = m;
+        }
+        for (int i = 1; i + 1 < n; ++i)
+            SetupTriangle(in[0], in[i], in[i + 1], draw, rs);
+    }
+
+    void ClipLine(const SoftVertexOut& a, const SoftVertexOut& b, uint32_t draw, const RasterStateDesc& rs)
+    {
+        const SoftVertexOut* seg[2] = { &a, &b };
+        if (TriviallyOutside(seg, 2, rs.depthClip)) return;
+
+        const uint32_t nvar = m_Draws[draw].varyings;
+        SoftVertexOut p0 = a, p1 = b;
+        for (int p = 0; p < 5; ++p)
+        {
+            float d0 = ClipDistance(p0, p, rs.depthClip), d1 = ClipDistance(p1, p, rs.depthClip);
+            if (d0 < 0.0f && d1 < 0.0f) return;
+            if (d0 < 0.0f) p0 = Lerp(p0, p1, d0 / (d0 - d1), nvar);
+            else if (d1 < 0.0f) p1 = Lerp(p0, p1, d0 / (d0 - d1), nvar);
+        }
+
+        Line l;
+        const SoftVertexOut* v[2] = { &p0, &p1 };
+        for (int i = 0; i < 2; ++i)
+        {
+            ToScreen(*v[i], l.x[i], l.y[i], l.z[i], l.invW[i]);
+            for (uint32_t k = 0; k < nvar; ++k) l.var[i][k] = v[i]->var[k] * l.invW[i];
+        }
+
+        int sx0, sy0, sx1, sy1;
+        ScissorRect(sx0, sy0, sx1, sy1);
+        l.minX = std::max(sx0, int(floorf(std::min(l.x[0], l.x[1]))));
+        l.minY = std::max(sy0, int(floorf(std::min(l.y[0], l.y[1]))));
+        l.maxX = std::min(sx1, int(floorf(std::max(l.x[0], l.x[1]))));
+        l.maxY = std::min(sy1, int(floorf(std::max(l.y[0], l.y[1]))));
+        if (l.minX > l.maxX || l.minY > l.maxY) return;
+        l.draw = draw;
+
+        uint32_t index = uint32_t(m_Lines.size());
+        m_Lines.push_back(l);
+        ++m_Stats.linesBinned;
+        Bin(index | LINE_BIT, l.minX, l.minY, l.maxX, l.maxY);
+    }
+
+    // ------------------------------------------------------------
+    // 타일 래스터
+    // ------------------------------------------------------------
+    static F4 Eval(const Plane& p, F4 px, F4 rowTerm) { return F4(p.a) * px + rowTerm; }
+
+    // 깊이 테스트 (mask: 커버된 lane), 통과한 lane 마스크를 돌려준다
+    static F4 DepthTest(const DepthStateDesc& ds, F4 z, F4 old, F4 mask)
+    {
+        if (!ds.depthEnable) return mask;
+        switch (ds.func)
+        {
+        case CompareFunc::Less:      return mask & CmpLT(z, old);
+        case CompareFunc::LessEqual: return mask & CmpLE(z, old);
+        default:                     return mask;
+        }
+    }
+
+    static uint32_t PackColor(const float c[4])
+    {
+        uint32_t p = 0;
+        for (int k = 0; k < 4; ++k)
+        {
+            float v = c[k] > 0.0f ? (c[k] < 1.0f ? c[k] : 1.0f) : 0.0f;   // NaN → 0
+            p |= uint32_t(v * 255.0f + 0.5f) << (k * 8);
+        }
+        return p;
+    }
+
+    // 4 lane 색 → RGBA8 (saturate, 반올림)
+    static void PackColors(const F4 color[4], uint32_t out[4])
+    {
+#if defined(SOFT_RASTER_SSE)
+        __m128i packed = _mm_setzero_si128();
+        for (int k = 0; k < 4; ++k)
+        {
+            __m128i c = _mm_cvttps_epi32((Saturate(color[k]) * F4(255.0f) + F4(0.5f)).v);
+            packed = _mm_or_si128(packed, _mm_slli_epi32(c, k * 8));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+#else
+        for (int i = 0; i < 4; ++i)
+        {
+            const float c[4] = { color[0][i], color[1][i], color[2][i], color[3][i] };
+            out[i] = PackColor(c);
+        }
+#endif
+    }
+
+    // 쿼드의 통과 lane에 셰이더 결과와 깊이를 기록
+    void WriteQuad(int bits, const F4 color[4], F4 z, const DepthStateDesc& ds, uint32_t* c0, float* d0)
+    {
+        uint32_t packed[4];
+        float zz[4];
+        PackColors(color, packed);
+        z.Store(zz);
+        const bool writeDepth = ds.depthEnable && ds.depthWrite;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (!(bits & (1 << i))) continue;
+            size_t o = size_t(i & 1) + ((i >> 1) ? m_Pitch : 0);
+            c0[o] = packed[i];
+            if (writeDepth) d0[o] = zz[i];
+        }
+    }
+
+    void RasterTriangle(const Tri& t, int tx0, int ty0, int tx1, int ty1, uint64_t& pixels)
+    {
+        const DrawState& d = m_Draws[t.draw];
+        // 쿼드는 짝수 좌표에서 시작 (타일 경계는 64의 배수라 쿼드가 타일을 넘지 않는다)
+        const int xFirst = std::max(t.minX, tx0), xe = std::min(t.maxX, tx1);
+        const int yFirst = std::max(t.minY, ty0), ye = std::min(t.maxY, ty1);
+        if (xFirst > xe || yFirst > ye) return;
+        const int xs = xFirst & ~1, ys = yFirst & ~1;
+
+        SoftPixelResources res;
+        for (uint32_t s = 0; s < MAX_CB_SLOTS; ++s) res.cb[s] = d.hasCB[s] ? d.cb[s] : nullptr;
+        res.tex = d.tex;
+        res.sampler = d.sampler;
+
+        const F4 zero(0.0f);
+        const F4 laneX(0.5f, 1.5f, 0.5f, 1.5f), laneY(0.5f, 0.5f, 1.5f, 1.5f);
+        SoftQuad q;
+        F4 color[4];
+
+        for (int y = ys; y <= ye; y += 2)
+        {
+            const F4 py = F4(float(y)) + laneY;
+            F4 row[3];
+            for (int e = 0; e < 3; ++e) row[e] = F4(t.edge[e].b) * py + F4(t.edge[e].c);
+            const F4 zRow = F4(t.z.b) * py + F4(t.z.c);
+            const F4 wRow = F4(t.invW.b) * py + F4(t.invW.c);
+            const int rowBits = ((y < yFirst) ? 0xC : 0xF) & ((y + 1 > ye) ? 0x3 : 0xF);
+
+            for (int x = xs; x <= xe; x += 2)
+            {
+                const F4 px = F4(float(x)) + laneX;
+                F4 inside = MaskFromBits(rowBits & ((x < xFirst) ? 0xA : 0xF) & ((x + 1 > xe) ? 0x5 : 0xF));
+                for (int e = 0; e < 3; ++e)
+                {
+                    F4 ev = Eval(t.edge[e], px, row[e]);
+                    inside = inside & ((t.topLeft >> e) & 1 ? CmpGE(ev, zero) : CmpGT(ev, zero));
+                }
+                if (MoveMask(inside) == 0) continue;
+
+                F4 z = Eval(t.z, px, zRow);
+                if (d.depthClip) inside = inside & CmpGE(z, zero) & CmpLE(z, F4(1.0f));
+                else             z = Saturate(z);
+
+                const size_t o = size_t(y) * m_Pitch + x;
+                float* d0 = &m_Depth[o];
+                const F4 old(d0[0], d0[1], d0[m_Pitch], d0[m_Pitch + 1]);
+                inside = DepthTest(d.depth, z, old, inside);
+                const int bits = MoveMask(inside);
+                if (bits == 0) continue;
+
+                // 원근 보정 보간: (v/w) / (1/w)
+                const F4 w = F4(1.0f) / Eval(t.invW, px, wRow);
+                for (uint32_t k = 0; k < d.varyings; ++k)
+                    q.var[k] = (F4(t.var[k].a) * px + F4(t.var[k].b) * py + F4(t.var[k].c)) * w;
+
+                d.ps(q, res, color);
+                WriteQuad(bits, color, z, d.depth, &m_Color[o], d0);
+                pixels += uint64_t(LaneCount(bits));
+            }
+        }
+    }
+
+    static int LaneCount(int bits) { return (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + ((bits >> 3) & 1); }
+
+    void RasterLine(const Line& l, int tx0, int ty0, int tx1, int ty1, uint64_t& pixels)
+    {
+        const DrawState& d = m_Draws[l.draw];
+        SoftPixelResources res;
+        for (uint32_t s = 0; s < MAX_CB_SLOTS; ++s) res.cb[s] = d.hasCB[s] ? d.cb[s] : nullptr;
+        res.tex = d.tex;
+        res.sampler = d.sampler;
+
+        const int x0 = std::max(l.minX, tx0), x1 = std::min(l.maxX, tx1);
+        const int y0 = std::max(l.minY, ty0), y1 = std::min(l.maxY, ty1);
+        if (x0 > x1 || y0 > y1) return;
+
+        const float dx = l.x[1] - l.x[0], dy = l.y[1] - l.y[0];
+        const bool xMajor = fabsf(dx) >= fabsf(dy);
+        const float len = xMajor ? dx : dy;
+        if (len == 0.0f) return;
+
+        // 주축 픽셀 중심마다 한 픽셀, 4개씩 모아서 셰이딩
+        int   lanes = 0;
+        int   px[4], py[4];
+        float pt[4], pz[4];
+        SoftQuad q;
+        F4 color[4];
+
+        auto flush = [&]()
+        {
+            if (lanes == 0) return;
+            float tt[4], iw[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                tt[i] = pt[i < lanes ? i : 0];
+                iw[i] = l.invW[0] + (l.invW[1] - l.invW[0]) * tt[i];
+            }
+            for (uint32_t k = 0; k < d.varyings; ++k)
+            {
+                float v[4];
+                for (int i = 0; i < 4; ++i) v[i] = (l.var[0][k] + (l.var[1][k] - l.var[0][k]) * tt[i]) / iw[i];
+                q.var[k] = F4(v[0], v[1], v[2], v[3]);
+            }
+            d.ps(q, res, color);
+            float r[4], g[4], b[4], a[4];
+            color[0].Store(r); color[1].Store(g); color[2].Store(b); color[3].Store(a);
+            for (int i = 0; i < lanes; ++i)
+            {
+                size_t o = size_t(py[i]) * m_Pitch + px[i];
+                const float c[4] = { r[i], g[i], b[i], a[i] };
+                m_Color[o] = PackColor(c);
+                if (d.depth.depthEnable && d.depth.depthWrite) m_Depth[o] = pz[i];
+            }
+            pixels += uint64_t(lanes);
+            lanes = 0;
+        };
+
+        const int s0 = xMajor ? x0 : y0, s1 = xMajor ? x1 : y1;
+        const float start = xMajor ? l.x[0] : l.y[0];
+        const float lo = std::min(start, start + len), hi = std::max(start, start + len);
+        for (int s = s0; s <= s1; ++s)
+        {
+            float center = s + 0.5f;
+            if (center < lo || center > hi) continue;
+            float t = (center - start) / len;
+            float other = xMajor ? l.y[0] + dy * t : l.x[0] + dx * t;
+            int   o = int(floorf(other));
+            int   x = xMajor ? s : o, y = xMajor ? o : s;
+            if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+
+            float z = l.z[0] + (l.z[1] - l.z[0]) * t;
+            if (d.depthClip) { if (z < 0.0f || z > 1.0f) continue; }
+            else z = std::clamp(z, 0.0f, 1.0f);
+
+            float old = m_Depth[size_t(y) * m_Pitch + x];
+            if (d.depth.depthEnable)
+            {
+                if (d.depth.func == CompareFunc::Less && !(z < old)) continue;
+                if (d.depth.func == CompareFunc::LessEqual && !(z <= old)) continue;
+            }
+            px[lanes] = x; py[lanes] = y; pt[lanes] = t; pz[lanes] = z;
+            if (++lanes == 4) flush();
+        }
+        flush();
+    }
+
+    void RasterTile(int tile)
+    {
+        const int tx0 = (tile % m_TilesX) * TILE, ty0 = (tile / m_TilesX) * TILE;
+        const int tx1 = std::min(tx0 + TILE, int(m_Width)) - 1, ty1 = std::min(ty0 + TILE, int(m_Height)) - 1;
+        uint64_t pixels = 0;
+        for (uint32_t item : m_Bins[tile])
+        {
+            if (item & LINE_BIT) RasterLine(m_Lines[item & ~LINE_BIT], tx0, ty0, tx1, ty1, pixels);
+            else                 RasterTriangle(m_Tris[item], tx0, ty0, tx1, ty1, pixels);
+        }
+        m_TilePixels[tile] = pixels;
+    }
+};
+
+struct SoftRenderDevice final : IRenderDevice
+{
+    struct Buffer
+    {
+        BufferDesc           desc;
+        std::vector<uint8_t> data;
+    };
+
+    struct LayoutElement
+    {
+        int      attr;         // SoftAttribute
+        uint32_t components;
+        uint32_t slot;
+        uint32_t offset;
+        bool     perInstance;
+    };
+
+    HandleTable<Buffer>                       m_Buffers;
+    HandleTable<SoftShaderProgram>            m_Shaders;
+    HandleTable<std::vector<LayoutElement>>   m_Layouts;
+    HandleTable<std::unique_ptr<SoftTexture>> m_Textures;   // 포인터 고정 (드로우 상태가 참조)
+    HandleTable<SamplerDesc>                  m_Samplers;
+    HandleTable<DepthStateDesc>               m_DepthStates;
+    HandleTable<RasterStateDesc>              m_RasterStates;
+    std::vector<std::string>                  m_Errors;      // 생성 실패 원인 (셰이더 미지원, 텍스처 로드 실패 등)
+    ThreadPool                                m_Pool;
+    SoftRenderContext                         m_Context{ *this };
+    uint64_t                                  m_Frames = 0;
+    uint64_t                                  m_LastFence = 0;
+
+    SoftRenderDevice(uint32_t width = 1280, uint32_t height = 720, unsigned threads = 0)
+        : m_Pool(threads)
+    {
+        m_Context.ResizeTargets(width, height);
+    }
+
+    IRenderContext& Context() override { return m_Context; }
+    std::unique_ptr<IDeferredContext> CreateDeferredContext() override { return std::make_unique<CommandStreamContext>(); }
+
+    BufferHandle CreateBuffer(const BufferDesc& desc, const void* initData) override
+    {
+        if (desc.byteWidth == 0) { m_Errors.emplace_back("CreateBuffer: zero size"); return {}; }
+        Buffer b;
+        b.desc = desc;
+        b.data.assign(desc.byteWidth, 0);
+        if (initData)
+        {
+            memcpy(b.data.data(), initData, desc.byteWidth);
+            m_Context.m_Counters.bytesUploaded += desc.byteWidth;
+        }
+        ++m_Context.m_Counters.buffersCreated;
+        return { m_Buffers.Add(std::move(b)) };
+    }
+
+    ShaderHandle CreateShader(const ShaderDesc& desc) override
+    {
+        SoftShaderProgram p;
+        if (!desc.file || !desc.entry || !FindSoftShader(desc.file, desc.entry, desc.stage, p))
+        {
+            m_Errors.emplace_back(std::string("CreateShader: no software implementation for ") + (desc.entry ? desc.entry : "(null)"));
+            return {};
+        }
+        return { m_Shaders.Add(p) };
+    }
+
+    InputLayoutHandle CreateInputLayout(const VertexElement* elements, uint32_t count, ShaderHandle vs) override
+    {
+        const SoftShaderProgram* p = m_Shaders.Get(vs.id);
+        if (!p || p->stage != ShaderStage::Vertex) { m_Errors.emplace_back("CreateInputLayout: invalid vertex shader"); return {}; }
+
+        std::vector<LayoutElement> layout;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const VertexElement& e = elements[i];
+            int attr = SoftAttributeIndex(e.semantic, e.semanticIndex);
+            if (attr < 0 || e.slot >= SoftRenderContext::MAX_VB_SLOTS)
+            {
+                m_Errors.emplace_back(std::string("CreateInputLayout: unsupported element ") + e.semantic);
+                return {};
+            }
+            uint32_t comps = (e.format == VertexFormat::Float2) ? 2 : (e.format == VertexFormat::Float3) ? 3 : 4;
+            layout.push_back({ attr, comps, e.slot, e.offset, e.perInstance });
+        }
+        return { m_Layouts.Add(std::move(layout)) };
+    }
+
+    TextureHandle LoadTexture(const wchar_t* path) override
+    {
+        auto tex = std::make_unique<SoftTexture>();
+        if (!path || !LoadImageFile(path, tex->set))
+        {
+            std::string narrow;
+            for (const wchar_t* p = path; p && *p; ++p) narrow += char(*p);
+            m_Errors.emplace_back("LoadTexture: failed to load " + narrow);
+            return {};
+        }
+        if (tex->set.faces == 1) GenerateMips(tex->set);   // WIC 로더처럼 밉 생성 (DDS는 파일의 밉 사용)
+        return { m_Textures.Add(std::move(tex)) };
+    }
+
+    // 블록 형식은 여기서 RGBA8로 풀어 둔다 (샘플링은 LoadTexture와 같은 경로)
+    TextureHandle CreateTexture(const TextureDesc& desc, const void* const* mipData) override
+    {
+        if (desc.width == 0 || desc.height == 0 || desc.mipLevels == 0 || !mipData)
+        {
+            m_Errors.emplace_back("CreateTexture: invalid desc");
+            return {};
+        }
+        auto tex = std::make_unique<SoftTexture>();
+        tex->set.faces = desc.cube ? 6 : 1;
+        tex->set.mipLevels = desc.mipLevels;
+        for (uint32_t f = 0; f < tex->set.faces; ++f)
+        {
+            uint32_t w = desc.width, h = desc.height;
+            for (uint32_t m = 0; m < desc.mipLevels; ++m)
+            {
+                Image img;
+                img.width = w; img.height = h;
+                img.rgba.resize(size_t(w) * h * 4);
+                const uint8_t* src = static_cast<const uint8_t*>(mipData[f * desc.mipLevels + m]);
+                switch (desc.format)
+                {
+                case TextureFormat::RGBA8: memcpy(img.rgba.data(), src, img.rgba.size()); break;
+                case TextureFormat::BC1:   DecodeBlocks(DdsFormat::BC1, src, img); break;
+                case TextureFormat::BC3:   DecodeBlocks(DdsFormat::BC3, src, img); break;
+                case TextureFormat::BC7:   DecodeBlocks(DdsFormat::BC7, src, img); break;
+                }
+                tex->set.surfaces.push_back(std::move(img));
+                w = std::max<uint32_t>(w / 2, 1);
+                h = std::max<uint32_t>(h / 2, 1);
+            }
+        }
+        return { m_Textures.Add(std::move(tex)) };
+    }
+
+    SamplerHandle CreateSampler(const SamplerDesc& desc) override { return { m_Samplers.Add(desc) }; }
+    DepthStateHandle CreateDepthState(const DepthStateDesc& desc) override { return { m_DepthStates.Add(desc) }; }
+    RasterStateHandle CreateRasterState(const RasterStateDesc& desc) override { return { m_RasterStates.Add(desc) }; }
+
+    void DestroyBuffer(BufferHandle buffer) override { m_Buffers.Remove(buffer.id); }
+
+    void Resize(uint32_t width, uint32_t height) override { m_Context.ResizeTargets(width, height); }
+
+    void Present(uint32_t) override
+    {
+        m_Context.Flush();
+        ++m_Frames;
+        ++m_Context.m_Stats.frames;
+    }
+
+    // 버퍼는 드로우 호출 때 이미 읽었으므로 펜스는 넣는 즉시 끝난다
+    uint64_t InsertFence() override { return ++m_LastFence; }
+    bool IsFenceComplete(uint64_t) override { return true; }
+    void WaitForFence(uint64_t) override {}
+    bool WaitForFrameLatency(uint32_t) override { return false; }
+
+    // 남은 프리미티브를 래스터한 뒤 백버퍼를 RGBA8 이미지로 복사
+    Image ReadBack()
+    {
+        m_Context.Flush();
+        Image img;
+        img.width = m_Context.m_Width;
+        img.height = m_Context.m_Height;
+        img.rgba.resize(size_t(img.width) * img.height * 4);
+        for (uint32_t y = 0; y < img.height; ++y)
+            memcpy(img.Pixel(0, y), &m_Context.m_Color[size_t(y) * m_Context.m_Pitch], size_t(img.width) * 4);
+        return img;
+    }
+
+    const SoftRasterStats& Stats() const { return m_Context.m_Stats; }
+};
+
+inline bool SoftRenderContext::UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes)
+{
+    SoftRenderDevice::Buffer* b = m_Device.m_Buffers.Get(buffer.id);
+    if (!b || b->desc.usage != BufferUsage::Dynamic || !data || bytes > b->desc.byteWidth) return false;
+    memcpy(b->data.data(), data, bytes);
+    m_Counters.bytesUploaded += bytes;
+    ++m_Counters.maps;
+    return true;
+}
+
+inline void* SoftRenderContext::MapBuffer(BufferHandle buffer, MapMode)
+{
+    SoftRenderDevice::Buffer* b = m_Device.m_Buffers.Get(buffer.id);
+    if (!b || b->desc.usage != BufferUsage::Dynamic) return nullptr;
+    ++m_Counters.maps;
+    return b->data.data();
+}
+
+inline void SoftRenderContext::UnmapBuffer(BufferHandle, uint32_t bytesWritten)
+{
+    m_Counters.bytesUploaded += bytesWritten;
+}
+
+inline void SoftRenderContext::Flush()
+{
+    if (m_Tris.empty() && m_Lines.empty()) return;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const size_t tiles = m_Bins.size();
+    m_Device.m_Pool.ParallelFor(tiles, 1, [this](size_t b, size_t e) { for (size_t i = b; i < e; ++i) RasterTile(int(i)); });
+
+    for (size_t i = 0; i < tiles; ++i)
+    {
+        m_Stats.pixelsShaded += m_TilePixels[i];
+        m_Bins[i].clear();
+    }
+    m_Tris.clear();
+    m_Lines.clear();
+    m_Draws.clear();
+    m_Stats.rasterMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
+
+inline void SoftRenderContext::DrawPrimitives(bool indexed, uint32_t count, uint32_t start, int32_t baseVertex,
+                                              uint32_t instanceCount, uint32_t startInstance)
+{
+    ++m_Counters.draws;
+    m_Counters.instances += instanceCount;
+    m_Counters.primitives += PrimitiveCount(m_Topology, count) * instanceCount;
+
+    SoftRenderDevice& dev = m_Device;
+    const SoftShaderProgram* vs = dev.m_Shaders.Get(m_VS.id);
+    const SoftShaderProgram* ps = dev.m_Shaders.Get(m_PS.id);
+    const std::vector<SoftRenderDevice::LayoutElement>* layout = dev.m_Layouts.Get(m_Layout.id);
+    if (!vs || !vs->vs || !ps || !ps->ps || !layout || count == 0) return;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    // 픽셀 단계 상태 스냅샷
+    DrawState ds;
+    ds.ps = ps->ps;
+    ds.varyings = vs->varyings;
+    if (std::unique_ptr<SoftTexture>* tex = dev.m_Textures.Get(m_Tex.id)) ds.tex = tex->get();
+    if (const SamplerDesc* s = dev.m_Samplers.Get(m_Sampler.id)) ds.sampler = *s;
+    if (const DepthStateDesc* s = dev.m_DepthStates.Get(m_DepthState.id)) ds.depth = *s;
+    RasterStateDesc rs;
+    if (const RasterStateDesc* s = dev.m_RasterStates.Get(m_RasterState.id)) rs = *s;
+    ds.depthClip = rs.depthClip;
+    for (uint32_t s = 0; s < MAX_CB_SLOTS; ++s)
+        if (const SoftRenderDevice::Buffer* b = dev.m_Buffers.Get(m_PSCB[s].id))
+        {
+            memcpy(ds.cb[s], b->data.data(), std::min<size_t>(b->data.size(), sizeof(ds.cb[s])));
+            ds.hasCB[s] = true;
+        }
+    const uint32_t draw = uint32_t(m_Draws.size());
+    m_Draws.push_back(ds);
+
+    float vsCB[MAX_CB_SLOTS][MAX_CB_FLOATS] = {};
+    SoftVertexResources vres;
+    for (uint32_t s = 0; s < MAX_CB_SLOTS; ++s)
+    {
+        if (const SoftRenderDevice::Buffer* b = dev.m_Buffers.Get(m_VSCB[s].id))
+        {
+            const size_t offset = std::min<size_t>(m_VSCBOffset[s], b->data.size());
+            memcpy(vsCB[s], b->data.data() + offset, std::min<size_t>(b->data.size() - offset, sizeof(vsCB[s])));
+        }
+        vres.cb[s] = vsCB[s];
+    }
+
+    // 정점 입력 (범위 밖 읽기는 0, D3D와 같음)
+    struct Fetch { const SoftRenderDevice::LayoutElement* e; const uint8_t* data; size_t size; uint32_t stride; };
+    Fetch fetch[8];
+    uint32_t fetchCount = 0;
+    for (const auto& e : *layout)
+    {
+        if (fetchCount == 8) break;
+        const SoftRenderDevice::Buffer* b = dev.m_Buffers.Get(m_VB[e.slot].id);
+        fetch[fetchCount++] = { &e, b ? b->data.data() + std::min<size_t>(m_VBOffset[e.slot], b->data.size()) : nullptr,
+                                b ? b->data.size() - std::min<size_t>(m_VBOffset[e.slot], b->data.size()) : 0, m_VBStride[e.slot] };
+    }
+
+    auto runVS = [&](uint32_t vertex, uint32_t instance, SoftVertexOut& out)
+    {
+        SoftVertexIn in;
+        for (auto& a : in.attr) { a[0] = a[1] = a[2] = 0.0f; a[3] = 1.0f; }
+        for (uint32_t i = 0; i < fetchCount; ++i)
+        {
+            const Fetch& f = fetch[i];
+            size_t o = size_t(f.e->perInstance ? instance : vertex) * f.stride + f.e->offset;
+            if (f.data && o + f.e->components * 4 <= f.size) memcpy(in.attr[f.e->attr], f.data + o, f.e->components * 4);
+            else for (float& v : in.attr[f.e->attr]) v = 0.0f;
+        }
+        vs->vs(in, vres, out);
+    };
+
+    // 인덱스 읽기 + 참조 범위
+    uint32_t minV = 0, maxV = 0;
+    if (indexed)
+    {
+        const SoftRenderDevice::Buffer* ib = dev.m_Buffers.Get(m_IB.id);
+        const uint32_t stride = (m_IBFormat == IndexFormat::UInt16) ? 2 : 4;
+        if (!ib || m_IBOffset + uint64_t(start + count) * stride > ib->data.size()) return;
+        m_Indices.resize(count);
+        const uint8_t* src = ib->data.data() + m_IBOffset + size_t(start) * stride;
+        minV = ~0u;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t v = (stride == 2) ? uint32_t(uint16_t(src[i * 2] | (src[i * 2 + 1] << 8)))
+                                       : uint32_t(src[i * 4] | (src[i * 4 + 1] << 8) | (src[i * 4 + 2] << 16) | (uint32_t(src[i * 4 + 3]) << 24));
+            v = uint32_t(int64_t(v) + baseVertex);
+            m_Indices[i] = v;
+            minV = std::min(minV, v);
+            maxV = std::max(maxV, v);
+        }
+    }
+    else
+    {
+        minV = start;
+        maxV = start + count - 1;
+    }
+
+    const bool lines = (m_Topology == PrimitiveTopology::LineList);
+    const uint32_t per = lines ? 2 : 3;
+    const uint32_t range = maxV - minV + 1;
+    const bool cacheRange = range <= 4 * count;   // 참조 범위가 좁으면 범위 전체를 한 번씩 변환
+    m_VertexCache.resize(cacheRange ? range : count);
+
+    for (uint32_t inst = 0; inst < instanceCount; ++inst)
+    {
+        const uint32_t instance = startInstance + inst;
+        if (cacheRange)
+            for (uint32_t v = 0; v < range; ++v) runVS(minV + v, instance, m_VertexCache[v]);
+        else
+            for (uint32_t i = 0; i < count; ++i) runVS(m_Indices[i], instance, m_VertexCache[i]);
+
+        auto vertex = [&](uint32_t i) -> const SoftVertexOut&
+        {
+            if (!cacheRange) return m_VertexCache[i];
+            return m_VertexCache[(indexed ? m_Indices[i] : start + i) - minV];
+        };
+
+        for (uint32_t i = 0; i + per <= count; i += per)
+        {
+            if (lines) ClipLine(vertex(i), vertex(i + 1), draw, rs);
+            else
+            {
+                ++m_Stats.trianglesIn;
+                ClipTriangle(vertex(i), vertex(i + 1), vertex(i + 2), draw, rs);
+            }
+        }
+    }
+
+    m_Stats.geometryMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+}
@@ -0,0 +1,516 @@
+﻿#pragma once
+
+// 소프트웨어 래스터라이저용 셰이더 (CPU 전용, Windows/D3D 의존성 없음)
+// - BasicTex.hlsl (VSMain/VSMesh/PSMain), BasicColor.hlsl, BasicSkyCubeMap.hlsl를 C++로 옮긴 것.
+//   HLSL을 고치면 여기도 같이 고쳐야 한다 (SoftRenderDevice는 파일/진입 함수 이름으로 셰이더를 고른다).
+// - 픽셀 셰이더는 2x2 쿼드(lane 0 = (x,y), 1 = (x+1,y), 2 = (x,y+1), 3 = (x+1,y+1))를 F4로 한 번에 처리한다.
+//   텍스처 LOD는 쿼드 안의 차분으로 계산한다 (GPU의 ddx/ddy와 같은 방식).
+// - 상수 버퍼 행렬은 C++에서 Transpose()로 올린 column_major 배치: mul(v, M)의 c 성분 = dot(v, cb[c*4 .. c*4+3]).
+// - 상수 버퍼 슬롯: b0 CBFrame (라이트/카메라), b1 CBPass (gViewProj), b2 CBObject (gWorld).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SOFT_RASTER_SSE 1
+#endif
+
+#include "ImageIO.h"
+#include "RenderDevice.h"
+
+// ------------------------------------------------------------
+// 4 lane float (SSE 또는 스칼라). 비교 결과는 lane별 비트 마스크(모두 1 / 모두 0).
+// ------------------------------------------------------------
+#if defined(SOFT_RASTER_SSE)
+struct F4
+{
+    __m128 v;
+
+    F4() = default;
+    F4(__m128 x) : v(x) {}
+    F4(float x) : v(_mm_set1_ps(x)) {}
+    F4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+    float operator[](int i) const { alignas(16) float t[4]; _mm_store_ps(t, v); return t[i]; }
+    void Store(float* out) const { _mm_storeu_ps(out, v); }
+
+    friend F4 operator+(F4 a, F4 b) { return _mm_add_ps(a.v, b.v); }
+    friend F4 operator-(F4 a, F4 b) { return _mm_sub_ps(a.v, b.v); }
+    friend F4 operator*(F4 a, F4 b) { return _mm_mul_ps(a.v, b.v); }
+    friend F4 operator/(F4 a, F4 b) { return _mm_div_ps(a.v, b.v); }
+    friend F4 operator&(F4 a, F4 b) { return _mm_and_ps(a.v, b.v); }
+    friend F4 operator|(F4 a, F4 b) { return _mm_or_ps(a.v, b.v); }
+};
+
+inline F4  Min(F4 a, F4 b) { return _mm_min_ps(a.v, b.v); }
+inline F4  Max(F4 a, F4 b) { return _mm_max_ps(a.v, b.v); }
+inline F4  Sqrt(F4 a) { return _mm_sqrt_ps(a.v); }
+inline F4  CmpGE(F4 a, F4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline F4  CmpGT(F4 a, F4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline F4  CmpLE(F4 a, F4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline F4  CmpLT(F4 a, F4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline F4  Select(F4 mask, F4 a, F4 b) { return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); }
+inline int MoveMask(F4 mask) { return _mm_movemask_ps(mask.v); }
+inline F4  MaskFromBits(int bits)
+{
+    const __m128i bit = _mm_setr_epi32(1, 2, 4, 8);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), bit), bit));
+}
+#else
+struct F4
+{
+    float f[4];
+
+    F4() = default;
+    F4(float x) : f{ x, x, x, x } {}
+    F4(float a, float b, float c, float d) : f{ a, b, c, d } {}
+
+    float operator[](int i) const { return f[i]; }
+    void Store(float* out) const { memcpy(out, f, sizeof(f)); }
+
+    template <typename Op> static F4 Map(F4 a, F4 b, Op op) { F4 r; for (int i = 0; i < 4; ++i) r.f[i] = op(a.f[i], b.f[i]); return r; }
+    static uint32_t Bits(float x) { uint32_t u; memcpy(&u, &x, 4); return u; }
+    static float FromBits(uint32_t u) { float x; memcpy(&x, &u, 4); return x; }
+
+    friend F4 operator+(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x + y; }); }
+    friend F4 operator-(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x - y; }); }
+    friend F4 operator*(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+    friend F4 operator/(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return x / y; }); }
+    friend F4 operator&(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return FromBits(Bits(x) & Bits(y)); }); }
+    friend F4 operator|(F4 a, F4 b) { return Map(a, b, [](float x, float y) { return FromBits(Bits(x) | Bits(y)); }); }
+};
+
+inline F4 Min(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+inline F4 Max(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return y > x ? y : x; }); }
+inline F4 Sqrt(F4 a) { return F4::Map(a, a, [](float x, float) { return sqrtf(x); }); }
+inline F4 CmpGE(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return F4::FromBits(x >= y ? ~0u : 0u); }); }
+inline F4 CmpGT(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return F4::FromBits(x > y ? ~0u : 0u); }); }
+inline F4 CmpLE(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return F4::FromBits(x <= y ? ~0u : 0u); }); }
+inline F4 CmpLT(F4 a, F4 b) { return F4::Map(a, b, [](float x, float y) { return F4::FromBits(x < y ? ~0u : 0u); }); }
+inline F4 Select(F4 mask, F4 a, F4 b)
+{
+    F4 r;
+    for (int i = 0; i < 4; ++i) r.f[i] = F4::Bits(mask.f[i]) ? a.f[i] : b.f[i];
+    return r;
+}
+inline int MoveMask(F4 mask)
+{
+    int m = 0;
+    for (int i = 0; i < 4; ++i) m |= (F4::Bits(mask.f[i]) >> 31) << i;
+    return m;
+}
+inline F4 MaskFromBits(int bits)
+{
+    F4 r;
+    for (int i = 0; i < 4; ++i) r.f[i] = F4::FromBits((bits >> i) & 1 ? ~0u : 0u);
+    return r;
+}
+#endif
+
+// lane별 floor → 정수부와 소수부 (SSE2에는 floor 명령이 없어 변환 후 보정)
+inline void FloorLanes(F4 x, int out[4], float frac[4])
+{
+#if defined(SOFT_RASTER_SSE)
+    __m128i t = _mm_cvttps_epi32(x.v);
+    __m128i adj = _mm_castps_si128(_mm_cmplt_ps(x.v, _mm_cvtepi32_ps(t)));   // 음수 소수면 -1
+    t = _mm_add_epi32(t, adj);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), t);
+    _mm_storeu_ps(frac, _mm_sub_ps(x.v, _mm_cvtepi32_ps(t)));
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        float f = floorf(x.f[i]);
+        out[i] = int(f);
+        frac[i] = x.f[i] - f;
+    }
+#endif
+}
+
+inline F4 Saturate(F4 a) { return Min(Max(a, F4(0.0f)), F4(1.0f)); }
+inline F4 Dot3(const F4 a[3], const F4 b[3]) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+inline void Normalize3(F4 v[3])
+{
+    F4 inv = F4(1.0f) / Sqrt(Dot3(v, v));
+    for (int i = 0; i < 3; ++i) v[i] = v[i] * inv;
+}
+
+// pow(x, p), x >= 0. 정수 지수(1..128)는 제곱을 반복하고, 아니면 lane별 powf.
+inline F4 Pow(F4 x, float p)
+{
+    if (p >= 1.0f && p <= 128.0f && p == floorf(p))
+    {
+        F4 r(1.0f), b = x;
+        for (unsigned e = unsigned(p); e; e >>= 1)
+        {
+            if (e & 1) r = r * b;
+            b = b * b;
+        }
+        return r;
+    }
+    float t[4];
+    x.Store(t);
+    return F4(powf(t[0], p), powf(t[1], p), powf(t[2], p), powf(t[3], p));
+}
+
+// ------------------------------------------------------------
+// 텍스처 (RGBA8, 밉 체인, 큐브맵 6면)
+// ------------------------------------------------------------
+struct SoftTexture
+{
+    ImageSet set;
+
+    uint32_t Faces() const { return set.faces; }
+    uint32_t Mips() const { return set.mipLevels; }
+    bool     IsCube() const { return set.faces == 6; }
+};
+
+struct SoftColor4 { F4 r, g, b, a; };
+
+// 한 레벨에서 lane별 bilinear 필터 (주소 모드: Wrap / Clamp). 크기가 2의 거듭제곱이면 Wrap은 비트 마스크.
+inline void SampleBilinear(const Image& img, TextureAddress address, F4 u, F4 v, float out[4][4])
+{
+    const int w = int(img.width), h = int(img.height);
+    const bool pow2 = (w & (w - 1)) == 0 && (h & (h - 1)) == 0;
+    const uint8_t* texels = img.rgba.data();
+
+    int   xi[4], yi[4];
+    float fracX[4], fracY[4];
+    FloorLanes(u * F4(float(w)) - F4(0.5f), xi, fracX);
+    FloorLanes(v * F4(float(h)) - F4(0.5f), yi, fracY);
+    for (int i = 0; i < 4; ++i)
+    {
+        const float ax = fracX[i], ay = fracY[i];
+        int x0 = xi[i], y0 = yi[i], x1 = x0 + 1, y1 = y0 + 1;
+        if (address == TextureAddress::Wrap && pow2)
+        {
+            x0 &= w - 1; x1 &= w - 1;
+            y0 &= h - 1; y1 &= h - 1;
+        }
+        else if (address == TextureAddress::Wrap)
+        {
+            x0 = ((x0 % w) + w) % w; x1 = ((x1 % w) + w) % w;
+            y0 = ((y0 % h) + h) % h; y1 = ((y1 % h) + h) % h;
+        }
+        else
+        {
+            x0 = std::clamp(x0, 0, w - 1); x1 = std::clamp(x1, 0, w - 1);
+            y0 = std::clamp(y0, 0, h - 1); y1 = std::clamp(y1, 0, h - 1);
+        }
+        const uint8_t* p00 = texels + (size_t(y0) * w + x0) * 4;
+        const uint8_t* p10 = texels + (size_t(y0) * w + x1) * 4;
+        const uint8_t* p01 = texels + (size_t(y1) * w + x0) * 4;
+        const uint8_t* p11 = texels + (size_t(y1) * w + x1) * 4;
+#if defined(SOFT_RASTER_SSE)
+        auto unpack = [](const uint8_t* p)
+        {
+            int32_t t;
+            memcpy(&t, p, 4);
+            const __m128i z = _mm_setzero_si128();
+            return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(t), z), z));
+        };
+        __m128 c00 = unpack(p00), c10 = unpack(p10), c01 = unpack(p01), c11 = unpack(p11);
+        __m128 vax = _mm_set1_ps(ax), vay = _mm_set1_ps(ay);
+        __m128 top = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), vax));
+        __m128 bottom = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), vax));
+        __m128 c = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), vay));
+        _mm_storeu_ps(out[i], _mm_mul_ps(c, _mm_set1_ps(1.0f / 255.0f)));
+#else
+        for (int c = 0; c < 4; ++c)
+        {
+            float top = p00[c] + (p10[c] - p00[c]) * ax;
+            float bottom = p01[c] + (p11[c] - p01[c]) * ax;
+            out[i][c] = (top + (bottom - top) * ay) * (1.0f / 255.0f);
+        }
+#endif
+    }
+}
+
+inline SoftColor4 ToColor4(const float c[4][4])
+{
+    return { F4(c[0][0], c[1][0], c[2][0], c[3][0]), F4(c[0][1], c[1][1], c[2][1], c[3][1]),
+             F4(c[0][2], c[1][2], c[2][2], c[3][2]), F4(c[0][3], c[1][3], c[2][3], c[3][3]) };
+}
+
+// Texture2D.Sample: 쿼드 차분으로 LOD를 구해 trilinear (MIN_MAG_MIP_LINEAR). 텍스처가 없으면 0 (D3D의 null SRV와 같음).
+inline SoftColor4 SampleTexture2D(const SoftTexture* tex, const SamplerDesc& s, F4 u, F4 v)
+{
+    if (!tex || tex->Mips() == 0) return { F4(0.0f), F4(0.0f), F4(0.0f), F4(0.0f) };
+
+    float uu[4], vv[4];
+    u.Store(uu);
+    v.Store(vv);
+
+    const Image& top = tex->set.Surface(0, 0);
+    float dux = (uu[1] - uu[0]) * top.width, dvx = (vv[1] - vv[0]) * top.height;
+    float duy = (uu[2] - uu[0]) * top.width, dvy = (vv[2] - vv[0]) * top.height;
+    float rho2 = std::max(dux * dux + dvx * dvx, duy * duy + dvy * dvy);
+    const float maxLod = std::min(s.maxLod, float(tex->Mips() - 1));
+    float lod = (rho2 > 1.0f && maxLod > 0.0f) ? 0.5f * log2f(rho2) : 0.0f;
+    lod = std::clamp(lod, 0.0f, maxLod);
+
+    int   l0 = int(lod);
+    float t = lod - float(l0);
+    float c0[4][4];
+    SampleBilinear(tex->set.Surface(0, l0), s.address, u, v, c0);
+    if (t > 0.0f && l0 + 1 < int(tex->Mips()))
+    {
+        float c1[4][4];
+        SampleBilinear(tex->set.Surface(0, l0 + 1), s.address, u, v, c1);
+        for (int i = 0; i < 4; ++i)
+            for (int c = 0; c < 4; ++c) c0[i][c] += (c1[i][c] - c0[i][c]) * t;
+    }
+    return ToColor4(c0);
+}
+
+// TextureCube.Sample: 주축으로 면을 고르고 mip 0에서 bilinear, 면 경계는 Clamp
+// (스카이박스는 화면 대비 텍셀이 커서 mip 0이면 충분)
+inline SoftColor4 SampleTextureCube(const SoftTexture* tex, const F4 dir[3])
+{
+    if (!tex || !tex->IsCube()) return { F4(0.0f), F4(0.0f), F4(0.0f), F4(0.0f) };
+
+    float d[3][4];
+    for (int k = 0; k < 3; ++k) dir[k].Store(d[k]);
+
+    float out[4][4];
+    for (int i = 0; i < 4; ++i)
+    {
+        float x = d[0][i], y = d[1][i], z = d[2][i];
+        float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+        uint32_t face;
+        float sc, tc, ma;
+        if (ax >= ay && ax >= az) { face = x >= 0 ? 0 : 1; ma = ax; sc = x >= 0 ? -z : z; tc = -y; }
+        else if (ay >= az)        { face = y >= 0 ? 2 : 3; ma = ay; sc = x; tc = y >= 0 ? z : -z; }
+        else                      { face = z >= 0 ? 4 : 5; ma = az; sc = z >= 0 ? x : -x; tc = -y; }
+
+        float c[4][4];
+        F4 u(ma > 0.0f ? 0.5f * (sc / ma + 1.0f) : 0.5f);
+        F4 v(ma > 0.0f ? 0.5f * (tc / ma + 1.0f) : 0.5f);
+        SampleBilinear(tex->set.Surface(face, 0), TextureAddress::Clamp, u, v, c);
+        memcpy(out[i], c[0], sizeof(out[i]));
+    }
+    return ToColor4(out);
+}
+
+// ------------------------------------------------------------
+// 셰이더
+// ------------------------------------------------------------
+constexpr int SOFT_MAX_VARYINGS = 8;
+
+// 입력 속성 (semantic → 인덱스)
+enum SoftAttribute : int
+{
+    SOFT_ATTR_POSITION, SOFT_ATTR_TEXCOORD, SOFT_ATTR_NORMAL, SOFT_ATTR_COLOR,
+    SOFT_ATTR_INSTWORLD0, SOFT_ATTR_INSTWORLD1, SOFT_ATTR_INSTWORLD2,
+    SOFT_ATTR_COUNT
+};
+
+inline int SoftAttributeIndex(const char* semantic, uint32_t index)
+{
+    if (!strcmp(semantic, "POSITION") && index == 0) return SOFT_ATTR_POSITION;
+    if (!strcmp(semantic, "TEXCOORD") && index == 0) return SOFT_ATTR_TEXCOORD;
+    if (!strcmp(semantic, "NORMAL") && index == 0) return SOFT_ATTR_NORMAL;
+    if (!strcmp(semantic, "COLOR") && index == 0) return SOFT_ATTR_COLOR;
+    if (!strcmp(semantic, "INSTWORLD") && index < 3) return SOFT_ATTR_INSTWORLD0 + int(index);
+    return -1;
+}
+
+struct SoftVertexIn
+{
+    float attr[SOFT_ATTR_COUNT][4];
+};
+
+struct SoftVertexOut
+{
+    float pos[4];                      // clip 좌표 (SV_POSITION)
+    float var[SOFT_MAX_VARYINGS];
+};
+
+// 픽셀 셰이더 입력: 보간된 varying (lane = 쿼드 픽셀)
+struct SoftQuad
+{
+    F4 var[SOFT_MAX_VARYINGS];
+};
+
+constexpr uint32_t SOFT_MAX_CB_SLOTS = 3;
+
+// VS 상수 버퍼 (바인딩되지 않은 슬롯도 0으로 채운 버퍼를 가리킨다)
+struct SoftVertexResources
+{
+    const float* cb[SOFT_MAX_CB_SLOTS] = {};
+};
+
+struct SoftPixelResources
+{
+    const float*       cb[SOFT_MAX_CB_SLOTS] = {};   // PS 상수 버퍼 b0 ~ b2 (없으면 nullptr)
+    const SoftTexture* tex = nullptr; // t0
+    SamplerDesc        sampler;       // s0
+};
+
+using SoftVertexShaderFn = void (*)(const SoftVertexIn&, const SoftVertexResources&, SoftVertexOut&);
+using SoftPixelShaderFn = void (*)(const SoftQuad&, const SoftPixelResources&, F4 out[4]);
+
+// mul(v, M) (v.w 포함 4성분)
+inline void SoftMulRow(const float v[4], const float* m, float out[4])
+{
+    for (int c = 0; c < 4; ++c)
+        out[c] = v[0] * m[c * 4] + v[1] * m[c * 4 + 1] + v[2] * m[c * 4 + 2] + v[3] * m[c * 4 + 3];
+}
+
+// BasicTex.hlsl VSMain: 인스턴스 행렬(전치된 상위 3행)로 월드 변환
+inline void SoftVSTexInstanced(const SoftVertexIn& in, const SoftVertexResources& res, SoftVertexOut& out)
+{
+    const float* p3 = in.attr[SOFT_ATTR_POSITION];
+    const float* n = in.attr[SOFT_ATTR_NORMAL];
+    const float p[4] = { p3[0], p3[1], p3[2], 1.0f };
+    float posW[4] = { 0, 0, 0, 1 };
+    for (int r = 0; r < 3; ++r)
+    {
+        const float* w = in.attr[SOFT_ATTR_INSTWORLD0 + r];
+        posW[r] = w[0] * p[0] + w[1] * p[1] + w[2] * p[2] + w[3] * p[3];
+        out.var[2 + r] = w[0] * n[0] + w[1] * n[1] + w[2] * n[2];
+        out.var[5 + r] = posW[r];
+    }
+    SoftMulRow(posW, res.cb[1], out.pos);
+    out.var[0] = in.attr[SOFT_ATTR_TEXCOORD][0];
+    out.var[1] = in.attr[SOFT_ATTR_TEXCOORD][1];
+}
+
+// BasicTex.hlsl VSMesh: gWorld로 월드 변환
+inline void SoftVSTexMesh(const SoftVertexIn& in, const SoftVertexResources& res, SoftVertexOut& out)
+{
+    const float* world = res.cb[2];
+    const float* p3 = in.attr[SOFT_ATTR_POSITION];
+    const float* n = in.attr[SOFT_ATTR_NORMAL];
+    const float p[4] = { p3[0], p3[1], p3[2], 1.0f };
+    float posW[4];
+    SoftMulRow(p, world, posW);
+    SoftMulRow(posW, res.cb[1], out.pos);
+    for (int c = 0; c < 3; ++c)
+    {
+        out.var[2 + c] = n[0] * world[c * 4] + n[1] * world[c * 4 + 1] + n[2] * world[c * 4 + 2];
+        out.var[5 + c] = posW[c];
+    }
+    out.var[0] = in.attr[SOFT_ATTR_TEXCOORD][0];
+    out.var[1] = in.attr[SOFT_ATTR_TEXCOORD][1];
+}
+
+// BasicColor.hlsl VSMain
+inline void SoftVSColor(const SoftVertexIn& in, const SoftVertexResources& res, SoftVertexOut& out)
+{
+    const float* p3 = in.attr[SOFT_ATTR_POSITION];
+    const float p[4] = { p3[0], p3[1], p3[2], 1.0f };
+    float posW[4];
+    SoftMulRow(p, res.cb[2], posW);
+    SoftMulRow(posW, res.cb[1], out.pos);
+    for (int c = 0; c < 3; ++c) out.var[c] = in.attr[SOFT_ATTR_COLOR][c];
+}
+
+// BasicSkyCubeMap.hlsl VSMain
+inline void SoftVSSky(const SoftVertexIn& in, const SoftVertexResources& res, SoftVertexOut& out)
+{
+    const float* p3 = in.attr[SOFT_ATTR_POSITION];
+    const float p[4] = { p3[0], p3[1], p3[2], 1.0f };
+    float posW[4];
+    SoftMulRow(p, res.cb[2], posW);
+    SoftMulRow(posW, res.cb[1], out.pos);
+    for (int c = 0; c < 3; ++c) out.var[c] = p3[c];
+}
+
+// BasicTex.hlsl PSMain: 점광원 Blinn-Phong (CBFrame b0: lightPos, range, lightColor, pad, eyePos, specPower)
+inline void SoftPSTex(const SoftQuad& q, const SoftPixelResources& res, F4 out[4])
+{
+    static const float zeroCB[12] = {};
+    const float* cb = res.cb[0] ? res.cb[0] : zeroCB;
+
+    F4 N[3] = { q.var[2], q.var[3], q.var[4] };
+    Normalize3(N);
+
+    const F4* posW = &q.var[5];
+    F4 L[3] = { F4(cb[0]) - posW[0], F4(cb[1]) - posW[1], F4(cb[2]) - posW[2] };
+    F4 dist = Sqrt(Dot3(L, L));
+    F4 invDist = F4(1.0f) / dist;
+    for (F4& c : L) c = c * invDist;
+
+    F4 atten = Saturate(F4(1.0f) - dist / F4(cb[3]));
+
+    F4 V[3] = { F4(cb[8]) - posW[0], F4(cb[9]) - posW[1], F4(cb[10]) - posW[2] };
+    Normalize3(V);
+    F4 H[3] = { L[0] + V[0], L[1] + V[1], L[2] + V[2] };
+    Normalize3(H);
+
+    F4 diff = Max(Dot3(N, L), F4(0.0f));
+    F4 spec = Pow(Max(Dot3(N, H), F4(0.0f)), cb[11]) & CmpGE(diff, F4(0.0f));   // step(0, diff)
+
+    SoftColor4 tex = SampleTexture2D(res.tex, res.sampler, q.var[0], q.var[1]);
+    F4 light = diff + F4(0.2f) * atten;
+    out[0] = tex.r * (F4(cb[4]) * light + spec);
+    out[1] = tex.g * (F4(cb[5]) * light + spec);
+    out[2] = tex.b * (F4(cb[6]) * light + spec);
+    out[3] = F4(1.0f);
+}
+
+// BasicColor.hlsl PSMain
+inline void SoftPSColor(const SoftQuad& q, const SoftPixelResources&, F4 out[4])
+{
+    out[0] = q.var[0];
+    out[1] = q.var[1];
+    out[2] = q.var[2];
+    out[3] = F4(1.0f);
+}
+
+// BasicSkyCubeMap.hlsl PSMain: dir = normalize(texDir).xzy
+inline void SoftPSSky(const SoftQuad& q, const SoftPixelResources& res, F4 out[4])
+{
+    F4 d[3] = { q.var[0], q.var[1], q.var[2] };
+    Normalize3(d);
+    F4 dir[3] = { d[0], d[2], d[1] };
+    SoftColor4 c = SampleTextureCube(res.tex, dir);
+    out[0] = c.r;
+    out[1] = c.g;
+    out[2] = c.b;
+    out[3] = c.a;
+}
+
+struct SoftShaderProgram
+{
+    ShaderStage        stage = ShaderStage::Vertex;
+    SoftVertexShaderFn vs = nullptr;
+    SoftPixelShaderFn  ps = nullptr;
+    uint32_t           varyings = 0;   // VS 출력 varying 수
+};
+
+// HLSL 파일 이름(경로 제외) + 진입 함수로 C++ 구현을 찾는다. 없으면 false.
+inline bool FindSoftShader(const wchar_t* file, const char* entry, ShaderStage stage, SoftShaderProgram& out)
+{
+    const wchar_t* name = file;
+    for (const wchar_t* p = file; *p; ++p)
+        if (*p == L'/' || *p == L'\\') name = p + 1;
+
+    struct Entry { const wchar_t* file; const char* entry; ShaderStage stage; SoftVertexShaderFn vs; SoftPixelShaderFn ps; uint32_t varyings; };
+    static const Entry table[] =
+    {
+        { L"BasicTex.hlsl",        "VSMain", ShaderStage::Vertex, SoftVSTexInstanced, nullptr,     8 },
+        { L"BasicTex.hlsl",        "VSMesh", ShaderStage::Vertex, SoftVSTexMesh,      nullptr,     8 },
+        { L"BasicTex.hlsl",        "PSMain", ShaderStage::Pixel,  nullptr,            SoftPSTex,   8 },
+        { L"BasicColor.hlsl",      "VSMain", ShaderStage::Vertex, SoftVSColor,        nullptr,     3 },
+        { L"BasicColor.hlsl",      "PSMain", ShaderStage::Pixel,  nullptr,            SoftPSColor, 3 },
+        { L"BasicSkyCubeMap.hlsl", "VSMain", ShaderStage::Vertex, SoftVSSky,          nullptr,     3 },
+        { L"BasicSkyCubeMap.hlsl", "PSMain", ShaderStage::Pixel,  nullptr,            SoftPSSky,   3 },
+    };
+    for (const Entry& e : table)
+    {
+        if (wcscmp(e.file, name) != 0 || strcmp(e.entry, entry) != 0 || e.stage != stage) continue;
+        out.stage = e.stage;
+        out.vs = e.vs;
+        out.ps = e.ps;
+        out.varyings = e.varyings;
+        return true;
+    }
+    return false;
+}
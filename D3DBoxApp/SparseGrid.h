@@ -0,0 +1,326 @@
+﻿#pragma once
+
+// 희소 청크 그리드 (CPU 전용, Windows/D3D 의존성 없음)
+// - 월드를 32x32x32 셀 청크로 나누고, 점유된 청크만 오픈 어드레싱 해시맵에 보관한다.
+// - 셀 삽입/삭제/조회는 O(1), 메모리는 점유 청크 수에 비례한다.
+
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+constexpr int CHUNK_BITS = 5;
+constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;   // 32
+constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+// 그리드 셀 좌표 (셀 단위 정수)
+struct CellCoord
+{
+    int x = 0;
+    int y = 0;
+    int z = 0;
+};
+
+inline bool operator==(const CellCoord& a, const CellCoord& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// 셀 좌표 한계: 각 축 [-CELL_COORD_LIMIT, CELL_COORD_LIMIT) 밖의 셀은 저장하지 않는다 (Set은 false, Get은 0).
+// - 청크 좌표가 ±2^17이라 경계 이웃(±1)까지 PackCoordKey의 21비트(±2^20) 안에 들어가 키가 겹치지 않는다.
+// - 셀 중심 월드 좌표 (정수 + 0.5) * cellSize가 float로 정확하다.
+constexpr int CELL_COORD_LIMIT = 1 << 22;   // 4,194,304
+
+inline bool CellInRange(const CellCoord& c)
+{
+    return c.x >= -CELL_COORD_LIMIT && c.x < CELL_COORD_LIMIT &&
+           c.y >= -CELL_COORD_LIMIT && c.y < CELL_COORD_LIMIT &&
+           c.z >= -CELL_COORD_LIMIT && c.z < CELL_COORD_LIMIT;
+}
+
+// 각 축 21비트씩 부호 포함 패킹 (±1,048,575). 범위 밖 좌표는 마스크되어 다른 좌표와 겹치므로
+// 청크 키는 CELL_COORD_LIMIT 안의 셀에서 나온 좌표로만 만든다.
+inline uint64_t PackCoordKey(int x, int y, int z)
+{
+    const uint64_t mask = (1ull << 21) - 1;
+    return ((uint64_t(uint32_t(x)) & mask) << 42) |
+           ((uint64_t(uint32_t(y)) & mask) << 21) |
+           ((uint64_t(uint32_t(z)) & mask));
+}
+
+struct ChunkCoord
+{
+    int x = 0;
+    int y = 0;
+    int z = 0;
+};
+
+inline bool operator==(const ChunkCoord& a, const ChunkCoord& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// 셀 → 청크 (산술 시프트 = 음수에서도 floor)
+inline ChunkCoord ChunkOf(const CellCoord& c)
+{
+    return { c.x >> CHUNK_BITS, c.y >> CHUNK_BITS, c.z >> CHUNK_BITS };
+}
+
+inline uint64_t ChunkKey(const ChunkCoord& c)
+{
+    return PackCoordKey(c.x, c.y, c.z);
+}
+
+struct Chunk
+{
+    ChunkCoord             coord;
+    uint8_t                cells[CHUNK_VOLUME] = {};  // 0 = 빈 셀, 그 외 = material
+    uint32_t               count = 0;
+    std::vector<uint16_t>  occupied;                  // 점유 셀의 로컬 인덱스 (필요할 때 재구성)
+    bool                   occupiedDirty = false;
+
+    // x가 가장 빠르게, 그 다음 z, y 순서
+    static int LocalIndex(int lx, int ly, int lz) { return (ly * CHUNK_SIZE + lz) * CHUNK_SIZE + lx; }
+    static int LocalX(int idx) { return idx & CHUNK_MASK; }
+    static int LocalZ(int idx) { return (idx >> CHUNK_BITS) & CHUNK_MASK; }
+    static int LocalY(int idx) { return idx >> (CHUNK_BITS * 2); }
+
+    CellCoord CellAt(int idx) const
+    {
+        return { (coord.x << CHUNK_BITS) + LocalX(idx),
+                 (coord.y << CHUNK_BITS) + LocalY(idx),
+                 (coord.z << CHUNK_BITS) + LocalZ(idx) };
+    }
+
+    const std::vector<uint16_t>& Occupied()
+    {
+        if (occupiedDirty)
+        {
+            occupied.clear();
+            occupied.reserve(count);
+            for (int i = 0; i < CHUNK_VOLUME; ++i)
+                if (cells[i]) occupied.push_back(uint16_t(i));
+            occupiedDirty = false;
+        }
+        return occupied;
+    }
+};
+
+// 청크 키 → m_Chunks 인덱스 (선형 탐사, 백워드 시프트 삭제)
+struct ChunkHashMap
+{
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    struct Slot
+    {
+        uint64_t key = 0;
+        uint32_t value = EMPTY;
+    };
+
+    std::vector<Slot> m_Slots;
+    size_t            m_Count = 0;
+
+    static uint64_t Hash(uint64_t k)
+    {
+        k ^= k >> 33; k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ull;
+        k ^= k >> 33;
+        return k;
+    }
+
+    size_t Mask() const { return m_Slots.size() - 1; }
+
+    uint32_t Find(uint64_t key) const
+    {
+        if (m_Slots.empty()) return EMPTY;
+        for (size_t i = Hash(key) & Mask();; i = (i + 1) & Mask())
+        {
+            const Slot& s = m_Slots[i];
+            if (s.value == EMPTY) return EMPTY;
+            if (s.key == key) return s.value;
+        }
+    }
+
+    // 이미 있으면 값을 덮어쓴다.
+    void Insert(uint64_t key, uint32_t value)
+    {
+        if ((m_Count + 1) * 2 > m_Slots.size()) Rehash(m_Slots.empty() ? 64 : m_Slots.size() * 2);
+
+        for (size_t i = Hash(key) & Mask();; i = (i + 1) & Mask())
+        {
+            Slot& s = m_Slots[i];
+            if (s.value == EMPTY) { s.key = key; s.value = value; ++m_Count; return; }
+            if (s.key == key) { s.value = value; return; }
+        }
+    }
+
+    void Erase(uint64_t key)
+    {
+        if (m_Slots.empty()) return;
+
+        size_t i = Hash(key) & Mask();
+        for (;; i = (i + 1) & Mask())
+        {
+            if (m_Slots[i].value == EMPTY) return;
+            if (m_Slots[i].key == key) break;
+        }
+
+        // 뒤따르는 클러스터를 앞으로 당겨 톰스톤 없이 삭제
+        size_t hole = i;
+        for (size_t j = (i + 1) & Mask();; j = (j + 1) & Mask())
+        {
+            Slot& s = m_Slots[j];
+            if (s.value == EMPTY) break;
+            size_t home = Hash(s.key) & Mask();
+            // home이 (hole, j] 구간 밖이면 hole로 옮길 수 있다
+            bool inRange = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!inRange)
+            {
+                m_Slots[hole] = s;
+                hole = j;
+            }
+        }
+        m_Slots[hole] = Slot{};
+        --m_Count;
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<Slot> old;
+        old.swap(m_Slots);
+        m_Slots.assign(capacity, Slot{});
+        m_Count = 0;
+        for (const Slot& s : old)
+            if (s.value != EMPTY) Insert(s.key, s.value);
+    }
+
+    void Clear()
+    {
+        m_Slots.clear();
+        m_Count = 0;
+    }
+};
+
+struct SparseGrid
+{
+    std::vector<std::unique_ptr<Chunk>> m_Chunks;    // 점유 청크 조밀 배열
+    ChunkHashMap                        m_Map;
+    size_t                              m_CellCount = 0;
+
+    Chunk* FindChunk(const ChunkCoord& cc) const
+    {
+        uint32_t idx = m_Map.Find(ChunkKey(cc));
+        return (idx == ChunkHashMap::EMPTY) ? nullptr : m_Chunks[idx].get();
+    }
+
+    uint8_t Get(const CellCoord& c) const
+    {
+        if (!CellInRange(c)) return 0;
+        const Chunk* ch = FindChunk(ChunkOf(c));
+        if (!ch) return 0;
+        return ch->cells[Chunk::LocalIndex(c.x & CHUNK_MASK, c.y & CHUNK_MASK, c.z & CHUNK_MASK)];
+    }
+
+    // material == 0 이면 셀을 비운다. 값이 바뀌었으면 true (범위 밖 셀은 항상 false)
+    bool Set(const CellCoord& c, uint8_t material)
+    {
+        if (!CellInRange(c)) return false;
+        ChunkCoord cc = ChunkOf(c);
+        Chunk* ch = FindChunk(cc);
+        if (!ch)
+        {
+            if (material == 0) return false;
+            auto chunk = std::make_unique<Chunk>();
+            chunk->coord = cc;
+            ch = chunk.get();
+            m_Map.Insert(ChunkKey(cc), uint32_t(m_Chunks.size()));
+            m_Chunks.push_back(std::move(chunk));
+        }
+
+        uint8_t& cell = ch->cells[Chunk::LocalIndex(c.x & CHUNK_MASK, c.y & CHUNK_MASK, c.z & CHUNK_MASK)];
+        if (cell == material) return false;
+
+        if (cell == 0) { ++ch->count; ++m_CellCount; }
+        else if (material == 0) { --ch->count; --m_CellCount; }
+        cell = material;
+        ch->occupiedDirty = true;
+
+        if (ch->count == 0) RemoveChunk(cc);
+        return true;
+    }
+
+    void RemoveChunk(const ChunkCoord& cc)
+    {
+        uint64_t key = ChunkKey(cc);
+        uint32_t idx = m_Map.Find(key);
+        if (idx == ChunkHashMap::EMPTY) return;
+
+        uint32_t last = uint32_t(m_Chunks.size() - 1);
+        m_Map.Erase(key);
+        if (idx != last)
+        {
+            m_Chunks[idx] = std::move(m_Chunks[last]);
+            m_Map.Insert(ChunkKey(m_Chunks[idx]->coord), idx);
+        }
+        m_Chunks.pop_back();
+    }
+
+    void Clear()
+    {
+        m_Chunks.clear();
+        m_Map.Clear();
+        m_CellCount = 0;
+    }
+
+    size_t ChunkCount() const { return m_Chunks.size(); }
+    size_t MemoryBytes() const
+    {
+        return m_Chunks.size() * sizeof(Chunk) + m_Map.m_Slots.size() * sizeof(ChunkHashMap::Slot);
+    }
+};
+
+// 셀 단위 DDA 레이캐스트 (Amanatides & Woo)
+// - 점유 셀에 맞으면 true, outHit = 맞은 셀, outPrev = 직전 빈 셀(배치 위치), outT = 월드 거리
+struct GridRayHit
+{
+    CellCoord hit;
+    CellCoord prev;
+    float     t = 0.0f;
+};
+
+inline bool RaycastCells(const SparseGrid& grid, const float origin[3], const float dir[3],
+    float cellSize, float maxDist, GridRayHit& out)
+{
+    int   cell[3], step[3];
+    float tMax[3], tDelta[3];
+    for (int a = 0; a < 3; ++a)
+    {
+        float o = origin[a] / cellSize;
+        cell[a] = int(floorf(o));
+        if (dir[a] > 0.0f)      { step[a] = 1;  tDelta[a] = cellSize / dir[a];  tMax[a] = (cell[a] + 1 - o) * tDelta[a]; }
+        else if (dir[a] < 0.0f) { step[a] = -1; tDelta[a] = -cellSize / dir[a]; tMax[a] = (o - cell[a]) * tDelta[a]; }
+        else                    { step[a] = 0;  tDelta[a] = INFINITY;           tMax[a] = INFINITY; }
+    }
+
+    CellCoord prev{ cell[0], cell[1], cell[2] };
+    float t = 0.0f;
+    while (t <= maxDist)
+    {
+        CellCoord c{ cell[0], cell[1], cell[2] };
+        if (grid.Get(c))
+        {
+            out.hit = c;
+            out.prev = prev;
+            out.t = t;
+            return true;
+        }
+        prev = c;
+
+        int a = (tMax[0] < tMax[1]) ? ((tMax[0] < tMax[2]) ? 0 : 2) : ((tMax[1] < tMax[2]) ? 1 : 2);
+        t = tMax[a];
+        tMax[a] += tDelta[a];
+        cell[a] += step[a];
+    }
+    return false;
+}
@@ -0,0 +1,239 @@
+﻿#pragma once
+
+// 중복 상태 변경 필터 (Windows/D3D 의존성 없음)
+// - IRenderContext를 감싸서 슬롯별로 마지막에 바인딩한 상태를 기억하고, 같은 값을 다시 설정하는 호출은 버린다.
+// - 처음에는 모든 상태를 "모름"으로 두므로 첫 호출은 항상 전달된다. 안쪽 컨텍스트를 직접 건드렸다면 Invalidate().
+// - UpdateBuffer(WRITE_DISCARD)는 바인딩을 바꾸지 않으므로 같은 버퍼를 다시 바인딩할 필요가 없다.
+// - 바인딩은 핸들 id로 비교한다. 버퍼를 해제하고 다시 만들면 칸이 재사용돼도 세대가 달라 새 id이므로 (HandleTable) 다시 전달된다.
+// - 드로우/UpdateBuffer/Map/Clear는 그대로 전달한다. 명령 목록을 실행하면 바인딩을 알 수 없으므로 캐시를 비운다.
+
+#include <cstdint>
+#include <cstring>
+
+#include "RenderDevice.h"
+
+struct StateFilterStats
+{
+    uint64_t issued = 0;   // 안쪽 컨텍스트로 전달한 Set* 호출
+    uint64_t elided = 0;   // 중복이라 버린 Set* 호출
+
+    double ElidedRatio() const { return issued + elided ? double(elided) / double(issued + elided) : 0.0; }
+};
+
+struct StateFilterContext final : IRenderContext
+{
+    static constexpr uint32_t MAX_VB_SLOTS = 4;
+    static constexpr uint32_t MAX_SLOTS = 8;   // CB / 텍스처 / 샘플러
+
+    template <typename T>
+    struct Cached
+    {
+        T    value{};
+        bool valid = false;
+
+        // 같은 값이 이미 바인딩돼 있으면 false, 아니면 기록하고 true
+        bool Set(const T& v)
+        {
+            if (valid && value == v) return false;
+            value = v;
+            valid = true;
+            return true;
+        }
+    };
+
+    struct VertexBinding
+    {
+        BufferHandle buffer;
+        uint32_t     stride = 0, offset = 0;
+        bool operator==(const VertexBinding& o) const { return buffer == o.buffer && stride == o.stride && offset == o.offset; }
+    };
+
+    struct IndexBinding
+    {
+        BufferHandle buffer;
+        IndexFormat  format = IndexFormat::UInt16;
+        uint32_t     offset = 0;
+        bool operator==(const IndexBinding& o) const { return buffer == o.buffer && format == o.format && offset == o.offset; }
+    };
+
+    // offset/bytes = 0 이면 버퍼 전체 (SetVSConstantBuffer)
+    struct ConstantBinding
+    {
+        BufferHandle buffer;
+        uint32_t     offset = 0, bytes = 0;
+        bool operator==(const ConstantBinding& o) const { return buffer == o.buffer && offset == o.offset && bytes == o.bytes; }
+    };
+
+    struct Viewport
+    {
+        RenderViewport vp;
+        bool operator==(const Viewport& o) const { return memcmp(&vp, &o.vp, sizeof(vp)) == 0; }
+    };
+
+    // 슬롯별 마지막 바인딩
+    struct BoundState
+    {
+        Cached<Viewport>          viewport;
+        Cached<InputLayoutHandle> layout;
+        Cached<PrimitiveTopology> topology;
+        Cached<VertexBinding>     vb[MAX_VB_SLOTS];
+        Cached<IndexBinding>      ib;
+        Cached<ShaderHandle>      vs, ps;
+        Cached<ConstantBinding>   vsCB[MAX_SLOTS];
+        Cached<BufferHandle>      psCB[MAX_SLOTS];
+        Cached<TextureHandle>     psTex[MAX_SLOTS];
+        Cached<SamplerHandle>     psSampler[MAX_SLOTS];
+        Cached<DepthStateHandle>  depthState;
+        Cached<RasterStateHandle> rasterState;
+    };
+
+    IRenderContext&  m_Inner;
+    BoundState       m_Bound;
+    StateFilterStats m_Stats;
+    bool             m_Enabled = true;   // false 이면 모두 전달 (비교용)
+
+    explicit StateFilterContext(IRenderContext& inner) : m_Inner(inner) {}
+
+    // 캐시를 비운다 (다음 Set*은 모두 전달)
+    void Invalidate() { m_Bound = BoundState{}; }
+
+    // 캐시 판정 결과를 세고, 전달해야 하면 true
+    template <typename T>
+    bool Filter(Cached<T>& slot, const T& value)
+    {
+        bool changed = slot.Set(value);
+        if (changed || !m_Enabled) { ++m_Stats.issued; return true; }
+        ++m_Stats.elided;
+        return false;
+    }
+
+    void ClearTargets(const float color[4], float depth) override { m_Inner.ClearTargets(color, depth); }
+
+    void SetViewport(const RenderViewport& vp) override
+    {
+        if (Filter(m_Bound.viewport, Viewport{ vp })) m_Inner.SetViewport(vp);
+    }
+
+    void SetInputLayout(InputLayoutHandle layout) override
+    {
+        if (Filter(m_Bound.layout, layout)) m_Inner.SetInputLayout(layout);
+    }
+
+    void SetPrimitiveTopology(PrimitiveTopology topology) override
+    {
+        if (Filter(m_Bound.topology, topology)) m_Inner.SetPrimitiveTopology(topology);
+    }
+
+    // 바뀐 슬롯을 포함하는 가장 작은 연속 구간만 전달한다.
+    void SetVertexBuffers(uint32_t startSlot, uint32_t count, const BufferHandle* buffers,
+                          const uint32_t* strides, const uint32_t* offsets) override
+    {
+        if (startSlot + count > MAX_VB_SLOTS)
+        {
+            ++m_Stats.issued;
+            m_Inner.SetVertexBuffers(startSlot, count, buffers, strides, offsets);
+            return;
+        }
+
+        int first = -1, last = -1;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            VertexBinding b{ buffers[i], strides[i], offsets ? offsets[i] : 0 };
+            if (m_Bound.vb[startSlot + i].Set(b) || !m_Enabled)
+            {
+                if (first < 0) first = int(i);
+                last = int(i);
+            }
+        }
+        if (first < 0) { ++m_Stats.elided; return; }
+
+        ++m_Stats.issued;
+        m_Inner.SetVertexBuffers(startSlot + first, uint32_t(last - first + 1), buffers + first, strides + first,
+                                 offsets ? offsets + first : nullptr);
+    }
+
+    void SetIndexBuffer(BufferHandle buffer, IndexFormat format, uint32_t offset) override
+    {
+        if (Filter(m_Bound.ib, IndexBinding{ buffer, format, offset })) m_Inner.SetIndexBuffer(buffer, format, offset);
+    }
+
+    void SetVertexShader(ShaderHandle shader) override
+    {
+        if (Filter(m_Bound.vs, shader)) m_Inner.SetVertexShader(shader);
+    }
+
+    void SetPixelShader(ShaderHandle shader) override
+    {
+        if (Filter(m_Bound.ps, shader)) m_Inner.SetPixelShader(shader);
+    }
+
+    void SetVSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        if (slot >= MAX_SLOTS || Filter(m_Bound.vsCB[slot], ConstantBinding{ buffer })) m_Inner.SetVSConstantBuffer(slot, buffer);
+    }
+
+    void SetVSConstantBufferRange(uint32_t slot, BufferHandle buffer, uint32_t offset, uint32_t bytes) override
+    {
+        if (slot >= MAX_SLOTS || Filter(m_Bound.vsCB[slot], ConstantBinding{ buffer, offset, bytes }))
+            m_Inner.SetVSConstantBufferRange(slot, buffer, offset, bytes);
+    }
+
+    void SetPSConstantBuffer(uint32_t slot, BufferHandle buffer) override
+    {
+        if (slot >= MAX_SLOTS || Filter(m_Bound.psCB[slot], buffer)) m_Inner.SetPSConstantBuffer(slot, buffer);
+    }
+
+    void SetPSTexture(uint32_t slot, TextureHandle texture) override
+    {
+        if (slot >= MAX_SLOTS || Filter(m_Bound.psTex[slot], texture)) m_Inner.SetPSTexture(slot, texture);
+    }
+
+    void SetPSSampler(uint32_t slot, SamplerHandle sampler) override
+    {
+        if (slot >= MAX_SLOTS || Filter(m_Bound.psSampler[slot], sampler)) m_Inner.SetPSSampler(slot, sampler);
+    }
+
+    void SetDepthState(DepthStateHandle state) override
+    {
+        if (Filter(m_Bound.depthState, state)) m_Inner.SetDepthState(state);
+    }
+
+    void SetRasterState(RasterStateHandle state) override
+    {
+        if (Filter(m_Bound.rasterState, state)) m_Inner.SetRasterState(state);
+    }
+
+    bool UpdateBuffer(BufferHandle buffer, const void* data, uint32_t bytes) override
+    {
+        return m_Inner.UpdateBuffer(buffer, data, bytes);
+    }
+
+    void* MapBuffer(BufferHandle buffer, MapMode mode) override { return m_Inner.MapBuffer(buffer, mode); }
+    void UnmapBuffer(BufferHandle buffer, uint32_t bytesWritten) override { m_Inner.UnmapBuffer(buffer, bytesWritten); }
+
+    void Draw(uint32_t vertexCount, uint32_t startVertex) override
+    {
+        m_Inner.Draw(vertexCount, startVertex);
+    }
+
+    void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex) override
+    {
+        m_Inner.DrawIndexed(indexCount, startIndex, baseVertex);
+    }
+
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount,
+                              uint32_t startIndex, int32_t baseVertex, uint32_t startInstance) override
+    {
+        m_Inner.DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    }
+
+    void ExecuteCommandList(IRenderCommandList& list) override
+    {
+        m_Inner.ExecuteCommandList(list);
+        Invalidate();
+    }
+
+    // 계수기는 실제로 전달된 호출 기준 (안쪽 컨텍스트의 것)
+    const RenderCounters& Counters() const override { return m_Inner.Counters(); }
+    void ResetCounters() override { m_Inner.ResetCounters(); m_Stats = StateFilterStats{}; }
+};
@@ -0,0 +1,188 @@
+﻿#pragma once
+
+// 오프라인 텍스처 쿠킹 (CPU 전용, Windows/D3D 의존성 없음)
+// - 원본 (PNG/DDS)의 mip 0에서 밉 체인을 새로 만든다. 감마 보정: sRGB → 선형으로 풀어 2x2 평균 후 다시 sRGB로
+//   (알파는 선형 그대로). 다음 레벨은 반올림 전의 선형 값에서 만든다.
+// - 레벨마다 BC1/BC3/BC7로 압축해 DX10 헤더 DDS 하나로 쓴다 (큐브맵은 면 구성을 유지).
+//   ThreadPool을 주면 레벨마다 블록 행을 나눠 병렬로 압축한다.
+// - 런타임은 결과를 CreateDDSTextureFromFile로 그대로 올린다 (디코드/밉 생성 없음).
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "BlockCompress.h"
+#include "ImageIO.h"
+
+struct CookOptions
+{
+    BlockFormat  format = BlockFormat::BC7;
+    BlockQuality quality = BlockQuality::Normal;
+    bool         srgb = false;           // DXGI *_SRGB로 표시 (샘플링이 선형으로 바뀐다). 지금 셰이더는 감마 공간이라 기본은 UNORM
+    bool         mips = true;
+    bool         gammaCorrectMips = true;
+};
+
+struct CookStats
+{
+    uint32_t width = 0, height = 0, mipLevels = 0, faces = 0;
+    size_t   rawBytes = 0;        // 같은 밉 체인을 RGBA8로 올렸을 때
+    size_t   cookedBytes = 0;     // DDS 파일 크기
+    double   mipMs = 0.0;
+    double   encodeMs = 0.0;
+    double   psnr = 0.0;          // mip 0, 복원 결과 대 원본 (RGBA)
+};
+
+// ------------------------------------------------------------
+// sRGB
+// ------------------------------------------------------------
+inline float SrgbToLinear(uint8_t v)
+{
+    static const std::vector<float> table = []
+    {
+        std::vector<float> t(256);
+        for (int i = 0; i < 256; ++i)
+        {
+            float c = i / 255.0f;
+            t[i] = (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table[v];
+}
+
+inline uint8_t LinearToSrgb8(float v)
+{
+    v = std::clamp(v, 0.0f, 1.0f);
+    float c = (v <= 0.0031308f) ? v * 12.92f : 1.055f * powf(v, 1.0f / 2.4f) - 0.055f;
+    return uint8_t(c * 255.0f + 0.5f);
+}
+
+// top에서 1x1까지 밉 체인을 만든다 (chain[0] = top). 홀수 크기는 경계 픽셀을 복제해 2x2로 본다
+inline void BuildMipChain(const Image& top, bool gammaCorrect, bool fullChain, std::vector<Image>& chain)
+{
+    chain.clear();
+    chain.push_back(top);
+    if (!fullChain) return;
+
+    // 현재 레벨 (채널당 실수, RGB는 gammaCorrect면 선형)
+    uint32_t w = top.width, h = top.height;
+    std::vector<float> level(size_t(w) * h * 4);
+    for (size_t i = 0; i < size_t(w) * h; ++i)
+        for (int k = 0; k < 4; ++k)
+        {
+            uint8_t v = top.rgba[i * 4 + k];
+            level[i * 4 + k] = (gammaCorrect && k < 3) ? SrgbToLinear(v) : v / 255.0f;
+        }
+
+    while (w > 1 || h > 1)
+    {
+        uint32_t nw = std::max<uint32_t>(w / 2, 1), nh = std::max<uint32_t>(h / 2, 1);
+        std::vector<float> next(size_t(nw) * nh * 4);
+        Image img;
+        img.width = nw; img.height = nh;
+        img.rgba.resize(size_t(nw) * nh * 4);
+        for (uint32_t y = 0; y < nh; ++y)
+            for (uint32_t x = 0; x < nw; ++x)
+            {
+                uint32_t x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+                uint32_t y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+                size_t d = (size_t(y) * nw + x) * 4;
+                for (int k = 0; k < 4; ++k)
+                {
+                    float v = 0.25f * (level[(size_t(y0) * w + x0) * 4 + k] + level[(size_t(y0) * w + x1) * 4 + k]
+                                     + level[(size_t(y1) * w + x0) * 4 + k] + level[(size_t(y1) * w + x1) * 4 + k]);
+                    next[d + k] = v;
+                    img.rgba[d + k] = (gammaCorrect && k < 3) ? LinearToSrgb8(v) : uint8_t(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+            }
+        chain.push_back(std::move(img));
+        level.swap(next);
+        w = nw; h = nh;
+    }
+}
+
+// ------------------------------------------------------------
+// DDS 쓰기
+// ------------------------------------------------------------
+inline uint32_t DxgiFormatFor(BlockFormat format, bool srgb)
+{
+    switch (format)
+    {
+    case BlockFormat::BC1: return srgb ? 72 : 71;   // DXGI_FORMAT_BC1_UNORM(_SRGB)
+    case BlockFormat::BC3: return srgb ? 78 : 77;
+    case BlockFormat::BC7: return srgb ? 99 : 98;
+    }
+    return 0;
+}
+
+// DDS_HEADER + DDS_HEADER_DXT10 (148바이트)를 out 앞에 쓴다
+inline void WriteDdsHeader(std::vector<uint8_t>& out, uint32_t width, uint32_t height, uint32_t mips, uint32_t faces,
+    BlockFormat format, bool srgb)
+{
+    out.assign(148, 0);
+    auto u32 = [&](size_t off, uint32_t v) { memcpy(&out[off], &v, 4); };
+    memcpy(out.data(), "DDS ", 4);
+    u32(4, 124);
+    u32(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);   // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+    u32(12, height);
+    u32(16, width);
+    u32(20, uint32_t(size_t((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format)));
+    u32(28, mips);
+    u32(76, 32);                                              // DDS_PIXELFORMAT
+    u32(80, 0x4);                                             // DDPF_FOURCC
+    memcpy(&out[84], "DX10", 4);
+    u32(108, 0x1000 | (mips > 1 ? 0x400008 : 0) | (faces == 6 ? 0x8 : 0));   // TEXTURE | MIPMAP | COMPLEX
+    u32(112, faces == 6 ? 0xFE00 : 0);                        // CUBEMAP + 모든 면
+    u32(128, DxgiFormatFor(format, srgb));
+    u32(132, 3);                                              // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+    u32(136, faces == 6 ? 0x4 : 0);                           // TEXTURECUBE
+    u32(140, 1);                                              // arraySize (큐브맵은 큐브 수)
+}
+
+// src의 면별 mip 0에서 DDS 파일 내용을 만든다
+inline bool CookTexture(const ImageSet& src, const CookOptions& options, std::vector<uint8_t>& dds, CookStats* stats = nullptr,
+    ThreadPool* pool = nullptr)
+{
+    using Clock = std::chrono::steady_clock;
+    if (src.surfaces.empty() || (src.faces != 1 && src.faces != 6)) return false;
+    const Image& top = src.Surface(0, 0);
+    for (uint32_t f = 1; f < src.faces; ++f)
+        if (src.Surface(f, 0).width != top.width || src.Surface(f, 0).height != top.height) return false;
+
+    CookStats s;
+    s.width = top.width;
+    s.height = top.height;
+    s.faces = src.faces;
+
+    auto t0 = Clock::now();
+    std::vector<std::vector<Image>> chains(src.faces);
+    for (uint32_t f = 0; f < src.faces; ++f)
+        BuildMipChain(src.Surface(f, 0), options.gammaCorrectMips, options.mips, chains[f]);
+    s.mipLevels = uint32_t(chains[0].size());
+
+    BlockCompressOptions compress;
+    compress.format = options.format;
+    compress.quality = options.quality;
+
+    auto t1 = Clock::now();
+    WriteDdsHeader(dds, s.width, s.height, s.mipLevels, s.faces, options.format, options.srgb);
+    for (const std::vector<Image>& chain : chains)   // 면마다 밉 전체 (DDS 배치)
+        for (const Image& level : chain)
+        {
+            CompressImage(level, compress, dds, pool);
+            s.rawBytes += level.rgba.size();
+        }
+    auto t2 = Clock::now();
+
+    s.cookedBytes = dds.size();
+    s.mipMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    s.encodeMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+    ImageSet decoded;
+    if (!DecodeDds(dds.data(), dds.size(), decoded)) return false;
+    s.psnr = ComputePsnr(top, decoded.Surface(0, 0));
+    if (stats) *stats = s;
+    return true;
+}
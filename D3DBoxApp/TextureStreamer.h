@@ -0,0 +1,220 @@
+﻿#pragma once
+
+// 비동기 텍스처 스트리밍 (CPU 전용, Windows/D3D 의존성 없음)
+// - UI 스레드: Request()로 파일을 워커 풀에 넣는다. 준비될 때까지 호출한 쪽은 자리표시 텍스처(1x1)를 바인딩해 둔다.
+// - 워커: 파일 읽기 → 파싱 → 업로드할 서브리소스 준비. BC1/BC3/BC7 DDS는 블록을 그대로 넘기고,
+//   그 밖의 형식은 RGBA8로 풀어 (2D이고 밉이 하나뿐이면) 박스 필터로 밉을 만든다.
+// - 렌더 루프: 프레임 시작에 UploadCompleted()로 끝난 것만 CreateTexture로 올리고 onReady로 핸들을 넘긴다.
+//   실패하면 빈 핸들을 넘긴다.
+// - 결과가 완료 큐에 들어갈 때마다 m_OnResult를 부른다 (ChunkRemesher와 같음).
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ImageIO.h"
+#include "RenderDevice.h"
+#include "ThreadPool.h"
+
+// CreateTexture에 넘길 데이터 (서브리소스는 면마다 밉 전체 순서로 bytes에 이어 붙인다)
+struct TextureUploadData
+{
+    TextureDesc          desc;
+    std::vector<uint8_t> bytes;
+    std::vector<size_t>  offsets;   // [face * mipLevels + mip]
+};
+
+inline bool PrepareTextureUpload(const std::vector<uint8_t>& file, TextureUploadData& out)
+{
+    out.bytes.clear();
+    out.offsets.clear();
+
+    // 블록 압축 DDS: 디바이스가 그대로 받는다
+    DdsHeader h;
+    if (ParseDdsHeader(file.data(), file.size(), h) &&
+        (h.format == DdsFormat::BC1 || h.format == DdsFormat::BC3 || h.format == DdsFormat::BC7))
+    {
+        out.desc.width = h.width;
+        out.desc.height = h.height;
+        out.desc.mipLevels = h.mips;
+        out.desc.format = (h.format == DdsFormat::BC1) ? TextureFormat::BC1
+                        : (h.format == DdsFormat::BC3) ? TextureFormat::BC3 : TextureFormat::BC7;
+        out.desc.cube = (h.faces == 6);
+
+        size_t size = 0;
+        for (uint32_t f = 0; f < h.faces; ++f)
+        {
+            uint32_t w = h.width, hh = h.height;
+            for (uint32_t m = 0; m < h.mips; ++m)
+            {
+                out.offsets.push_back(size);
+                size += h.SurfaceBytes(w, hh);
+                w = std::max<uint32_t>(w / 2, 1);
+                hh = std::max<uint32_t>(hh / 2, 1);
+            }
+        }
+        if (h.offset + size > file.size()) return false;
+        out.bytes.assign(file.begin() + h.offset, file.begin() + h.offset + size);
+        return true;
+    }
+
+    ImageSet set;
+    if (!DecodeImage(file.data(), file.size(), set)) return false;
+    if (set.faces == 1) GenerateMips(set);
+
+    out.desc.width = set.surfaces[0].width;
+    out.desc.height = set.surfaces[0].height;
+    out.desc.mipLevels = set.mipLevels;
+    out.desc.format = TextureFormat::RGBA8;
+    out.desc.cube = (set.faces == 6);
+    for (const Image& img : set.surfaces)
+    {
+        out.offsets.push_back(out.bytes.size());
+        out.bytes.insert(out.bytes.end(), img.rgba.begin(), img.rgba.end());
+    }
+    return true;
+}
+
+// 1x1 단색 텍스처 (cube면 6면 모두 같은 색)
+inline TextureHandle CreatePlaceholderTexture(IRenderDevice& device, bool cube, const uint8_t rgba[4])
+{
+    TextureDesc desc;
+    desc.width = desc.height = 1;
+    desc.cube = cube;
+    const void* faces[6] = { rgba, rgba, rgba, rgba, rgba, rgba };
+    return device.CreateTexture(desc, faces);
+}
+
+// 텍스처 하나의 로드 시간 (요청 → 업로드)
+struct TextureLoadStats
+{
+    std::wstring path;
+    bool         ok = false;
+    TextureDesc  desc;
+    size_t       fileBytes = 0;
+    size_t       uploadBytes = 0;
+    double       queueMs = 0.0;    // 요청 → 워커 시작
+    double       readMs = 0.0;     // 워커: 파일 읽기
+    double       parseMs = 0.0;    // 워커: 파싱/디코드/밉 생성
+    double       uploadMs = 0.0;   // UI 스레드: CreateTexture
+    double       readyMs = 0.0;    // 요청 → 업로드 끝
+    uint32_t     frames = 0;       // 기다린 프레임 경계 수
+};
+
+struct TextureStreamer
+{
+    using Clock = std::chrono::steady_clock;
+    using ReadyFn = std::function<void(TextureHandle, const TextureLoadStats&)>;
+
+    struct PendingRequest
+    {
+        ReadyFn           onReady;
+        Clock::time_point submitTime;
+        uint64_t          frame = 0;
+    };
+
+    struct Result
+    {
+        uint32_t          id = 0;
+        TextureUploadData data;
+        TextureLoadStats  stats;
+    };
+
+    ThreadPool&                                  m_Pool;
+    std::unordered_map<uint32_t, PendingRequest> m_Requests;   // 아직 올리지 않은 요청 (UI 스레드 전용)
+    uint32_t                                     m_NextId = 1;
+    uint64_t                                     m_Frame = 0;  // UploadCompleted 호출 수
+
+    std::mutex                                   m_DoneMutex;
+    std::vector<Result>                          m_Done;
+    std::atomic<uint32_t>                        m_InFlight{ 0 };
+    std::function<void()>                        m_OnResult;   // 워커 스레드에서 불린다. 요청하기 전에 설정
+
+    explicit TextureStreamer(ThreadPool& pool) : m_Pool(pool) {}
+
+    ~TextureStreamer()
+    {
+        while (m_InFlight.load() != 0) std::this_thread::yield();
+    }
+
+    void Request(const wchar_t* path, ReadyFn onReady)
+    {
+        uint32_t id = m_NextId++;
+        Clock::time_point submit = Clock::now();
+        m_Requests[id] = { std::move(onReady), submit, m_Frame };
+
+        ++m_InFlight;
+        m_Pool.Submit([this, id, submit, file = std::wstring(path)]
+        {
+            Result r;
+            r.id = id;
+            r.stats.path = file;
+
+            auto t0 = Clock::now();
+            std::vector<uint8_t> bytes;
+            bool read = ReadWholeFile(file.c_str(), bytes);
+            auto t1 = Clock::now();
+            r.stats.ok = read && PrepareTextureUpload(bytes, r.data);
+            auto t2 = Clock::now();
+
+            r.stats.desc = r.data.desc;
+            r.stats.fileBytes = bytes.size();
+            r.stats.uploadBytes = r.data.bytes.size();
+            r.stats.queueMs = std::chrono::duration<double, std::milli>(t0 - submit).count();
+            r.stats.readMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            r.stats.parseMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+            {
+                std::lock_guard<std::mutex> lock(m_DoneMutex);
+                m_Done.push_back(std::move(r));
+            }
+            if (m_OnResult) m_OnResult();
+            --m_InFlight;
+        });
+    }
+
+    // 프레임 경계에서 호출: 준비된 텍스처를 올리고 onReady를 부른다. 올린 (또는 실패를 알린) 수를 돌려준다.
+    size_t UploadCompleted(IRenderDevice& device)
+    {
+        ++m_Frame;
+        std::vector<Result> done;
+        {
+            std::lock_guard<std::mutex> lock(m_DoneMutex);
+            done.swap(m_Done);
+        }
+
+        for (Result& r : done)
+        {
+            auto it = m_Requests.find(r.id);
+            if (it == m_Requests.end()) continue;
+            PendingRequest req = std::move(it->second);
+            m_Requests.erase(it);
+
+            auto t0 = Clock::now();
+            TextureHandle handle;
+            if (r.stats.ok)
+            {
+                std::vector<const void*> subresources;
+                for (size_t offset : r.data.offsets) subresources.push_back(r.data.bytes.data() + offset);
+                handle = device.CreateTexture(r.data.desc, subresources.data());
+                r.stats.ok = bool(handle);
+            }
+            auto t1 = Clock::now();
+
+            r.stats.uploadMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            r.stats.readyMs = std::chrono::duration<double, std::milli>(t1 - req.submitTime).count();
+            r.stats.frames = uint32_t(m_Frame - req.frame);
+            req.onReady(handle, r.stats);
+        }
+        return done.size();
+    }
+
+    bool Idle() const { return m_Requests.empty(); }
+    size_t Pending() const { return m_Requests.size(); }
+};
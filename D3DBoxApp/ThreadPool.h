@@ -0,0 +1,121 @@
+﻿#pragma once
+
+// 간단한 워커 스레드 풀 (CPU 전용, Windows/D3D 의존성 없음)
+// - Submit(): 작업 하나를 큐에 넣는다.
+// - ParallelFor(): [0, count) 구간을 나눠 워커와 호출 스레드가 함께 처리하고, 끝날 때까지 기다린다.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadPool
+{
+    std::vector<std::thread>          m_Workers;
+    std::deque<std::function<void()>> m_Jobs;
+    std::mutex                        m_Mutex;
+    std::condition_variable           m_CV;
+    bool                              m_Stop = false;
+
+    // threadCount == 0 이면 (하드웨어 스레드 - 1), 최소 1개
+    explicit ThreadPool(unsigned threadCount = 0)
+    {
+        if (threadCount == 0)
+        {
+            unsigned hw = std::thread::hardware_concurrency();
+            threadCount = (hw > 1) ? hw - 1 : 1;
+        }
+        for (unsigned i = 0; i < threadCount; ++i)
+            m_Workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        for (auto& t : m_Workers) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t ThreadCount() const { return m_Workers.size(); }
+
+    void Submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Jobs.push_back(std::move(job));
+        }
+        m_CV.notify_one();
+    }
+
+    // fn(begin, end)를 grain 크기 구간으로 나눠 호출한다.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+    {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        size_t blocks = (count + grain - 1) / grain;
+        if (blocks == 1 || m_Workers.empty())
+        {
+            fn(0, count);
+            return;
+        }
+
+        struct Shared
+        {
+            std::atomic<size_t>     next{ 0 };
+            std::atomic<size_t>     done{ 0 };
+            std::mutex              mutex;
+            std::condition_variable cv;
+        };
+        auto shared = std::make_shared<Shared>();
+
+        auto run = [shared, count, grain, blocks, &fn]
+        {
+            for (;;)
+            {
+                size_t b = shared->next.fetch_add(1);
+                if (b >= blocks) return;
+                size_t begin = b * grain;
+                fn(begin, std::min(begin + grain, count));
+                if (shared->done.fetch_add(1) + 1 == blocks)
+                {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->cv.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = std::min(m_Workers.size(), blocks - 1);
+        for (size_t i = 0; i < helpers; ++i) Submit(run);
+        run();
+
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->cv.wait(lock, [&] { return shared->done.load() == blocks; });
+    }
+
+    void WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_CV.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+                if (m_Stop && m_Jobs.empty()) return;
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+            job();
+        }
+    }
+};
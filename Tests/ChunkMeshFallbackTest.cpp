@@ -0,0 +1,97 @@
+﻿// 청크 메쉬 모드: 첫 메쉬가 아직 올라오지 않은 청크는 인스턴싱으로 그리고, 메쉬가 올라오면 그 청크는 인스턴싱에서 빠지는지
+// Null 백엔드에서 BoxScene 프레임을 돌리고 렌더 큐에 들어간 박스 드로우를 센다.
+
+#include <chrono>
+#include <thread>
+
+#include "SceneScript.h"
+#include "TestCheck.h"
+
+struct BoxDraws
+{
+    uint32_t instances = 0;   // 인스턴싱 드로우의 인스턴스 수 합
+    uint32_t meshDraws = 0;   // 청크 메쉬 드로우 수
+};
+
+static BoxDraws CountBoxDraws(const BoxScene& scene)
+{
+    BoxDraws d;
+    for (const DrawItem& it : scene.m_Queue.m_Items)
+    {
+        if (it.vs == scene.m_VSTex) d.instances += it.instanceCount;
+        if (it.vs == scene.m_VSTexMesh) ++d.meshDraws;
+    }
+    return d;
+}
+
+static void Frame(BoxScene& scene)
+{
+    scene.BeginFrame();
+    scene.UpdateAndDraw();
+}
+
+// 리메싱이 모두 끝나 교체될 때까지 프레임 경계를 돌린 뒤 한 프레임 그린다
+static void FrameAfterRemesh(BoxScene& scene)
+{
+    scene.BeginFrame();
+    while (!scene.m_Remesher.Idle())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        scene.BeginFrame();
+    }
+    scene.UpdateAndDraw();
+}
+
+int main()
+{
+    SteadyFrameClock clock;
+    BoxScene scene(clock);
+    scene.m_LogSink = [](const char*) {};
+    CHECK(scene.InitScene(std::make_unique<NullRenderDevice>()));
+    scene.m_Camera.SetOrbit(0.0f, ToRadians(30.0f), 40.0f);
+
+    // 두 청크 (0,0,0), (-1,0,0)에 걸친 4x4 바닥
+    for (int x = -2; x < 2; ++x)
+        for (int z = 0; z < 4; ++z)
+            scene.m_PlacedBoxes.Place({ x, 0, z });
+
+    Frame(scene);
+    const BoxDraws instanced = CountBoxDraws(scene);
+    CHECK_EQ(instanced.instances, 16u);
+    CHECK_EQ(instanced.meshDraws, 0u);
+
+    // 청크 메쉬 모드로 바꾼 첫 프레임: 메싱을 막 요청했으므로 메쉬가 없다 → 박스는 전부 인스턴싱
+    scene.m_RenderMode = BoxScene::BoxRenderMode::ChunkMesh;
+    Frame(scene);
+    BoxDraws d = CountBoxDraws(scene);
+    CHECK_EQ(d.meshDraws, 0u);
+    CHECK_EQ(d.instances, 16u);
+
+    // 메쉬가 올라오면 인스턴싱 드로우는 없다
+    FrameAfterRemesh(scene);
+    d = CountBoxDraws(scene);
+    CHECK(d.meshDraws >= 2);
+    CHECK_EQ(d.instances, 0u);
+    const uint32_t meshDraws = d.meshDraws;
+
+    // 새 청크 (0,0,-1)에 놓은 박스는 그 청크의 메쉬가 올라올 때까지 인스턴싱, 기존 청크는 메쉬 그대로
+    CHECK(scene.m_PlacedBoxes.Place({ 0, 0, -1 }));
+    Frame(scene);
+    d = CountBoxDraws(scene);
+    CHECK_EQ(d.instances, 1u);
+    CHECK_EQ(d.meshDraws, meshDraws);
+
+    FrameAfterRemesh(scene);
+    d = CountBoxDraws(scene);
+    CHECK_EQ(d.instances, 0u);
+    CHECK(d.meshDraws > meshDraws);
+
+    // 인스턴스 모드로 돌아가면 다시 전부 인스턴싱
+    scene.m_RenderMode = BoxScene::BoxRenderMode::Instanced;
+    Frame(scene);
+    d = CountBoxDraws(scene);
+    CHECK_EQ(d.instances, 17u);
+    CHECK_EQ(d.meshDraws, 0u);
+
+    return TestResult("ChunkMeshFallbackTest");
+}
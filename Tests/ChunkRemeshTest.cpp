@@ -0,0 +1,134 @@
+﻿// 배치 → dirty 청크 → 리메싱 요청 수: 무작위 박스 10k개를 한 프레임에 배치하고,
+// 리메싱이 (바뀐 셀의 청크 + 경계 너머 점유된 이웃 셀의 청크) 각각 정확히 한 번씩 요청되는지 확인한다.
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "ChunkRemesher.h"
+#include "PlacedBoxStore.h"
+#include "TestCheck.h"
+
+// 바뀐 셀 목록과 편집 후 그리드로 다시 센 기대 dirty 청크 키
+static std::unordered_set<uint64_t> ExpectedDirty(const PlacedBoxStore& store, const std::vector<CellCoord>& changed)
+{
+    std::unordered_set<uint64_t> keys;
+    for (const CellCoord& c : changed)
+    {
+        const ChunkCoord cc = ChunkOf(c);
+        keys.insert(ChunkKey(cc));
+
+        const int d[6][3] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} };
+        for (const auto& o : d)
+        {
+            CellCoord n{ c.x + o[0], c.y + o[1], c.z + o[2] };
+            const ChunkCoord nc = ChunkOf(n);
+            if (nc == cc || !store.Contains(n)) continue;
+            keys.insert(ChunkKey(nc));
+        }
+    }
+    return keys;
+}
+
+// App::ScheduleChunkRemesh와 같은 순서: dirty 청크를 꺼내 청크마다 한 번 요청하고, 결과가 다 올 때까지 교체한다
+static uint64_t RemeshDirty(PlacedBoxStore& store, ChunkRemesher& remesher, std::vector<ChunkCoord>& dirty, size_t& applied)
+{
+    const uint64_t before = remesher.m_Stats.submitted;
+    store.m_Dirty.Take(dirty);
+    for (const ChunkCoord& cc : dirty) remesher.Request(store.m_Grid, cc);
+
+    applied = 0;
+    while (!remesher.Idle())
+    {
+        while (remesher.m_InFlight.load() != 0) std::this_thread::yield();
+        applied += remesher.SwapCompleted([](const ChunkMeshData&) {});
+    }
+    return remesher.m_Stats.submitted - before;
+}
+
+static void TestRandomPlacement()
+{
+    ThreadPool pool(2);
+    ChunkRemesher remesher(pool, 1.0f);
+    PlacedBoxStore store;
+    std::vector<ChunkCoord> dirty;
+    size_t applied = 0;
+
+    // 128x128 바닥 (청크 4x4) 을 먼저 메싱해 둔다
+    for (int x = -64; x < 64; ++x)
+        for (int z = -64; z < 64; ++z)
+            store.Place({ x, 0, z });
+    CHECK_EQ(RemeshDirty(store, remesher, dirty, applied), 16ull);
+    CHECK_EQ(applied, size_t(16));
+
+    // 한 프레임 동안 무작위 배치 10k번 (이미 있는 셀은 실패하고 dirty를 만들지 않는다)
+    std::mt19937 rng(12345);
+    std::vector<CellCoord> placed;
+    const uint64_t marksBefore = store.m_Dirty.m_Marks;
+    for (int i = 0; i < 10000; ++i)
+    {
+        CellCoord c{ int(rng() % 256) - 128, int(rng() % 48), int(rng() % 256) - 128 };
+        if (store.Place(c, uint8_t(1 + (rng() & 1)))) placed.push_back(c);
+    }
+
+    std::unordered_set<uint64_t> expected = ExpectedDirty(store, placed);
+    CHECK(store.m_Dirty.m_Marks - marksBefore > expected.size());   // 같은 청크는 모여서 한 번
+    CHECK_EQ(store.m_Dirty.Count(), expected.size());
+
+    const uint64_t requested = RemeshDirty(store, remesher, dirty, applied);
+    CHECK_EQ(requested, uint64_t(expected.size()));
+    CHECK_EQ(applied, expected.size());
+    for (const ChunkCoord& cc : dirty) CHECK(expected.count(ChunkKey(cc)) == 1);
+
+    // 고정 시드라 개수도 고정: 8x2x8 청크 영역 전체 + 바닥의 경계 이웃은 그 안에 있으므로 128
+    CHECK_EQ(placed.size(), size_t(9930));
+    CHECK_EQ(requested, 128ull);
+
+    // 다음 프레임: 청크 경계 셀 몇 개만 지운다 → 지운 셀의 청크 + 경계 너머 점유 이웃의 청크만
+    std::vector<CellCoord> removed;
+    for (const CellCoord& c : placed)
+    {
+        if ((c.x & CHUNK_MASK) == 0 && c.y > 0 && store.Remove(c)) removed.push_back(c);
+        if (removed.size() == 20) break;
+    }
+    CHECK_EQ(removed.size(), size_t(20));
+    expected = ExpectedDirty(store, removed);
+    CHECK(expected.size() > 20 / 8);
+    CHECK_EQ(RemeshDirty(store, remesher, dirty, applied), uint64_t(expected.size()));
+    CHECK_EQ(applied, expected.size());
+
+    // 편집이 없으면 요청도 없다
+    CHECK_EQ(RemeshDirty(store, remesher, dirty, applied), 0ull);
+}
+
+// 청크 경계를 사이에 둔 두 셀: 한쪽을 놓으면 (이웃이 점유돼 있으므로) 양쪽 청크가 모두 dirty,
+// 이웃이 비어 있으면 자기 청크만
+static void TestBorderNeighbour()
+{
+    PlacedBoxStore store;
+    std::vector<ChunkCoord> dirty;
+    store.Place({ CHUNK_SIZE - 1, 0, 0 });
+    store.m_Dirty.Take(dirty);
+    CHECK_EQ(dirty.size(), size_t(1));
+
+    store.Place({ CHUNK_SIZE, 0, 0 });
+    store.m_Dirty.Take(dirty);
+    CHECK_EQ(dirty.size(), size_t(2));
+
+    store.Place({ CHUNK_SIZE, 0, 1 });   // -X 이웃 (31, 0, 1)은 비어 있음, 같은 청크 안 이웃은 상관없음
+    store.m_Dirty.Take(dirty);
+    CHECK_EQ(dirty.size(), size_t(1));
+
+    store.Remove({ CHUNK_SIZE - 1, 0, 0 });
+    store.m_Dirty.Take(dirty);
+    CHECK_EQ(dirty.size(), size_t(2));
+}
+
+int main()
+{
+    TestRandomPlacement();
+    TestBorderNeighbour();
+    return TestResult("ChunkRemeshTest");
+}
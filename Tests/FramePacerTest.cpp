@@ -0,0 +1,234 @@
+﻿// FramePacer: 네 가지 모드를 시뮬레이션 시계로 돌려 프레임 시작 시각과 sleep 요청을 확인한다.
+// VSync/LowLatency는 60 Hz 수직 동기를 흉내 내는 스왑체인 (최대 지연 1프레임)으로 기다린다.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "FramePacer.h"
+#include "NullRenderDevice.h"
+#include "TestCheck.h"
+
+constexpr int64_t VBLANK_US = 16667;   // 60 Hz (FramePacer 기본 목표 간격과 같음)
+
+// sleep 요청을 기록하는 시뮬레이션 시계 (SimulatedFrameClock에 위임)
+struct RecordingClock final : IFrameClock
+{
+    SimulatedFrameClock  m_Sim;
+    std::vector<int64_t> m_Sleeps;   // 요청한 길이
+
+    int64_t NowMicroseconds() override { return m_Sim.NowMicroseconds(); }
+    void SleepMicroseconds(int64_t us) override { m_Sleeps.push_back(us); m_Sim.SleepMicroseconds(us); }
+    void SpinPause() override { m_Sim.SpinPause(); }
+};
+
+// 스왑체인 흉내: 큐에 한 프레임만 둘 수 있다. Present(1)은 앞 프레임이 아직 화면에 안 나갔으면 그때까지 막히고,
+// 새 프레임은 다음 수직 동기에 나간다. WaitForFrameLatency는 큐가 빌 때 (앞 프레임이 나갈 때)까지 기다린다.
+struct VBlankDevice final : IRenderDevice
+{
+    NullRenderDevice     m_Null;
+    RecordingClock&      m_Clock;
+    int64_t              m_DisplayAt = 0;   // 큐에 있는 프레임이 화면에 나가는 시각 (0 = 비어 있음)
+    std::vector<int64_t> m_Displayed;       // 프레임별 화면에 나간 시각 (Present(0)은 Present 시각)
+    int64_t              m_BlockedUs = 0;   // Present + WaitForFrameLatency에서 기다린 시간
+
+    explicit VBlankDevice(RecordingClock& clock) : m_Clock(clock) {}
+
+    static int64_t NextVBlank(int64_t t) { return (t / VBLANK_US + 1) * VBLANK_US; }
+
+    void WaitUntil(int64_t t)
+    {
+        int64_t now = m_Clock.NowMicroseconds();
+        if (t > now) { m_Clock.m_Sim.Advance(t - now); m_BlockedUs += t - now; }
+    }
+
+    void Present(uint32_t syncInterval) override
+    {
+        if (syncInterval == 0) { m_Displayed.push_back(m_Clock.NowMicroseconds()); return; }
+        WaitUntil(m_DisplayAt);
+        m_DisplayAt = NextVBlank(m_Clock.NowMicroseconds());
+        m_Displayed.push_back(m_DisplayAt);
+    }
+
+    bool WaitForFrameLatency(uint32_t) override { WaitUntil(m_DisplayAt); return true; }
+
+    IRenderContext& Context() override { return m_Null.Context(); }
+    std::unique_ptr<IDeferredContext> CreateDeferredContext() override { return m_Null.CreateDeferredContext(); }
+    BufferHandle CreateBuffer(const BufferDesc& d, const void* data) override { return m_Null.CreateBuffer(d, data); }
+    ShaderHandle CreateShader(const ShaderDesc& d) override { return m_Null.CreateShader(d); }
+    InputLayoutHandle CreateInputLayout(const VertexElement* e, uint32_t n, ShaderHandle vs) override { return m_Null.CreateInputLayout(e, n, vs); }
+    TextureHandle LoadTexture(const wchar_t* path) override { return m_Null.LoadTexture(path); }
+    TextureHandle CreateTexture(const TextureDesc& d, const void* const* mips) override { return m_Null.CreateTexture(d, mips); }
+    SamplerHandle CreateSampler(const SamplerDesc& d) override { return m_Null.CreateSampler(d); }
+    DepthStateHandle CreateDepthState(const DepthStateDesc& d) override { return m_Null.CreateDepthState(d); }
+    RasterStateHandle CreateRasterState(const RasterStateDesc& d) override { return m_Null.CreateRasterState(d); }
+    void DestroyBuffer(BufferHandle b) override { m_Null.DestroyBuffer(b); }
+    void Resize(uint32_t w, uint32_t h) override { m_Null.Resize(w, h); }
+    uint64_t InsertFence() override { return m_Null.InsertFence(); }
+    bool IsFenceComplete(uint64_t f) override { return m_Null.IsFenceComplete(f); }
+    void WaitForFence(uint64_t f) override { m_Null.WaitForFence(f); }
+};
+
+// BuildFramePacerReport와 같은 작업량: 4~12 ms, 100프레임마다 25 ms
+static int64_t VaryingWorkUs(int f) { return (f % 100 == 99) ? 25000 : 4000 + (f * 7 % 9) * 1000; }
+static int64_t SteadyWorkUs(int) { return 6000; }
+
+struct PacedRun
+{
+    std::vector<int64_t> starts;     // BeginFrame 직후 시각
+    std::vector<int64_t> presented;  // Present가 돌아온 시각
+    std::vector<int64_t> sleeps;     // 페이서가 요청한 sleep
+    std::vector<int64_t> displayed;
+    int64_t              blockedUs = 0;
+    FramePacerStats      stats;
+};
+
+// 앱 루프와 같은 순서: BeginFrame → (입력/그리기 = 작업) → Present(SyncInterval())
+static PacedRun Run(PacingMode mode, int frames, int64_t (*work)(int))
+{
+    RecordingClock clock;
+    VBlankDevice device(clock);
+    FramePacer pacer(clock);
+    pacer.SetMode(mode);
+    pacer.SetTargetRate(1e6 / double(VBLANK_US));
+
+    PacedRun r;
+    for (int f = 0; f < frames; ++f)
+    {
+        pacer.BeginFrame(&device);
+        r.starts.push_back(clock.NowMicroseconds());
+        clock.m_Sim.Advance(work(f));
+        device.Present(pacer.SyncInterval());
+        r.presented.push_back(clock.NowMicroseconds());
+    }
+    r.sleeps = clock.m_Sleeps;
+    r.displayed = device.m_Displayed;
+    r.blockedUs = device.m_BlockedUs;
+    r.stats = pacer.m_Stats;
+    return r;
+}
+
+constexpr int FRAMES = 300;
+
+// Uncapped: 기다리지 않으므로 프레임 시작 = 앞 프레임 작업이 끝난 시각
+static void TestUncapped()
+{
+    PacedRun r = Run(PacingMode::Uncapped, FRAMES, VaryingWorkUs);
+    int64_t t = 0;
+    for (int f = 0; f < FRAMES; ++f)
+    {
+        CHECK_EQ(r.starts[f], t);
+        CHECK_EQ(r.displayed[f], t + VaryingWorkUs(f));
+        t += VaryingWorkUs(f);
+    }
+    CHECK(r.sleeps.empty());
+    CHECK_EQ(r.blockedUs, 0ll);
+    CHECK_EQ(r.stats.frames, uint64_t(FRAMES));
+    CHECK_EQ(r.stats.intervals, uint64_t(FRAMES - 1));
+    CHECK_EQ(r.stats.minIntervalUs, 4000ll);
+    CHECK_EQ(r.stats.maxIntervalUs, 25000ll);
+}
+
+// FixedRate: 마감은 간격 격자에 고정. 마감 2 ms 전까지 sleep (오차 최대 1 ms) 하고 나머지는 스핀하므로
+// 일찍 끝난 프레임 다음은 정확히 마감에 시작하고, 늦게 끝난 프레임 (한 간격 안) 다음은 끝나자마자 시작한다.
+static void TestFixedRate()
+{
+    PacedRun r = Run(PacingMode::FixedRate, FRAMES, VaryingWorkUs);
+    std::vector<int64_t> sleeps;
+    int64_t late = 0;
+    CHECK_EQ(r.starts[0], 0ll);
+    for (int f = 1; f < FRAMES; ++f)
+    {
+        const int64_t deadline = int64_t(f) * VBLANK_US;
+        const int64_t ready = r.starts[f - 1] + VaryingWorkUs(f - 1);   // 앞 프레임이 끝난 시각
+        CHECK_EQ(r.starts[f], std::max(ready, deadline));
+        if (deadline - ready > 2000) sleeps.push_back(deadline - 2000 - ready);
+        late += std::max<int64_t>(0, ready - deadline);
+    }
+    CHECK(r.sleeps == sleeps);
+    CHECK(sleeps.size() > size_t(FRAMES * 9 / 10));
+    CHECK_EQ(r.stats.missed, 0ull);
+    CHECK_EQ(r.stats.lateUs, late);
+    CHECK(late > 0);
+    CHECK_EQ(r.blockedUs, 0ll);
+
+    // 한 간격 넘게 늦으면 (40 ms) 기준을 다시 잡고 missed로 센다
+    RecordingClock clock;
+    FramePacer pacer(clock);
+    pacer.SetMode(PacingMode::FixedRate);
+    pacer.BeginFrame(nullptr);
+    clock.m_Sim.Advance(40000);
+    pacer.BeginFrame(nullptr);
+    CHECK_EQ(pacer.m_Stats.missed, 1ull);
+    CHECK_EQ(clock.NowMicroseconds(), 40000ll);
+    clock.m_Sim.Advance(5000);
+    pacer.BeginFrame(nullptr);
+    CHECK_EQ(clock.NowMicroseconds(), 40000ll + VBLANK_US);
+    CHECK_EQ(clock.m_Sleeps.size(), size_t(1));
+    CHECK_EQ(clock.m_Sleeps[0], VBLANK_US - 5000 - 2000);
+}
+
+// VSync: 페이서는 기다리지 않고 (다음 프레임은 Present가 돌아오자마자 시작) 기다림은 Present에서.
+// 큐에 한 프레임이 쌓여 있어 일정한 작업량에서는 시작 → 화면이 두 간격이다.
+static void TestVSync()
+{
+    PacedRun r = Run(PacingMode::VSync, FRAMES, VaryingWorkUs);
+    CHECK(r.sleeps.empty());
+    CHECK(r.blockedUs > 0);
+    for (int f = 1; f < FRAMES; ++f)
+    {
+        CHECK_EQ(r.starts[f], r.presented[f - 1]);
+        CHECK_EQ(r.displayed[f] % VBLANK_US, 0ll);
+        CHECK(r.displayed[f] - r.displayed[f - 1] >= VBLANK_US);
+    }
+
+    PacedRun s = Run(PacingMode::VSync, FRAMES, SteadyWorkUs);
+    for (int f = 2; f < FRAMES; ++f)
+    {
+        CHECK_EQ(s.starts[f], int64_t(f - 1) * VBLANK_US);
+        CHECK_EQ(s.displayed[f] - s.starts[f], 2 * VBLANK_US);
+    }
+    CHECK_EQ(s.stats.minIntervalUs, 6000ll);   // 첫 Present는 큐가 비어 있어 막히지 않는다
+    CHECK_EQ(s.stats.maxIntervalUs, VBLANK_US);
+}
+
+// LowLatency: 프레임을 시작하기 전에 앞 프레임이 화면에 나갈 때까지 기다리므로
+// 일정한 작업량에서 시작 → 화면이 한 간격 (VSync의 절반), 나가는 속도는 같다.
+static void TestLowLatency()
+{
+    PacedRun r = Run(PacingMode::LowLatency, FRAMES, VaryingWorkUs);
+    CHECK(r.sleeps.empty());
+    for (int f = 1; f < FRAMES; ++f)
+    {
+        CHECK_EQ(r.starts[f], std::max(r.presented[f - 1], r.displayed[f - 1]));
+        CHECK_EQ(r.displayed[f] % VBLANK_US, 0ll);
+        CHECK_EQ(r.displayed[f] - r.starts[f], VaryingWorkUs(f) > VBLANK_US ? 2 * VBLANK_US : VBLANK_US);
+    }
+
+    PacedRun s = Run(PacingMode::LowLatency, FRAMES, SteadyWorkUs);
+    PacedRun v = Run(PacingMode::VSync, FRAMES, SteadyWorkUs);
+    for (int f = 1; f < FRAMES; ++f)
+    {
+        CHECK_EQ(s.starts[f], int64_t(f) * VBLANK_US);
+        CHECK_EQ(s.displayed[f] - s.starts[f], VBLANK_US);
+    }
+    CHECK_EQ(s.displayed.back(), v.displayed.back());
+
+    // 지연 대기 객체가 없는 백엔드 (Null)에서는 기다리지 않는다
+    RecordingClock clock;
+    NullRenderDevice null;
+    FramePacer pacer(clock);
+    pacer.SetMode(PacingMode::LowLatency);
+    pacer.BeginFrame(&null);
+    CHECK_EQ(clock.NowMicroseconds(), 0ll);
+    CHECK_EQ(pacer.SyncInterval(), 1u);
+}
+
+int main()
+{
+    TestUncapped();
+    TestFixedRate();
+    TestVSync();
+    TestLowLatency();
+    return TestResult("FramePacerTest");
+}
@@ -0,0 +1,141 @@
+﻿// 입력 재생: 합성 마우스 이벤트를 BoxScene에 넣고 프레임마다 적용한 카메라와 배치 결과를 확인한다
+// (디바이스 없이 입력/카메라/레이캐스트/배치만 쓴다)
+
+#include <cmath>
+
+#include "SceneScript.h"
+#include "TestCheck.h"
+
+static bool Near(float a, float b, float eps = 1e-5f) { return fabsf(a - b) <= eps; }
+
+static void InitCamera(BoxScene& scene)
+{
+    scene.m_Camera.SetProjection(ToRadians(60.0f), float(scene.m_Width) / float(scene.m_Height), BoxScene::CAMERA_NEAR, BoxScene::CAMERA_FAR);
+    scene.m_Camera.SetOrbit(0.0f, ToRadians(30.0f), 40.0f);
+}
+
+// 월드 점 → 지금 카메라에서의 화면 픽셀 (ScreenRay의 역)
+static void ProjectToPixel(BoxScene& scene, const Vec3& p, int& mx, int& my)
+{
+    Vec3 ndc = scene.m_Camera.ViewProj().TransformPoint(p);
+    mx = int(lroundf((ndc.x + 1.0f) * 0.5f * float(scene.m_Width)));
+    my = int(lroundf((1.0f - ndc.y) * 0.5f * float(scene.m_Height)));
+}
+
+// 한 프레임의 드래그/휠은 합쳐서 카메라를 한 번만 바꾼다
+static void TestDragAndWheel()
+{
+    SteadyFrameClock clock;
+    BoxScene scene(clock);
+    InitCamera(scene);
+    const uint64_t v0 = scene.m_Camera.Version();
+
+    scene.m_Input.BeginDrag(100, 100);
+    scene.m_Input.MouseMove(110, 100);
+    scene.m_Input.MouseMove(130, 95);
+    scene.m_Input.EndDrag();
+    scene.m_Input.MouseMove(500, 500);   // 드래그가 끝난 뒤의 이동은 무시
+    scene.m_Input.Wheel(120);
+    scene.m_Input.Wheel(120);
+    scene.ApplyInput();
+
+    const float k = BoxScene::ORBIT_RADIANS_PER_PIXEL;
+    CHECK(Near(scene.m_Camera.m_Yaw, 30 * k));
+    CHECK(Near(scene.m_Camera.m_Pitch, ToRadians(30.0f) + 5 * k));
+    CHECK(Near(scene.m_Camera.m_Radius, 40.0f * 0.9f * 0.9f, 1e-4f));
+    CHECK_EQ(scene.m_Camera.Version(), v0 + 1);
+
+    // 입력이 없는 프레임은 카메라를 건드리지 않는다
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_Camera.Version(), v0 + 1);
+
+    // 줌 아웃은 RADIUS_MAX에서, 피치는 ±89도에서 멈춘다
+    for (int i = 0; i < 100; ++i) scene.m_Input.Wheel(-120);
+    scene.m_Input.BeginDrag(0, 0);
+    scene.m_Input.MouseMove(0, -100000);
+    scene.m_Input.EndDrag();
+    scene.ApplyInput();
+    CHECK(Near(scene.m_Camera.m_Radius, OrbitCamera::RADIUS_MAX));
+    CHECK(Near(scene.m_Camera.m_Pitch, ToRadians(89.0f)));
+}
+
+// 바닥 클릭 → 배치, 윗면 클릭 → 위에 쌓기, Ctrl 클릭 → 맞은 박스 제거
+static void TestPlacement()
+{
+    SteadyFrameClock clock;
+    BoxScene scene(clock);
+    InitCamera(scene);
+
+    int mx, my;
+    ProjectToPixel(scene, Vec3(3.5f, 0.0f, -1.5f), mx, my);
+    scene.m_Input.Click(mx, my, false);
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_PlacedBoxes.Count(), 1u);
+    CHECK(scene.m_PlacedBoxes.Contains({ 3, 0, -2 }));
+    CHECK_EQ(scene.m_PlacedBoxes.MaterialAt({ 3, 0, -2 }), 1);
+
+    // 윗면 가운데를 겨누면 그 위 셀에 material 2로 쌓인다
+    scene.m_CurrentMaterial = 2;
+    ProjectToPixel(scene, Vec3(3.5f, 1.0f, -1.5f), mx, my);
+    scene.m_Input.Click(mx, my, false);
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_PlacedBoxes.Count(), 2u);
+    CHECK_EQ(scene.m_PlacedBoxes.MaterialAt({ 3, 1, -2 }), 2);
+
+    // 같은 곳을 Ctrl 클릭하면 처음 맞는 (위) 박스만 지운다
+    ProjectToPixel(scene, Vec3(3.5f, 2.0f, -1.5f), mx, my);
+    scene.m_Input.Click(mx, my, true);
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_PlacedBoxes.Count(), 1u);
+    CHECK(!scene.m_PlacedBoxes.Contains({ 3, 1, -2 }));
+    CHECK(scene.m_PlacedBoxes.Contains({ 3, 0, -2 }));
+
+    // 빈 바닥을 Ctrl 클릭해도 아무 일 없다
+    ProjectToPixel(scene, Vec3(-5.5f, 0.0f, 4.5f), mx, my);
+    scene.m_Input.Click(mx, my, true);
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_PlacedBoxes.Count(), 1u);
+}
+
+// 같은 프레임의 클릭은 그 프레임의 드래그를 적용한 뒤의 카메라로 레이를 쏜다
+static void TestClickUsesFrameCamera()
+{
+    SteadyFrameClock clock;
+    BoxScene scene(clock);
+    InitCamera(scene);
+
+    // 드래그 후 카메라에서 (−6, 0, 2) 셀 중심이 보이는 픽셀을 미리 구한다
+    BoxScene after(clock);
+    InitCamera(after);
+    after.m_Camera.Orbit(40 * BoxScene::ORBIT_RADIANS_PER_PIXEL, -(-20) * BoxScene::ORBIT_RADIANS_PER_PIXEL);
+    int mx, my;
+    ProjectToPixel(after, Vec3(-5.5f, 0.0f, 2.5f), mx, my);
+
+    scene.m_Input.BeginDrag(0, 0);
+    scene.m_Input.MouseMove(40, -20);
+    scene.m_Input.EndDrag();
+    scene.m_Input.Click(mx, my, false);
+    scene.ApplyInput();
+    CHECK_EQ(scene.m_PlacedBoxes.Count(), 1u);
+    CHECK(scene.m_PlacedBoxes.Contains({ -6, 0, 2 }));
+}
+
+// SceneScript의 긴 재생: 프레임마다 한 번 적용한 카메라가 이벤트마다 적용한 카메라와 같고, 재계산은 프레임당 한 번
+static void TestReplayScript()
+{
+    const int FRAMES = 120;
+    InputReplayReport r = RunInputReplay(FRAMES);
+    CHECK(r.Matches());
+    CHECK_EQ(r.coalescedUpdates, uint64_t(FRAMES));
+    CHECK(r.perEventUpdates > 10 * r.coalescedUpdates);
+    CHECK_EQ(r.boxes, size_t(FRAMES / 30));   // 30프레임마다 화면 가운데 클릭 한 번
+}
+
+int main()
+{
+    TestDragAndWheel();
+    TestPlacement();
+    TestClickUsesFrameCamera();
+    TestReplayScript();
+    return TestResult("InputReplayTest");
+}
@@ -0,0 +1,230 @@
+﻿// OcclusionCuller: 가리개 벽 뒤/앞/옆 박스 판정, 두 가리개 사이 틈으로 보이는 박스, 무작위 장면에서 실제로 보이는 박스를 숨기지 않는지 (보수성)
+// 실제 가시성은 오클루전 버퍼의 8배 해상도로 광선을 쏴서 박스끼리 직접 교차해 구한다.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "OcclusionCuller.h"
+#include "TestCheck.h"
+
+// 원점에서 +Z를 바라보는 원근 투영 (60도, 16:9). 화면 x가 월드 x와 같은 방향이 되도록 왼손 행렬을 직접 만든다
+// (기준 광선과 WorldXAt을 단순하게 하려고. 컬러는 행렬만 쓰므로 규약과 무관하다)
+static const float ZN = 0.1f, ZF = 1000.0f;
+static const float PROJ_H = 1.0f / tanf(0.5f * 1.0471976f), PROJ_W = PROJ_H / (16.0f / 9.0f);
+static const float VIEW_PROJ[16] = { PROJ_W,0,0,0, 0,PROJ_H,0,0, 0,0,ZF / (ZF - ZN),1, 0,0,-ZN * ZF / (ZF - ZN),0 };
+
+struct Box
+{
+    float mn[3], mx[3];
+};
+
+// 오클루전 버퍼 픽셀 x → 깊이 z에서의 월드 x (IsVisible의 화면 변환의 역)
+static float WorldXAt(float sx, float z)
+{
+    return (sx / OcclusionCuller::WIDTH - 0.5f) * 2.0f / PROJ_W * z;
+}
+
+static void Build(OcclusionCuller& oc, const std::vector<Box>& occluders)
+{
+    oc.BeginFrame(VIEW_PROJ);
+    for (const Box& b : occluders) oc.AddOccluderBox(b.mn, b.mx);
+    oc.Rasterize(nullptr);
+}
+
+static void TestWall()
+{
+    // 벽 실루엣 오른쪽 가장자리 (앞면 z = 20)가 픽셀 160의 중심을 지나 160.9에 오도록 둔다
+    const float edge = 160.9f;
+    OcclusionCuller oc;
+    Build(oc, { { { -5, -5, 20 }, { WorldXAt(edge, 20.0f), 5, 21 } } });
+    CHECK_EQ(oc.m_Stats.occluders, 1u);
+
+    const Box behind{ { -1, -1, 50 }, { 1, 1, 52 } };
+    const Box front{ { -1, -1, 10 }, { 1, 1, 12 } };
+    const Box beside{ { 20, -1, 50 }, { 22, 1, 52 } };
+    const Box straddle{ { -1, -1, 15 }, { 1, 1, 30 } };   // 벽을 뚫고 앞으로 나옴
+    CHECK(!oc.IsVisible(behind.mn, behind.mx));
+    CHECK(oc.IsVisible(front.mn, front.mx));
+    CHECK(oc.IsVisible(beside.mn, beside.mx));
+    CHECK(oc.IsVisible(straddle.mn, straddle.mx));
+
+    // 가장자리 밖으로 한 픽셀이 안 되게 삐져나온 뒤쪽 박스도 보인다
+    // (픽셀 160은 중심이 덮였지만 160.9 ~ 161은 비어 있으므로 깊이를 쓰지 않는다)
+    for (float overhang = 0.05f; overhang < 1.0f; overhang += 0.1f)
+    {
+        const float z = 60.0f;
+        Box b{ { 0.0f, -1, z }, { WorldXAt(edge + overhang, z), 1, z + 2 } };
+        if (!oc.IsVisible(b.mn, b.mx))
+        {
+            std::fprintf(stderr, "  box overhanging the occluder edge by %.2f px was culled\n", overhang);
+            CHECK(false);
+        }
+    }
+    // 가장자리 안쪽으로 한 픽셀 넘게 들어오면 가려진다
+    Box inside{ { 0.0f, -1, 60 }, { WorldXAt(edge - 2.0f, 60), 1, 62 } };
+    CHECK(!oc.IsVisible(inside.mn, inside.mx));
+}
+
+// 광선 r(t) = dir * t 와 AABB의 가장 가까운 교차 t (없으면 INFINITY)
+static float RayBox(const float dir[3], const Box& b)
+{
+    float t0 = 0.0f, t1 = INFINITY;
+    for (int a = 0; a < 3; ++a)
+    {
+        if (dir[a] == 0.0f)
+        {
+            if (b.mn[a] > 0.0f || b.mx[a] < 0.0f) return INFINITY;
+            continue;
+        }
+        float ta = b.mn[a] / dir[a], tb = b.mx[a] / dir[a];
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1) return INFINITY;
+    }
+    return t0;
+}
+
+// 화면을 SUPERSAMPLE배로 나눈 샘플 중 하나라도 박스가 가리개보다 앞이면 보인다
+static bool TrulyVisible(const Box& box, const std::vector<Box>& occluders)
+{
+    constexpr int SUPERSAMPLE = 8;
+    constexpr int W = OcclusionCuller::WIDTH * SUPERSAMPLE, H = OcclusionCuller::HEIGHT * SUPERSAMPLE;
+
+    // 박스의 화면 사각형 (박스는 모두 카메라 앞)
+    float x0 = 1e30f, x1 = -1e30f, y0 = 1e30f, y1 = -1e30f;
+    for (int i = 0; i < 8; ++i)
+    {
+        float p[3] = { (i & 1) ? box.mx[0] : box.mn[0], (i & 2) ? box.mx[1] : box.mn[1], (i & 4) ? box.mx[2] : box.mn[2] };
+        float sx = (p[0] / p[2] * PROJ_W * 0.5f + 0.5f) * W, sy = (0.5f - p[1] / p[2] * PROJ_H * 0.5f) * H;
+        x0 = std::min(x0, sx); x1 = std::max(x1, sx); y0 = std::min(y0, sy); y1 = std::max(y1, sy);
+    }
+    int ix0 = std::max(0, int(x0)), ix1 = std::min(W - 1, int(x1));
+    int iy0 = std::max(0, int(y0)), iy1 = std::min(H - 1, int(y1));
+
+    for (int y = iy0; y <= iy1; ++y)
+        for (int x = ix0; x <= ix1; ++x)
+        {
+            float dir[3] = { ((x + 0.5f) / W * 2.0f - 1.0f) / PROJ_W, (1.0f - (y + 0.5f) / H * 2.0f) / PROJ_H, 1.0f };
+            float t = RayBox(dir, box);
+            if (t == INFINITY) continue;
+            bool hidden = false;
+            for (const Box& o : occluders)
+                if (RayBox(dir, o) < t) { hidden = true; break; }
+            if (!hidden) return true;
+        }
+    return false;
+}
+
+// 두 벽이 이웃한 저해상도 픽셀 안에서 끝나고 시작할 때 (160.6 | 160.9) 그 틈으로 보이는 뒤쪽 박스는 보인다.
+// 두 벽 모두 자기 쪽 픽셀 중심을 덮으므로 중심 샘플로 래스터하면 틈이 메워진다.
+static void TestGapBetweenOccluders()
+{
+    const float z = 20.0f, behindZ = 50.0f;
+    for (float left = 160.1f; left < 161.0f; left += 0.1f)
+        for (float gap = 0.15f; gap < 1.5f; gap += 0.2f)   // 기준 광선이 8배 해상도라 그보다 좁은 틈은 빼고 본다
+        {
+            // 화면 중심 오른쪽이므로 왼쪽 벽의 실루엣 오른쪽 끝은 앞면, 오른쪽 벽의 왼쪽 끝은 뒷면이다
+            const float right = left + gap;
+            const std::vector<Box> walls =
+            {
+                { { WorldXAt(100.0f, z), -5, z }, { WorldXAt(left, z), 5, z + 1 } },
+                { { WorldXAt(right, z + 1.5f), -5, z + 0.5f }, { WorldXAt(220.0f, z), 5, z + 1.5f } },
+            };
+            OcclusionCuller oc;
+            Build(oc, walls);
+
+            // 틈 뒤를 가로지르는 박스 (틈 밖으로 여러 픽셀 걸치므로 대부분 벽에 가려진다)
+            const Box behind{ { WorldXAt(150.0f, behindZ), -1, behindZ }, { WorldXAt(170.0f, behindZ), 1, behindZ + 2 } };
+            CHECK(TrulyVisible(behind, walls));
+            if (!oc.IsVisible(behind.mn, behind.mx))
+            {
+                std::fprintf(stderr, "  box behind a %.2f px gap at x = %.2f was culled\n", gap, left);
+                CHECK(false);
+            }
+
+            // 틈에서 떨어진 쪽 박스는 여전히 가려진다
+            const Box hidden{ { WorldXAt(120.0f, behindZ), -1, behindZ }, { WorldXAt(140.0f, behindZ), 1, behindZ + 2 } };
+            CHECK(!oc.IsVisible(hidden.mn, hidden.mx));
+        }
+}
+
+// 무작위 가리개/박스: 컬러가 숨긴 박스는 모두 실제로도 안 보여야 하고, 실제로 가려진 박스 상당수는 숨겨야 한다
+static void TestConservativeRandom()
+{
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+
+    int culled = 0, trulyHidden = 0, wrong = 0;
+    for (int scene = 0; scene < 8; ++scene)
+    {
+        std::vector<Box> occluders;
+        for (int i = 0; i < 24; ++i)
+        {
+            float x = -12 + 24 * u(rng), y = -6 + 12 * u(rng), z = 12 + 10 * u(rng);
+            float sx = 1 + 4 * u(rng), sy = 1 + 4 * u(rng), sz = 0.5f + 2 * u(rng);
+            occluders.push_back({ { x, y, z }, { x + sx, y + sy, z + sz } });
+        }
+        OcclusionCuller oc;
+        Build(oc, occluders);
+
+        for (int i = 0; i < 60; ++i)
+        {
+            float z = 25 + 40 * u(rng);
+            float x = (-0.5f + u(rng)) * z * 0.9f, y = (-0.5f + u(rng)) * z * 0.5f;
+            float s = 0.2f + 2.0f * u(rng);
+            Box b{ { x, y, z }, { x + s, y + s, z + s } };
+
+            bool visible = TrulyVisible(b, occluders);
+            trulyHidden += !visible;
+            if (!oc.IsVisible(b.mn, b.mx))
+            {
+                ++culled;
+                if (visible) ++wrong;
+            }
+        }
+    }
+    std::printf("  random scenes: %d truly hidden, %d culled, %d visible boxes culled\n", trulyHidden, culled, wrong);
+    CHECK_EQ(wrong, 0);
+    CHECK(culled * 4 > trulyHidden * 3);
+}
+
+// FilterVisible은 (병렬이어도) 보이는 항목만 순서대로 남긴다
+static void TestFilterVisible()
+{
+    OcclusionCuller oc;
+    Build(oc, { { { -5, -5, 20 }, { 5, 5, 21 } } });
+
+    std::vector<Box> boxes;
+    for (int i = 0; i < 5000; ++i)
+    {
+        float x = float(i % 50) - 25.0f, y = float((i / 50) % 10) - 5.0f;
+        boxes.push_back({ { x, y, 40 }, { x + 0.8f, y + 0.8f, 41 } });
+    }
+    std::vector<uint32_t> serial(boxes.size()), parallel;
+    for (uint32_t i = 0; i < boxes.size(); ++i) serial[i] = i;
+    parallel = serial;
+
+    auto bounds = [&](uint32_t i, float mn[3], float mx[3])
+    {
+        for (int a = 0; a < 3; ++a) { mn[a] = boxes[i].mn[a]; mx[a] = boxes[i].mx[a]; }
+    };
+    oc.FilterVisible(serial, bounds, nullptr);
+    ThreadPool pool(2);
+    oc.FilterVisible(parallel, bounds, &pool);
+
+    CHECK(serial == parallel);
+    CHECK(oc.m_Stats.occluded > 0 && oc.m_Stats.occluded < oc.m_Stats.tested);
+    for (size_t i = 1; i < serial.size(); ++i) CHECK(serial[i - 1] < serial[i]);
+    for (uint32_t i : serial) CHECK(oc.IsVisible(boxes[i].mn, boxes[i].mx));
+}
+
+int main()
+{
+    TestWall();
+    TestGapBetweenOccluders();
+    TestConservativeRandom();
+    TestFilterVisible();
+    return TestResult("OcclusionCullerTest");
+}
@@ -0,0 +1,75 @@
+﻿// RenderQueue::PassRange: 정렬 후 패스별 구간이 제출 순서와 상관없이 그 패스의 항목만 정확히 담는지
+// BoxScene처럼 하늘을 불투명 다음에 제출하는 경우와 먼저 제출하는 경우, 삽입 정렬(작은 큐)과 기수 정렬 경로를 모두 본다.
+
+#include <cstdint>
+
+#include "RenderQueue.h"
+#include "TestCheck.h"
+
+// 항목의 start에 패스를 적어 두고 구간 안의 항목이 그 패스인지 확인한다.
+static DrawItem MakeItem(RenderPass pass, uint32_t shader, uint32_t texture)
+{
+    DrawItem it;
+    it.vs.id = shader;
+    it.ps.id = shader;
+    it.texture.id = texture;
+    it.start = uint32_t(pass);
+    return it;
+}
+
+static void CheckRanges(RenderQueue& q, size_t skyCount, size_t opaqueCount)
+{
+    q.Sort();
+    RenderQueue::Range sky = q.PassRange(RenderPass::Sky);
+    RenderQueue::Range opaque = q.PassRange(RenderPass::Opaque);
+
+    CHECK_EQ(sky.begin, size_t(0));
+    CHECK_EQ(sky.end, skyCount);
+    CHECK_EQ(opaque.begin, skyCount);
+    CHECK_EQ(opaque.end, skyCount + opaqueCount);
+
+    for (size_t i = sky.begin; i < sky.end; ++i) CHECK_EQ(q.m_Items[q.m_Order[i]].start, uint32_t(RenderPass::Sky));
+    for (size_t i = opaque.begin; i < opaque.end; ++i) CHECK_EQ(q.m_Items[q.m_Order[i]].start, uint32_t(RenderPass::Opaque));
+    for (size_t i = 1; i < q.m_Keys.size(); ++i) CHECK(q.m_Keys[i - 1] <= q.m_Keys[i]);
+}
+
+// skyFirst: 하늘을 먼저 제출할지. 불투명 항목은 셰이더/텍스처/깊이를 섞어 하늘보다 작은 키 비트도 갖게 한다.
+static void TestPassRanges(size_t skyCount, size_t opaqueCount, bool skyFirst)
+{
+    RenderQueue q;
+    auto submitSky = [&]
+    {
+        for (size_t i = 0; i < skyCount; ++i) q.Submit(RenderPass::Sky, MakeItem(RenderPass::Sky, 40, 7), 1.0f);
+    };
+
+    if (skyFirst) submitSky();
+    for (size_t i = 0; i < opaqueCount; ++i)
+        q.Submit(RenderPass::Opaque, MakeItem(RenderPass::Opaque, 1 + uint32_t(i % 3), uint32_t(i % 5)), float(i % 17) / 16.0f);
+    if (!skyFirst) submitSky();
+
+    CheckRanges(q, skyCount, opaqueCount);
+}
+
+// 빈 패스는 빈 구간
+static void TestEmptyPass()
+{
+    RenderQueue q;
+    for (int i = 0; i < 3; ++i) q.Submit(RenderPass::Opaque, MakeItem(RenderPass::Opaque, 1, uint32_t(i)), 0.5f);
+    CheckRanges(q, 0, 3);
+
+    q.Reset();
+    q.Submit(RenderPass::Sky, MakeItem(RenderPass::Sky, 40, 7), 1.0f);
+    CheckRanges(q, 1, 0);
+}
+
+int main()
+{
+    for (bool skyFirst : { false, true })
+    {
+        TestPassRanges(1, 2, skyFirst);      // BoxScene: 박스 + 격자, 하늘
+        TestPassRanges(1, 40, skyFirst);
+        TestPassRanges(3, 500, skyFirst);    // 기수 정렬 경로
+    }
+    TestEmptyPass();
+    return TestResult("RenderQueueTest");
+}
@@ -0,0 +1,160 @@
+﻿// StateFilterContext + HandleTable: 버퍼를 해제하고 다시 만들면 (같은 칸을 재사용해도) 다시 바인딩이 전달되는지
+// App::UploadInstances가 인스턴스 버퍼를 키울 때와 같은 순서로 Null 백엔드에서 확인한다.
+
+#include <cstddef>
+
+#include "NullRenderDevice.h"
+#include "StateFilter.h"
+#include "TestCheck.h"
+
+struct InstancedScene
+{
+    NullRenderDevice   device;
+    StateFilterContext filter{ device.Context() };
+    ShaderHandle       vs, ps;
+    InputLayoutHandle  layout;
+    BufferHandle       vb, ib;
+
+    static constexpr uint32_t VERTEX_STRIDE = 12;
+    static constexpr uint32_t INSTANCE_STRIDE = 48;
+
+    InstancedScene()
+    {
+        device.m_Context.m_Record = true;
+        vs = device.CreateShader({ ShaderStage::Vertex, L"BasicTex.hlsl", "VSMain" });
+        ps = device.CreateShader({ ShaderStage::Pixel, L"BasicTex.hlsl", "PSMain" });
+        VertexElement il[] =
+        {
+            { "POSITION",  0, VertexFormat::Float3, 0, 0, false },
+            { "INSTWORLD", 0, VertexFormat::Float4, 1, 0, true },
+        };
+        layout = device.CreateInputLayout(il, 2, vs);
+
+        float verts[3 * 3] = {};
+        uint16_t idx[3] = { 0, 1, 2 };
+        vb = device.CreateBuffer({ BufferBind::Vertex, BufferUsage::Immutable, sizeof(verts) }, verts);
+        ib = device.CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, sizeof(idx) }, idx);
+    }
+
+    BufferHandle CreateInstanceBuffer(uint32_t capacity)
+    {
+        return device.CreateBuffer({ BufferBind::Vertex, BufferUsage::Dynamic, capacity * INSTANCE_STRIDE }, nullptr);
+    }
+
+    void Draw(BufferHandle instances, uint32_t instanceCount)
+    {
+        const BufferHandle buffers[2] = { vb, instances };
+        const uint32_t strides[2] = { VERTEX_STRIDE, INSTANCE_STRIDE };
+        filter.SetVertexShader(vs);
+        filter.SetPixelShader(ps);
+        filter.SetInputLayout(layout);
+        filter.SetVertexBuffers(0, 2, buffers, strides, nullptr);
+        filter.SetIndexBuffer(ib, IndexFormat::UInt16, 0);
+        filter.DrawIndexedInstanced(3, instanceCount, 0, 0, 0);
+    }
+
+    // 마지막으로 slot에 바인딩된 버퍼 id (로그 기준, 없으면 0)
+    uint32_t LastBoundVertexBuffer(uint32_t slot) const
+    {
+        uint32_t id = 0;
+        for (const NullCommand& c : device.m_Context.m_Log)
+            if (c.op == NullOp::VertexBuffer && c.a == slot) id = c.b;
+        return id;
+    }
+};
+
+// 인스턴스 버퍼를 두 배로 키우며 다시 만든다: 칸은 재사용되지만 새 핸들의 바인딩이 디바이스까지 가야 한다
+static void TestInstanceBufferGrowth()
+{
+    InstancedScene s;
+    uint32_t capacity = 1024;
+    BufferHandle instances = s.CreateInstanceBuffer(capacity);
+    s.Draw(instances, capacity);
+    CHECK_EQ(s.LastBoundVertexBuffer(1), instances.id);
+
+    for (int grow = 0; grow < 4; ++grow)
+    {
+        const BufferHandle old = instances;
+        const size_t liveBefore = s.device.m_Buffers.LiveCount();
+        s.device.DestroyBuffer(instances);
+        capacity *= 2;
+        instances = s.CreateInstanceBuffer(capacity);
+
+        CHECK(instances);
+        CHECK(instances != old);                                  // 같은 칸이라도 세대가 다르다
+        CHECK_EQ(s.device.m_Buffers.LiveCount(), liveBefore);     // 칸은 늘지 않았다 (재사용)
+        CHECK(s.device.m_Buffers.Get(old.id) == nullptr);         // 해제한 핸들은 계속 무효
+
+        const size_t logBefore = s.device.m_Context.m_Log.size();
+        s.Draw(instances, capacity);                              // 키운 만큼 그려도 범위 안
+        CHECK_EQ(s.LastBoundVertexBuffer(1), instances.id);
+        CHECK_EQ(s.device.m_Context.m_VB[1].id, instances.id);
+
+        // 슬롯 0 (박스 정점)은 그대로라 슬롯 1만 다시 전달된다
+        uint32_t vbBinds = 0;
+        for (size_t i = logBefore; i < s.device.m_Context.m_Log.size(); ++i)
+        {
+            const NullCommand& c = s.device.m_Context.m_Log[i];
+            if (c.op == NullOp::VertexBuffer) { ++vbBinds; CHECK_EQ(c.a, 1u); }
+        }
+        CHECK_EQ(vbBinds, 1u);
+    }
+
+    // 바뀐 것이 없으면 여전히 걸러진다
+    const uint64_t elided = s.filter.m_Stats.elided;
+    s.Draw(instances, capacity);
+    CHECK(s.filter.m_Stats.elided > elided);
+
+    CHECK_EQ(s.device.m_Context.m_Counters.validationErrors, 0ull);
+    for (const std::string& e : s.device.m_Context.m_Errors) std::fprintf(stderr, "  %s\n", e.c_str());
+}
+
+// 청크 메쉬 교체 (정점/인덱스 버퍼를 모두 해제 후 생성)도 같은 경로: 인덱스 버퍼 바인딩이 걸러지지 않아야 한다
+static void TestIndexBufferReplace()
+{
+    InstancedScene s;
+    BufferHandle instances = s.CreateInstanceBuffer(16);
+    s.Draw(instances, 16);
+
+    const BufferHandle oldIb = s.ib;
+    s.device.DestroyBuffer(s.ib);
+    uint32_t idx[3] = { 0, 1, 2 };
+    s.ib = s.device.CreateBuffer({ BufferBind::Index, BufferUsage::Immutable, sizeof(idx) }, idx);
+    CHECK(s.ib != oldIb);
+
+    const BufferHandle buffers[2] = { s.vb, instances };
+    const uint32_t strides[2] = { InstancedScene::VERTEX_STRIDE, InstancedScene::INSTANCE_STRIDE };
+    s.filter.SetVertexBuffers(0, 2, buffers, strides, nullptr);
+    s.filter.SetIndexBuffer(s.ib, IndexFormat::UInt32, 0);
+    s.filter.DrawIndexedInstanced(3, 16, 0, 0, 0);
+
+    uint32_t boundIb = 0;
+    for (const NullCommand& c : s.device.m_Context.m_Log)
+        if (c.op == NullOp::IndexBuffer) boundIb = c.a;
+    CHECK_EQ(boundIb, s.ib.id);
+    CHECK_EQ(s.device.m_Context.m_Counters.validationErrors, 0ull);
+}
+
+// 해제한 핸들을 (칸이 재사용된 뒤) 바인딩하면 Null 백엔드가 잡는다
+static void TestStaleHandleRejected()
+{
+    InstancedScene s;
+    BufferHandle a = s.CreateInstanceBuffer(16);
+    s.device.DestroyBuffer(a);
+    BufferHandle b = s.CreateInstanceBuffer(16);
+    CHECK(a != b);
+    CHECK_EQ(a.id & HANDLE_INDEX_MASK, b.id & HANDLE_INDEX_MASK);
+
+    const BufferHandle buffers[1] = { a };
+    const uint32_t strides[1] = { InstancedScene::INSTANCE_STRIDE };
+    s.device.Context().SetVertexBuffers(1, 1, buffers, strides, nullptr);
+    CHECK_EQ(s.device.m_Context.m_Counters.validationErrors, 1ull);
+}
+
+int main()
+{
+    TestInstanceBufferGrowth();
+    TestIndexBufferReplace();
+    TestStaleHandleRejected();
+    return TestResult("StateFilterTest");
+}
@@ -0,0 +1,27 @@
+﻿#pragma once
+
+// 테스트 공용 검사 매크로 (Windows/D3D 의존성 없음)
+// - CHECK는 실패해도 계속 진행하고, main은 TestResult()를 돌려준다.
+
+#include <cstdio>
+
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond) \
+    do { if (!(cond)) { std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); ++TestFailures(); } } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { auto va_ = (a); auto vb_ = (b); if (!(va_ == vb_)) { \
+        std::fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, \
+            (long long)va_, (long long)vb_); ++TestFailures(); } } while (0)
+
+inline int TestResult(const char* name)
+{
+    if (TestFailures()) std::printf("[%s] %d check(s) FAILED\n", name, TestFailures());
+    else std::printf("[%s] OK\n", name);
+    return TestFailures() ? 1 : 0;
+}
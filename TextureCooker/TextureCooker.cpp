@@ -0,0 +1,87 @@
+﻿// 텍스처 쿠커: PNG/DDS 원본 → BC1/BC3/BC7 DDS (감마 보정 밉 체인 포함)
+// 사용법: TextureCooker [-bc1|-bc3|-bc7] [-fast|-high] [-srgb] [-nomips] [-linearmips] <입력> <출력.dds> [<입력> <출력.dds> ...]
+//   옵션은 뒤에 오는 입력 쌍에 적용된다 (파일마다 다른 형식을 줄 수 있다)
+//   압축은 하드웨어 스레드 수만큼의 풀로 병렬 처리한다. 결과는 스레드 수와 관계없이 같다.
+// Windows/D3D 의존성 없음. Linux: g++ -std=c++17 -O2 -I../D3DBoxApp TextureCooker.cpp -o TextureCooker
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TextureCook.h"
+
+static std::wstring Widen(const char* s)
+{
+    std::wstring w;
+    for (; *s; ++s) w += wchar_t(*s);   // 경로는 ASCII 가정 (ImageIO와 같음)
+    return w;
+}
+
+static int Usage()
+{
+    fprintf(stderr, "usage: TextureCooker [-bc1|-bc3|-bc7] [-fast|-high] [-srgb] [-nomips] [-linearmips] <input> <output.dds> [...]\n");
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    CookOptions options;
+    std::vector<const char*> pending;
+    int cooked = 0;
+    ThreadPool pool;   // 하드웨어 스레드 - 1개 + 호출 스레드
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        if (a[0] == '-')
+        {
+            if (!strcmp(a, "-bc1")) options.format = BlockFormat::BC1;
+            else if (!strcmp(a, "-bc3")) options.format = BlockFormat::BC3;
+            else if (!strcmp(a, "-bc7")) options.format = BlockFormat::BC7;
+            else if (!strcmp(a, "-fast")) options.quality = BlockQuality::Fast;
+            else if (!strcmp(a, "-high")) options.quality = BlockQuality::High;
+            else if (!strcmp(a, "-srgb")) options.srgb = true;
+            else if (!strcmp(a, "-nomips")) options.mips = false;
+            else if (!strcmp(a, "-linearmips")) options.gammaCorrectMips = false;
+            else return Usage();
+            continue;
+        }
+
+        pending.push_back(a);
+        if (pending.size() < 2) continue;
+
+        const char* input = pending[0];
+        const char* output = pending[1];
+        pending.clear();
+
+        ImageSet src;
+        if (!LoadImageFile(Widen(input).c_str(), src))
+        {
+            fprintf(stderr, "[Cook] %s: failed to load\n", input);
+            return 1;
+        }
+
+        std::vector<uint8_t> dds;
+        CookStats s;
+        if (!CookTexture(src, options, dds, &s, &pool))
+        {
+            fprintf(stderr, "[Cook] %s: unsupported layout (%u faces)\n", input, src.faces);
+            return 1;
+        }
+        if (!WriteWholeFile(Widen(output).c_str(), dds))
+        {
+            fprintf(stderr, "[Cook] %s: failed to write\n", output);
+            return 1;
+        }
+
+        printf("[Cook] %s -> %s: %ls%s (%ls) %ux%u, %u mips x %u faces, %.1f KB (RGBA8 %.1f KB), mips %.1f ms, encode %.1f ms, PSNR %.2f dB\n",
+            input, output, BlockFormatName(options.format), options.srgb ? "_SRGB" : "",
+            BlockQualityName(options.quality), s.width, s.height, s.mipLevels, s.faces,
+            s.cookedBytes / 1024.0, s.rawBytes / 1024.0, s.mipMs, s.encodeMs, s.psnr);
+        ++cooked;
+    }
+
+    if (!pending.empty() || cooked == 0) return Usage();
+    return 0;
+}